@@ -0,0 +1,543 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include "Benchmarker.h"
+
+#include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/CellSetStructured.h>
+#include <viskores/cont/DataSet.h>
+#include <viskores/cont/DataSetBuilderUniform.h>
+#include <viskores/cont/ErrorBadValue.h>
+#include <viskores/cont/Initialize.h>
+#include <viskores/cont/RuntimeDeviceTracker.h>
+#include <viskores/cont/Timer.h>
+
+#include <viskores/filter/geometry_refinement/Tetrahedralize.h>
+
+#include <viskores/io/BOVDataSetReader.h>
+#include <viskores/io/ImageWriterPNG.h>
+#include <viskores/io/ImageWriterPNM.h>
+#include <viskores/io/VTKDataSetReader.h>
+#include <viskores/io/VTKDataSetWriter.h>
+#include <viskores/io/VTKXMLDataSetReader.h>
+#include <viskores/io/VTKXMLDataSetWriter.h>
+#ifdef VISKORES_BENCHMARK_HDF5_IO
+#include <viskores/io/ImageWriterHDF5.h>
+#endif
+
+#include <viskores/source/Tangle.h>
+#include <viskores/source/Wavelet.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Hold configuration state (e.g. active device):
+viskores::cont::InitializeResult Config;
+
+enum class DataSource
+{
+  Wavelet = 0,
+  Tangle = 1
+};
+
+enum class VTKFormat
+{
+  LegacyASCII = 0,
+  LegacyBinary = 1,
+  XMLAppended = 2
+};
+
+enum class ImageFormat
+{
+  PNG = 0,
+  PNM = 1,
+  HDF5 = 2
+};
+
+std::string GetScalarsName(DataSource source)
+{
+  return (source == DataSource::Wavelet) ? "RTData" : "tangle";
+}
+
+viskores::cont::DataSet MakeDataSet(DataSource source, viskores::Id dim, bool isUnstructured)
+{
+  viskores::cont::DataSet dataSet;
+  if (source == DataSource::Wavelet)
+  {
+    viskores::source::Wavelet wavelet;
+    wavelet.SetExtent({ 0 }, viskores::Id3(dim - 1));
+    dataSet = wavelet.Execute();
+  }
+  else
+  {
+    viskores::source::Tangle tangle;
+    tangle.SetPointDimensions(viskores::Id3(dim));
+    dataSet = tangle.Execute();
+  }
+
+  if (isUnstructured)
+  {
+    viskores::filter::geometry_refinement::Tetrahedralize tetrahedralize;
+    tetrahedralize.SetFieldsToPass(
+      viskores::filter::FieldSelection(viskores::filter::FieldSelection::Mode::All));
+    dataSet = tetrahedralize.Execute(dataSet);
+  }
+  return dataSet;
+}
+
+std::string MakeFileName(const std::string& bench, const std::string& extension)
+{
+  return "BenchmarkIO_" + bench + extension;
+}
+
+viskores::Id GetFileSize(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  return file ? static_cast<viskores::Id>(file.tellg()) : 0;
+}
+
+/// Measures how much the resident memory of the process grows while an I/O operation
+/// runs. Only Linux provides a high-water mark that can be reset, so the peak is not
+/// reported on other platforms.
+class PeakMemoryTracker
+{
+public:
+  void Start()
+  {
+#ifdef __linux__
+    std::ofstream("/proc/self/clear_refs") << "5";
+    this->Baseline = ReadStatus("VmRSS:");
+#endif
+  }
+
+  void Stop()
+  {
+    const viskores::Id highWaterMark = ReadStatus("VmHWM:");
+    if ((this->Baseline >= 0) && (highWaterMark >= this->Baseline))
+    {
+      this->PeakKB = std::max(this->PeakKB, highWaterMark - this->Baseline);
+    }
+  }
+
+  void ReportCounter(::benchmark::State& state) const
+  {
+    if (this->PeakKB >= 0)
+    {
+      state.counters["PeakAllocMB"] = static_cast<double>(this->PeakKB) / 1024.0;
+    }
+  }
+
+private:
+  static viskores::Id ReadStatus(const std::string& key)
+  {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+      if (line.compare(0, key.size(), key) == 0)
+      {
+        std::istringstream parse(line.substr(key.size()));
+        viskores::Id valueKB = -1;
+        parse >> valueKB;
+        return valueKB;
+      }
+    }
+    return -1;
+  }
+
+  viskores::Id Baseline = -1;
+  viskores::Id PeakKB = -1;
+};
+
+/// Accumulates the bytes moved and the time spent over all iterations so the throughput
+/// can be reported in MB/s alongside the per-iteration time.
+struct ThroughputCounter
+{
+  viskores::Id TotalBytes = 0;
+  viskores::Float64 TotalSeconds = 0;
+
+  void Add(viskores::Id bytes, viskores::Float64 seconds)
+  {
+    this->TotalBytes += bytes;
+    this->TotalSeconds += seconds;
+  }
+
+  void ReportCounters(::benchmark::State& state, viskores::Id bytesPerIteration) const
+  {
+    state.SetBytesProcessed(this->TotalBytes);
+    state.counters["FileMB"] = static_cast<double>(bytesPerIteration) / 1.0e6;
+    if (this->TotalSeconds > 0)
+    {
+      state.counters["MB/s"] = static_cast<double>(this->TotalBytes) / 1.0e6 / this->TotalSeconds;
+    }
+  }
+};
+
+void WriteVTK(const viskores::cont::DataSet& dataSet,
+              VTKFormat format,
+              const std::string& fileName)
+{
+  if (format == VTKFormat::XMLAppended)
+  {
+    viskores::io::VTKXMLDataSetWriter writer(fileName);
+    writer.WriteDataSet(dataSet);
+  }
+  else
+  {
+    viskores::io::VTKDataSetWriter writer(fileName);
+    writer.SetFileType((format == VTKFormat::LegacyBinary) ? viskores::io::FileType::BINARY
+                                                           : viskores::io::FileType::ASCII);
+    writer.WriteDataSet(dataSet);
+  }
+}
+
+viskores::cont::DataSet ReadVTK(VTKFormat format, const std::string& fileName)
+{
+  if (format == VTKFormat::XMLAppended)
+  {
+    viskores::io::VTKXMLDataSetReader reader(fileName);
+    return reader.ReadDataSet();
+  }
+  else
+  {
+    viskores::io::VTKDataSetReader reader(fileName);
+    return reader.ReadDataSet();
+  }
+}
+
+std::string GetVTKExtension(const viskores::cont::DataSet& dataSet, VTKFormat format)
+{
+  return (format == VTKFormat::XMLAppended)
+    ? viskores::io::VTKXMLDataSetWriter::GetFileExtension(dataSet)
+    : std::string(".vtk");
+}
+
+void BenchVTKWrite(::benchmark::State& state)
+{
+  const viskores::cont::DeviceAdapterId device = Config.Device;
+
+  const DataSource source = static_cast<DataSource>(state.range(0));
+  const viskores::Id dim = static_cast<viskores::Id>(state.range(1));
+  const bool isUnstructured = static_cast<bool>(state.range(2));
+  const VTKFormat format = static_cast<VTKFormat>(state.range(3));
+
+  const viskores::cont::DataSet dataSet = MakeDataSet(source, dim, isUnstructured);
+  const std::string fileName = MakeFileName("VTKWrite", GetVTKExtension(dataSet, format));
+
+  viskores::cont::Timer timer{ device };
+  PeakMemoryTracker memory;
+  ThroughputCounter throughput;
+  viskores::Id fileSize = 0;
+  for (auto _ : state)
+  {
+    (void)_;
+    memory.Start();
+    timer.Start();
+    WriteVTK(dataSet, format, fileName);
+    timer.Stop();
+    memory.Stop();
+
+    fileSize = GetFileSize(fileName);
+    throughput.Add(fileSize, timer.GetElapsedTime());
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  std::remove(fileName.c_str());
+
+  throughput.ReportCounters(state, fileSize);
+  memory.ReportCounter(state);
+}
+
+void BenchVTKRead(::benchmark::State& state)
+{
+  const viskores::cont::DeviceAdapterId device = Config.Device;
+
+  const DataSource source = static_cast<DataSource>(state.range(0));
+  const viskores::Id dim = static_cast<viskores::Id>(state.range(1));
+  const bool isUnstructured = static_cast<bool>(state.range(2));
+  const VTKFormat format = static_cast<VTKFormat>(state.range(3));
+
+  std::string fileName;
+  {
+    const viskores::cont::DataSet dataSet = MakeDataSet(source, dim, isUnstructured);
+    fileName = MakeFileName("VTKRead", GetVTKExtension(dataSet, format));
+    WriteVTK(dataSet, format, fileName);
+  }
+  const viskores::Id fileSize = GetFileSize(fileName);
+
+  viskores::cont::Timer timer{ device };
+  PeakMemoryTracker memory;
+  ThroughputCounter throughput;
+  for (auto _ : state)
+  {
+    (void)_;
+    memory.Start();
+    timer.Start();
+    viskores::cont::DataSet result = ReadVTK(format, fileName);
+    timer.Stop();
+    memory.Stop();
+
+    throughput.Add(fileSize, timer.GetElapsedTime());
+    state.SetIterationTime(timer.GetElapsedTime());
+    ::benchmark::DoNotOptimize(result);
+  }
+  std::remove(fileName.c_str());
+
+  throughput.ReportCounters(state, fileSize);
+  memory.ReportCounter(state);
+}
+
+void BenchVTKGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "Source", "Dim", "IsUnstructured", "Format" });
+
+  for (auto source : { DataSource::Wavelet, DataSource::Tangle })
+  {
+    for (auto dim : { 32, 64, 128 })
+    {
+      for (auto isUnstructured : { 0, 1 })
+      {
+        for (auto format :
+             { VTKFormat::LegacyASCII, VTKFormat::LegacyBinary, VTKFormat::XMLAppended })
+        {
+          bm->Args({ static_cast<int>(source), dim, isUnstructured, static_cast<int>(format) });
+        }
+      }
+    }
+  }
+}
+
+VISKORES_BENCHMARK_APPLY(BenchVTKWrite, BenchVTKGenerator);
+VISKORES_BENCHMARK_APPLY(BenchVTKRead, BenchVTKGenerator);
+
+/// Writes the scalars of a structured data set as a BOV brick: a raw binary file of
+/// values and a small text header that describes it.
+void WriteBOV(const viskores::cont::DataSet& dataSet,
+              const std::string& fieldName,
+              const std::string& headerFileName,
+              const std::string& dataFileName)
+{
+  viskores::cont::ArrayHandle<viskores::FloatDefault> values;
+  dataSet.GetPointField(fieldName).GetDataAsDefaultFloat().AsArrayHandle(values);
+  auto portal = values.ReadPortal();
+  {
+    std::ofstream data(dataFileName, std::ios::binary);
+    for (viskores::Id index = 0; index < portal.GetNumberOfValues(); ++index)
+    {
+      const viskores::FloatDefault value = portal.Get(index);
+      data.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+  }
+
+  viskores::cont::CellSetStructured<3> cellSet;
+  dataSet.GetCellSet().AsCellSet(cellSet);
+  const viskores::Id3 pointDims = cellSet.GetPointDimensions();
+  const viskores::Bounds bounds = dataSet.GetCoordinateSystem().GetBounds();
+
+  std::ofstream header(headerFileName);
+  header << "DATA_FILE: " << dataFileName << "\n";
+  header << "DATA_SIZE: " << pointDims[0] << " " << pointDims[1] << " " << pointDims[2] << "\n";
+  header << "DATA_FORMAT: " << ((sizeof(viskores::FloatDefault) == 4) ? "FLOAT" : "DOUBLE")
+         << "\n";
+  header << "VARIABLE: " << fieldName << "\n";
+  header << "DATA_ENDIAN: LITTLE\n";
+  header << "CENTERING: nodal\n";
+  header << "BRICK_ORIGIN: " << bounds.X.Min << " " << bounds.Y.Min << " " << bounds.Z.Min
+         << "\n";
+  header << "BRICK_SIZE: " << bounds.X.Length() << " " << bounds.Y.Length() << " "
+         << bounds.Z.Length() << "\n";
+}
+
+void BenchBOVRead(::benchmark::State& state)
+{
+  const viskores::cont::DeviceAdapterId device = Config.Device;
+
+  const DataSource source = static_cast<DataSource>(state.range(0));
+  const viskores::Id dim = static_cast<viskores::Id>(state.range(1));
+
+  const std::string headerFileName = MakeFileName("BOVRead", ".bov");
+  const std::string dataFileName = MakeFileName("BOVRead", ".values");
+  WriteBOV(MakeDataSet(source, dim, false), GetScalarsName(source), headerFileName, dataFileName);
+  const viskores::Id fileSize = GetFileSize(dataFileName);
+
+  viskores::cont::Timer timer{ device };
+  PeakMemoryTracker memory;
+  ThroughputCounter throughput;
+  for (auto _ : state)
+  {
+    (void)_;
+    memory.Start();
+    timer.Start();
+    viskores::io::BOVDataSetReader reader(headerFileName);
+    viskores::cont::DataSet result = reader.ReadDataSet();
+    timer.Stop();
+    memory.Stop();
+
+    throughput.Add(fileSize, timer.GetElapsedTime());
+    state.SetIterationTime(timer.GetElapsedTime());
+    ::benchmark::DoNotOptimize(result);
+  }
+  std::remove(headerFileName.c_str());
+  std::remove(dataFileName.c_str());
+
+  throughput.ReportCounters(state, fileSize);
+  memory.ReportCounter(state);
+}
+
+void BenchBOVReadGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "Source", "Dim" });
+
+  for (auto source : { DataSource::Wavelet, DataSource::Tangle })
+  {
+    for (auto dim : { 32, 64, 128, 256 })
+    {
+      bm->Args({ static_cast<int>(source), dim });
+    }
+  }
+}
+
+VISKORES_BENCHMARK_APPLY(BenchBOVRead, BenchBOVReadGenerator);
+
+viskores::cont::DataSet MakeImageDataSet(viskores::Id imageSize)
+{
+  viskores::cont::DataSet dataSet =
+    viskores::cont::DataSetBuilderUniform::Create(viskores::Id2(imageSize, imageSize));
+
+  // A smooth gradient with some high frequency detail, so the PNG compressor does not
+  // get an unrealistically easy image.
+  viskores::cont::ArrayHandle<viskores::Vec4f_32> colors;
+  colors.Allocate(imageSize * imageSize);
+  auto portal = colors.WritePortal();
+  for (viskores::Id y = 0; y < imageSize; ++y)
+  {
+    for (viskores::Id x = 0; x < imageSize; ++x)
+    {
+      const viskores::Float32 u = static_cast<viskores::Float32>(x) / imageSize;
+      const viskores::Float32 v = static_cast<viskores::Float32>(y) / imageSize;
+      const viskores::Float32 noise =
+        static_cast<viskores::Float32>(((x * 73856093) ^ (y * 19349663)) % 256) / 255.0f;
+      portal.Set(y * imageSize + x, viskores::Vec4f_32(u, v, 0.75f * noise, 1.0f));
+    }
+  }
+  dataSet.AddPointField("color", colors);
+  return dataSet;
+}
+
+std::unique_ptr<viskores::io::ImageWriterBase> MakeImageWriter(ImageFormat format,
+                                                               const std::string& fileName)
+{
+  switch (format)
+  {
+    case ImageFormat::PNG:
+      return std::unique_ptr<viskores::io::ImageWriterBase>(
+        new viskores::io::ImageWriterPNG(fileName));
+    case ImageFormat::PNM:
+      return std::unique_ptr<viskores::io::ImageWriterBase>(
+        new viskores::io::ImageWriterPNM(fileName));
+#ifdef VISKORES_BENCHMARK_HDF5_IO
+    case ImageFormat::HDF5:
+      return std::unique_ptr<viskores::io::ImageWriterBase>(
+        new viskores::io::ImageWriterHDF5(fileName));
+#endif
+    default:
+      throw viskores::cont::ErrorBadValue("Unsupported image format.");
+  }
+}
+
+std::string GetImageExtension(ImageFormat format)
+{
+  switch (format)
+  {
+    case ImageFormat::PNG:
+      return ".png";
+    case ImageFormat::PNM:
+      return ".pnm";
+    case ImageFormat::HDF5:
+    default:
+      return ".h5";
+  }
+}
+
+void BenchImageWrite(::benchmark::State& state)
+{
+  const viskores::cont::DeviceAdapterId device = Config.Device;
+
+  const ImageFormat format = static_cast<ImageFormat>(state.range(0));
+  const viskores::Id imageSize = static_cast<viskores::Id>(state.range(1));
+
+  const viskores::cont::DataSet dataSet = MakeImageDataSet(imageSize);
+  const std::string fileName = MakeFileName("ImageWrite", GetImageExtension(format));
+  // Compressed image sizes say little about the encoder speed, so the throughput is
+  // measured on the 8-bit RGBA pixels that are encoded.
+  const viskores::Id pixelBytes = imageSize * imageSize * 4;
+  std::unique_ptr<viskores::io::ImageWriterBase> writer = MakeImageWriter(format, fileName);
+
+  viskores::cont::Timer timer{ device };
+  PeakMemoryTracker memory;
+  ThroughputCounter throughput;
+  viskores::Id fileSize = 0;
+  for (auto _ : state)
+  {
+    (void)_;
+    memory.Start();
+    timer.Start();
+    writer->WriteDataSet(dataSet, "color");
+    timer.Stop();
+    memory.Stop();
+
+    fileSize = GetFileSize(fileName);
+    throughput.Add(pixelBytes, timer.GetElapsedTime());
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  std::remove(fileName.c_str());
+
+  throughput.ReportCounters(state, fileSize);
+  memory.ReportCounter(state);
+}
+
+void BenchImageWriteGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "Format", "ImageSize" });
+
+  std::vector<ImageFormat> formats{ ImageFormat::PNG, ImageFormat::PNM };
+#ifdef VISKORES_BENCHMARK_HDF5_IO
+  formats.push_back(ImageFormat::HDF5);
+#endif
+  for (auto format : formats)
+  {
+    for (auto imageSize : { 256, 1024, 2048 })
+    {
+      bm->Args({ static_cast<int>(format), imageSize });
+    }
+  }
+}
+
+VISKORES_BENCHMARK_APPLY(BenchImageWrite, BenchImageWriteGenerator);
+
+} // end anon namespace
+
+int main(int argc, char* argv[])
+{
+  auto opts = viskores::cont::InitializeOptions::DefaultAnyDevice;
+  std::vector<char*> args(argv, argv + argc);
+  viskores::bench::detail::InitializeArgs(&argc, args, opts);
+  Config = viskores::cont::Initialize(argc, args.data(), opts);
+  if (opts != viskores::cont::InitializeOptions::None)
+  {
+    viskores::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+  VISKORES_EXECUTE_BENCHMARKS(argc, args.data());
+}
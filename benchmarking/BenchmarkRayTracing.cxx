@@ -44,6 +44,8 @@ viskores::cont::InitializeResult Config;
 
 void BenchRayTracing(::benchmark::State& state)
 {
+  const bool usePackets = static_cast<bool>(state.range(0));
+
   viskores::source::Tangle maker;
   maker.SetPointDimensions({ 128, 128, 128 });
   viskores::cont::DataSet dataset = maker.Execute();
@@ -63,6 +65,7 @@ void BenchRayTracing(::benchmark::State& state)
 
   viskores::rendering::raytracing::RayTracer tracer;
   triIntersector->SetData(coords, triExtractor.GetTriangles());
+  triIntersector->SetUsePacketTraversal(usePackets);
   tracer.AddShapeIntersector(triIntersector);
 
   viskores::rendering::CanvasRayTracer canvas(1920, 1080);
@@ -113,7 +116,7 @@ void BenchRayTracing(::benchmark::State& state)
   }
 }
 
-VISKORES_BENCHMARK(BenchRayTracing);
+VISKORES_BENCHMARK_OPTS(BenchRayTracing, ->ArgName("Packets")->DenseRange(0, 1));
 
 } // end namespace viskores::benchmarking
 
@@ -57,6 +57,7 @@ using SplitPermutationArrayHandle =
   viskores::cont::ArrayHandlePermutation<IdArrayHandle, SplitArrayHandle>;
 using SplitPropertiesArrayHandle =
   viskores::cont::ArrayHandle<viskores::worklet::spatialstructure::SplitProperties>;
+using BoundsArrayHandle = viskores::cont::ArrayHandle<viskores::Bounds>;
 
 namespace
 {
@@ -240,9 +241,276 @@ IdArrayHandle CalculateSplitScatterIndices(const IdArrayHandle& cellIds,
   return scatterIndices;
 }
 
+void SelectPlaneSplits(viskores::IdComponent numPlanes,
+                       viskores::IdComponent maxLeafSize,
+                       viskores::Id numSegments,
+                       const IdArrayHandle& segmentSizes,
+                       IdArrayHandle& segmentIds,
+                       RangeArrayHandle& xRanges,
+                       RangeArrayHandle& yRanges,
+                       RangeArrayHandle& zRanges,
+                       CoordsArrayHandle& centerXs,
+                       CoordsArrayHandle& centerYs,
+                       CoordsArrayHandle& centerZs,
+                       SplitArrayHandle& segmentSplits,
+                       IdArrayHandle& splitChoices,
+                       IdArrayHandle& leqFlags)
+{
+  viskores::cont::Invoker invoker;
+  IdArrayHandle discardKeys;
+
+  //START_TIMER(s21);
+  // Calculate the X, Y, Z bounding ranges for each segment
+  RangeArrayHandle perSegmentXRanges, perSegmentYRanges, perSegmentZRanges;
+  viskores::cont::Algorithm::ReduceByKey(
+    segmentIds, xRanges, discardKeys, perSegmentXRanges, viskores::Add());
+  viskores::cont::Algorithm::ReduceByKey(
+    segmentIds, yRanges, discardKeys, perSegmentYRanges, viskores::Add());
+  viskores::cont::Algorithm::ReduceByKey(
+    segmentIds, zRanges, discardKeys, perSegmentZRanges, viskores::Add());
+  //PRINT_TIMER("2.1", s21);
+
+  // Expand the per segment bounding ranges, to per cell;
+  RangePermutationArrayHandle segmentXRanges(segmentIds, perSegmentXRanges);
+  RangePermutationArrayHandle segmentYRanges(segmentIds, perSegmentYRanges);
+  RangePermutationArrayHandle segmentZRanges(segmentIds, perSegmentZRanges);
+
+  //START_TIMER(s22);
+  // Calculate split costs for NumPlanes split planes, across X, Y and Z dimensions
+  viskores::Id numSplitPlanes = numSegments * (numPlanes + 1);
+  viskores::cont::ArrayHandle<viskores::worklet::spatialstructure::SplitProperties> xSplits,
+    ySplits, zSplits;
+  xSplits.Allocate(numSplitPlanes);
+  ySplits.Allocate(numSplitPlanes);
+  zSplits.Allocate(numSplitPlanes);
+  CalculateSplitCosts(numPlanes, segmentXRanges, xRanges, centerXs, segmentIds, xSplits);
+  CalculateSplitCosts(numPlanes, segmentYRanges, yRanges, centerYs, segmentIds, ySplits);
+  CalculateSplitCosts(numPlanes, segmentZRanges, zRanges, centerZs, segmentIds, zSplits);
+  //PRINT_TIMER("2.2", s22);
+
+  segmentXRanges.ReleaseResourcesExecution();
+  segmentYRanges.ReleaseResourcesExecution();
+  segmentZRanges.ReleaseResourcesExecution();
+
+  //START_TIMER(s23);
+  // Select best split plane and dimension across X, Y, Z dimension, per segment
+  viskores::cont::ArrayHandle<viskores::FloatDefault> segmentPlanes;
+  CountingIdArrayHandle indices(0, 1, numSegments);
+
+  viskores::worklet::spatialstructure::SplitSelector worklet(
+    numPlanes, maxLeafSize, numPlanes + 1);
+  invoker(worklet,
+          indices,
+          xSplits,
+          ySplits,
+          zSplits,
+          segmentSizes,
+          segmentSplits,
+          segmentPlanes,
+          splitChoices);
+  //PRINT_TIMER("2.3", s23);
+
+  // Expand the per segment split plane to per cell
+  SplitPermutationArrayHandle splits(segmentIds, segmentSplits);
+  CoordsPermutationArrayHandle planes(segmentIds, segmentPlanes);
+
+  //START_TIMER(s31);
+  invoker(viskores::worklet::spatialstructure::CalculateSplitDirectionFlag{},
+          centerXs,
+          centerYs,
+          centerZs,
+          splits,
+          planes,
+          leqFlags);
+  //PRINT_TIMER("3.1", s31);
+}
+
+// Chooses the splits with the surface area heuristic. The centers of the cells of each
+// segment are binned along the longest dimension of their bounds, and the segment is split at
+// the bin boundary with the lowest cost. Cells stay in their order within each child.
+void SelectBinnedSAHSplits(viskores::IdComponent maxLeafSize,
+                           viskores::Id numSegments,
+                           const IdArrayHandle& segmentSizes,
+                           const IdArrayHandle& segmentIds,
+                           const RangeArrayHandle& xRanges,
+                           const RangeArrayHandle& yRanges,
+                           const RangeArrayHandle& zRanges,
+                           const CoordsArrayHandle& centerXs,
+                           const CoordsArrayHandle& centerYs,
+                           const CoordsArrayHandle& centerZs,
+                           SplitArrayHandle& segmentSplits,
+                           IdArrayHandle& splitChoices,
+                           IdArrayHandle& leqFlags)
+{
+  using viskores::worklet::spatialstructure::SAHNumberOfBins;
+  viskores::cont::Invoker invoker;
+  IdArrayHandle discardKeys;
+
+  BoundsArrayHandle segmentCentroidBounds;
+  {
+    BoundsArrayHandle centroidBounds;
+    invoker(viskores::worklet::spatialstructure::CentroidBounds{},
+            centerXs,
+            centerYs,
+            centerZs,
+            centroidBounds);
+    viskores::cont::Algorithm::ReduceByKey(
+      segmentIds, centroidBounds, discardKeys, segmentCentroidBounds, viskores::Add());
+  }
+
+  IdArrayHandle binKeys;
+  BoundsArrayHandle cellBounds;
+  invoker(viskores::worklet::spatialstructure::SAHBinCalculator{},
+          centerXs,
+          centerYs,
+          centerZs,
+          xRanges,
+          yRanges,
+          zRanges,
+          segmentIds,
+          viskores::cont::make_ArrayHandlePermutation(segmentIds, segmentCentroidBounds),
+          binKeys,
+          cellBounds);
+
+  // Count the cells and accumulate their bounds in every bin of every segment.
+  IdArrayHandle binCounts;
+  BoundsArrayHandle binBounds;
+  binCounts.AllocateAndFill(numSegments * SAHNumberOfBins, 0);
+  binBounds.AllocateAndFill(numSegments * SAHNumberOfBins, viskores::Bounds{});
+  {
+    IdArrayHandle sortedBinKeys;
+    viskores::cont::Algorithm::Copy(binKeys, sortedBinKeys);
+    viskores::cont::Algorithm::SortByKey(sortedBinKeys, cellBounds);
+
+    IdArrayHandle occupiedBins;
+    IdArrayHandle occupiedBinCounts;
+    BoundsArrayHandle occupiedBinBounds;
+    viskores::cont::Algorithm::ReduceByKey(
+      sortedBinKeys,
+      viskores::cont::ArrayHandleConstant<viskores::Id>(1, sortedBinKeys.GetNumberOfValues()),
+      occupiedBins,
+      occupiedBinCounts,
+      viskores::Add());
+    viskores::cont::Algorithm::ReduceByKey(
+      sortedBinKeys, cellBounds, occupiedBins, occupiedBinBounds, viskores::Add());
+    invoker(viskores::worklet::spatialstructure::Scatter{},
+            occupiedBinCounts,
+            occupiedBins,
+            binCounts);
+    invoker(viskores::worklet::spatialstructure::Scatter{},
+            occupiedBinBounds,
+            occupiedBins,
+            binBounds);
+  }
+
+  IdArrayHandle splitBins;
+  invoker(viskores::worklet::spatialstructure::SAHSplitSelector{ maxLeafSize },
+          CountingIdArrayHandle(0, 1, numSegments),
+          segmentSizes,
+          segmentCentroidBounds,
+          binCounts,
+          binBounds,
+          segmentSplits,
+          splitBins,
+          splitChoices);
+
+  IdArrayHandle segmentStarts;
+  viskores::cont::Algorithm::ScanExclusive(segmentSizes, segmentStarts);
+  invoker(viskores::worklet::spatialstructure::SAHSplitDirectionFlag{},
+          binKeys,
+          IdPermutationArrayHandle(segmentIds, segmentStarts),
+          IdPermutationArrayHandle(segmentIds, segmentSizes),
+          IdPermutationArrayHandle(segmentIds, splitBins),
+          leqFlags);
+}
+
+template <typename ArrayHandleType>
+void GatherArray(ArrayHandleType& array, const IdArrayHandle& indices)
+{
+  ArrayHandleType gathered;
+  viskores::cont::Algorithm::Copy(viskores::cont::make_ArrayHandlePermutation(indices, array),
+                                  gathered);
+  array = gathered;
+}
+
+// Orders the cells along a Morton curve of their centers, so that the cells of every
+// subtree are close in memory.
+void SortAlongMortonCurve(IdArrayHandle& cellIds,
+                          RangeArrayHandle& xRanges,
+                          RangeArrayHandle& yRanges,
+                          RangeArrayHandle& zRanges,
+                          CoordsArrayHandle& centerXs,
+                          CoordsArrayHandle& centerYs,
+                          CoordsArrayHandle& centerZs)
+{
+  viskores::cont::Invoker invoker;
+
+  BoundsArrayHandle centroidBounds;
+  invoker(viskores::worklet::spatialstructure::CentroidBounds{},
+          centerXs,
+          centerYs,
+          centerZs,
+          centroidBounds);
+  viskores::Bounds bounds =
+    viskores::cont::Algorithm::Reduce(centroidBounds, viskores::Bounds{}, viskores::Add());
+
+  viskores::cont::ArrayHandle<viskores::UInt32> mortonCodes;
+  invoker(viskores::worklet::spatialstructure::MortonCodeCalculator{ bounds },
+          centerXs,
+          centerYs,
+          centerZs,
+          mortonCodes);
+  IdArrayHandle order;
+  viskores::cont::Algorithm::Copy(CountingIdArrayHandle(0, 1, cellIds.GetNumberOfValues()),
+                                  order);
+  viskores::cont::Algorithm::SortByKey(mortonCodes, order);
+
+  GatherArray(cellIds, order);
+  GatherArray(xRanges, order);
+  GatherArray(yRanges, order);
+  GatherArray(zRanges, order);
+  GatherArray(centerXs, order);
+  GatherArray(centerYs, order);
+  GatherArray(centerZs, order);
+}
+
 } // anonymous namespace
 
 
+CellLocatorBoundingIntervalHierarchy::GeometryFingerprint
+CellLocatorBoundingIntervalHierarchy::ComputeFingerprint() const
+{
+  viskores::cont::UnknownCellSet cellSet = this->GetCellSet();
+  viskores::cont::CoordinateSystem coords = this->GetCoordinates();
+
+  GeometryFingerprint fingerprint;
+  fingerprint.NumberOfCells = cellSet.GetNumberOfCells();
+  fingerprint.NumberOfPoints = coords.GetNumberOfPoints();
+  fingerprint.Bounds = coords.GetBounds();
+
+  viskores::cont::ArrayHandle<viskores::UInt64> cellHashes;
+  viskores::cont::Invoker invoker;
+  invoker(viskores::worklet::spatialstructure::CellFingerprint{},
+          cellSet,
+          coords.GetDataAsMultiplexer(),
+          cellHashes);
+  // Integer sums do not depend on the order of the reduction, so the hash is the same on
+  // every device.
+  fingerprint.CellsHash = viskores::cont::Algorithm::Reduce(cellHashes, viskores::UInt64{ 0 });
+  return fingerprint;
+}
+
+const CellLocatorBoundingIntervalHierarchy::GeometryFingerprint&
+CellLocatorBoundingIntervalHierarchy::GetFingerprint() const
+{
+  if (!this->FingerprintValid)
+  {
+    this->Fingerprint = this->ComputeFingerprint();
+    this->FingerprintValid = true;
+  }
+  return this->Fingerprint;
+}
+
 void CellLocatorBoundingIntervalHierarchy::Build()
 {
   VISKORES_LOG_SCOPE(viskores::cont::LogLevel::Perf, "CellLocatorBoundingIntervalHierarchy::Build");
@@ -254,6 +522,28 @@ void CellLocatorBoundingIntervalHierarchy::Build()
   viskores::cont::CoordinateSystem coords = this->GetCoordinates();
   auto points = coords.GetDataAsMultiplexer();
 
+  if (this->TreeLoaded)
+  {
+    // Compare the fingerprint loaded with the hierarchy against the current geometry.
+    this->TreeLoaded = false;
+    const GeometryFingerprint loaded = this->Fingerprint;
+    this->FingerprintValid = false;
+    if (loaded == this->GetFingerprint())
+    {
+      return;
+    }
+    VISKORES_LOG_S(viskores::cont::LogLevel::Info,
+                   "Loaded bounding interval hierarchy was built for different geometry. "
+                   "Rebuilding it.");
+  }
+  else
+  {
+    this->FingerprintValid = false;
+  }
+  this->Nodes =
+    viskores::cont::ArrayHandle<viskores::exec::CellLocatorBoundingIntervalHierarchyNode>{};
+  this->ProcessedCellIds = IdArrayHandle{};
+
   //std::cout << "No of cells: " << numCells << "\n";
   //std::cout.precision(3);
   //START_TIMER(s11);
@@ -278,11 +568,15 @@ void CellLocatorBoundingIntervalHierarchy::Build()
           centerZs);
   //PRINT_TIMER("1.2", s12);
 
+  if (this->Method == BuildMethod::BinnedSAH)
+  {
+    SortAlongMortonCurve(cellIds, xRanges, yRanges, zRanges, centerXs, centerYs, centerZs);
+  }
+
   bool done = false;
   //viskores::IdComponent iteration = 0;
   viskores::Id nodesIndexOffset = 0;
   viskores::Id numSegments = 1;
-  IdArrayHandle discardKeys;
   IdArrayHandle segmentSizes;
   segmentSizes.Allocate(1);
   segmentSizes.WritePortal().Set(0, numCells);
@@ -297,73 +591,42 @@ void CellLocatorBoundingIntervalHierarchy::Build()
   {
     //std::cout << "**** Iteration " << (++iteration) << " ****\n";
     //Output(segmentSizes);
-    //START_TIMER(s21);
-    // Calculate the X, Y, Z bounding ranges for each segment
-    RangeArrayHandle perSegmentXRanges, perSegmentYRanges, perSegmentZRanges;
-    viskores::cont::Algorithm::ReduceByKey(
-      segmentIds, xRanges, discardKeys, perSegmentXRanges, viskores::Add());
-    viskores::cont::Algorithm::ReduceByKey(
-      segmentIds, yRanges, discardKeys, perSegmentYRanges, viskores::Add());
-    viskores::cont::Algorithm::ReduceByKey(
-      segmentIds, zRanges, discardKeys, perSegmentZRanges, viskores::Add());
-    //PRINT_TIMER("2.1", s21);
-
-    // Expand the per segment bounding ranges, to per cell;
-    RangePermutationArrayHandle segmentXRanges(segmentIds, perSegmentXRanges);
-    RangePermutationArrayHandle segmentYRanges(segmentIds, perSegmentYRanges);
-    RangePermutationArrayHandle segmentZRanges(segmentIds, perSegmentZRanges);
-
-    //START_TIMER(s22);
-    // Calculate split costs for NumPlanes split planes, across X, Y and Z dimensions
-    viskores::Id numSplitPlanes = numSegments * (this->NumPlanes + 1);
-    viskores::cont::ArrayHandle<viskores::worklet::spatialstructure::SplitProperties> xSplits,
-      ySplits, zSplits;
-    xSplits.Allocate(numSplitPlanes);
-    ySplits.Allocate(numSplitPlanes);
-    zSplits.Allocate(numSplitPlanes);
-    CalculateSplitCosts(this->NumPlanes, segmentXRanges, xRanges, centerXs, segmentIds, xSplits);
-    CalculateSplitCosts(this->NumPlanes, segmentYRanges, yRanges, centerYs, segmentIds, ySplits);
-    CalculateSplitCosts(this->NumPlanes, segmentZRanges, zRanges, centerZs, segmentIds, zSplits);
-    //PRINT_TIMER("2.2", s22);
-
-    segmentXRanges.ReleaseResourcesExecution();
-    segmentYRanges.ReleaseResourcesExecution();
-    segmentZRanges.ReleaseResourcesExecution();
-
-    //START_TIMER(s23);
-    // Select best split plane and dimension across X, Y, Z dimension, per segment
     SplitArrayHandle segmentSplits;
-    viskores::cont::ArrayHandle<viskores::FloatDefault> segmentPlanes;
     viskores::cont::ArrayHandle<viskores::Id> splitChoices;
-    CountingIdArrayHandle indices(0, 1, numSegments);
-
-    viskores::worklet::spatialstructure::SplitSelector worklet(
-      this->NumPlanes, this->MaxLeafSize, this->NumPlanes + 1);
-    invoker(worklet,
-            indices,
-            xSplits,
-            ySplits,
-            zSplits,
-            segmentSizes,
-            segmentSplits,
-            segmentPlanes,
-            splitChoices);
-    //PRINT_TIMER("2.3", s23);
-
-    // Expand the per segment split plane to per cell
-    SplitPermutationArrayHandle splits(segmentIds, segmentSplits);
-    CoordsPermutationArrayHandle planes(segmentIds, segmentPlanes);
-
-    //START_TIMER(s31);
     IdArrayHandle leqFlags;
-    invoker(viskores::worklet::spatialstructure::CalculateSplitDirectionFlag{},
-            centerXs,
-            centerYs,
-            centerZs,
-            splits,
-            planes,
-            leqFlags);
-    //PRINT_TIMER("3.1", s31);
+    if (this->Method == BuildMethod::BinnedSAH)
+    {
+      SelectBinnedSAHSplits(this->MaxLeafSize,
+                            numSegments,
+                            segmentSizes,
+                            segmentIds,
+                            xRanges,
+                            yRanges,
+                            zRanges,
+                            centerXs,
+                            centerYs,
+                            centerZs,
+                            segmentSplits,
+                            splitChoices,
+                            leqFlags);
+    }
+    else
+    {
+      SelectPlaneSplits(this->NumPlanes,
+                        this->MaxLeafSize,
+                        numSegments,
+                        segmentSizes,
+                        segmentIds,
+                        xRanges,
+                        yRanges,
+                        zRanges,
+                        centerXs,
+                        centerYs,
+                        centerZs,
+                        segmentSplits,
+                        splitChoices,
+                        leqFlags);
+    }
 
     //START_TIMER(s32);
     IdArrayHandle scatterIndices = CalculateSplitScatterIndices(cellIds, leqFlags, segmentIds);
@@ -496,3 +759,47 @@ CellLocatorBoundingIntervalHierarchy::PrepareForExecution(viskores::cont::Device
 
 } //namespace cont
 } //namespace viskores
+
+namespace mangled_diy_namespace
+{
+
+void Serialization<viskores::cont::CellLocatorBoundingIntervalHierarchy>::save(
+  BinaryBuffer& bb,
+  const viskores::cont::CellLocatorBoundingIntervalHierarchy& locator)
+{
+  // Make sure the hierarchy describes the current geometry before fingerprinting it.
+  locator.Update();
+  const auto& fingerprint = locator.GetFingerprint();
+  viskoresdiy::save(bb, locator.NumPlanes);
+  viskoresdiy::save(bb, locator.MaxLeafSize);
+  viskoresdiy::save(bb, static_cast<int>(locator.Method));
+  viskoresdiy::save(bb, locator.Nodes);
+  viskoresdiy::save(bb, locator.ProcessedCellIds);
+  viskoresdiy::save(bb, fingerprint.NumberOfCells);
+  viskoresdiy::save(bb, fingerprint.NumberOfPoints);
+  viskoresdiy::save(bb, fingerprint.Bounds);
+  viskoresdiy::save(bb, fingerprint.CellsHash);
+}
+
+void Serialization<viskores::cont::CellLocatorBoundingIntervalHierarchy>::load(
+  BinaryBuffer& bb,
+  viskores::cont::CellLocatorBoundingIntervalHierarchy& locator)
+{
+  viskoresdiy::load(bb, locator.NumPlanes);
+  viskoresdiy::load(bb, locator.MaxLeafSize);
+  int method = 0;
+  viskoresdiy::load(bb, method);
+  locator.Method =
+    static_cast<viskores::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod>(method);
+  viskoresdiy::load(bb, locator.Nodes);
+  viskoresdiy::load(bb, locator.ProcessedCellIds);
+  viskoresdiy::load(bb, locator.Fingerprint.NumberOfCells);
+  viskoresdiy::load(bb, locator.Fingerprint.NumberOfPoints);
+  viskoresdiy::load(bb, locator.Fingerprint.Bounds);
+  viskoresdiy::load(bb, locator.Fingerprint.CellsHash);
+  locator.FingerprintValid = false;
+  locator.TreeLoaded = true;
+  locator.SetModified();
+}
+
+} // namespace diy
@@ -26,6 +26,7 @@
 #include <viskores/cont/ArrayHandleTransform.h>
 
 #include <viskores/cont/CellLocatorBase.h>
+#include <viskores/cont/Serialization.h>
 
 #include <viskores/exec/CellLocatorBoundingIntervalHierarchy.h>
 #include <viskores/exec/CellLocatorMultiplexer.h>
@@ -63,6 +64,13 @@ VISKORES_DEPRECATED_SUPPRESS_END
 /// The algorithm then recurses into each region and repeats the process until the regions
 /// are divided to the point where the contain no more than a maximum number of cells
 /// (specified with `SetMaxLeafSize()`).
+///
+/// The hierarchy can be saved and loaded with `viskoresdiy::save()` and `viskoresdiy::load()`.
+/// The hierarchy is saved along with a fingerprint of the geometry it was built for: the
+/// numbers of cells and points, the bounds of the coordinates, and a hash of the shape,
+/// points, and coordinates of every cell. A loaded hierarchy is used as is only for geometry
+/// with the same fingerprint, so the hierarchy of a mesh whose geometry does not change needs
+/// to be built only once. For any other geometry, the hierarchy is built again.
 class VISKORES_CONT_EXPORT CellLocatorBoundingIntervalHierarchy
   : public viskores::cont::CellLocatorBase
 {
@@ -77,6 +85,18 @@ public:
     viskores::ListApply<CellLocatorExecList, viskores::exec::CellLocatorMultiplexer>;
   using LastCell = typename ExecObjType::LastCell;
 
+  /// @brief The algorithm used to build the hierarchy.
+  enum struct BuildMethod
+  {
+    /// Each region is divided by the best of a number of evenly spaced splitting planes
+    /// in each dimension (set with `SetNumberOfSplittingPlanes()`).
+    SplittingPlanes,
+    /// Cells are first sorted along a Morton curve of their centers. Each region is then
+    /// divided along its longest dimension by binning the cell centers and choosing the
+    /// bin boundary with the lowest surface area heuristic cost.
+    BinnedSAH
+  };
+
   /// Construct a `CellLocatorBoundingIntervalHierarchy` while optionally specifying the
   /// number of splitting planes and number of cells in each leaf.
   VISKORES_CONT
@@ -99,6 +119,7 @@ public:
   VISKORES_CONT void SetNumberOfSplittingPlanes(viskores::IdComponent numPlanes)
   {
     this->NumPlanes = numPlanes;
+    this->TreeLoaded = false;
     this->SetModified();
   }
   /// @copydoc SetNumberOfSplittingPlanes
@@ -115,26 +136,84 @@ public:
   VISKORES_CONT void SetMaxLeafSize(viskores::IdComponent maxLeafSize)
   {
     this->MaxLeafSize = maxLeafSize;
+    this->TreeLoaded = false;
     this->SetModified();
   }
   /// @copydoc SetMaxLeafSize
   VISKORES_CONT viskores::Id GetMaxLeafSize() { return this->MaxLeafSize; }
 
+  /// @brief Specify the algorithm used to build the hierarchy.
+  ///
+  /// The default is `BuildMethod::SplittingPlanes`.
+  VISKORES_CONT void SetBuildMethod(BuildMethod method)
+  {
+    this->Method = method;
+    this->TreeLoaded = false;
+    this->SetModified();
+  }
+  /// @copydoc SetBuildMethod
+  VISKORES_CONT BuildMethod GetBuildMethod() const { return this->Method; }
+
   VISKORES_CONT ExecObjType PrepareForExecution(viskores::cont::DeviceAdapterId device,
                                                 viskores::cont::Token& token) const;
 
 private:
   viskores::IdComponent NumPlanes;
   viskores::IdComponent MaxLeafSize;
+  BuildMethod Method = BuildMethod::SplittingPlanes;
   viskores::cont::ArrayHandle<viskores::exec::CellLocatorBoundingIntervalHierarchyNode> Nodes;
   viskores::cont::ArrayHandle<viskores::Id> ProcessedCellIds;
+  bool TreeLoaded = false;
 
+  // Identifies the geometry the hierarchy was built for.
+  struct GeometryFingerprint
+  {
+    viskores::Id NumberOfCells = -1;
+    viskores::Id NumberOfPoints = -1;
+    viskores::Bounds Bounds;
+    viskores::UInt64 CellsHash = 0;
+
+    VISKORES_CONT bool operator==(const GeometryFingerprint& other) const
+    {
+      return (this->NumberOfCells == other.NumberOfCells) &&
+        (this->NumberOfPoints == other.NumberOfPoints) && (this->Bounds == other.Bounds) &&
+        (this->CellsHash == other.CellsHash);
+    }
+  };
+  // Hashing every cell is a full pass over the mesh, so the fingerprint is only computed to check
+  // a loaded hierarchy or to save one, and then kept until the hierarchy is rebuilt.
+  mutable GeometryFingerprint Fingerprint;
+  mutable bool FingerprintValid = false;
+
+  VISKORES_CONT GeometryFingerprint ComputeFingerprint() const;
+  VISKORES_CONT const GeometryFingerprint& GetFingerprint() const;
   VISKORES_CONT void Build() override;
 
   struct MakeExecObject;
+
+  friend struct mangled_diy_namespace::Serialization<
+    viskores::cont::CellLocatorBoundingIntervalHierarchy>;
 };
 
 } // namespace cont
 } // namespace viskores
 
+/// @cond SERIALIZATION
+
+namespace mangled_diy_namespace
+{
+
+template <>
+struct VISKORES_CONT_EXPORT Serialization<viskores::cont::CellLocatorBoundingIntervalHierarchy>
+{
+  static VISKORES_CONT void save(
+    BinaryBuffer& bb,
+    const viskores::cont::CellLocatorBoundingIntervalHierarchy& locator);
+  static VISKORES_CONT void load(BinaryBuffer& bb,
+                                 viskores::cont::CellLocatorBoundingIntervalHierarchy& locator);
+};
+
+} // diy
+/// @endcond SERIALIZATION
+
 #endif // viskores_cont_CellLocatorBoundingIntervalHierarchy_h
@@ -20,6 +20,7 @@
 
 #include <viskores/cont/Logging.h>
 #include <viskores/cont/RuntimeDeviceTracker.h>
+#include <viskores/cont/Tracing.h>
 #include <viskores/cont/internal/OptionParser.h>
 #include <viskores/cont/internal/OptionParserArguments.h>
 
@@ -198,6 +199,14 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
                       loggingFlagName.c_str(),
                       opt::ViskoresArg::Required,
                       loggingHelp.c_str() });
+    usage.push_back({ opt::OptionIndex::TRACE_FILE,
+                      0,
+                      "",
+                      "viskores-trace-file",
+                      opt::ViskoresArg::Required,
+                      "  --viskores-trace-file <file> \tRecord a timeline of filters, worklets, "
+                      "and memory transfers and write it to a Chrome trace JSON file at exit. "
+                      "Can also be set with the VISKORES_TRACE_FILE environment variable." });
 
     // Bring in extra args used by the runtime device configuration options
     viskores::cont::internal::RuntimeDeviceConfigurationOptions runtimeDeviceOptions(usage);
@@ -247,6 +256,16 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
       exit(0);
     }
 
+    // Check for a trace file on the command line or in the environment.
+    if (options[opt::OptionIndex::TRACE_FILE])
+    {
+      viskores::cont::TraceToFileAtExit(options[opt::OptionIndex::TRACE_FILE].arg);
+    }
+    else if (const char* traceEnv = std::getenv("VISKORES_TRACE_FILE"))
+    {
+      viskores::cont::TraceToFileAtExit(traceEnv);
+    }
+
     // Check for device on command line.
     if (options[opt::OptionIndex::DEVICE])
     {
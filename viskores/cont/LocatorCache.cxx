@@ -0,0 +1,191 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/LocatorCache.h>
+
+#include <viskores/cont/CellSetExplicit.h>
+#include <viskores/cont/CellSetSingleType.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace viskores
+{
+namespace cont
+{
+
+namespace
+{
+
+template <typename CellSetType>
+void AddConnectivityBuffers(const viskores::cont::UnknownCellSet& cellSet,
+                            std::vector<viskores::cont::internal::Buffer>& buffers)
+{
+  if (!cellSet.IsType<CellSetType>())
+  {
+    return;
+  }
+  // Other cell sets hold no arrays or are identified by the cell set object alone.
+  CellSetType explicitCells = cellSet.AsCellSet<CellSetType>();
+  for (const auto& array :
+       { explicitCells
+           .GetShapesArray(viskores::TopologyElementTagCell{}, viskores::TopologyElementTagPoint{})
+           .GetBuffers(),
+         explicitCells
+           .GetConnectivityArray(viskores::TopologyElementTagCell{},
+                                 viskores::TopologyElementTagPoint{})
+           .GetBuffers(),
+         explicitCells
+           .GetOffsetsArray(viskores::TopologyElementTagCell{}, viskores::TopologyElementTagPoint{})
+           .GetBuffers() })
+  {
+    buffers.insert(buffers.end(), array.begin(), array.end());
+  }
+}
+
+} // anonymous namespace
+
+namespace detail
+{
+
+LocatorCacheKey::LocatorCacheKey(const viskores::cont::UnknownCellSet& cellSet,
+                                 const viskores::cont::CoordinateSystem& coords)
+  : LocatorCacheKey(cellSet, coords.GetData())
+{
+}
+
+LocatorCacheKey::LocatorCacheKey(const viskores::cont::UnknownCellSet& cellSet,
+                                 const viskores::cont::UnknownArrayHandle& array)
+  : CellSet(cellSet.IsValid() ? cellSet.GetCellSetBase() : nullptr)
+  , NumberOfCells(cellSet.GetNumberOfCells())
+  , NumberOfPoints(cellSet.GetNumberOfPoints())
+  , Buffers(array.GetBuffers())
+{
+  AddConnectivityBuffers<viskores::cont::CellSetExplicit<>>(cellSet, this->Buffers);
+  AddConnectivityBuffers<viskores::cont::CellSetSingleType<>>(cellSet, this->Buffers);
+
+  this->ModifiedCounts.reserve(this->Buffers.size());
+  for (const auto& buffer : this->Buffers)
+  {
+    this->ModifiedCounts.push_back(buffer.GetModifiedCount());
+  }
+}
+
+bool LocatorCacheKey::operator==(const LocatorCacheKey& other) const
+{
+  return (this->CellSet == other.CellSet) && (this->NumberOfCells == other.NumberOfCells) &&
+    (this->NumberOfPoints == other.NumberOfPoints) && (this->Buffers == other.Buffers) &&
+    (this->ModifiedCounts == other.ModifiedCounts);
+}
+
+} // namespace detail
+
+struct LocatorCache::InternalsType
+{
+  struct Entry
+  {
+    std::type_index Type;
+    detail::LocatorCacheKey Key;
+    std::shared_ptr<void> Locator;
+  };
+
+  std::mutex Mutex;
+  std::size_t Capacity;
+  // Ordered from the least to the most recently used.
+  std::vector<Entry> Entries;
+  viskores::Id NumberOfBuilds = 0;
+};
+
+LocatorCache::LocatorCache(std::size_t capacity)
+  : Internals(std::make_shared<InternalsType>())
+{
+  this->Internals->Capacity = std::max(capacity, std::size_t{ 1 });
+}
+
+void LocatorCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Entries.clear();
+}
+
+void LocatorCache::SetCapacity(std::size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  auto& entries = this->Internals->Entries;
+  this->Internals->Capacity = std::max(capacity, std::size_t{ 1 });
+  if (entries.size() > this->Internals->Capacity)
+  {
+    entries.erase(entries.begin(),
+                  entries.begin() +
+                    static_cast<std::ptrdiff_t>(entries.size() - this->Internals->Capacity));
+  }
+}
+
+std::size_t LocatorCache::GetCapacity() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->Capacity;
+}
+
+std::size_t LocatorCache::GetNumberOfLocators() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->Entries.size();
+}
+
+viskores::Id LocatorCache::GetNumberOfBuilds() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfBuilds;
+}
+
+std::shared_ptr<void> LocatorCache::Find(const std::type_index& type,
+                                         const detail::LocatorCacheKey& key) const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  auto& entries = this->Internals->Entries;
+  auto entry = std::find_if(entries.begin(),
+                            entries.end(),
+                            [&](const InternalsType::Entry& candidate)
+                            { return (candidate.Type == type) && (candidate.Key == key); });
+  if (entry == entries.end())
+  {
+    return nullptr;
+  }
+  std::rotate(entry, entry + 1, entries.end());
+  return entries.back().Locator;
+}
+
+void LocatorCache::Insert(const std::type_index& type,
+                          detail::LocatorCacheKey&& key,
+                          const std::shared_ptr<void>& locator)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  auto& entries = this->Internals->Entries;
+  ++this->Internals->NumberOfBuilds;
+
+  // A locator for the same arrays, built before they were modified, is stale.
+  entries.erase(std::remove_if(entries.begin(),
+                               entries.end(),
+                               [&](const InternalsType::Entry& entry)
+                               {
+                                 return (entry.Type == type) &&
+                                   (entry.Key.CellSet == key.CellSet) &&
+                                   (entry.Key.Buffers == key.Buffers);
+                               }),
+                entries.end());
+
+  if (entries.size() >= this->Internals->Capacity)
+  {
+    entries.erase(entries.begin());
+  }
+  entries.push_back(InternalsType::Entry{ type, std::move(key), locator });
+}
+
+}
+} // namespace viskores::cont
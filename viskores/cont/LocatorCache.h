@@ -0,0 +1,146 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_cont_LocatorCache_h
+#define viskores_cont_LocatorCache_h
+
+#include <viskores/cont/viskores_cont_export.h>
+
+#include <viskores/cont/CoordinateSystem.h>
+#include <viskores/cont/UnknownCellSet.h>
+#include <viskores/cont/internal/Buffer.h>
+
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+namespace viskores
+{
+namespace cont
+{
+
+namespace detail
+{
+
+/// Identifies the geometry a locator was built for: the cell set object and the
+/// buffers of the coordinates and connectivity, along with how many times each
+/// buffer had been written. Other objects derived from a cell set and a point array,
+/// such as a field, can be identified the same way.
+struct VISKORES_CONT_EXPORT LocatorCacheKey
+{
+  VISKORES_CONT LocatorCacheKey(const viskores::cont::UnknownCellSet& cellSet,
+                                const viskores::cont::CoordinateSystem& coords);
+  VISKORES_CONT LocatorCacheKey(const viskores::cont::UnknownCellSet& cellSet,
+                                const viskores::cont::UnknownArrayHandle& array);
+
+  VISKORES_CONT bool operator==(const LocatorCacheKey& other) const;
+
+  const viskores::cont::CellSet* CellSet;
+  viskores::Id NumberOfCells;
+  viskores::Id NumberOfPoints;
+  std::vector<viskores::cont::internal::Buffer> Buffers;
+  std::vector<viskores::UInt64> ModifiedCounts;
+};
+
+} // namespace detail
+
+/// @brief Keeps built locators so that they are reused for unchanged geometry.
+///
+/// Building a cell or point locator often costs more than using it. `LocatorCache`
+/// holds on to the locators it builds. A locator is reused when it is requested again
+/// for the same cell set object and for coordinates and connectivity arrays that
+/// share the same buffers, as long as none of those buffers were written to since the
+/// locator was built. Thus, a filter run over the time steps of a fixed mesh builds its
+/// locator only once.
+///
+/// Copies of a `LocatorCache` share the same locators, and the cache can be used from
+/// several threads at once. The cache holds at most `GetCapacity()` locators and drops
+/// the least recently used one when it is full. A cached locator keeps its cell set and
+/// coordinates from being freed until it is dropped or `Clear()` is called.
+class VISKORES_CONT_EXPORT LocatorCache
+{
+public:
+  VISKORES_CONT LocatorCache(std::size_t capacity = 4);
+
+  /// @brief Returns a built cell locator for the given cells and coordinates.
+  ///
+  /// A new locator is default constructed and built if there is no cached locator of
+  /// type `LocatorType` for this geometry.
+  template <typename LocatorType>
+  VISKORES_CONT LocatorType GetCellLocator(const viskores::cont::UnknownCellSet& cellSet,
+                                           const viskores::cont::CoordinateSystem& coords)
+  {
+    detail::LocatorCacheKey key(cellSet, coords);
+    std::shared_ptr<void> cached = this->Find(typeid(LocatorType), key);
+    if (cached)
+    {
+      return *static_cast<LocatorType*>(cached.get());
+    }
+
+    auto locator = std::make_shared<LocatorType>();
+    locator->SetCellSet(cellSet);
+    locator->SetCoordinates(coords);
+    locator->Update();
+    this->Insert(typeid(LocatorType), std::move(key), locator);
+    return *locator;
+  }
+
+  /// @brief Returns a built point locator for the given coordinates.
+  ///
+  /// A new locator is default constructed and built if there is no cached locator of
+  /// type `LocatorType` for these coordinates.
+  template <typename LocatorType>
+  VISKORES_CONT LocatorType GetPointLocator(const viskores::cont::CoordinateSystem& coords)
+  {
+    detail::LocatorCacheKey key(viskores::cont::UnknownCellSet{}, coords);
+    std::shared_ptr<void> cached = this->Find(typeid(LocatorType), key);
+    if (cached)
+    {
+      return *static_cast<LocatorType*>(cached.get());
+    }
+
+    auto locator = std::make_shared<LocatorType>();
+    locator->SetCoordinates(coords);
+    locator->Update();
+    this->Insert(typeid(LocatorType), std::move(key), locator);
+    return *locator;
+  }
+
+  /// @brief Drops all the cached locators.
+  VISKORES_CONT void Clear();
+
+  /// @brief The maximum number of locators held by the cache.
+  ///
+  /// When the capacity is reduced, the least recently used locators are dropped.
+  VISKORES_CONT void SetCapacity(std::size_t capacity);
+  /// @copydoc SetCapacity
+  VISKORES_CONT std::size_t GetCapacity() const;
+
+  /// @brief The number of locators held by the cache.
+  VISKORES_CONT std::size_t GetNumberOfLocators() const;
+
+  /// @brief The number of locators the cache has built.
+  ///
+  /// Each request that does not find a cached locator builds one.
+  VISKORES_CONT viskores::Id GetNumberOfBuilds() const;
+
+private:
+  struct InternalsType;
+  std::shared_ptr<InternalsType> Internals;
+
+  VISKORES_CONT std::shared_ptr<void> Find(const std::type_index& type,
+                                           const detail::LocatorCacheKey& key) const;
+  VISKORES_CONT void Insert(const std::type_index& type,
+                            detail::LocatorCacheKey&& key,
+                            const std::shared_ptr<void>& locator);
+};
+
+}
+} // namespace viskores::cont
+
+#endif //viskores_cont_LocatorCache_h
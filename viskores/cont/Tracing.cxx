@@ -0,0 +1,289 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/Tracing.h>
+
+#include <viskores/cont/ErrorBadValue.h>
+#include <viskores/cont/Logging.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+namespace viskores
+{
+namespace cont
+{
+
+namespace detail
+{
+
+std::atomic<bool> TracingEnabled{ false };
+
+viskores::Int64 GetTraceTimestamp()
+{
+  // Nanoseconds since the first call, which keeps the numbers in the trace small.
+  using Clock = std::chrono::steady_clock;
+  static const Clock::time_point epoch = Clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+}
+
+} // namespace detail
+
+namespace
+{
+
+struct TraceEvent
+{
+  std::string Name;
+  const char* Category;
+  viskores::Int64 Start;
+  viskores::Int64 Duration;
+  viskores::Int32 ThreadId;
+  std::string Args;
+};
+
+struct TraceThread
+{
+  viskores::Int32 ThreadId;
+  std::string Name;
+};
+
+struct TraceLog
+{
+  std::mutex Mutex;
+  std::vector<TraceEvent> Events;
+  std::vector<TraceThread> Threads;
+  std::string ExitFileName;
+};
+
+TraceLog& GetTraceLog()
+{
+  // Never destroyed so that events from threads still running at exit are safe to record.
+  static TraceLog* log = new TraceLog;
+  return *log;
+}
+
+viskores::Int32 GetTraceThreadId()
+{
+  static std::atomic<viskores::Int32> nextThreadId{ 1 };
+  thread_local viskores::Int32 threadId = 0;
+  if (threadId == 0)
+  {
+    threadId = nextThreadId++;
+    std::string name = viskores::cont::GetLogThreadName();
+    TraceLog& log = GetTraceLog();
+    std::lock_guard<std::mutex> lock(log.Mutex);
+    log.Threads.push_back({ threadId, (name == "N/A") ? std::string{} : name });
+  }
+  return threadId;
+}
+
+void WriteJSONString(std::ostream& out, const std::string& value)
+{
+  out << '"';
+  for (char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+              << std::dec << std::setfill(' ');
+        }
+        else
+        {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+std::string ToJSONString(const std::string& value)
+{
+  std::ostringstream out;
+  WriteJSONString(out, value);
+  return out.str();
+}
+
+// Chrome traces use microseconds. Keep the nanoseconds as a fraction.
+void WriteMicroseconds(std::ostream& out, viskores::Int64 nanoseconds)
+{
+  out << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000
+      << std::setfill(' ');
+}
+
+void WriteTraceAtExit()
+{
+  TraceLog& log = GetTraceLog();
+  std::string fileName;
+  {
+    std::lock_guard<std::mutex> lock(log.Mutex);
+    fileName = log.ExitFileName;
+  }
+  if (!fileName.empty())
+  {
+    viskores::cont::StopTracing();
+    try
+    {
+      viskores::cont::WriteTraceFile(fileName);
+    }
+    catch (const viskores::cont::Error& error)
+    {
+      VISKORES_LOG_S(viskores::cont::LogLevel::Error, error.GetMessage());
+    }
+  }
+}
+
+} // anonymous namespace
+
+void StartTracing()
+{
+  GetTraceThreadId();
+  detail::TracingEnabled.store(true);
+}
+
+void StopTracing()
+{
+  detail::TracingEnabled.store(false);
+}
+
+void ClearTrace()
+{
+  TraceLog& log = GetTraceLog();
+  std::lock_guard<std::mutex> lock(log.Mutex);
+  log.Events.clear();
+}
+
+viskores::Id GetNumberOfTraceEvents()
+{
+  TraceLog& log = GetTraceLog();
+  std::lock_guard<std::mutex> lock(log.Mutex);
+  return static_cast<viskores::Id>(log.Events.size());
+}
+
+void WriteTrace(std::ostream& out)
+{
+  TraceLog& log = GetTraceLog();
+  std::lock_guard<std::mutex> lock(log.Mutex);
+
+  out << "{\"traceEvents\":[\n";
+  bool first = true;
+  for (const TraceThread& thread : log.Threads)
+  {
+    out << (first ? "" : ",\n") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)"
+        << thread.ThreadId << R"(,"args":{"name":)";
+    WriteJSONString(out,
+                    thread.Name.empty() ? "Thread " + std::to_string(thread.ThreadId)
+                                        : thread.Name);
+    out << "}}";
+    first = false;
+  }
+  for (const TraceEvent& event : log.Events)
+  {
+    out << (first ? "" : ",\n") << "{\"name\":";
+    WriteJSONString(out, event.Name);
+    out << ",\"cat\":\"" << event.Category << "\",\"ph\":\"X\",\"ts\":";
+    WriteMicroseconds(out, event.Start);
+    out << ",\"dur\":";
+    WriteMicroseconds(out, event.Duration);
+    out << ",\"pid\":1,\"tid\":" << event.ThreadId;
+    if (!event.Args.empty())
+    {
+      out << ",\"args\":{" << event.Args << "}";
+    }
+    out << "}";
+    first = false;
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void WriteTraceFile(const std::string& fileName)
+{
+  std::ofstream file(fileName.c_str(), std::ios_base::trunc);
+  if (!file)
+  {
+    throw viskores::cont::ErrorBadValue("Could not open trace file " + fileName);
+  }
+  WriteTrace(file);
+  VISKORES_LOG_S(viskores::cont::LogLevel::Info,
+                 "Wrote " << GetNumberOfTraceEvents() << " trace events to " << fileName);
+}
+
+void TraceToFileAtExit(const std::string& fileName)
+{
+  TraceLog& log = GetTraceLog();
+  bool registerHandler;
+  {
+    std::lock_guard<std::mutex> lock(log.Mutex);
+    registerHandler = log.ExitFileName.empty();
+    log.ExitFileName = fileName;
+  }
+  if (registerHandler)
+  {
+    std::atexit(WriteTraceAtExit);
+  }
+  StartTracing();
+}
+
+void TraceScope::AddArg(const char* key, const std::string& value)
+{
+  this->Args += (this->Args.empty() ? "\"" : ",\"");
+  this->Args += key;
+  this->Args += "\":";
+  this->Args += ToJSONString(value);
+}
+
+void TraceScope::AddArg(const char* key, const char* value)
+{
+  this->AddArg(key, std::string(value));
+}
+
+void TraceScope::AddArg(const char* key, viskores::Int64 value)
+{
+  this->Args += (this->Args.empty() ? "\"" : ",\"");
+  this->Args += key;
+  this->Args += "\":";
+  this->Args += std::to_string(value);
+}
+
+void TraceScope::Record()
+{
+  const viskores::Int64 end = detail::GetTraceTimestamp();
+  const viskores::Int32 threadId = GetTraceThreadId();
+  TraceLog& log = GetTraceLog();
+  std::lock_guard<std::mutex> lock(log.Mutex);
+  log.Events.push_back({ std::move(this->Name),
+                         this->Category,
+                         this->Start,
+                         end - this->Start,
+                         threadId,
+                         std::move(this->Args) });
+}
+
+}
+} // namespace viskores::cont
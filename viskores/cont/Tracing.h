@@ -0,0 +1,151 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+#ifndef viskores_cont_Tracing_h
+#define viskores_cont_Tracing_h
+
+#include <viskores/Types.h>
+
+#include <viskores/cont/viskores_cont_export.h>
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+
+namespace viskores
+{
+namespace cont
+{
+
+namespace detail
+{
+
+VISKORES_CONT_EXPORT extern std::atomic<bool> TracingEnabled;
+
+VISKORES_CONT_EXPORT viskores::Int64 GetTraceTimestamp();
+
+} // namespace detail
+
+/// @brief Returns true while trace events are being recorded.
+///
+/// This is a single relaxed atomic load, so it is cheap enough to check around any
+/// code that only exists to build trace events.
+inline bool IsTracingEnabled()
+{
+  return detail::TracingEnabled.load(std::memory_order_relaxed);
+}
+
+/// @brief Starts recording trace events.
+///
+/// While tracing, Viskores records the time spent in each filter execution, each worklet
+/// dispatch, and each transfer of array memory between the host and a device, along with
+/// the thread that did the work. Events recorded by an earlier session are kept. Use
+/// `ClearTrace()` to drop them.
+///
+/// Tracing can also be turned on with the `--viskores-trace-file` option to
+/// `viskores::cont::Initialize()` or the `VISKORES_TRACE_FILE` environment variable.
+VISKORES_CONT_EXPORT void StartTracing();
+
+/// @brief Stops recording trace events. The events recorded so far are kept.
+VISKORES_CONT_EXPORT void StopTracing();
+
+/// @brief Removes all recorded trace events.
+VISKORES_CONT_EXPORT void ClearTrace();
+
+/// @brief Returns the number of trace events recorded.
+VISKORES_CONT_EXPORT viskores::Id GetNumberOfTraceEvents();
+
+/// @brief Writes the recorded events in the Chrome trace event JSON format.
+///
+/// The output can be loaded into Perfetto (https://ui.perfetto.dev) or `chrome://tracing`.
+VISKORES_CONT_EXPORT void WriteTrace(std::ostream& out);
+
+/// @brief Writes the recorded events to a Chrome trace JSON file.
+VISKORES_CONT_EXPORT void WriteTraceFile(const std::string& fileName);
+
+/// @brief Starts tracing and writes the trace to the given file when the program exits.
+VISKORES_CONT_EXPORT void TraceToFileAtExit(const std::string& fileName);
+
+/// @brief Records the time spent in a scope as a trace event.
+///
+/// The event starts when the object is constructed and ends when it is destroyed. When
+/// tracing is off, construction and destruction do nothing, so the cost of building a
+/// name or arguments should be guarded with `IsActive()`.
+///
+/// ```cpp
+/// viskores::cont::TraceScope trace("worklet");
+/// if (trace.IsActive())
+/// {
+///   trace.SetName(viskores::cont::TypeToString<WorkletType>());
+///   trace.AddArg("size", numInstances);
+/// }
+/// ```
+class VISKORES_CONT_EXPORT TraceScope
+{
+public:
+  /// The category must be a string literal (or otherwise outlive the trace).
+  VISKORES_CONT explicit TraceScope(const char* category)
+    : Category(category)
+    , Active(IsTracingEnabled())
+  {
+    if (this->Active)
+    {
+      this->Start = detail::GetTraceTimestamp();
+    }
+  }
+
+  VISKORES_CONT TraceScope(const char* category, const std::string& name)
+    : TraceScope(category)
+  {
+    if (this->Active)
+    {
+      this->Name = name;
+    }
+  }
+
+  VISKORES_CONT ~TraceScope()
+  {
+    if (this->Active)
+    {
+      this->Record();
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  /// True if this scope will record an event.
+  VISKORES_CONT bool IsActive() const { return this->Active; }
+
+  VISKORES_CONT void SetName(const std::string& name) { this->Name = name; }
+
+  /// Adds a named value shown with the event.
+  VISKORES_CONT void AddArg(const char* key, const std::string& value);
+  VISKORES_CONT void AddArg(const char* key, const char* value);
+  VISKORES_CONT void AddArg(const char* key, viskores::Int64 value);
+  VISKORES_CONT void AddArg(const char* key, viskores::Int32 value)
+  {
+    this->AddArg(key, static_cast<viskores::Int64>(value));
+  }
+
+  /// Drops the event, for example when the traced operation turned out to do nothing.
+  VISKORES_CONT void Discard() { this->Active = false; }
+
+private:
+  VISKORES_CONT void Record();
+
+  const char* Category;
+  bool Active;
+  viskores::Int64 Start = 0;
+  std::string Name;
+  std::string Args;
+};
+
+}
+} // namespace viskores::cont
+
+#endif //viskores_cont_Tracing_h
@@ -313,6 +313,18 @@ VISKORES_CONT viskores::Id UnknownArrayHandle::GetNumberOfValues() const
   }
 }
 
+std::vector<viskores::cont::internal::Buffer> UnknownArrayHandle::GetBuffers() const
+{
+  if (this->Container)
+  {
+    return this->Container->Buffers(this->Container->ArrayHandlePointer);
+  }
+  else
+  {
+    return {};
+  }
+}
+
 viskores::IdComponent UnknownArrayHandle::GetNumberOfComponents() const
 {
   if (this->Container)
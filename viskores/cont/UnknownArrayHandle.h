@@ -639,6 +639,13 @@ public:
   ///
   VISKORES_CONT viskores::IdComponent GetNumberOfComponentsFlat() const;
 
+  /// @brief Returns the buffers of the array held by this `UnknownArrayHandle`.
+  ///
+  /// Two arrays share their data if they have the same buffers. The buffers are empty when
+  /// no array is held.
+  ///
+  VISKORES_CONT std::vector<viskores::cont::internal::Buffer> GetBuffers() const;
+
   /// @brief Reallocate the data in the array.
   ///
   /// The allocation works the same as the `Allocate()` method of `viskores::cont::ArrayHandle`.
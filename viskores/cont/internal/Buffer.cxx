@@ -26,6 +26,7 @@
 #include <viskores/cont/Initialize.h>
 #include <viskores/cont/Logging.h>
 #include <viskores/cont/RuntimeDeviceInformation.h>
+#include <viskores/cont/Tracing.h>
 #include <viskores/cont/TryExecute.h>
 
 #include <viskores/cont/internal/Buffer.h>
@@ -288,6 +289,8 @@ private:
   // data preserved.
   viskores::BufferSizeType NumberOfBytes = 0;
 
+  viskores::UInt64 ModifiedCount = 0;
+
   DeviceBufferMap DeviceBuffers;
   BufferState HostBuffer;
 
@@ -338,6 +341,17 @@ public:
     this->CheckLock(lock);
     this->NumberOfBytes = numberOfBytes;
   }
+
+  VISKORES_CONT viskores::UInt64 GetModifiedCount(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    return this->ModifiedCount;
+  }
+  VISKORES_CONT void SetModified(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    ++this->ModifiedCount;
+  }
 };
 
 namespace detail
@@ -454,6 +468,7 @@ struct VISKORES_NEVER_EXPORT BufferHelper
       lock, [&lock, &token, internals] { return CanWrite(internals, lock, token); });
 
     token.Attach(internals, internals->GetWriteCount(lock), lock, &internals->ConditionVariable);
+    internals->SetModified(lock);
 
     // We successfully attached the token. Pop it off the queue.
     auto& queue = internals->GetQueue(lock);
@@ -550,6 +565,14 @@ struct VISKORES_NEVER_EXPORT BufferHelper
         deviceBuffer.second.Reallocate(targetSize);
       }
 
+      viskores::cont::TraceScope trace("transfer");
+      if (trace.IsActive())
+      {
+        trace.SetName("CopyDeviceToHost");
+        trace.AddArg("bytes", deviceBuffer.second.GetSize());
+        trace.AddArg("device", deviceBuffer.first.GetName());
+      }
+
       if (!hostBuffer.Pinned)
       {
         hostBuffer = memoryManager.CopyDeviceToHost(deviceBuffer.second);
@@ -560,6 +583,12 @@ struct VISKORES_NEVER_EXPORT BufferHelper
         memoryManager.CopyDeviceToHost(deviceBuffer.second, hostBuffer);
       }
 
+      if (hostBuffer.GetPointer() == deviceBuffer.second.GetPointer())
+      {
+        // Devices that share memory with the host do not copy anything.
+        trace.Discard();
+      }
+
       if (hostBuffer.GetSize() != targetSize)
       {
         hostBuffer.Reallocate(targetSize);
@@ -645,6 +674,14 @@ struct VISKORES_NEVER_EXPORT BufferHelper
         hostBuffer.Reallocate(targetSize);
       }
 
+      viskores::cont::TraceScope trace("transfer");
+      if (trace.IsActive())
+      {
+        trace.SetName("CopyHostToDevice");
+        trace.AddArg("bytes", hostBuffer.GetSize());
+        trace.AddArg("device", device.GetName());
+      }
+
       if (!deviceBuffers[device].Pinned)
       {
         deviceBuffers[device] = memoryManager.CopyHostToDevice(hostBuffer);
@@ -655,6 +692,12 @@ struct VISKORES_NEVER_EXPORT BufferHelper
         memoryManager.CopyHostToDevice(hostBuffer, deviceBuffers[device]);
       }
 
+      if (deviceBuffers[device].GetPointer() == hostBuffer.GetPointer())
+      {
+        // Devices that share memory with the host do not copy anything.
+        trace.Discard();
+      }
+
       if (deviceBuffers[device].GetSize() != targetSize)
       {
         deviceBuffers[device].Reallocate(targetSize);
@@ -802,6 +845,12 @@ void Buffer::SetNumberOfBytes(viskores::BufferSizeType numberOfBytes,
   detail::BufferHelper::SetNumberOfBytes(this->Internals, lock, numberOfBytes, preserve, token);
 }
 
+viskores::UInt64 Buffer::GetModifiedCount() const
+{
+  LockType lock = this->Internals->GetLock();
+  return this->Internals->GetModifiedCount(lock);
+}
+
 bool Buffer::HasMetaData() const
 {
   return (this->Internals->MetaData.Data != nullptr);
@@ -1055,6 +1104,7 @@ void Buffer::Reset(const viskores::cont::internal::BufferInfo& bufferInfo)
   }
 
   this->Internals->SetNumberOfBytes(lock, bufferInfo.GetSize());
+  this->Internals->SetModified(lock);
 }
 
 void Buffer::ReleaseDeviceResources() const
@@ -133,6 +133,14 @@ public:
                                       viskores::CopyFlag preserve,
                                       viskores::cont::Token& token) const;
 
+  /// \brief Returns the number of times the buffer was opened for writing.
+  ///
+  /// The count goes up whenever the contents of the buffer may have changed: when write access
+  /// is granted, and when the buffer is resized or reset. An object derived from the buffer can
+  /// compare the count with the one it was derived from to find out if it is out of date.
+  ///
+  VISKORES_CONT viskores::UInt64 GetModifiedCount() const;
+
 private:
   VISKORES_CONT bool MetaDataIsType(const std::string& type) const;
   VISKORES_CONT void SetMetaData(void* data,
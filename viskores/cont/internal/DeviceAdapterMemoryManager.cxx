@@ -18,6 +18,7 @@
 
 #include <viskores/cont/ErrorBadAllocation.h>
 #include <viskores/cont/internal/DeviceAdapterMemoryManager.h>
+#include <viskores/cont/internal/HostMemoryPool.h>
 
 #include <viskores/Math.h>
 
@@ -320,6 +321,18 @@ TransferredBuffer BufferInfo::TransferOwnership()
 //----------------------------------------------------------------------------------------
 viskores::cont::internal::BufferInfo AllocateOnHost(viskores::BufferSizeType size)
 {
+  auto& pool = viskores::cont::internal::HostMemoryPool::GetInstance();
+  if (pool.CanPool(size))
+  {
+    void* memory = pool.Allocate(size);
+    return viskores::cont::internal::BufferInfo(viskores::cont::DeviceAdapterTagUndefined{},
+                                                memory,
+                                                memory,
+                                                size,
+                                                HostMemoryPool::Deleter,
+                                                HostMemoryPool::Reallocater);
+  }
+
   void* memory = HostAllocate(size);
 
   return viskores::cont::internal::BufferInfo(
@@ -92,6 +92,12 @@ void DeviceAdapterMemoryManagerShared::CopyDeviceToDevice(
   std::memcpy(dest.GetPointer(), src.GetPointer(), static_cast<std::size_t>(src.GetSize()));
 }
 
+void* DeviceAdapterMemoryManagerShared::AllocateRawPointer(viskores::BufferSizeType size) const
+{
+  // Raw pointers are freed with `HostDeleter`, so they must not come from the host memory pool.
+  return viskores::cont::internal::HostAllocate(size);
+}
+
 void DeviceAdapterMemoryManagerShared::DeleteRawPointer(void* mem) const
 {
   viskores::cont::internal::HostDeleter(mem);
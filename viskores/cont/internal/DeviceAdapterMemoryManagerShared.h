@@ -59,6 +59,8 @@ public:
     const viskores::cont::internal::BufferInfo& src,
     const viskores::cont::internal::BufferInfo& dest) const override;
 
+  VISKORES_CONT void* AllocateRawPointer(viskores::BufferSizeType size) const override;
+
   VISKORES_CONT void DeleteRawPointer(void* mem) const override;
 };
 }
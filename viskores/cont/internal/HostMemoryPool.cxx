@@ -0,0 +1,444 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/ErrorBadAllocation.h>
+#include <viskores/cont/Logging.h>
+#include <viskores/cont/RuntimeDeviceTracker.h>
+#include <viskores/cont/internal/DeviceAdapterMemoryManager.h>
+#include <viskores/cont/internal/HostMemoryPool.h>
+
+#include <viskores/Math.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace viskores
+{
+namespace cont
+{
+namespace internal
+{
+
+namespace
+{
+
+// Each pooled block has a header in front of the memory handed out that records its size
+// class. The header is a full alignment unit so the returned memory keeps the alignment.
+constexpr std::size_t HeaderSize = VISKORES_ALLOCATION_ALIGNMENT;
+
+// The smallest size class is 2^MinShift bytes. Above that, every power of two is divided into
+// 4 classes, so a block is never more than 25% larger than requested.
+constexpr int MinShift = 6;
+constexpr int MaxShift = 47;
+constexpr int NumSizeClasses = 1 + (MaxShift - MinShift + 1) * 4;
+
+constexpr viskores::BufferSizeType DefaultMaximumHeldBytes =
+  viskores::BufferSizeType{ 1 } << 30; // 1 GiB
+
+struct BlockHeader
+{
+  std::int32_t SizeClass;
+};
+
+int HighestBit(std::uint64_t value)
+{
+  int bit = -1;
+  while (value != 0)
+  {
+    value >>= 1;
+    ++bit;
+  }
+  return bit;
+}
+
+int SizeClassIndex(viskores::BufferSizeType numBytes)
+{
+  if (numBytes <= (viskores::BufferSizeType{ 1 } << MinShift))
+  {
+    return 0;
+  }
+  const std::uint64_t value = static_cast<std::uint64_t>(numBytes - 1);
+  const int shift = HighestBit(value);
+  const int sub = static_cast<int>((value >> (shift - 2)) & 3);
+  return 1 + (shift - MinShift) * 4 + sub;
+}
+
+viskores::BufferSizeType SizeClassBytes(int sizeClass)
+{
+  if (sizeClass == 0)
+  {
+    return viskores::BufferSizeType{ 1 } << MinShift;
+  }
+  const int shift = ((sizeClass - 1) / 4) + MinShift;
+  const int sub = (sizeClass - 1) % 4;
+  return (viskores::BufferSizeType{ 1 } << shift) +
+    (sub + 1) * (viskores::BufferSizeType{ 1 } << (shift - 2));
+}
+
+char* BlockBase(void* memory)
+{
+  return static_cast<char*>(memory) - HeaderSize;
+}
+
+int BlockSizeClass(void* memory)
+{
+  return reinterpret_cast<BlockHeader*>(BlockBase(memory))->SizeClass;
+}
+
+struct HostMemoryPoolBins
+{
+  std::vector<void*> Bins[NumSizeClasses];
+  viskores::BufferSizeType Bytes = 0;
+};
+
+// The cache of a thread using thread-friendly allocation. The cache is registered with the pool
+// so that releasing the pool can empty it. When the thread exits, its blocks go back to the
+// shared bins.
+struct HostMemoryPoolThreadCache : HostMemoryPoolBins
+{
+  HostMemoryPool::InternalsType* Pool;
+
+  // Held by the owning thread while it uses the cache and by a thread releasing the pool. Only
+  // those two ever contend for it.
+  std::mutex Lock;
+
+  HostMemoryPoolThreadCache(HostMemoryPool::InternalsType* pool);
+  ~HostMemoryPoolThreadCache();
+};
+
+thread_local HostMemoryPoolThreadCache* CurrentThreadCache = nullptr;
+
+HostMemoryPoolThreadCache* GetThreadCache(HostMemoryPool::InternalsType* pool)
+{
+  thread_local std::unique_ptr<HostMemoryPoolThreadCache> cache;
+  if (!cache)
+  {
+    cache.reset(new HostMemoryPoolThreadCache(pool));
+    CurrentThreadCache = cache.get();
+  }
+  return cache.get();
+}
+
+} // anonymous namespace
+
+struct HostMemoryPool::InternalsType
+{
+  std::atomic<bool> Enabled{ false };
+  std::atomic<viskores::BufferSizeType> MaximumHeldBytes{ DefaultMaximumHeldBytes };
+
+  std::atomic<viskores::Id> Hits{ 0 };
+  std::atomic<viskores::Id> Misses{ 0 };
+  // Bytes held in the shared bins and all thread caches.
+  std::atomic<viskores::BufferSizeType> BytesHeld{ 0 };
+
+  std::mutex Lock;
+  HostMemoryPoolBins Shared;
+
+  // Caches of all threads that have used thread-friendly allocation and not yet exited. A
+  // thread cache lock may be taken while holding this lock, but not the other way around.
+  std::mutex ThreadCachesLock;
+  std::vector<HostMemoryPoolThreadCache*> ThreadCaches;
+
+  viskores::BufferSizeType GetThreadCacheLimit() const { return this->MaximumHeldBytes / 16; }
+
+  bool ReserveHeldBytes(viskores::BufferSizeType numBytes)
+  {
+    viskores::BufferSizeType held = this->BytesHeld.load();
+    do
+    {
+      if ((held + numBytes) > this->MaximumHeldBytes)
+      {
+        return false;
+      }
+    } while (!this->BytesHeld.compare_exchange_weak(held, held + numBytes));
+    return true;
+  }
+
+  void* AllocateBlock(viskores::BufferSizeType numBytes)
+  {
+    const int sizeClass = SizeClassIndex(numBytes);
+    if (sizeClass >= NumSizeClasses)
+    {
+      throw viskores::cont::ErrorBadAllocation("Host allocation too large for memory pool.");
+    }
+    const viskores::BufferSizeType blockBytes = SizeClassBytes(sizeClass);
+
+    if (viskores::cont::GetRuntimeDeviceTracker().GetThreadFriendlyMemAlloc())
+    {
+      HostMemoryPoolThreadCache* cache = GetThreadCache(this);
+      std::lock_guard<std::mutex> lock(cache->Lock);
+      std::vector<void*>& bin = cache->Bins[sizeClass];
+      if (!bin.empty())
+      {
+        void* memory = bin.back();
+        bin.pop_back();
+        cache->Bytes -= blockBytes;
+        this->BytesHeld -= blockBytes;
+        ++this->Hits;
+        return memory;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->Lock);
+      std::vector<void*>& bin = this->Shared.Bins[sizeClass];
+      if (!bin.empty())
+      {
+        void* memory = bin.back();
+        bin.pop_back();
+        this->Shared.Bytes -= blockBytes;
+        this->BytesHeld -= blockBytes;
+        ++this->Hits;
+        return memory;
+      }
+    }
+
+    ++this->Misses;
+    void* base = HostAllocate(static_cast<viskores::BufferSizeType>(HeaderSize) + blockBytes);
+    if (base == nullptr)
+    {
+      // Cached blocks of other sizes might be what is keeping us from allocating.
+      this->ReleaseShared();
+      base = HostAllocate(static_cast<viskores::BufferSizeType>(HeaderSize) + blockBytes);
+      if (base == nullptr)
+      {
+        return nullptr;
+      }
+    }
+    reinterpret_cast<BlockHeader*>(base)->SizeClass = static_cast<std::int32_t>(sizeClass);
+    return static_cast<char*>(base) + HeaderSize;
+  }
+
+  void FreeBlock(void* memory)
+  {
+    const int sizeClass = BlockSizeClass(memory);
+    const viskores::BufferSizeType blockBytes = SizeClassBytes(sizeClass);
+
+    if (this->Enabled && this->ReserveHeldBytes(blockBytes))
+    {
+      HostMemoryPoolThreadCache* cache = CurrentThreadCache;
+      if (cache != nullptr)
+      {
+        std::lock_guard<std::mutex> lock(cache->Lock);
+        if ((cache->Bytes + blockBytes) <= this->GetThreadCacheLimit())
+        {
+          cache->Bins[sizeClass].push_back(memory);
+          cache->Bytes += blockBytes;
+          return;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(this->Lock);
+      this->Shared.Bins[sizeClass].push_back(memory);
+      this->Shared.Bytes += blockBytes;
+      return;
+    }
+
+    HostDeleter(BlockBase(memory));
+  }
+
+  void ReleaseBins(HostMemoryPoolBins& bins)
+  {
+    for (auto& bin : bins.Bins)
+    {
+      for (void* memory : bin)
+      {
+        HostDeleter(BlockBase(memory));
+      }
+      bin.clear();
+    }
+    this->BytesHeld -= bins.Bytes;
+    bins.Bytes = 0;
+  }
+
+  void ReleaseThreadCaches()
+  {
+    std::lock_guard<std::mutex> lock(this->ThreadCachesLock);
+    for (HostMemoryPoolThreadCache* cache : this->ThreadCaches)
+    {
+      std::lock_guard<std::mutex> cacheLock(cache->Lock);
+      this->ReleaseBins(*cache);
+    }
+  }
+
+  void ReleaseShared()
+  {
+    std::lock_guard<std::mutex> lock(this->Lock);
+    this->ReleaseBins(this->Shared);
+  }
+
+  void MoveToShared(HostMemoryPoolBins& bins)
+  {
+    std::lock_guard<std::mutex> lock(this->Lock);
+    for (int sizeClass = 0; sizeClass < NumSizeClasses; ++sizeClass)
+    {
+      auto& source = bins.Bins[sizeClass];
+      auto& dest = this->Shared.Bins[sizeClass];
+      dest.insert(dest.end(), source.begin(), source.end());
+      source.clear();
+    }
+    this->Shared.Bytes += bins.Bytes;
+    bins.Bytes = 0;
+  }
+};
+
+namespace
+{
+
+HostMemoryPoolThreadCache::HostMemoryPoolThreadCache(HostMemoryPool::InternalsType* pool)
+  : Pool(pool)
+{
+  std::lock_guard<std::mutex> lock(this->Pool->ThreadCachesLock);
+  this->Pool->ThreadCaches.push_back(this);
+}
+
+HostMemoryPoolThreadCache::~HostMemoryPoolThreadCache()
+{
+  CurrentThreadCache = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->Pool->ThreadCachesLock);
+    auto& caches = this->Pool->ThreadCaches;
+    caches.erase(std::find(caches.begin(), caches.end(), this));
+  }
+  // No other thread can reach the cache once it is unregistered.
+  this->Pool->MoveToShared(*this);
+}
+
+} // anonymous namespace
+
+HostMemoryPool::HostMemoryPool()
+  : Internals(new InternalsType)
+{
+}
+
+HostMemoryPool& HostMemoryPool::GetInstance()
+{
+  // The pool is intentionally never destroyed. Buffers held in static objects may be freed
+  // after static destruction has started.
+  static HostMemoryPool* pool = new HostMemoryPool;
+  return *pool;
+}
+
+void HostMemoryPool::SetEnabled(bool enabled)
+{
+  VISKORES_LOG_S(viskores::cont::LogLevel::Info,
+                 "Host memory pool " << (enabled ? "enabled" : "disabled"));
+  this->Internals->Enabled = enabled;
+  if (!enabled)
+  {
+    this->ReleaseCachedMemory();
+  }
+}
+
+bool HostMemoryPool::GetEnabled() const
+{
+  return this->Internals->Enabled;
+}
+
+void HostMemoryPool::SetMaximumHeldBytes(viskores::BufferSizeType numBytes)
+{
+  this->Internals->MaximumHeldBytes = viskores::Max(numBytes, viskores::BufferSizeType{ 0 });
+  if (this->Internals->BytesHeld > this->Internals->MaximumHeldBytes)
+  {
+    this->ReleaseCachedMemory();
+  }
+}
+
+viskores::BufferSizeType HostMemoryPool::GetMaximumHeldBytes() const
+{
+  return this->Internals->MaximumHeldBytes;
+}
+
+void HostMemoryPool::ReleaseCachedMemory()
+{
+  this->Internals->ReleaseThreadCaches();
+  this->Internals->ReleaseShared();
+}
+
+viskores::cont::internal::HostMemoryPoolStatistics HostMemoryPool::GetStatistics() const
+{
+  viskores::cont::internal::HostMemoryPoolStatistics statistics;
+  statistics.Hits = this->Internals->Hits;
+  statistics.Misses = this->Internals->Misses;
+  statistics.BytesHeld = this->Internals->BytesHeld;
+  return statistics;
+}
+
+void HostMemoryPool::ResetStatistics()
+{
+  this->Internals->Hits = 0;
+  this->Internals->Misses = 0;
+}
+
+bool HostMemoryPool::CanPool(viskores::BufferSizeType numBytes) const
+{
+  return this->Internals->Enabled && (numBytes > 0) &&
+    (numBytes <= this->Internals->MaximumHeldBytes) &&
+    (numBytes <= SizeClassBytes(NumSizeClasses - 1));
+}
+
+void* HostMemoryPool::Allocate(viskores::BufferSizeType numBytes)
+{
+  VISKORES_ASSERT(numBytes > 0);
+  return this->Internals->AllocateBlock(numBytes);
+}
+
+void HostMemoryPool::Deleter(void* memory)
+{
+  if (memory == nullptr)
+  {
+    return;
+  }
+  HostMemoryPool::GetInstance().Internals->FreeBlock(memory);
+}
+
+void HostMemoryPool::Reallocater(void*& memory,
+                                 void*& container,
+                                 viskores::BufferSizeType oldSize,
+                                 viskores::BufferSizeType newSize)
+{
+  VISKORES_ASSERT(memory == container);
+
+  if (newSize <= 0)
+  {
+    HostMemoryPool::Deleter(memory);
+    memory = container = nullptr;
+    return;
+  }
+
+  // Like `HostReallocate`, keep the block if the new size still fits and does not waste too
+  // much of it.
+  if (memory != nullptr)
+  {
+    const viskores::BufferSizeType capacity = SizeClassBytes(BlockSizeClass(memory));
+    if ((newSize <= capacity) && (newSize > ((3 * oldSize) / 4)))
+    {
+      return;
+    }
+  }
+
+  // The deleter of the buffer does not change, so the new memory has to be a pool block even
+  // if it will not be cached when freed.
+  void* newBuffer = HostMemoryPool::GetInstance().Internals->AllocateBlock(newSize);
+  if (memory != nullptr)
+  {
+    std::memcpy(newBuffer, memory, static_cast<std::size_t>(viskores::Min(newSize, oldSize)));
+    HostMemoryPool::Deleter(memory);
+  }
+
+  memory = container = newBuffer;
+}
+
+}
+}
+} // namespace viskores::cont::internal
@@ -0,0 +1,106 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_cont_internal_HostMemoryPool_h
+#define viskores_cont_internal_HostMemoryPool_h
+
+#include <viskores/cont/viskores_cont_export.h>
+
+#include <viskores/cont/internal/DeviceAdapterMemoryManager.h>
+
+namespace viskores
+{
+namespace cont
+{
+namespace internal
+{
+
+/// Counters reported by `HostMemoryPool::GetStatistics()`.
+struct HostMemoryPoolStatistics
+{
+  /// Number of allocations satisfied by a block cached in the pool.
+  viskores::Id Hits = 0;
+  /// Number of allocations that had to get new memory from the system.
+  viskores::Id Misses = 0;
+  /// Number of bytes currently cached in the pool (and not in use by any buffer).
+  viskores::BufferSizeType BytesHeld = 0;
+};
+
+/// \brief A caching allocator for host memory.
+///
+/// When enabled, `AllocateOnHost` gets its memory from this pool rather than directly from the
+/// system. Requests are rounded up to a size class (four classes for each power of two), and
+/// freed blocks are kept in per-class bins to be reused by later allocations of the same class.
+/// This avoids repeatedly allocating (and having the system zero) large buffers in pipelines
+/// that run the same filters over and over.
+///
+/// The pool never holds more than `GetMaximumHeldBytes()` of unused memory. Blocks freed when
+/// the pool is full are returned to the system. Allocations larger than this limit are never
+/// pooled.
+///
+/// When the current thread's `RuntimeDeviceTracker` has thread-friendly memory allocation
+/// turned on, blocks are kept in a small cache local to the thread before falling back to the
+/// shared bins, which avoids lock contention when many threads allocate at the same time.
+///
+/// The pool is off by default. It can be turned on with the `--viskores-host-memory-pool`
+/// command line option or the `VISKORES_HOST_MEMORY_POOL` environment variable, both of which
+/// take the maximum held size in MiB, or by calling `SetEnabled`.
+///
+class VISKORES_CONT_EXPORT HostMemoryPool
+{
+public:
+  /// Returns the pool used by `AllocateOnHost`.
+  VISKORES_CONT static HostMemoryPool& GetInstance();
+
+  /// Turns the pool on or off. Turning the pool off returns all cached memory to the
+  /// system. Buffers that were allocated from the pool are still safely returned to it.
+  VISKORES_CONT void SetEnabled(bool enabled);
+  VISKORES_CONT bool GetEnabled() const;
+
+  /// Sets the maximum number of unused bytes kept by the pool. If more than this is currently
+  /// held, the excess is returned to the system.
+  VISKORES_CONT void SetMaximumHeldBytes(viskores::BufferSizeType numBytes);
+  VISKORES_CONT viskores::BufferSizeType GetMaximumHeldBytes() const;
+
+  /// Returns all cached memory, including the caches of every thread, to the system.
+  VISKORES_CONT void ReleaseCachedMemory();
+
+  VISKORES_CONT viskores::cont::internal::HostMemoryPoolStatistics GetStatistics() const;
+  VISKORES_CONT void ResetStatistics();
+
+  /// Returns true if an allocation of the given size will come from the pool.
+  VISKORES_CONT bool CanPool(viskores::BufferSizeType numBytes) const;
+
+  /// Allocates memory from the pool. The memory must be freed with `Deleter`. Only call this
+  /// if `CanPool` returns true for the size.
+  VISKORES_CONT void* Allocate(viskores::BufferSizeType numBytes);
+
+  /// The deleter and reallocater to use with `BufferInfo` objects for memory from `Allocate`.
+  VISKORES_CONT static void Deleter(void* memory);
+  VISKORES_CONT static void Reallocater(void*& memory,
+                                        void*& container,
+                                        viskores::BufferSizeType oldSize,
+                                        viskores::BufferSizeType newSize);
+
+  struct InternalsType;
+
+private:
+  VISKORES_CONT HostMemoryPool();
+  ~HostMemoryPool() = delete;
+
+  HostMemoryPool(const HostMemoryPool&) = delete;
+  void operator=(const HostMemoryPool&) = delete;
+
+  InternalsType* Internals;
+};
+
+}
+}
+} // namespace viskores::cont::internal
+
+#endif //viskores_cont_internal_HostMemoryPool_h
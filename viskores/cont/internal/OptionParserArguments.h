@@ -44,7 +44,11 @@ enum OptionIndex
   // All RuntimeDeviceConfiguration specific options
   NUM_THREADS,
   NUMA_REGIONS,
-  DEVICE_INSTANCE
+  DEVICE_INSTANCE,
+  HOST_MEMORY_POOL,
+
+  // Tracing
+  TRACE_FILE
 };
 
 struct ViskoresArg : public option::Arg
@@ -16,6 +16,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 #include <viskores/cont/Logging.h>
+#include <viskores/cont/internal/HostMemoryPool.h>
 #include <viskores/cont/internal/RuntimeDeviceConfiguration.h>
 
 namespace viskores
@@ -104,6 +105,11 @@ void RuntimeDeviceConfigurationBase::Initialize(
     [&](const viskores::Id& value) { return this->SetDeviceInstance(value); },
     "SetDeviceInstance",
     this->GetDevice().GetName());
+  InitializeOption(
+    configOptions.ViskoresHostMemoryPool,
+    [&](const viskores::Id& value) { return this->SetHostMemoryPool(value); },
+    "SetHostMemoryPool",
+    this->GetDevice().GetName());
   this->InitializeSubsystem();
 }
 
@@ -126,6 +132,22 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetHostMemoryPool(
+  const viskores::Id& value)
+{
+  if (value < 0)
+  {
+    return RuntimeDeviceConfigReturnCode::INVALID_VALUE;
+  }
+  auto& pool = viskores::cont::internal::HostMemoryPool::GetInstance();
+  if (value > 0)
+  {
+    pool.SetMaximumHeldBytes(static_cast<viskores::BufferSizeType>(value) * 1024 * 1024);
+  }
+  pool.SetEnabled(value > 0);
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
 RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetThreads(viskores::Id&) const
 {
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
@@ -136,6 +158,15 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetHostMemoryPool(
+  viskores::Id& value) const
+{
+  const auto& pool = viskores::cont::internal::HostMemoryPool::GetInstance();
+  value = pool.GetEnabled() ? static_cast<viskores::Id>(pool.GetMaximumHeldBytes() / (1024 * 1024))
+                            : 0;
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
 RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetMaxThreads(viskores::Id&) const
 {
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
@@ -64,10 +64,16 @@ public:
   VISKORES_CONT virtual RuntimeDeviceConfigReturnCode SetThreads(const viskores::Id& value);
   VISKORES_CONT virtual RuntimeDeviceConfigReturnCode SetDeviceInstance(const viskores::Id& value);
 
+  /// Sets the maximum size, in MiB, of unused host memory cached for reuse by
+  /// `viskores::cont::internal::HostMemoryPool`. A value of 0 turns the pool off. Host memory is
+  /// shared by all devices, so the base implementation applies to every device.
+  VISKORES_CONT virtual RuntimeDeviceConfigReturnCode SetHostMemoryPool(const viskores::Id& value);
+
   /// The following public methods are overriden in each individual device and store the
   /// values that were set via the above Set* methods for the given device.
   VISKORES_CONT virtual RuntimeDeviceConfigReturnCode GetThreads(viskores::Id& value) const;
   VISKORES_CONT virtual RuntimeDeviceConfigReturnCode GetDeviceInstance(viskores::Id& value) const;
+  VISKORES_CONT virtual RuntimeDeviceConfigReturnCode GetHostMemoryPool(viskores::Id& value) const;
 
   /// The following public methods should be overriden as needed for each individual device
   /// as they describe various device parameters.
@@ -54,6 +54,14 @@ void AppendOptionDescriptors(std::vector<option::Descriptor>& usage,
       option::ViskoresArg::Required,
       "  --viskores-device-instance <dev> \tSets the device instance to use when using "
       "kokkos/cuda" });
+  usage.push_back(
+    { useOptionIndex ? static_cast<uint32_t>(option::OptionIndex::HOST_MEMORY_POOL) : 3,
+      0,
+      "",
+      "viskores-host-memory-pool",
+      option::ViskoresArg::Required,
+      "  --viskores-host-memory-pool <MiB> \tCaches freed host memory for reuse, holding at "
+      "most the given size (0 to disable)" });
 }
 } // anonymous namespace
 
@@ -62,6 +70,8 @@ RuntimeDeviceConfigurationOptions::RuntimeDeviceConfigurationOptions(const bool&
                        "VISKORES_NUM_THREADS")
   , ViskoresDeviceInstance(useOptionIndex ? option::OptionIndex::DEVICE_INSTANCE : 2,
                            "VISKORES_DEVICE_INSTANCE")
+  , ViskoresHostMemoryPool(useOptionIndex ? option::OptionIndex::HOST_MEMORY_POOL : 3,
+                           "VISKORES_HOST_MEMORY_POOL")
   , Initialized(false)
 {
 }
@@ -110,6 +120,7 @@ void RuntimeDeviceConfigurationOptions::Initialize(const option::Option* options
 {
   this->ViskoresNumThreads.Initialize(options);
   this->ViskoresDeviceInstance.Initialize(options);
+  this->ViskoresHostMemoryPool.Initialize(options);
   this->Initialized = true;
 }
 
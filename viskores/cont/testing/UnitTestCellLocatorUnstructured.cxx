@@ -21,6 +21,7 @@
 #include <viskores/cont/Algorithm.h>
 #include <viskores/cont/ArrayCopy.h>
 #include <viskores/cont/ArrayHandleGroupVecVariable.h>
+#include <viskores/cont/ArrayHandleReverse.h>
 #include <viskores/cont/CellLocatorBoundingIntervalHierarchy.h>
 #include <viskores/cont/CellLocatorTwoLevel.h>
 #include <viskores/cont/CellLocatorUniformBins.h>
@@ -720,6 +721,76 @@ void TestFindAllCells(LocatorType& locator)
   ValidateFindAllCells(locator, testPts, expCellIds);
 }
 
+void TestLoadedBoundingIntervalHierarchy()
+{
+  std::cout << "Testing loaded CellLocatorBoundingIntervalHierarchy" << std::endl;
+  auto ds = MakeTestDataSet(viskores::Id3(8));
+
+  viskores::cont::CellLocatorBoundingIntervalHierarchy locator;
+  locator.SetBuildMethod(
+    viskores::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::BinnedSAH);
+  locator.SetCellSet(ds.GetCellSet());
+  locator.SetCoordinates(ds.GetCoordinateSystem());
+  locator.Update();
+
+  viskoresdiy::MemoryBuffer buffer;
+  viskoresdiy::save(buffer, locator);
+  buffer.reset();
+  viskores::cont::CellLocatorBoundingIntervalHierarchy loaded;
+  viskoresdiy::load(buffer, loaded);
+  VISKORES_TEST_ASSERT(loaded.GetBuildMethod() == locator.GetBuildMethod());
+
+  constexpr viskores::Id numberOfPoints = 512;
+  auto checkFindCell = [&](const viskores::cont::DataSet& dataSet)
+  {
+    loaded.SetCellSet(dataSet.GetCellSet());
+    loaded.SetCoordinates(dataSet.GetCoordinateSystem());
+    loaded.Update();
+
+    viskores::cont::ArrayHandle<viskores::Id> expCellIds;
+    viskores::cont::ArrayHandle<PointType> expPCoords;
+    viskores::cont::ArrayHandle<PointType> points;
+    GenerateRandomInput<3>(dataSet, numberOfPoints, expCellIds, expPCoords, points);
+
+    viskores::cont::ArrayHandle<viskores::Id> cellIds;
+    viskores::cont::Invoker invoker;
+    invoker(FindCellIdWorklet{}, points, loaded, cellIds);
+    auto cellIdsPortal = cellIds.ReadPortal();
+    auto expCellIdsPortal = expCellIds.ReadPortal();
+    for (viskores::Id i = 0; i < numberOfPoints; ++i)
+    {
+      VISKORES_TEST_ASSERT(cellIdsPortal.Get(i) == expCellIdsPortal.Get(i), "Incorrect cell ids");
+    }
+  };
+
+  // The loaded hierarchy is used for the same mesh, so it must find the same cells.
+  checkFindCell(ds);
+
+  // A hierarchy loaded for the same cells with moved points is rebuilt. Reversing the points
+  // mirrors the mesh through its center, which moves every cell but keeps the number of
+  // points and cells and the bounds of the mesh.
+  viskores::cont::ArrayHandle<PointType> mirroredPoints;
+  viskores::cont::ArrayCopy(
+    viskores::cont::make_ArrayHandleReverse(
+      ds.GetCoordinateSystem().GetData().AsArrayHandle<viskores::cont::ArrayHandle<PointType>>()),
+    mirroredPoints);
+  viskores::cont::DataSet mirrored;
+  mirrored.AddCoordinateSystem(viskores::cont::CoordinateSystem("coords", mirroredPoints));
+  mirrored.SetCellSet(ds.GetCellSet());
+  viskoresdiy::MemoryBuffer mirroredBuffer;
+  viskoresdiy::save(mirroredBuffer, locator);
+  mirroredBuffer.reset();
+  viskoresdiy::load(mirroredBuffer, loaded);
+  checkFindCell(mirrored);
+
+  // A hierarchy loaded for a different mesh is rebuilt.
+  viskoresdiy::MemoryBuffer otherBuffer;
+  viskoresdiy::save(otherBuffer, locator);
+  otherBuffer.reset();
+  viskoresdiy::load(otherBuffer, loaded);
+  TestCellLocator(loaded, viskores::Id3(6), numberOfPoints);
+}
+
 void TestingCellLocatorUnstructured()
 {
   viskores::UInt32 seed = static_cast<viskores::UInt32>(std::time(nullptr));
@@ -759,6 +830,16 @@ void TestingCellLocatorUnstructured()
   TestCellLocator(locatorBIH, viskores::Id3(8), 512);  // 3D dataset
   TestCellLocator(locatorBIH, viskores::Id2(18), 512); // 2D dataset
   TestFindAllCells(locatorBIH);
+
+  locatorBIH = viskores::cont::CellLocatorBoundingIntervalHierarchy();
+  locatorBIH.SetBuildMethod(
+    viskores::cont::CellLocatorBoundingIntervalHierarchy::BuildMethod::BinnedSAH);
+  std::cout << "Testing CellLocatorBoundingIntervalHierarchy with binned SAH" << std::endl;
+  TestCellLocator(locatorBIH, viskores::Id3(8), 512);  // 3D dataset
+  TestCellLocator(locatorBIH, viskores::Id2(18), 512); // 2D dataset
+  TestFindAllCells(locatorBIH);
+
+  TestLoadedBoundingIntervalHierarchy();
 }
 
 int UnitTestCellLocatorUnstructured(int argc, char* argv[])
@@ -0,0 +1,197 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/RuntimeDeviceTracker.h>
+#include <viskores/cont/internal/DeviceAdapterMemoryManager.h>
+#include <viskores/cont/internal/HostMemoryPool.h>
+
+#include <viskores/cont/testing/Testing.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+using viskores::cont::internal::HostMemoryPool;
+
+constexpr viskores::Id ARRAY_SIZE = 1000;
+
+void TestReuse()
+{
+  std::cout << "Reuse freed blocks" << std::endl;
+  HostMemoryPool& pool = HostMemoryPool::GetInstance();
+  pool.ResetStatistics();
+
+  void* firstPointer;
+  {
+    viskores::cont::internal::BufferInfo buffer =
+      viskores::cont::internal::AllocateOnHost(ARRAY_SIZE);
+    firstPointer = buffer.GetPointer();
+    VISKORES_TEST_ASSERT(firstPointer != nullptr);
+  }
+  VISKORES_TEST_ASSERT(pool.GetStatistics().Misses == 1);
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld >= ARRAY_SIZE);
+
+  {
+    // A slightly smaller request is in the same size class.
+    viskores::cont::internal::BufferInfo buffer =
+      viskores::cont::internal::AllocateOnHost(ARRAY_SIZE - 10);
+    VISKORES_TEST_ASSERT(buffer.GetPointer() == firstPointer, "Block not reused");
+  }
+  VISKORES_TEST_ASSERT(pool.GetStatistics().Hits == 1);
+
+  std::cout << "Reallocate" << std::endl;
+  {
+    viskores::cont::internal::BufferInfo buffer =
+      viskores::cont::internal::AllocateOnHost(ARRAY_SIZE);
+    char* data = static_cast<char*>(buffer.GetPointer());
+    for (viskores::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+      data[index] = static_cast<char>(index % 127);
+    }
+    buffer.Reallocate(ARRAY_SIZE * 10);
+    VISKORES_TEST_ASSERT(buffer.GetSize() == ARRAY_SIZE * 10);
+    data = static_cast<char*>(buffer.GetPointer());
+    for (viskores::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+      VISKORES_TEST_ASSERT(data[index] == static_cast<char>(index % 127), "Data lost");
+    }
+  }
+
+  std::cout << "Use with ArrayHandle" << std::endl;
+  {
+    viskores::cont::ArrayHandle<viskores::Id> array;
+    array.Allocate(ARRAY_SIZE);
+    SetPortal(array.WritePortal());
+    CheckPortal(array.ReadPortal());
+    array.Allocate(ARRAY_SIZE * 2, viskores::CopyFlag::On);
+    auto portal = array.ReadPortal();
+    for (viskores::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+      VISKORES_TEST_ASSERT(test_equal(portal.Get(index), TestValue(index, viskores::Id{})));
+    }
+  }
+}
+
+void TestHighWaterMark()
+{
+  std::cout << "High water mark" << std::endl;
+  HostMemoryPool& pool = HostMemoryPool::GetInstance();
+  pool.ReleaseCachedMemory();
+  pool.SetMaximumHeldBytes(4096);
+
+  VISKORES_TEST_ASSERT(!pool.CanPool(8192), "Allocation larger than cap should not be pooled");
+  {
+    viskores::cont::internal::BufferInfo buffer1 = viskores::cont::internal::AllocateOnHost(3000);
+    viskores::cont::internal::BufferInfo buffer2 = viskores::cont::internal::AllocateOnHost(3000);
+  }
+  // Only one of the blocks fits under the cap.
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld <= 4096);
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld > 0);
+
+  pool.SetMaximumHeldBytes(viskores::BufferSizeType{ 1 } << 30);
+}
+
+void TestThreadFriendly()
+{
+  std::cout << "Thread-local caches" << std::endl;
+  HostMemoryPool& pool = HostMemoryPool::GetInstance();
+  pool.ReleaseCachedMemory();
+
+  auto worker = []()
+  {
+    viskores::cont::GetRuntimeDeviceTracker().SetThreadFriendlyMemAlloc(true);
+    for (int iteration = 0; iteration < 100; ++iteration)
+    {
+      viskores::cont::ArrayHandle<viskores::Float32> array;
+      array.Allocate(ARRAY_SIZE);
+      SetPortal(array.WritePortal());
+      CheckPortal(array.ReadPortal());
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  // Memory cached by the threads is given back to the pool when they exit.
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld > 0);
+  pool.ReleaseCachedMemory();
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld == 0);
+
+  std::cout << "Release caches of running threads" << std::endl;
+  std::mutex lock;
+  std::condition_variable changed;
+  bool cached = false;
+  bool released = false;
+  std::thread thread(
+    [&]()
+    {
+      viskores::cont::GetRuntimeDeviceTracker().SetThreadFriendlyMemAlloc(true);
+      {
+        viskores::cont::internal::BufferInfo buffer =
+          viskores::cont::internal::AllocateOnHost(ARRAY_SIZE);
+      }
+      std::unique_lock<std::mutex> threadLock(lock);
+      cached = true;
+      changed.notify_all();
+      // Keep the thread, and so its cache, alive until the pool has been released.
+      changed.wait(threadLock, [&]() { return released; });
+    });
+  {
+    std::unique_lock<std::mutex> mainLock(lock);
+    changed.wait(mainLock, [&]() { return cached; });
+  }
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld > 0);
+  pool.ReleaseCachedMemory();
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld == 0, "Cache of other thread not released");
+  {
+    std::lock_guard<std::mutex> mainLock(lock);
+    released = true;
+    changed.notify_all();
+  }
+  thread.join();
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld == 0);
+}
+
+void TestHostMemoryPool()
+{
+  HostMemoryPool& pool = HostMemoryPool::GetInstance();
+  bool wasEnabled = pool.GetEnabled();
+  pool.SetEnabled(true);
+
+  TestReuse();
+  TestHighWaterMark();
+  TestThreadFriendly();
+
+  std::cout << "Disable" << std::endl;
+  viskores::cont::internal::BufferInfo outstanding = viskores::cont::internal::AllocateOnHost(100);
+  pool.SetEnabled(false);
+  VISKORES_TEST_ASSERT(!pool.CanPool(100));
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld == 0);
+  // Freeing a pooled block after the pool is disabled returns it to the system.
+  outstanding = viskores::cont::internal::BufferInfo{};
+  VISKORES_TEST_ASSERT(pool.GetStatistics().BytesHeld == 0);
+
+  pool.SetEnabled(wasEnabled);
+}
+
+} // anonymous namespace
+
+int UnitTestHostMemoryPool(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestHostMemoryPool, argc, argv);
+}
@@ -0,0 +1,144 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/LocatorCache.h>
+
+#include <viskores/cont/CellLocatorBoundingIntervalHierarchy.h>
+#include <viskores/cont/CellLocatorTwoLevel.h>
+#include <viskores/cont/Invoker.h>
+#include <viskores/cont/PointLocatorSparseGrid.h>
+#include <viskores/cont/testing/MakeTestDataSet.h>
+#include <viskores/cont/testing/Testing.h>
+#include <viskores/worklet/WorkletMapField.h>
+
+namespace
+{
+
+struct FindCellWorklet : viskores::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn point, ExecObject locator, FieldOut cellId);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename LocatorType>
+  VISKORES_EXEC void operator()(const viskores::Vec3f& point,
+                                const LocatorType& locator,
+                                viskores::Id& cellId) const
+  {
+    viskores::Vec3f pcoords;
+    locator.FindCell(point, cellId, pcoords);
+  }
+};
+
+viskores::Id FindCell(const viskores::cont::CellLocatorTwoLevel& locator,
+                      const viskores::Vec3f& point)
+{
+  viskores::cont::ArrayHandle<viskores::Id> cellIds;
+  viskores::cont::Invoker invoke;
+  invoke(FindCellWorklet{}, viskores::cont::make_ArrayHandle({ point }), locator, cellIds);
+  return cellIds.ReadPortal().Get(0);
+}
+
+void TestCellLocators()
+{
+  std::cout << "Test cell locators." << std::endl;
+  viskores::cont::testing::MakeTestDataSet makeData;
+  viskores::cont::DataSet dataSet = makeData.Make3DExplicitDataSet5();
+  viskores::cont::LocatorCache cache;
+
+  auto locator = cache.GetCellLocator<viskores::cont::CellLocatorTwoLevel>(
+    dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 1);
+  const viskores::Vec3f point(0.5f, 0.5f, 0.5f);
+  const viskores::Id cellId = FindCell(locator, point);
+  VISKORES_TEST_ASSERT(cellId >= 0, "Point not found.");
+
+  std::cout << "  Same geometry." << std::endl;
+  // A copy of the data set shares the cell set and coordinates.
+  viskores::cont::DataSet copy = dataSet;
+  locator = cache.GetCellLocator<viskores::cont::CellLocatorTwoLevel>(
+    copy.GetCellSet(), copy.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 1, "Locator was rebuilt.");
+  VISKORES_TEST_ASSERT(FindCell(locator, point) == cellId);
+
+  // Copies of the cache share the locators.
+  viskores::cont::LocatorCache cacheCopy = cache;
+  cacheCopy.GetCellLocator<viskores::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(),
+                                                                dataSet.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 1, "Locator was rebuilt.");
+
+  std::cout << "  Different locator type." << std::endl;
+  cache.GetCellLocator<viskores::cont::CellLocatorBoundingIntervalHierarchy>(
+    dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 2);
+  VISKORES_TEST_ASSERT(cache.GetNumberOfLocators() == 2);
+
+  std::cout << "  Modified coordinates." << std::endl;
+  viskores::cont::ArrayHandle<viskores::Vec3f_32> coords;
+  dataSet.GetCoordinateSystem().GetData().AsArrayHandle(coords);
+  {
+    auto portal = coords.WritePortal();
+    for (viskores::Id index = 0; index < portal.GetNumberOfValues(); ++index)
+    {
+      portal.Set(index, portal.Get(index) + viskores::Vec3f_32(10, 0, 0));
+    }
+  }
+  locator = cache.GetCellLocator<viskores::cont::CellLocatorTwoLevel>(
+    dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 3, "Locator was not rebuilt.");
+  VISKORES_TEST_ASSERT(cache.GetNumberOfLocators() == 2, "Stale locator was kept.");
+  VISKORES_TEST_ASSERT(FindCell(locator, point) == -1);
+  VISKORES_TEST_ASSERT(FindCell(locator, point + viskores::Vec3f(10, 0, 0)) == cellId);
+
+  std::cout << "  Different cell set." << std::endl;
+  viskores::cont::DataSet other = makeData.Make3DExplicitDataSet5();
+  cache.GetCellLocator<viskores::cont::CellLocatorTwoLevel>(other.GetCellSet(),
+                                                            other.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 4);
+  VISKORES_TEST_ASSERT(cache.GetNumberOfLocators() == 3);
+
+  std::cout << "  Capacity." << std::endl;
+  cache.SetCapacity(1);
+  VISKORES_TEST_ASSERT(cache.GetNumberOfLocators() == 1);
+  cache.GetCellLocator<viskores::cont::CellLocatorTwoLevel>(other.GetCellSet(),
+                                                            other.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 4, "Most recent locator was dropped.");
+
+  cache.Clear();
+  VISKORES_TEST_ASSERT(cache.GetNumberOfLocators() == 0);
+}
+
+void TestPointLocators()
+{
+  std::cout << "Test point locators." << std::endl;
+  viskores::cont::testing::MakeTestDataSet makeData;
+  viskores::cont::DataSet dataSet = makeData.Make3DExplicitDataSet5();
+  viskores::cont::LocatorCache cache;
+
+  cache.GetPointLocator<viskores::cont::PointLocatorSparseGrid>(dataSet.GetCoordinateSystem());
+  cache.GetPointLocator<viskores::cont::PointLocatorSparseGrid>(dataSet.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 1, "Locator was rebuilt.");
+
+  viskores::cont::ArrayHandle<viskores::Vec3f_32> coords;
+  dataSet.GetCoordinateSystem().GetData().AsArrayHandle(coords);
+  coords.WritePortal().Set(0, viskores::Vec3f_32(0, 0, 0));
+  cache.GetPointLocator<viskores::cont::PointLocatorSparseGrid>(dataSet.GetCoordinateSystem());
+  VISKORES_TEST_ASSERT(cache.GetNumberOfBuilds() == 2, "Locator was not rebuilt.");
+}
+
+void TestLocatorCache()
+{
+  TestCellLocators();
+  TestPointLocators();
+}
+
+} // anonymous namespace
+
+int UnitTestLocatorCache(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestLocatorCache, argc, argv);
+}
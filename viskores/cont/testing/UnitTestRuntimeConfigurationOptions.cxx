@@ -201,11 +201,15 @@ void TestConfigOptionValues(const internal::RuntimeDeviceConfigurationOptions& c
   VISKORES_TEST_ASSERT(configOptions.ViskoresNumThreads.IsSet(), "num threads should be set");
   VISKORES_TEST_ASSERT(configOptions.ViskoresDeviceInstance.IsSet(),
                        "device instance should be set");
+  VISKORES_TEST_ASSERT(configOptions.ViskoresHostMemoryPool.IsSet(),
+                       "host memory pool should be set");
 
   VISKORES_TEST_ASSERT(configOptions.ViskoresNumThreads.GetValue() == 100,
                        "num threads should == 100");
   VISKORES_TEST_ASSERT(configOptions.ViskoresDeviceInstance.GetValue() == 1,
                        "device instance should == 1");
+  VISKORES_TEST_ASSERT(configOptions.ViskoresHostMemoryPool.GetValue() == 64,
+                       "host memory pool should == 64");
 }
 
 void TestRuntimeDeviceConfigurationOptions()
@@ -224,8 +228,14 @@ void TestRuntimeDeviceConfigurationOptions()
 
     int argc;
     char** argv;
-    viskores::cont::testing::Testing::MakeArgs(
-      argc, argv, "--viskores-num-threads", "100", "--viskores-device-instance", "1");
+    viskores::cont::testing::Testing::MakeArgs(argc,
+                                               argv,
+                                               "--viskores-num-threads",
+                                               "100",
+                                               "--viskores-device-instance",
+                                               "1",
+                                               "--viskores-host-memory-pool",
+                                               "64");
     auto options = GetOptions(argc, argv, usage);
 
     VISKORES_TEST_ASSERT(!configOptions.IsInitialized(),
@@ -237,8 +247,14 @@ void TestRuntimeDeviceConfigurationOptions()
   {
     int argc;
     char** argv;
-    viskores::cont::testing::Testing::MakeArgs(
-      argc, argv, "--viskores-num-threads", "100", "--viskores-device-instance", "1");
+    viskores::cont::testing::Testing::MakeArgs(argc,
+                                               argv,
+                                               "--viskores-num-threads",
+                                               "100",
+                                               "--viskores-device-instance",
+                                               "1",
+                                               "--viskores-host-memory-pool",
+                                               "64");
     internal::RuntimeDeviceConfigurationOptions configOptions(argc, argv);
     TestConfigOptionValues(configOptions);
   }
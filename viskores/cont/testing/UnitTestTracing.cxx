@@ -0,0 +1,131 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/Invoker.h>
+#include <viskores/cont/Tracing.h>
+#include <viskores/worklet/WorkletMapField.h>
+
+#include <viskores/cont/testing/Testing.h>
+
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+struct TracedWorklet : viskores::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+
+  VISKORES_EXEC void operator()(viskores::Id in, viskores::Id& out) const { out = 2 * in; }
+};
+
+void RunWorklet()
+{
+  viskores::cont::ArrayHandle<viskores::Id> input =
+    viskores::cont::make_ArrayHandle<viskores::Id>({ 1, 2, 3, 4, 5 });
+  viskores::cont::ArrayHandle<viskores::Id> output;
+  viskores::cont::Invoker invoke;
+  invoke(TracedWorklet{}, input, output);
+  VISKORES_TEST_ASSERT(output.ReadPortal().Get(4) == 10);
+}
+
+void TestDisabled()
+{
+  std::cout << "Tracing disabled" << std::endl;
+  viskores::cont::StopTracing();
+  viskores::cont::ClearTrace();
+  VISKORES_TEST_ASSERT(!viskores::cont::IsTracingEnabled());
+
+  RunWorklet();
+  {
+    viskores::cont::TraceScope trace("test", "unrecorded");
+    VISKORES_TEST_ASSERT(!trace.IsActive());
+  }
+  VISKORES_TEST_ASSERT(viskores::cont::GetNumberOfTraceEvents() == 0);
+}
+
+void TestWorkletEvents()
+{
+  std::cout << "Worklet events" << std::endl;
+  viskores::cont::ClearTrace();
+  viskores::cont::StartTracing();
+  RunWorklet();
+  viskores::cont::StopTracing();
+  VISKORES_TEST_ASSERT(viskores::cont::GetNumberOfTraceEvents() >= 1);
+
+  std::ostringstream trace;
+  viskores::cont::WriteTrace(trace);
+  std::string json = trace.str();
+  std::cout << json << std::endl;
+  VISKORES_TEST_ASSERT(json.find("\"traceEvents\"") != std::string::npos);
+  VISKORES_TEST_ASSERT(json.find("TracedWorklet") != std::string::npos);
+  VISKORES_TEST_ASSERT(json.find("\"cat\":\"worklet\"") != std::string::npos);
+  VISKORES_TEST_ASSERT(json.find("\"input_size\":5") != std::string::npos);
+  VISKORES_TEST_ASSERT(json.find("\"thread_name\"") != std::string::npos);
+
+  // Events recorded after stopping are dropped.
+  viskores::Id numEvents = viskores::cont::GetNumberOfTraceEvents();
+  RunWorklet();
+  VISKORES_TEST_ASSERT(viskores::cont::GetNumberOfTraceEvents() == numEvents);
+}
+
+void TestCustomScopes()
+{
+  std::cout << "Custom scopes" << std::endl;
+  viskores::cont::ClearTrace();
+  viskores::cont::StartTracing();
+  {
+    viskores::cont::TraceScope outer("test", "outer \"quoted\"");
+    VISKORES_TEST_ASSERT(outer.IsActive());
+    outer.AddArg("count", viskores::Int64{ 42 });
+    outer.AddArg("label", "a\\b");
+
+    std::thread worker(
+      []()
+      {
+        viskores::cont::TraceScope inner("test", "inner");
+        inner.AddArg("index", viskores::Int32{ 7 });
+      });
+    worker.join();
+
+    viskores::cont::TraceScope discarded("test", "discarded");
+    discarded.Discard();
+  }
+  viskores::cont::StopTracing();
+  VISKORES_TEST_ASSERT(viskores::cont::GetNumberOfTraceEvents() == 2);
+
+  std::ostringstream trace;
+  viskores::cont::WriteTrace(trace);
+  std::string json = trace.str();
+  std::cout << json << std::endl;
+  VISKORES_TEST_ASSERT(json.find(R"("name":"outer \"quoted\"")") != std::string::npos);
+  VISKORES_TEST_ASSERT(json.find(R"("args":{"count":42,"label":"a\\b"})") != std::string::npos);
+  VISKORES_TEST_ASSERT(json.find(R"("args":{"index":7})") != std::string::npos);
+  VISKORES_TEST_ASSERT(json.find("discarded") == std::string::npos);
+  // The worker thread gets its own track.
+  VISKORES_TEST_ASSERT(json.find("thread_name") != json.rfind("thread_name"));
+
+  viskores::cont::ClearTrace();
+  VISKORES_TEST_ASSERT(viskores::cont::GetNumberOfTraceEvents() == 0);
+}
+
+void TestTracing()
+{
+  TestDisabled();
+  TestWorkletEvents();
+  TestCustomScopes();
+}
+
+} // anonymous namespace
+
+int UnitTestTracing(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestTracing, argc, argv);
+}
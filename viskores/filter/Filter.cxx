@@ -15,43 +15,18 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
-#include <viskores/cont/Algorithm.h>
 #include <viskores/cont/Logging.h>
 #include <viskores/cont/RuntimeDeviceTracker.h>
+#include <viskores/cont/Tracing.h>
 
 #include <viskores/filter/Filter.h>
-#include <viskores/filter/TaskQueue.h>
-
-#include <future>
+#include <viskores/filter/PartitionScheduler.h>
 
 namespace viskores
 {
 namespace filter
 {
 
-namespace
-{
-void RunFilter(Filter* self,
-               viskores::filter::DataSetQueue& input,
-               viskores::filter::DataSetQueue& output)
-{
-  auto& tracker = viskores::cont::GetRuntimeDeviceTracker();
-  bool prevVal = tracker.GetThreadFriendlyMemAlloc();
-  tracker.SetThreadFriendlyMemAlloc(true);
-
-  std::pair<viskores::Id, viskores::cont::DataSet> task;
-  while (input.GetTask(task))
-  {
-    auto outDS = self->Execute(task.second);
-    output.Push(std::make_pair(task.first, std::move(outDS)));
-  }
-
-  viskores::cont::Algorithm::Synchronize();
-  tracker.SetThreadFriendlyMemAlloc(prevVal);
-}
-
-} // anonymous namespace
-
 Filter::Filter()
 {
   this->SetActiveCoordinateSystem(0);
@@ -107,49 +82,38 @@ void Filter::SetFieldsToPass(const std::string& fieldname,
 viskores::cont::PartitionedDataSet Filter::DoExecutePartitions(
   const viskores::cont::PartitionedDataSet& input)
 {
-  viskores::cont::PartitionedDataSet output;
-
   const bool runMultiThreaded = this->GetRunMultiThreadedFilter();
   const viskores::Id numThreads =
     runMultiThreaded ? this->DetermineNumberOfThreads(input) : viskores::Id{ 1 };
 
-  if (numThreads > 1)
-  {
-    viskores::filter::DataSetQueue inputQueue(input);
-    viskores::filter::DataSetQueue outputQueue;
-    viskores::cont::ScopedRuntimeDeviceTracker tracker;
-    tracker.DisableDevice(viskores::cont::DeviceAdapterTagOpenMP{});
-    tracker.DisableDevice(viskores::cont::DeviceAdapterTagTBB{});
-
-    //Run 'numThreads' filters.
-    std::vector<std::future<void>> futures(static_cast<std::size_t>(numThreads));
-    for (std::size_t i = 0; i < static_cast<std::size_t>(numThreads); i++)
+  // The scheduler runs the partitions inline when only one thread is requested.
+  std::vector<viskores::cont::DataSet> outputPartitions(input.GetPartitions().size());
+  viskores::filter::PartitionScheduler::GetGlobalScheduler().Execute(
+    input.GetNumberOfPartitions(),
+    numThreads,
+    [&](viskores::Id index)
     {
-      auto f = std::async(
-        std::launch::async, RunFilter, this, std::ref(inputQueue), std::ref(outputQueue));
-      futures[i] = std::move(f);
-    }
+      outputPartitions[static_cast<std::size_t>(index)] =
+        this->Execute(input.GetPartition(index));
+    },
+    this->PartitionTimings);
 
-    for (auto& f : futures)
-      f.get();
-
-    //Get results from the outputQueue.
-    output = outputQueue.Get();
-  }
-  else
-  {
-    for (const auto& inBlock : input)
-    {
-      viskores::cont::DataSet outBlock = this->Execute(inBlock);
-      output.AppendPartition(outBlock);
-    }
-  }
+  viskores::cont::PartitionedDataSet output;
+  output.AppendPartitions(outputPartitions);
 
   return this->CreateResult(input, output);
 }
 
 viskores::cont::DataSet Filter::Execute(const viskores::cont::DataSet& input)
 {
+  viskores::cont::TraceScope trace("filter");
+  if (trace.IsActive())
+  {
+    trace.SetName(viskores::cont::TypeToString(typeid(*this)));
+    trace.AddArg("points", input.GetNumberOfPoints());
+    trace.AddArg("cells", input.GetNumberOfCells());
+  }
+
   return this->DoExecute(input);
 }
 
@@ -159,6 +123,12 @@ viskores::cont::PartitionedDataSet Filter::Execute(const viskores::cont::Partiti
                      "Filter (%d partitions): '%s'",
                      (int)input.GetNumberOfPartitions(),
                      viskores::cont::TypeToString<decltype(*this)>().c_str());
+  viskores::cont::TraceScope trace("filter");
+  if (trace.IsActive())
+  {
+    trace.SetName(viskores::cont::TypeToString(typeid(*this)));
+    trace.AddArg("partitions", input.GetNumberOfPartitions());
+  }
 
   return this->DoExecutePartitions(input);
 }
@@ -200,8 +170,9 @@ viskores::Id Filter::DetermineNumberOfThreads(const viskores::cont::PartitionedD
   if (tracker.CanRunOn(viskores::cont::DeviceAdapterTagOpenMP{}) ||
       tracker.CanRunOn(viskores::cont::DeviceAdapterTagTBB{}))
   {
-    // Filter-level threading should not layer on top of OpenMP or TBB execution.
-    availThreads = 1;
+    // The PartitionScheduler divides the device threads among the partition workers, so
+    // filter-level threading can layer on top of OpenMP or TBB execution.
+    availThreads = this->NumThreadsPerCPU;
   }
   else if (tracker.CanRunOn(viskores::cont::DeviceAdapterTagCuda{}))
     availThreads = this->NumThreadsPerGPU;
@@ -27,6 +27,7 @@
 #include <viskores/cont/PartitionedDataSet.h>
 
 #include <viskores/filter/FieldSelection.h>
+#include <viskores/filter/PartitionScheduler.h>
 #include <viskores/filter/TaskQueue.h>
 #include <viskores/filter/viskores_filter_core_export.h>
 
@@ -161,13 +162,15 @@ namespace filter
 ///
 /// _FilterThreadScheduling DoExecute_
 ///
-/// The default multi-threaded execution of `Execute(PartitionedDataSet&)` uses a simple FIFO queue
-/// of DataSet and pool of *worker* threads. Implementation of Filter subclass can override the
-/// `DoExecutePartitions(PartitionedDataSet)` virtual method to provide implementation specific
-/// scheduling policy. The default number of *worker* threads in the pool are determined by the
-/// `DetermineNumberOfThreads()` virtual method using several backend dependent heuristic.
-/// Implementations of Filter subclass can also override
-/// `DetermineNumberOfThreads()` to provide implementation specific heuristic.
+/// The default multi-threaded execution of `Execute(PartitionedDataSet&)` runs the partitions on
+/// the `viskores::filter::PartitionScheduler` shared by all filters, a persistent work-stealing
+/// pool of *worker* threads that cooperates with the TBB and OpenMP devices. Implementation of
+/// Filter subclass can override the `DoExecutePartitions(PartitionedDataSet)` virtual method to
+/// provide implementation specific scheduling policy. The number of *worker* threads used for a
+/// filter is determined by the `DetermineNumberOfThreads()` virtual method using several backend
+/// dependent heuristic. Implementations of Filter subclass can also override
+/// `DetermineNumberOfThreads()` to provide implementation specific heuristic. The time spent on
+/// each partition during the last execution is available from `GetPartitionTimings()`.
 ///
 class VISKORES_FILTER_CORE_EXPORT Filter
 {
@@ -391,6 +394,15 @@ public:
     }
   }
 
+  /// @brief Returns the time spent on each partition during the last execution.
+  ///
+  /// The timings are filled by `Execute(PartitionedDataSet&)` and are indexed by partition.
+  /// Filters that override `DoExecutePartitions()` may not provide timings.
+  VISKORES_CONT const std::vector<viskores::filter::PartitionTiming>& GetPartitionTimings() const
+  {
+    return this->PartitionTimings;
+  }
+
   // FIXME: Is this actually materialize? Are there different kinds of Invoker?
   /// Specify the viskores::cont::Invoker to be used to execute worklets by
   /// this filter instance. Overriding the default allows callers to control
@@ -873,6 +885,7 @@ private:
   bool RunFilterWithMultipleThreads = false;
   viskores::Id NumThreadsPerGPU = 8;
   viskores::Id NumThreadsPerCPU = 4;
+  std::vector<viskores::filter::PartitionTiming> PartitionTimings;
 
   std::string OutputFieldName;
 
@@ -0,0 +1,331 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/Algorithm.h>
+#include <viskores/cont/Logging.h>
+#include <viskores/cont/RuntimeDeviceInformation.h>
+#include <viskores/cont/RuntimeDeviceTracker.h>
+
+#include <viskores/filter/PartitionScheduler.h>
+
+#ifdef VISKORES_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace viskores
+{
+namespace filter
+{
+
+namespace
+{
+
+thread_local bool IsPartitionSchedulerWorker = false;
+
+struct PartitionWorkQueue
+{
+  std::mutex Lock;
+  std::deque<viskores::Id> Tasks;
+
+  bool PopFront(viskores::Id& index)
+  {
+    std::lock_guard<std::mutex> lock(this->Lock);
+    if (this->Tasks.empty())
+    {
+      return false;
+    }
+    index = this->Tasks.front();
+    this->Tasks.pop_front();
+    return true;
+  }
+
+  bool StealBack(viskores::Id& index)
+  {
+    std::lock_guard<std::mutex> lock(this->Lock);
+    if (this->Tasks.empty())
+    {
+      return false;
+    }
+    index = this->Tasks.back();
+    this->Tasks.pop_back();
+    return true;
+  }
+};
+
+struct PartitionBatch
+{
+  const viskores::filter::PartitionScheduler::TaskType* Task = nullptr;
+  const viskores::cont::RuntimeDeviceTracker* CallerTracker = nullptr;
+  std::vector<viskores::filter::PartitionTiming>* Timings = nullptr;
+  viskores::Id NumberOfWorkers = 0;
+  viskores::Id DeviceThreadsPerWorker = 0;
+
+  std::vector<PartitionWorkQueue> Queues;
+  std::atomic<viskores::Id> ActiveWorkers{ 0 };
+  std::atomic<bool> Failed{ false };
+  std::mutex ErrorLock;
+  std::exception_ptr Error;
+
+  explicit PartitionBatch(std::size_t numQueues)
+    : Queues(numQueues)
+  {
+  }
+
+  bool NextTask(std::size_t workerIndex, viskores::Id& index)
+  {
+    if (this->Queues[workerIndex].PopFront(index))
+    {
+      return true;
+    }
+    // Own queue is empty. Steal from the other workers, starting with the next one over.
+    const std::size_t numQueues = this->Queues.size();
+    for (std::size_t offset = 1; offset < numQueues; ++offset)
+    {
+      if (this->Queues[(workerIndex + offset) % numQueues].StealBack(index))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+viskores::Float64 RunPartitionTask(const viskores::filter::PartitionScheduler::TaskType& task,
+                                   viskores::Id index)
+{
+  auto start = std::chrono::steady_clock::now();
+  task(index);
+  viskores::cont::Algorithm::Synchronize();
+  std::chrono::duration<viskores::Float64> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+} // anonymous namespace
+
+struct PartitionScheduler::InternalsType
+{
+  // Only one batch runs on the workers at a time.
+  std::mutex SubmitLock;
+
+  std::mutex Lock;
+  std::condition_variable WakeWorkers;
+  std::condition_variable BatchDone;
+  std::vector<std::thread> Workers;
+  std::shared_ptr<PartitionBatch> CurrentBatch;
+  std::uint64_t Generation = 0;
+  bool Shutdown = false;
+
+  void WorkerLoop(std::size_t workerIndex, std::uint64_t seenGeneration)
+  {
+    IsPartitionSchedulerWorker = true;
+
+    while (true)
+    {
+      std::shared_ptr<PartitionBatch> batch;
+      {
+        std::unique_lock<std::mutex> lock(this->Lock);
+        this->WakeWorkers.wait(
+          lock, [&]() { return this->Shutdown || (this->Generation != seenGeneration); });
+        if (this->Shutdown)
+        {
+          return;
+        }
+        seenGeneration = this->Generation;
+        batch = this->CurrentBatch;
+      }
+
+      // A worker that is not part of the batch may not get the lock until the batch has
+      // finished and been cleared, so the batch may already be gone.
+      if (!batch || (static_cast<viskores::Id>(workerIndex) >= batch->NumberOfWorkers))
+      {
+        continue;
+      }
+
+      this->RunBatch(*batch, workerIndex);
+
+      if (--batch->ActiveWorkers == 0)
+      {
+        std::lock_guard<std::mutex> lock(this->Lock);
+        this->BatchDone.notify_all();
+      }
+    }
+  }
+
+  void RunBatch(PartitionBatch& batch, std::size_t workerIndex)
+  {
+    // Worker threads are long lived, so each batch brings the device state of the thread that
+    // submitted it. The submitting thread is blocked until the batch finishes, so reading its
+    // tracker here is safe.
+    auto& tracker = viskores::cont::GetRuntimeDeviceTracker();
+    tracker.CopyStateFrom(*batch.CallerTracker);
+    tracker.SetThreadFriendlyMemAlloc(true);
+
+#ifdef VISKORES_ENABLE_OPENMP
+    // The number of threads for an OpenMP parallel region is a per-thread setting, so this only
+    // limits the teams started by this worker.
+    omp_set_num_threads(static_cast<int>(batch.DeviceThreadsPerWorker));
+#endif
+
+    viskores::Id index;
+    while (batch.NextTask(workerIndex, index))
+    {
+      if (batch.Failed)
+      {
+        continue;
+      }
+      try
+      {
+        viskores::Float64 elapsed = RunPartitionTask(*batch.Task, index);
+        auto& timing = (*batch.Timings)[static_cast<std::size_t>(index)];
+        timing.PartitionIndex = index;
+        timing.WorkerIndex = static_cast<viskores::Id>(workerIndex);
+        timing.ElapsedTime = elapsed;
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(batch.ErrorLock);
+        if (!batch.Error)
+        {
+          batch.Error = std::current_exception();
+        }
+        batch.Failed = true;
+      }
+    }
+  }
+
+  void EnsureWorkers(std::size_t numWorkers)
+  {
+    std::lock_guard<std::mutex> lock(this->Lock);
+    while (this->Workers.size() < numWorkers)
+    {
+      // Capture the generation while locked so that a worker that starts late does not miss
+      // the batch that is about to be submitted.
+      std::size_t workerIndex = this->Workers.size();
+      std::uint64_t generation = this->Generation;
+      this->Workers.emplace_back([this, workerIndex, generation]()
+                                 { this->WorkerLoop(workerIndex, generation); });
+    }
+  }
+};
+
+PartitionScheduler& PartitionScheduler::GetGlobalScheduler()
+{
+  static PartitionScheduler scheduler;
+  return scheduler;
+}
+
+bool PartitionScheduler::InWorkerThread()
+{
+  return IsPartitionSchedulerWorker;
+}
+
+PartitionScheduler::PartitionScheduler()
+  : Internals(new InternalsType)
+{
+}
+
+PartitionScheduler::~PartitionScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Lock);
+    this->Internals->Shutdown = true;
+    this->Internals->WakeWorkers.notify_all();
+  }
+  for (auto& worker : this->Internals->Workers)
+  {
+    worker.join();
+  }
+}
+
+viskores::Id PartitionScheduler::GetNumberOfWorkers() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Lock);
+  return static_cast<viskores::Id>(this->Internals->Workers.size());
+}
+
+void PartitionScheduler::Execute(viskores::Id numberOfTasks,
+                                 viskores::Id maxConcurrency,
+                                 const TaskType& task)
+{
+  std::vector<viskores::filter::PartitionTiming> timings;
+  this->Execute(numberOfTasks, maxConcurrency, task, timings);
+}
+
+void PartitionScheduler::Execute(viskores::Id numberOfTasks,
+                                 viskores::Id maxConcurrency,
+                                 const TaskType& task,
+                                 std::vector<viskores::filter::PartitionTiming>& timings)
+{
+  timings.assign(static_cast<std::size_t>(numberOfTasks), viskores::filter::PartitionTiming{});
+
+  const viskores::Id numWorkers = std::min(numberOfTasks, maxConcurrency);
+  if ((numWorkers <= 1) || InWorkerThread())
+  {
+    for (viskores::Id index = 0; index < numberOfTasks; ++index)
+    {
+      auto& timing = timings[static_cast<std::size_t>(index)];
+      timing.PartitionIndex = index;
+      timing.ElapsedTime = RunPartitionTask(task, index);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> submitLock(this->Internals->SubmitLock);
+  this->Internals->EnsureWorkers(static_cast<std::size_t>(numWorkers));
+
+  auto batch = std::make_shared<PartitionBatch>(static_cast<std::size_t>(numWorkers));
+  batch->Task = &task;
+  batch->CallerTracker = &viskores::cont::GetRuntimeDeviceTracker();
+  batch->Timings = &timings;
+  batch->NumberOfWorkers = numWorkers;
+  batch->ActiveWorkers = numWorkers;
+  batch->DeviceThreadsPerWorker = 1;
+#ifdef VISKORES_ENABLE_OPENMP
+  {
+    viskores::Id ompThreads = 1;
+    viskores::cont::RuntimeDeviceInformation{}
+      .GetRuntimeConfiguration(viskores::cont::DeviceAdapterTagOpenMP{})
+      .GetThreads(ompThreads);
+    batch->DeviceThreadsPerWorker = std::max(viskores::Id{ 1 }, ompThreads / numWorkers);
+  }
+#endif
+  for (viskores::Id index = 0; index < numberOfTasks; ++index)
+  {
+    batch->Queues[static_cast<std::size_t>(index % numWorkers)].Tasks.push_back(index);
+  }
+
+  VISKORES_LOG_F(viskores::cont::LogLevel::Perf,
+                 "PartitionScheduler running %lld partitions on %lld workers",
+                 static_cast<long long>(numberOfTasks),
+                 static_cast<long long>(numWorkers));
+
+  {
+    std::unique_lock<std::mutex> lock(this->Internals->Lock);
+    this->Internals->CurrentBatch = batch;
+    ++this->Internals->Generation;
+    this->Internals->WakeWorkers.notify_all();
+    this->Internals->BatchDone.wait(lock, [&]() { return batch->ActiveWorkers == 0; });
+    this->Internals->CurrentBatch.reset();
+  }
+
+  if (batch->Error)
+  {
+    std::rethrow_exception(batch->Error);
+  }
+}
+
+}
+} // namespace viskores::filter
@@ -0,0 +1,105 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_filter_PartitionScheduler_h
+#define viskores_filter_PartitionScheduler_h
+
+#include <viskores/Types.h>
+
+#include <viskores/filter/viskores_filter_core_export.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace viskores
+{
+namespace filter
+{
+
+/// @brief Timing information for a single partition run by a `PartitionScheduler`.
+struct PartitionTiming
+{
+  /// The index of the partition (task) in the batch.
+  viskores::Id PartitionIndex = -1;
+  /// The index of the scheduler worker that ran the partition. Partitions run inline on the
+  /// calling thread report a worker index of -1.
+  viskores::Id WorkerIndex = -1;
+  /// Wall clock time, in seconds, spent executing the partition.
+  viskores::Float64 ElapsedTime = 0.0;
+};
+
+/// @brief A persistent, work-stealing pool of threads used to run filters on partitions.
+///
+/// `Filter::DoExecutePartitions()` uses the global scheduler (see `GetGlobalScheduler()`)
+/// to execute a filter on the partitions of a `viskores::cont::PartitionedDataSet`
+/// concurrently. The worker threads are created the first time they are needed and are
+/// reused for all subsequent filter executions, so the cost of starting threads is not paid
+/// for every filter in a pipeline.
+///
+/// Each batch of tasks is spread over per-worker queues. A worker takes tasks from the front
+/// of its own queue and, when that is empty, steals from the back of the queues of the other
+/// workers. This balances the load when partitions have very different sizes.
+///
+/// Partition-level threads run alongside the device-level parallelism of the TBB and
+/// OpenMP devices. TBB shares one pool of threads among all callers, so it naturally does not
+/// oversubscribe. For OpenMP, the threads configured for the device are divided among the
+/// active workers.
+///
+/// Tasks that are submitted from within a worker thread (for example, a filter that internally
+/// runs another filter on a `PartitionedDataSet`) are executed inline on the calling thread.
+///
+class VISKORES_FILTER_CORE_EXPORT PartitionScheduler
+{
+public:
+  using TaskType = std::function<void(viskores::Id)>;
+
+  /// @brief Returns the scheduler shared by all filters.
+  VISKORES_CONT static viskores::filter::PartitionScheduler& GetGlobalScheduler();
+
+  /// @brief Returns true if the calling thread is one of the scheduler's worker threads.
+  VISKORES_CONT static bool InWorkerThread();
+
+  VISKORES_CONT PartitionScheduler();
+  VISKORES_CONT ~PartitionScheduler();
+
+  PartitionScheduler(const PartitionScheduler&) = delete;
+  PartitionScheduler& operator=(const PartitionScheduler&) = delete;
+
+  /// @brief Runs `task` for each index in [0, `numberOfTasks`) and waits for completion.
+  ///
+  /// At most `maxConcurrency` tasks are run at the same time. If `maxConcurrency` is 1 or less,
+  /// or if this is called from a worker thread, the tasks are run in order on the calling thread.
+  /// The runtime device tracker state of the calling thread is used for each task.
+  ///
+  /// If any task throws an exception, the remaining tasks that have not started are skipped
+  /// and the first exception is rethrown on the calling thread.
+  ///
+  /// The time spent in each task is returned in `timings`, which is indexed by task.
+  VISKORES_CONT void Execute(viskores::Id numberOfTasks,
+                             viskores::Id maxConcurrency,
+                             const TaskType& task,
+                             std::vector<viskores::filter::PartitionTiming>& timings);
+
+  /// @copydoc Execute
+  VISKORES_CONT void Execute(viskores::Id numberOfTasks,
+                             viskores::Id maxConcurrency,
+                             const TaskType& task);
+
+  /// @brief Returns the number of worker threads that have been created.
+  VISKORES_CONT viskores::Id GetNumberOfWorkers() const;
+
+private:
+  struct InternalsType;
+  std::unique_ptr<InternalsType> Internals;
+};
+
+}
+} // namespace viskores::filter
+
+#endif //viskores_filter_PartitionScheduler_h
@@ -0,0 +1,38 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/filter/contour/AbstractContour.h>
+#include <viskores/filter/contour/worklet/contour/SpanSpace.h>
+
+namespace viskores
+{
+namespace filter
+{
+namespace contour
+{
+
+VISKORES_CONT void AbstractContour::SetUseSpanSpace(bool flag)
+{
+  if (flag)
+  {
+    this->SpanSpaceIndices = std::make_shared<viskores::worklet::contour::SpanSpaceCache>();
+  }
+  else
+  {
+    this->SpanSpaceIndices.reset();
+  }
+}
+
+VISKORES_CONT viskores::Id AbstractContour::GetNumberOfSpanSpaceBuilds() const
+{
+  return this->SpanSpaceIndices ? this->SpanSpaceIndices->GetNumberOfBuilds() : 0;
+}
+
+} // namespace contour
+} // namespace filter
+} // namespace viskores
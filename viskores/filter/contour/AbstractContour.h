@@ -25,12 +25,24 @@
 #include <viskores/filter/contour/viskores_filter_contour_export.h>
 #include <viskores/filter/vector_analysis/SurfaceNormals.h>
 
+#include <memory>
+
 namespace viskores
 {
+namespace worklet
+{
+namespace contour
+{
+class SpanSpaceCache;
+}
+}
+
 namespace filter
 {
 namespace contour
 {
+class Contour;
+
 /// \brief Contour filter interface
 ///
 /// Provides common configuration & execution methods for contour filters
@@ -217,6 +229,23 @@ public:
   VISKORES_CONT
   bool GetMergeDuplicatePoints() const { return this->MergeDuplicatedPoints; }
 
+  /// @brief Set whether to index the cells by the range of the contoured field.
+  ///
+  /// When on, marching cells builds a span space index the first time it contours a
+  /// cell set and field. The indices are kept by the filter, one for each partition, and
+  /// reused as long as it is executed on the same cell sets and field arrays, so that only
+  /// the cells that may contain the isovalues are visited. This speeds up changing the
+  /// isovalues of a static mesh. An index is rebuilt when its cell set or field array
+  /// changes, including when the values of the field array are written in place. Turning
+  /// the flag on again drops the indices.
+  ///
+  /// Flying edges does not use the index. Off by default.
+  VISKORES_CONT void SetUseSpanSpace(bool flag);
+  /// Get whether to index the cells by the range of the contoured field.
+  VISKORES_CONT bool GetUseSpanSpace() const { return this->SpanSpaceIndices != nullptr; }
+  /// Get the number of span space indices built since the index was turned on.
+  VISKORES_CONT viskores::Id GetNumberOfSpanSpaceBuilds() const;
+
 protected:
   /// \brief Map a given field to the output \c DataSet , depending on its type.
   ///
@@ -304,6 +333,10 @@ protected:
   bool MergeDuplicatedPoints = true;
   std::string NormalArrayName = "normals";
   std::string InterpolationEdgeIdsArrayName = "edgeIds";
+  std::shared_ptr<viskores::worklet::contour::SpanSpaceCache> SpanSpaceIndices;
+
+  // Contour shares the span space indices with the implementation it runs.
+  friend class viskores::filter::contour::Contour;
 };
 } // namespace contour
 } // namespace filter
@@ -64,6 +64,7 @@ viskores::cont::DataSet Contour::DoExecute(const viskores::cont::DataSet& inData
   implementation->SetInputCellDimension(this->GetInputCellDimension());
   implementation->SetActiveField(this->GetActiveFieldName());
   implementation->SetFieldsToPass(this->GetFieldsToPass());
+  implementation->SpanSpaceIndices = this->SpanSpaceIndices;
   implementation->SetNumberOfIsoValues(this->GetNumberOfIsoValues());
   for (int i = 0; i < this->GetNumberOfIsoValues(); i++)
   {
@@ -99,6 +99,10 @@ viskores::cont::DataSet ContourMarchingCells::DoExecuteDimension(
 {
   viskores::worklet::ContourMarchingCells worklet;
   worklet.SetMergeDuplicatePoints(this->GetMergeDuplicatePoints());
+  if (this->SpanSpaceIndices)
+  {
+    worklet.SetSpanSpace(this->SpanSpaceIndices, inDataSet.GetCellSet());
+  }
 
   if (!this->GetFieldFromDataSet(inDataSet).IsPointField())
   {
@@ -16,10 +16,17 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <viskores/cont/ArrayCopy.h>
+#include <viskores/cont/ArrayHandleIndex.h>
 #include <viskores/cont/DataSetBuilderExplicit.h>
 #include <viskores/cont/testing/MakeTestDataSet.h>
 #include <viskores/cont/testing/Testing.h>
+#include <viskores/filter/clean_grid/CleanGrid.h>
 #include <viskores/filter/contour/ClipWithField.h>
+#include <viskores/source/Tangle.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace
 {
@@ -106,11 +113,71 @@ void TestClipVolume()
   const viskores::cont::DataSet outputData = clip.Execute(ds);
 }
 
+// Lists each output cell by its input cell id, shape, and points, in a canonical order.
+std::vector<std::vector<viskores::Id>> GetSortedCells(const viskores::cont::DataSet& dataSet)
+{
+  viskores::cont::CellSetExplicit<> cells;
+  dataSet.GetCellSet().AsCellSet(cells);
+  viskores::cont::ArrayHandle<viskores::Id> cellIds;
+  dataSet.GetCellField("cellIds").GetData().AsArrayHandle(cellIds);
+  auto cellIdsPortal = cellIds.ReadPortal();
+
+  std::vector<std::vector<viskores::Id>> result;
+  for (viskores::Id cell = 0; cell < cells.GetNumberOfCells(); ++cell)
+  {
+    std::vector<viskores::Id> entry{ cellIdsPortal.Get(cell), cells.GetCellShape(cell) };
+    viskores::Id pointIds[8];
+    cells.GetCellPointIds(cell, pointIds);
+    entry.insert(entry.end(), pointIds, pointIds + cells.GetNumberOfPointsInCell(cell));
+    result.push_back(entry);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void TestClipStructured(bool invert)
+{
+  std::cout << "Testing Clip Filter on structured data, invert = " << invert << std::endl;
+
+  viskores::source::Tangle tangle;
+  tangle.SetCellDimensions({ 8, 8, 8 });
+  viskores::cont::DataSet structured = tangle.Execute();
+  viskores::cont::ArrayHandle<viskores::Id> cellIds;
+  viskores::cont::ArrayCopy(viskores::cont::ArrayHandleIndex(structured.GetNumberOfCells()),
+                            cellIds);
+  structured.AddCellField("cellIds", cellIds);
+
+  viskores::filter::clean_grid::CleanGrid makeExplicit;
+  makeExplicit.SetCompactPointFields(false);
+  makeExplicit.SetMergePoints(false);
+  viskores::cont::DataSet unstructured = makeExplicit.Execute(structured);
+
+  viskores::filter::contour::ClipWithField clip;
+  clip.SetClipValue(0.6);
+  clip.SetInvertClip(invert);
+  clip.SetActiveField("tangle");
+  const viskores::cont::DataSet expected = clip.Execute(unstructured);
+  const viskores::cont::DataSet result = clip.Execute(structured);
+
+  // The points are the same. The cells are the same, but the kept cells come first.
+  VISKORES_TEST_ASSERT(result.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                       "Wrong number of points for structured clip");
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(result.GetPointField("tangle").GetData(),
+                                               expected.GetPointField("tangle").GetData()),
+                       "Wrong point field for structured clip");
+  VISKORES_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                       "Wrong number of cells for structured clip");
+  VISKORES_TEST_ASSERT(GetSortedCells(result) == GetSortedCells(expected),
+                       "Wrong cells for structured clip");
+}
+
 void TestClip()
 {
   //todo: add more clip tests
   TestClipExplicit();
   TestClipVolume();
+  TestClipStructured(false);
+  TestClipStructured(true);
 }
 }
 
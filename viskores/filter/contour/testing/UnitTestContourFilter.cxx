@@ -23,14 +23,18 @@
 #include <viskores/cont/testing/MakeTestDataSet.h>
 #include <viskores/cont/testing/Testing.h>
 
+#include <viskores/filter/clean_grid/CleanGrid.h>
 #include <viskores/filter/contour/Contour.h>
 #include <viskores/filter/contour/ContourFlyingEdges.h>
 #include <viskores/filter/contour/ContourMarchingCells.h>
+#include <viskores/filter/contour/worklet/contour/SpanSpace.h>
 #include <viskores/filter/field_transform/GenerateIds.h>
 
 #include <viskores/io/VTKDataSetReader.h>
 #include <viskores/source/Tangle.h>
 
+#include <set>
+
 namespace
 {
 
@@ -174,6 +178,244 @@ public:
     VISKORES_TEST_ASSERT(result.GetNumberOfCells() == 52);
   }
 
+  void TestFlyingEdgesMultipleIsoValues() const
+  {
+    std::cout << "Testing Flying Edges with multiple isovalues" << std::endl;
+
+    viskores::source::Tangle tangle;
+    tangle.SetCellDimensions({ 12, 10, 8 });
+    viskores::cont::DataSet dataSet = tangle.Execute();
+
+    // Includes isovalues outside of the field range that produce nothing.
+    const std::vector<viskores::Float64> isovalues = { -100.0, -0.5, 0.0, 0.5,
+                                                       1.0,    2.0,  100.0, 5.0 };
+
+    viskores::filter::contour::ContourFlyingEdges filter;
+    filter.SetGenerateNormals(true);
+    filter.SetActiveField("tangle");
+    filter.SetIsoValues(isovalues);
+    viskores::cont::DataSet result = filter.Execute(dataSet);
+
+    // The contours of the isovalues are stored one after another in the same
+    // order as contouring each isovalue on its own.
+    std::vector<viskores::Vec3f> expectedPoints;
+    std::vector<viskores::Vec3f> expectedNormals;
+    std::vector<viskores::FloatDefault> expectedScalars;
+    viskores::Id expectedCells = 0;
+    for (viskores::Float64 isovalue : isovalues)
+    {
+      filter.SetIsoValues({ isovalue });
+      viskores::cont::DataSet single = filter.Execute(dataSet);
+      expectedCells += single.GetNumberOfCells();
+
+      viskores::cont::ArrayHandle<viskores::Vec3f> points;
+      single.GetCoordinateSystem().GetData().AsArrayHandle(points);
+      viskores::cont::ArrayHandle<viskores::Vec3f> normals;
+      single.GetPointField("normals").GetData().AsArrayHandle(normals);
+      viskores::cont::ArrayHandle<viskores::FloatDefault> scalars;
+      single.GetPointField("tangle").GetData().AsArrayHandle(scalars);
+      for (viskores::Id index = 0; index < points.GetNumberOfValues(); ++index)
+      {
+        expectedPoints.push_back(points.ReadPortal().Get(index));
+        expectedNormals.push_back(normals.ReadPortal().Get(index));
+        expectedScalars.push_back(scalars.ReadPortal().Get(index));
+      }
+    }
+
+    VISKORES_TEST_ASSERT(result.GetNumberOfCells() == expectedCells, "Wrong number of cells");
+    auto expectedPointsArray =
+      viskores::cont::make_ArrayHandle(expectedPoints, viskores::CopyFlag::Off);
+    auto expectedNormalsArray =
+      viskores::cont::make_ArrayHandle(expectedNormals, viskores::CopyFlag::Off);
+    auto expectedScalarsArray =
+      viskores::cont::make_ArrayHandle(expectedScalars, viskores::CopyFlag::Off);
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(result.GetCoordinateSystem().GetData(), expectedPointsArray),
+      "Wrong contour points");
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(result.GetPointField("normals").GetData(), expectedNormalsArray),
+      "Wrong contour normals");
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(result.GetPointField("tangle").GetData(), expectedScalarsArray),
+      "Wrong mapped field");
+
+    // Marching cells generates the same triangles.
+    viskores::filter::contour::ContourMarchingCells marchingCells;
+    marchingCells.SetActiveField("tangle");
+    marchingCells.SetIsoValues(isovalues);
+    VISKORES_TEST_ASSERT(marchingCells.Execute(dataSet).GetNumberOfCells() == expectedCells,
+                         "Flying edges and marching cells disagree");
+  }
+
+  void TestSpanSpace() const
+  {
+    std::cout << "Testing Contour filter with a span space index" << std::endl;
+
+    viskores::source::Tangle tangle;
+    tangle.SetCellDimensions({ 16, 16, 16 });
+    viskores::filter::clean_grid::CleanGrid makeUnstructured;
+    makeUnstructured.SetCompactPointFields(false);
+    makeUnstructured.SetMergePoints(false);
+    viskores::cont::DataSet dataSet = makeUnstructured.Execute(tangle.Execute());
+
+    viskores::filter::contour::Contour reference;
+    reference.SetActiveField("tangle");
+    viskores::filter::contour::Contour indexed;
+    indexed.SetActiveField("tangle");
+    indexed.SetUseSpanSpace(true);
+    VISKORES_TEST_ASSERT(indexed.GetUseSpanSpace());
+
+    auto compare = [&](const std::vector<viskores::Float64>& isovalues)
+    {
+      reference.SetIsoValues(isovalues);
+      indexed.SetIsoValues(isovalues);
+      viskores::cont::DataSet expected = reference.Execute(dataSet);
+      viskores::cont::DataSet result = indexed.Execute(dataSet);
+      VISKORES_TEST_ASSERT(result.GetNumberOfCells() == expected.GetNumberOfCells(),
+                           "Wrong number of cells with span space");
+      VISKORES_TEST_ASSERT(test_equal_ArrayHandles(result.GetCoordinateSystem().GetData(),
+                                                   expected.GetCoordinateSystem().GetData()),
+                           "Wrong points with span space");
+      VISKORES_TEST_ASSERT(test_equal_ArrayHandles(result.GetPointField("normals").GetData(),
+                                                   expected.GetPointField("normals").GetData()),
+                           "Wrong normals with span space");
+    };
+
+    // Sweep the isovalues with the same index.
+    compare({ 0.1 });
+    compare({ 0.6 });
+    compare({ 1.3 });
+    compare({ -0.2, 0.3, 0.8 });
+    compare({ 100.0 });
+    VISKORES_TEST_ASSERT(indexed.GetNumberOfSpanSpaceBuilds() == 1, "Index was rebuilt");
+
+    // Contouring another field rebuilds the index.
+    viskores::cont::ArrayHandle<viskores::Float32> tangleValues;
+    dataSet.GetPointField("tangle").GetData().AsArrayHandle(tangleValues);
+    viskores::cont::ArrayHandle<viskores::Float32> negated;
+    negated.Allocate(tangleValues.GetNumberOfValues());
+    {
+      auto inPortal = tangleValues.ReadPortal();
+      auto outPortal = negated.WritePortal();
+      for (viskores::Id index = 0; index < inPortal.GetNumberOfValues(); ++index)
+      {
+        outPortal.Set(index, -inPortal.Get(index));
+      }
+    }
+    dataSet.AddPointField("negated", negated);
+    reference.SetActiveField("negated");
+    indexed.SetActiveField("negated");
+    compare({ -0.6, 0.2 });
+    VISKORES_TEST_ASSERT(indexed.GetNumberOfSpanSpaceBuilds() == 2);
+
+    // Writing the field values in place rebuilds the index.
+    {
+      auto portal = negated.WritePortal();
+      for (viskores::Id index = 0; index < portal.GetNumberOfValues(); ++index)
+      {
+        portal.Set(index, 2.0f * portal.Get(index));
+      }
+    }
+    compare({ -0.6, 0.2 });
+    VISKORES_TEST_ASSERT(indexed.GetNumberOfSpanSpaceBuilds() == 3, "Stale index was used");
+
+    // Each partition keeps its own index, also when the partitions run concurrently.
+    viskores::cont::PartitionedDataSet partitions;
+    for (viskores::Id3 dims : { viskores::Id3{ 12, 14, 9 }, viskores::Id3{ 10, 8, 16 } })
+    {
+      tangle.SetCellDimensions(dims);
+      partitions.AppendPartition(makeUnstructured.Execute(tangle.Execute()));
+    }
+    partitions.AppendPartition(dataSet);
+    indexed.SetActiveField("tangle");
+    indexed.SetRunMultiThreadedFilter(true);
+    reference.SetActiveField("tangle");
+    for (viskores::Float64 isovalue : { 0.1, 0.6, 1.3 })
+    {
+      reference.SetIsoValue(isovalue);
+      indexed.SetIsoValue(isovalue);
+      viskores::cont::PartitionedDataSet expected = reference.Execute(partitions);
+      viskores::cont::PartitionedDataSet result = indexed.Execute(partitions);
+      for (viskores::Id index = 0; index < partitions.GetNumberOfPartitions(); ++index)
+      {
+        VISKORES_TEST_ASSERT(test_equal_ArrayHandles(
+                               result.GetPartition(index).GetCoordinateSystem().GetData(),
+                               expected.GetPartition(index).GetCoordinateSystem().GetData()),
+                             "Wrong points with span space on partitions");
+      }
+    }
+    // The last partition uses the index built for the data set above.
+    VISKORES_TEST_ASSERT(indexed.GetNumberOfSpanSpaceBuilds() == 5,
+                         "Partitions did not keep their indices");
+
+    // The index lists a fraction of the cells.
+    viskores::worklet::contour::SpanSpace spanSpace;
+    viskores::cont::CellSetExplicit<> cells;
+    dataSet.GetCellSet().AsCellSet(cells);
+    spanSpace.Build(cells, tangleValues);
+    const viskores::Id numCandidates =
+      spanSpace.GetCandidateCells(std::vector<viskores::Float32>{ 0.6f }).GetNumberOfValues();
+    VISKORES_TEST_ASSERT(numCandidates > 0);
+    VISKORES_TEST_ASSERT(numCandidates < cells.GetNumberOfCells() / 2,
+                         "Span space should not list most cells");
+    VISKORES_TEST_ASSERT(
+      spanSpace.GetCandidateCells(std::vector<viskores::Float32>{ 100.0f }).GetNumberOfValues() ==
+      0);
+  }
+
+  void TestMergeDuplicatePointsUnstructured() const
+  {
+    std::cout << "Testing merging duplicate points on unstructured data" << std::endl;
+
+    viskores::source::Tangle tangle;
+    tangle.SetCellDimensions({ 8, 8, 8 });
+    viskores::filter::clean_grid::CleanGrid makeUnstructured;
+    makeUnstructured.SetCompactPointFields(false);
+    makeUnstructured.SetMergePoints(false);
+    viskores::cont::DataSet dataSet = makeUnstructured.Execute(tangle.Execute());
+
+    viskores::filter::contour::ContourMarchingCells filter;
+    filter.SetActiveField("tangle");
+    filter.SetIsoValues({ 0.3, 0.8 });
+    filter.SetGenerateNormals(false);
+    filter.SetMergeDuplicatePoints(false);
+    viskores::cont::DataSet separate = filter.Execute(dataSet);
+    filter.SetMergeDuplicatePoints(true);
+    viskores::cont::DataSet merged = filter.Execute(dataSet);
+
+    VISKORES_TEST_ASSERT(merged.GetNumberOfCells() == separate.GetNumberOfCells(),
+                         "Merging points should not change the cells");
+    viskores::cont::ArrayHandle<viskores::Vec3f> separatePoints;
+    viskores::cont::ArrayHandle<viskores::Vec3f> mergedPoints;
+    separate.GetCoordinateSystem().GetData().AsArrayHandle(separatePoints);
+    merged.GetCoordinateSystem().GetData().AsArrayHandle(mergedPoints);
+    auto separatePortal = separatePoints.ReadPortal();
+    auto mergedPortal = mergedPoints.ReadPortal();
+
+    // Every distinct point is generated once.
+    std::set<viskores::Vec3f> distinctPoints;
+    for (viskores::Id index = 0; index < separatePortal.GetNumberOfValues(); ++index)
+    {
+      distinctPoints.insert(separatePortal.Get(index));
+    }
+    VISKORES_TEST_ASSERT(static_cast<std::size_t>(mergedPortal.GetNumberOfValues()) ==
+                           distinctPoints.size(),
+                         "Wrong number of merged points");
+
+    // The triangles are the same. Without merging, each triangle has its own points.
+    viskores::cont::CellSetSingleType<> mergedCells;
+    merged.GetCellSet().AsCellSet(mergedCells);
+    auto connectivity = mergedCells
+                          .GetConnectivityArray(viskores::TopologyElementTagCell{},
+                                                viskores::TopologyElementTagPoint{})
+                          .ReadPortal();
+    for (viskores::Id index = 0; index < connectivity.GetNumberOfValues(); ++index)
+    {
+      VISKORES_TEST_ASSERT(mergedPortal.Get(connectivity.Get(index)) == separatePortal.Get(index),
+                           "Wrong point in merged triangles");
+    }
+  }
+
   void TestUnsupportedFlyingEdges() const
   {
     viskores::cont::testing::MakeTestDataSet maker;
@@ -319,6 +561,9 @@ public:
     this->TestNonUniformStructured<viskores::filter::contour::ContourFlyingEdges>();
     this->TestNonUniformStructured<viskores::filter::contour::ContourMarchingCells>();
 
+    this->TestFlyingEdgesMultipleIsoValues();
+    this->TestSpanSpace();
+    this->TestMergeDuplicatePointsUnstructured();
     this->TestUnsupportedFlyingEdges();
 
     this->TestMixedShapes();
@@ -29,17 +29,23 @@
 #include <viskores/cont/ArrayHandleIndex.h>
 #include <viskores/cont/ArrayHandlePermutation.h>
 #include <viskores/cont/ArrayHandleTransform.h>
+#include <viskores/cont/ArrayHandleView.h>
 #include <viskores/cont/ArraySetValues.h>
 #include <viskores/cont/CellSetExplicit.h>
+#include <viskores/cont/CellSetPermutation.h>
+#include <viskores/cont/CellSetStructured.h>
 #include <viskores/cont/CoordinateSystem.h>
 #include <viskores/cont/Invoker.h>
 #include <viskores/cont/Logging.h>
 #include <viskores/cont/RuntimeDeviceTracker.h>
+#include <viskores/cont/UnknownCellSet.h>
 
 #include <viskores/filter/contour/worklet/clip/ClipTables.h>
+#include <viskores/filter/contour/worklet/contour/UniqueEdges.h>
 
 #include <viskores/worklet/MaskSelect.h>
 #include <viskores/worklet/WorkletMapField.h>
+#include <viskores/worklet/WorkletMapTopology.h>
 
 
 #if defined(THRUST_MAJOR_VERSION) && THRUST_MAJOR_VERSION == 1 && THRUST_MINOR_VERSION == 8 && \
@@ -144,21 +150,12 @@ public:
     viskores::Id Vertex2 = -1;
     viskores::Float64 Weight = 0;
 
-    struct LessThanOp
+    struct EdgeOp
     {
-      VISKORES_EXEC
-      bool operator()(const EdgeInterpolation& v1, const EdgeInterpolation& v2) const
-      {
-        return (v1.Vertex1 < v2.Vertex1) || (v1.Vertex1 == v2.Vertex1 && v1.Vertex2 < v2.Vertex2);
-      }
-    };
-
-    struct EqualToOp
-    {
-      VISKORES_EXEC
-      bool operator()(const EdgeInterpolation& v1, const EdgeInterpolation& v2) const
+      VISKORES_EXEC_CONT
+      viskores::Id2 operator()(const EdgeInterpolation& v) const
       {
-        return v1.Vertex1 == v2.Vertex1 && v1.Vertex2 == v2.Vertex2;
+        return viskores::Id2(v.Vertex1, v.Vertex2);
       }
     };
   };
@@ -592,15 +589,257 @@ public:
     viskores::Id CentroidPointsOffset;
   };
 
+  enum class CellClass : viskores::UInt8
+  {
+    Discarded = 0,
+    Kept = 1,
+    Cut = 2
+  };
+
+  struct IsCellClass
+  {
+    CellClass Class;
+
+    VISKORES_EXEC_CONT bool operator()(viskores::UInt8 cellClass) const
+    {
+      return cellClass == static_cast<viskores::UInt8>(this->Class);
+    }
+  };
+
+  /**
+   * This worklet finds whether each cell of a structured cell set is discarded, kept whole,
+   * or cut by the clip.
+   */
+  template <bool Invert>
+  class ClassifyStructuredCells : public viskores::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn cellSet,
+                                  FieldInPoint keptPointsMask,
+                                  FieldOutCell cellClass);
+    using ExecutionSignature = void(_2, _3);
+
+    using CT = internal::ClipTables<Invert>;
+
+    template <typename KeptPointsVec>
+    VISKORES_EXEC void operator()(const KeptPointsVec& keptPointsMask,
+                                  viskores::UInt8& cellClass) const
+    {
+      const viskores::IdComponent pointCount = keptPointsMask.GetNumberOfComponents();
+      viskores::UInt8 caseIndex = 0;
+      for (viskores::IdComponent ptId = pointCount - 1; ptId >= 0; --ptId)
+      {
+        static constexpr auto InvertUint8 = static_cast<viskores::UInt8>(Invert);
+        caseIndex |= (InvertUint8 != keptPointsMask[ptId]) << ptId;
+      }
+
+      CellClass result = CellClass::Cut;
+      if (CT::IsCellDiscarded(pointCount, caseIndex))
+      {
+        result = CellClass::Discarded;
+      }
+      else if (CT::IsCellKept(pointCount, caseIndex))
+      {
+        result = CellClass::Kept;
+      }
+      cellClass = static_cast<viskores::UInt8>(result);
+    }
+  };
+
+  class MapCutCellIds : public viskores::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldInOut cellId, WholeArrayIn cutCellIds);
+    using ExecutionSignature = void(_1, _2);
+
+    template <typename CutCellIds>
+    VISKORES_EXEC void operator()(viskores::Id& cellId, const CutCellIds& cutCellIds) const
+    {
+      cellId = cutCellIds.Get(cellId);
+    }
+  };
+
+  /**
+   * This worklet writes the cells of a structured cell set that are kept whole. All the cells
+   * have the same number of points, so the kept cell at index `i` starts at `i` times that.
+   */
+  class CopyKeptCells : public viskores::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn cellId,
+                                  WholeCellSetIn<> cellSet,
+                                  WholeArrayIn pointMapInputToOutput,
+                                  WholeArrayOut cellMapOutputToInput,
+                                  WholeArrayOut shapes,
+                                  WholeArrayOut offsets,
+                                  WholeArrayOut connectivity);
+    using ExecutionSignature = void(_1, WorkIndex, _2, _3, _4, _5, _6, _7);
+
+    template <typename CellSetType,
+              typename PointMapInputToOutput,
+              typename CellMapOutputToInput,
+              typename Shapes,
+              typename Offsets,
+              typename Connectivity>
+    VISKORES_EXEC void operator()(viskores::Id cellId,
+                                  viskores::Id outputCellId,
+                                  const CellSetType& cellSet,
+                                  const PointMapInputToOutput& pointMapInputToOutput,
+                                  CellMapOutputToInput& cellMapOutputToInput,
+                                  Shapes& shapes,
+                                  Offsets& offsets,
+                                  Connectivity& connectivity) const
+    {
+      const auto points = cellSet.GetIndices(cellId);
+      const viskores::IdComponent pointCount = points.GetNumberOfComponents();
+      const viskores::Id cellIndicesOffset = outputCellId * pointCount;
+
+      cellMapOutputToInput.Set(outputCellId, cellId);
+      shapes.Set(outputCellId, static_cast<viskores::UInt8>(cellSet.GetCellShape(cellId).Id));
+      offsets.Set(outputCellId, cellIndicesOffset);
+      for (viskores::IdComponent pointId = 0; pointId < pointCount; ++pointId)
+      {
+        connectivity.Set(cellIndicesOffset + pointId,
+                         pointMapInputToOutput.Get(points[pointId]));
+      }
+    }
+  };
+
   Clip() = default;
 
   template <bool Invert, typename CellSetType, typename ScalarsArrayHandle>
   viskores::cont::CellSetExplicit<> Run(const CellSetType& cellSet,
                                         const ScalarsArrayHandle& scalars,
                                         viskores::Float64 value)
+  {
+    return this->RunUnstructured<Invert>(cellSet, scalars, value);
+  }
+
+  template <bool Invert, typename ScalarsArrayHandle>
+  viskores::cont::CellSetExplicit<> Run(const viskores::cont::UnknownCellSet& cellSet,
+                                        const ScalarsArrayHandle& scalars,
+                                        viskores::Float64 value)
+  {
+    if (cellSet.IsType<viskores::cont::CellSetStructured<3>>())
+    {
+      return this->Run<Invert>(
+        cellSet.AsCellSet<viskores::cont::CellSetStructured<3>>(), scalars, value);
+    }
+    else if (cellSet.IsType<viskores::cont::CellSetStructured<2>>())
+    {
+      return this->Run<Invert>(
+        cellSet.AsCellSet<viskores::cont::CellSetStructured<2>>(), scalars, value);
+    }
+    return this->RunUnstructured<Invert>(cellSet, scalars, value);
+  }
+
+  /// Clips a structured cell set. The cells that are kept whole are only recorded by their
+  /// id in the structured cell set, and only the cells that are cut go through the clip
+  /// tables. The output lists the kept cells first, followed by the pieces of the cut cells.
+  template <bool Invert, viskores::IdComponent Dimension, typename ScalarsArrayHandle>
+  viskores::cont::CellSetExplicit<> Run(
+    const viskores::cont::CellSetStructured<Dimension>& cellSet,
+    const ScalarsArrayHandle& scalars,
+    viskores::Float64 value)
+  {
+    static constexpr viskores::IdComponent PointsPerCell = 1 << Dimension;
+    viskores::cont::Invoker invoke;
+
+    viskores::cont::ArrayHandle<viskores::UInt8> keptPointsMask;
+    viskores::cont::ArrayHandle<viskores::Id> pointMapInputToOutput;
+    this->MarkPoints<Invert>(scalars, value, keptPointsMask, pointMapInputToOutput);
+
+    // Split the cells into the kept cells and the cut cells.
+    viskores::cont::ArrayHandle<viskores::Id> keptCellIds;
+    viskores::cont::ArrayHandle<viskores::Id> cutCellIds;
+    {
+      viskores::cont::ArrayHandle<viskores::UInt8> cellClasses;
+      invoke(ClassifyStructuredCells<Invert>{}, cellSet, keptPointsMask, cellClasses);
+      const viskores::cont::ArrayHandleIndex cellIds(cellSet.GetNumberOfCells());
+      viskores::cont::Algorithm::CopyIf(
+        cellIds, cellClasses, keptCellIds, IsCellClass{ CellClass::Kept });
+      viskores::cont::Algorithm::CopyIf(
+        cellIds, cellClasses, cutCellIds, IsCellClass{ CellClass::Cut });
+    }
+    const viskores::Id numberOfKeptCells = keptCellIds.GetNumberOfValues();
+
+    // Clip the cut cells, leaving room for the kept cells at the start of the output.
+    CellBatchData keptCellsData;
+    keptCellsData.NumberOfCells = numberOfKeptCells;
+    keptCellsData.NumberOfCellIndices = numberOfKeptCells * PointsPerCell;
+    viskores::cont::ArrayHandle<viskores::UInt8> shapes;
+    viskores::cont::ArrayHandle<viskores::Id> offsets;
+    viskores::cont::ArrayHandle<viskores::Id> connectivity;
+    const viskores::Id numberOfOutputPoints = this->ClipCells<Invert>(
+      viskores::cont::make_CellSetPermutation(cutCellIds, cellSet),
+      scalars,
+      value,
+      keptPointsMask,
+      pointMapInputToOutput,
+      keptCellsData,
+      shapes,
+      offsets,
+      connectivity);
+
+    // The cut cells were indexed through the permutation. Map them back to the input cells.
+    invoke(MapCutCellIds{},
+           viskores::cont::make_ArrayHandleView(
+             this->CellMapOutputToInput,
+             numberOfKeptCells,
+             this->CellMapOutputToInput.GetNumberOfValues() - numberOfKeptCells),
+           cutCellIds);
+
+    // Write the kept cells.
+    invoke(CopyKeptCells{},
+           keptCellIds,
+           cellSet,
+           pointMapInputToOutput,
+           this->CellMapOutputToInput,
+           shapes,
+           offsets,
+           connectivity);
+
+    viskores::cont::CellSetExplicit<> output;
+    output.Fill(numberOfOutputPoints, shapes, connectivity, offsets);
+    return output;
+  }
+
+private:
+  template <bool Invert, typename CellSetType, typename ScalarsArrayHandle>
+  viskores::cont::CellSetExplicit<> RunUnstructured(const CellSetType& cellSet,
+                                                    const ScalarsArrayHandle& scalars,
+                                                    viskores::Float64 value)
+  {
+    viskores::cont::ArrayHandle<viskores::UInt8> keptPointsMask;
+    viskores::cont::ArrayHandle<viskores::Id> pointMapInputToOutput;
+    this->MarkPoints<Invert>(scalars, value, keptPointsMask, pointMapInputToOutput);
+
+    viskores::cont::ArrayHandle<viskores::UInt8> shapes;
+    viskores::cont::ArrayHandle<viskores::Id> offsets;
+    viskores::cont::ArrayHandle<viskores::Id> connectivity;
+    const viskores::Id numberOfOutputPoints = this->ClipCells<Invert>(cellSet,
+                                                                      scalars,
+                                                                      value,
+                                                                      keptPointsMask,
+                                                                      pointMapInputToOutput,
+                                                                      CellBatchData{},
+                                                                      shapes,
+                                                                      offsets,
+                                                                      connectivity);
+
+    viskores::cont::CellSetExplicit<> output;
+    output.Fill(numberOfOutputPoints, shapes, connectivity, offsets);
+    return output;
+  }
+
+  // Marks the kept points and numbers them in the output.
+  template <bool Invert, typename ScalarsArrayHandle>
+  void MarkPoints(const ScalarsArrayHandle& scalars,
+                  viskores::Float64 value,
+                  viskores::cont::ArrayHandle<viskores::UInt8>& keptPointsMask,
+                  viskores::cont::ArrayHandle<viskores::Id>& pointMapInputToOutput)
   {
     const viskores::Id numberOfInputPoints = scalars.GetNumberOfValues();
-    const viskores::Id numberOfInputCells = cellSet.GetNumberOfCells();
 
     // Create an invoker.
     viskores::cont::Invoker invoke;
@@ -617,7 +856,6 @@ public:
     batchesWithKeptPointsMask.Allocate(pointBatches.GetNumberOfValues());
 
     // Create an array to store the mask of kept points.
-    viskores::cont::ArrayHandle<viskores::UInt8> keptPointsMask;
     keptPointsMask.Allocate(numberOfInputPoints);
 
     // Mark the points that are kept.
@@ -628,7 +866,6 @@ public:
            scalars,
            keptPointsMask);
 
-    viskores::cont::ArrayHandle<viskores::Id> pointMapInputToOutput;
     { // A new scope is needed so that batchesWithKeptPointsMaskSelect is released at the end.
       // Create a mask to only process the batches that have kept points.
       auto batchesWithKeptPointsMaskSelect =
@@ -659,6 +896,26 @@ public:
       pointBatches.ReleaseResources();
       pointBatchesData.ReleaseResources();
     }
+  }
+
+  // Clips the cells with the clip tables. The output cells are written after the cells and
+  // cell indices counted in `reserved`, which the caller fills. Returns the number of output
+  // points.
+  template <bool Invert, typename CellSetType, typename ScalarsArrayHandle>
+  viskores::Id ClipCells(const CellSetType& cellSet,
+                         const ScalarsArrayHandle& scalars,
+                         viskores::Float64 value,
+                         viskores::cont::ArrayHandle<viskores::UInt8>& keptPointsMask,
+                         const viskores::cont::ArrayHandle<viskores::Id>& pointMapInputToOutput,
+                         const CellBatchData& reserved,
+                         viskores::cont::ArrayHandle<viskores::UInt8>& shapes,
+                         viskores::cont::ArrayHandle<viskores::Id>& offsets,
+                         viskores::cont::ArrayHandle<viskores::Id>& connectivity)
+  {
+    const viskores::Id numberOfInputCells = cellSet.GetNumberOfCells();
+
+    // Create an invoker.
+    viskores::cont::Invoker invoke;
 
     // Create batches of cells to process.
     auto cellBatches = CreateBatches(numberOfInputCells);
@@ -701,7 +958,7 @@ public:
       cellBatchesData);
     // Compute the total of filledCellBatchesData, and convert filledCellBatchesData to offsets in-place.
     const CellBatchData cellBatchTotal = viskores::cont::Algorithm::ScanExclusive(
-      filledCellBatchesData, filledCellBatchesData, CellBatchData::SumOp(), CellBatchData{});
+      filledCellBatchesData, filledCellBatchesData, CellBatchData::SumOp(), reserved);
 
     // Create an array to store the edge interpolations.
     viskores::cont::ArrayHandle<EdgeInterpolation> edgeInterpolation;
@@ -724,19 +981,17 @@ public:
              edgeInterpolation);
     }
 
-    // Copy the edge interpolations to the output.
-    viskores::cont::Algorithm::Copy(edgeInterpolation, this->EdgePointsInterpolation);
-    // Sort the edge interpolations.
-    viskores::cont::Algorithm::Sort(this->EdgePointsInterpolation, EdgeInterpolation::LessThanOp());
-    // Remove duplicates.
-    viskores::cont::Algorithm::Unique(this->EdgePointsInterpolation,
-                                      EdgeInterpolation::EqualToOp());
-    // Get the edge index to unique index.
+    // Find the unique edges, ordered by their vertices, and the edge index to unique index.
+    viskores::cont::ArrayHandle<viskores::Id> uniqueEdgeToEdgeIndex;
     viskores::cont::ArrayHandle<viskores::Id> edgeInterpolationIndexToUnique;
-    viskores::cont::Algorithm::LowerBounds(this->EdgePointsInterpolation,
-                                           edgeInterpolation,
-                                           edgeInterpolationIndexToUnique,
-                                           EdgeInterpolation::LessThanOp());
+    viskores::worklet::contour::UniqueEdges(
+      viskores::cont::make_ArrayHandleTransform(edgeInterpolation, EdgeInterpolation::EdgeOp()),
+      uniqueEdgeToEdgeIndex,
+      edgeInterpolationIndexToUnique);
+    // Copy the unique edge interpolations to the output.
+    viskores::cont::Algorithm::Copy(
+      viskores::cont::make_ArrayHandlePermutation(uniqueEdgeToEdgeIndex, edgeInterpolation),
+      this->EdgePointsInterpolation);
     edgeInterpolation.ReleaseResources(); // Release since it's no longer needed.
 
     // Get the number of kept points, unique edge points, centroids, and output points.
@@ -758,11 +1013,8 @@ public:
       viskores::cont::make_ArrayHandleGroupVecVariable(centroidConnectivity, centroidOffsets);
 
     // Allocate the output cell set.
-    viskores::cont::ArrayHandle<viskores::UInt8> shapes;
     shapes.Allocate(cellBatchTotal.NumberOfCells);
-    viskores::cont::ArrayHandle<viskores::Id> offsets;
     offsets.Allocate(cellBatchTotal.NumberOfCells + 1);
-    viskores::cont::ArrayHandle<viskores::Id> connectivity;
     connectivity.Allocate(cellBatchTotal.NumberOfCellIndices);
 
     // Allocate Cell Map output to Input.
@@ -791,11 +1043,11 @@ public:
     viskores::cont::ArraySetValue(
       numberOfCentroids, cellBatchTotal.NumberOfCentroidIndices, centroidOffsets);
 
-    viskores::cont::CellSetExplicit<> output;
-    output.Fill(numberOfOutputPoints, shapes, connectivity, offsets);
-    return output;
+    return numberOfOutputPoints;
   }
 
+public:
+
   template <bool Invert, typename CellSetType, typename ImplicitFunction>
   class ClipWithImplicitFunction
   {
@@ -115,6 +115,14 @@ public:
   //----------------------------------------------------------------------------
   bool GetMergeDuplicatePoints() const { return this->SharedState.MergeDuplicatePoints; }
 
+  //----------------------------------------------------------------------------
+  void SetSpanSpace(const std::shared_ptr<contour::SpanSpaceCache>& indices,
+                    const viskores::cont::UnknownCellSet& cellSet)
+  {
+    this->SharedState.SpanSpaceIndices = indices;
+    this->SharedState.SpanSpaceCellSet = cellSet;
+  }
+
   //----------------------------------------------------------------------------
   viskores::cont::ArrayHandle<viskores::Id> GetCellIdMap() const
   {
@@ -21,6 +21,9 @@
 #define viskores_worklet_contour_CommonState_h
 
 #include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/UnknownCellSet.h>
+
+#include <memory>
 
 namespace viskores
 {
@@ -29,6 +32,8 @@ namespace worklet
 namespace contour
 {
 
+class SpanSpaceCache;
+
 struct CommonState
 {
   explicit CommonState(bool mergeDuplicates)
@@ -41,6 +46,10 @@ struct CommonState
   viskores::cont::ArrayHandle<viskores::FloatDefault> InterpolationWeights;
   viskores::cont::ArrayHandle<viskores::Id2> InterpolationEdgeIds;
   viskores::cont::ArrayHandle<viskores::Id> CellIdMap;
+  // When set, marching cells only classifies the cells that the span space index of the
+  // cell set lists for the isovalues.
+  std::shared_ptr<SpanSpaceCache> SpanSpaceIndices;
+  viskores::cont::UnknownCellSet SpanSpaceCellSet;
 };
 }
 }
@@ -26,7 +26,9 @@
 #include <viskores/filter/contour/worklet/contour/FlyingEdgesPass4.h>
 
 #include <viskores/cont/Algorithm.h>
+#include <viskores/cont/ArrayGetValues.h>
 #include <viskores/cont/ArrayHandleGroupVec.h>
+#include <viskores/cont/ArrayHandleView.h>
 #include <viskores/cont/Invoker.h>
 
 namespace viskores
@@ -36,17 +38,6 @@ namespace worklet
 namespace flying_edges
 {
 
-namespace detail
-{
-template <typename T, typename S>
-viskores::Id extend_by(viskores::cont::ArrayHandle<T, S>& handle, viskores::Id size)
-{
-  viskores::Id oldLen = handle.GetNumberOfValues();
-  handle.Allocate(oldLen + size, viskores::CopyFlag::On);
-  return oldLen;
-}
-}
-
 //----------------------------------------------------------------------------
 template <typename IVType,
           typename ValueType,
@@ -67,9 +58,16 @@ viskores::cont::CellSetSingleType<> execute(
 {
   viskores::cont::Invoker invoke;
   auto pdims = cells.GetPointDimensions();
-
+  const viskores::Id numPoints = pdims[0] * pdims[1] * pdims[2];
+  const viskores::Id numIsoValues = static_cast<viskores::Id>(isovalues.size());
+
+  // All isovalues are processed together. The edge cases and the meta data of each
+  // isovalue are stored one after another in the same arrays, so the input field is
+  // only traversed once to classify all of them.
+  viskores::cont::ArrayHandle<IVType> isovalueArray =
+    viskores::cont::make_ArrayHandle(isovalues, viskores::CopyFlag::Off);
   viskores::cont::ArrayHandle<viskores::UInt8> edgeCases;
-  edgeCases.Allocate(coordinateSystem.GetData().GetNumberOfValues());
+  edgeCases.Allocate(numIsoValues * numPoints);
 
   viskores::cont::CellSetStructured<2> metaDataMesh2D;
   viskores::cont::ArrayHandle<viskores::Id> metaDataLinearSums; //per point of metaDataMesh
@@ -87,12 +85,8 @@ viskores::cont::CellSetSingleType<> execute(
   sharedState.CellIdMap.ReleaseResources();
 
   viskores::cont::ArrayHandle<viskores::Id> triangle_topology;
-  for (std::size_t i = 0; i < isovalues.size(); ++i)
+  if (numIsoValues > 0)
   {
-    auto multiContourCellOffset = sharedState.CellIdMap.GetNumberOfValues();
-    auto multiContourPointOffset = sharedState.InterpolationWeights.GetNumberOfValues();
-    IVType isoval = isovalues[i];
-
     //----------------------------------------------------------------------------
     // PASS 1: Process all of the voxel edges that compose each row. Determine the
     // edges case classification, count the number of edge intersections, and
@@ -109,10 +103,11 @@ viskores::cont::CellSetSingleType<> execute(
       // Additionally GPU's does significantly better when you do an initial fill
       // and write only non-below values
       //
-      ComputePass1<IVType> worklet1(isoval, pdims);
+      ComputePass1<IVType> worklet1(pdims);
       viskores::cont::TryExecuteOnDevice(invoke.GetDevice(),
                                          launchComputePass1{},
                                          worklet1,
+                                         isovalueArray,
                                          inputField,
                                          edgeCases,
                                          metaDataMesh2D,
@@ -128,7 +123,8 @@ viskores::cont::CellSetSingleType<> execute(
     // row. Use computational trimming to reduce work.
     {
       VISKORES_LOG_SCOPE(viskores::cont::LogLevel::Perf, "FlyingEdges Pass2");
-      ComputePass2 worklet2(pdims);
+      metaDataNumTris.Allocate(numIsoValues * metaDataMesh2D.GetNumberOfCells());
+      ComputePass2 worklet2(pdims, numIsoValues);
       invoke(worklet2,
              metaDataMesh2D,
              metaDataSums,
@@ -137,55 +133,84 @@ viskores::cont::CellSetSingleType<> execute(
              metaDataNumTris,
              edgeCases);
     }
+  }
 
-    //----------------------------------------------------------------------------
-    // PASS 3: Compute the number of points and triangles that each edge
-    // row needs to generate by using exclusive scans.
-    viskores::cont::Algorithm::ScanExtended(metaDataNumTris, metaDataNumTris);
-    auto sumTris =
-      viskores::cont::ArrayGetValue(metaDataNumTris.GetNumberOfValues() - 1, metaDataNumTris);
-    if (sumTris > 0)
+  //----------------------------------------------------------------------------
+  // PASS 3: Compute the number of points and triangles that each edge
+  // row needs to generate by using exclusive scans. The triangles of all
+  // isovalues are scanned together. The points are scanned per isovalue
+  // since pass 4 writes them relative to the start of each isovalue.
+  const viskores::Id numMetaPoints = metaDataMesh2D.GetNumberOfPoints();
+  const viskores::Id numMetaCells = metaDataMesh2D.GetNumberOfCells();
+  viskores::cont::Algorithm::ScanExtended(metaDataNumTris, metaDataNumTris);
+  std::vector<viskores::Id> triOffsetIds(isovalues.size() + 1);
+  for (std::size_t index = 0; index < triOffsetIds.size(); ++index)
+  {
+    triOffsetIds[index] = static_cast<viskores::Id>(index) * numMetaCells;
+  }
+  std::vector<viskores::Int32> triOffsets;
+  viskores::cont::ArrayGetValues(triOffsetIds, metaDataNumTris, triOffsets);
+
+  std::vector<viskores::Id> pointOffsets(isovalues.size() + 1, 0);
+  for (viskores::Id iso = 0; iso < numIsoValues; ++iso)
+  {
+    const std::size_t index = static_cast<std::size_t>(iso);
+    viskores::Id newPointSize = 0;
+    if (triOffsets[index + 1] > triOffsets[index])
     {
-      detail::extend_by(triangle_topology, 3 * sumTris);
-      detail::extend_by(sharedState.CellIdMap, sumTris);
-
-
-      viskores::Id newPointSize =
-        viskores::cont::Algorithm::ScanExclusive(metaDataLinearSums, metaDataLinearSums);
-      detail::extend_by(sharedState.InterpolationEdgeIds, newPointSize);
-      detail::extend_by(sharedState.InterpolationWeights, newPointSize);
-
-      //----------------------------------------------------------------------------
-      // PASS 4: Process voxel rows and generate topology, and interpolation state
-      {
-        VISKORES_LOG_SCOPE(viskores::cont::LogLevel::Perf, "FlyingEdges Pass4");
-
-        auto pass4 = launchComputePass4(pdims, multiContourCellOffset, multiContourPointOffset);
-
-        detail::extend_by(points, newPointSize);
-        if (sharedState.GenerateNormals)
-        {
-          detail::extend_by(normals, newPointSize);
-        }
-
-        viskores::cont::TryExecuteOnDevice(invoke.GetDevice(),
-                                           pass4,
-                                           newPointSize,
-                                           isoval,
-                                           coordinateSystem,
-                                           inputField,
-                                           edgeCases,
-                                           metaDataMesh2D,
-                                           metaDataSums,
-                                           metaDataMin,
-                                           metaDataMax,
-                                           metaDataNumTris,
-                                           sharedState,
-                                           triangle_topology,
-                                           points,
-                                           normals);
-      }
+      auto isoSums = viskores::cont::make_ArrayHandleView(
+        metaDataLinearSums, 3 * iso * numMetaPoints, 3 * numMetaPoints);
+      newPointSize = viskores::cont::Algorithm::ScanExclusive(isoSums, isoSums);
     }
+    pointOffsets[index + 1] = pointOffsets[index] + newPointSize;
+  }
+
+  // Every isovalue writes its triangles and points into its own range of the same
+  // output arrays, so they are allocated once for all isovalues.
+  const viskores::Id sumTris = triOffsets.back();
+  const viskores::Id sumPoints = pointOffsets.back();
+  triangle_topology.Allocate(3 * sumTris);
+  sharedState.CellIdMap.Allocate(sumTris);
+  sharedState.InterpolationEdgeIds.Allocate(sumPoints);
+  sharedState.InterpolationWeights.Allocate(sumPoints);
+  points.Allocate(sumPoints);
+  if (sharedState.GenerateNormals)
+  {
+    normals.Allocate(sumPoints);
+  }
+
+  for (viskores::Id iso = 0; iso < numIsoValues; ++iso)
+  {
+    const std::size_t index = static_cast<std::size_t>(iso);
+    if (triOffsets[index + 1] == triOffsets[index])
+    {
+      continue;
+    }
+
+    //----------------------------------------------------------------------------
+    // PASS 4: Process voxel rows and generate topology, and interpolation state
+    VISKORES_LOG_SCOPE(viskores::cont::LogLevel::Perf, "FlyingEdges Pass4");
+
+    // The triangle offsets already count the triangles of the previous isovalues.
+    auto pass4 = launchComputePass4(pdims, 0, pointOffsets[index]);
+    viskores::cont::TryExecuteOnDevice(
+      invoke.GetDevice(),
+      pass4,
+      pointOffsets[index + 1] - pointOffsets[index],
+      isovalues[index],
+      coordinateSystem,
+      inputField,
+      viskores::cont::make_ArrayHandleView(edgeCases, iso * numPoints, numPoints),
+      metaDataMesh2D,
+      viskores::cont::make_ArrayHandleGroupVec<3>(viskores::cont::make_ArrayHandleView(
+        metaDataLinearSums, 3 * iso * numMetaPoints, 3 * numMetaPoints)),
+      viskores::cont::make_ArrayHandleView(metaDataMin, iso * numMetaPoints, numMetaPoints),
+      viskores::cont::make_ArrayHandleView(metaDataMax, iso * numMetaPoints, numMetaPoints),
+      viskores::cont::make_ArrayHandleView(metaDataNumTris, iso * numMetaCells, numMetaCells + 1),
+      sharedState,
+      triangle_topology,
+      points,
+      normals);
   }
 
   viskores::cont::CellSetSingleType<> outputCells;
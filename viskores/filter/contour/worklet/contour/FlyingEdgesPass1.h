@@ -78,32 +78,37 @@ template <typename T>
 struct ComputePass1 : public viskores::worklet::WorkletVisitPointsWithCells
 {
   viskores::Id3 PointDims;
-  T IsoValue;
 
   ComputePass1() {}
-  ComputePass1(T value, const viskores::Id3& pdims)
+  explicit ComputePass1(const viskores::Id3& pdims)
     : PointDims(pdims)
-    , IsoValue(value)
   {
   }
 
   using ControlSignature = void(CellSetIn,
-                                FieldOut axis_sum,
-                                FieldOut axis_min,
-                                FieldOut axis_max,
+                                WholeArrayIn isovalues,
+                                WholeArrayOut axis_sums,
+                                WholeArrayOut axis_mins,
+                                WholeArrayOut axis_maxs,
                                 WholeArrayInOut edgeData,
                                 WholeArrayIn data);
-  using ExecutionSignature = void(ThreadIndices, _2, _3, _4, _5, _6, Device);
+  using ExecutionSignature = void(ThreadIndices, _2, _3, _4, _5, _6, _7, Device);
   using InputDomain = _1;
 
+  // The edge cases and row meta data of all isovalues are stored one isovalue after
+  // another. Each row of the field is read once and classified against every isovalue.
   template <typename ThreadIndices,
+            typename WholeIsoField,
+            typename WholeSumField,
+            typename WholeIdField,
             typename WholeEdgeField,
             typename WholeDataField,
             typename Device>
   VISKORES_EXEC void operator()(const ThreadIndices& threadIndices,
-                                viskores::Id3& axis_sum,
-                                viskores::Id& axis_min,
-                                viskores::Id& axis_max,
+                                const WholeIsoField& isovalues,
+                                const WholeSumField& axis_sums,
+                                const WholeIdField& axis_mins,
+                                const WholeIdField& axis_maxs,
                                 WholeEdgeField& edges,
                                 const WholeDataField& field,
                                 Device) const
@@ -114,42 +119,61 @@ struct ComputePass1 : public viskores::worklet::WorkletVisitPointsWithCells
     const viskores::Id3 dims = this->PointDims;
     const viskores::Id startPos = compute_start(AxisToSum{}, ijk, dims);
     const viskores::Id offset = compute_inc(AxisToSum{}, dims);
+    const viskores::Id numPoints = dims[0] * dims[1] * dims[2];
+    const viskores::Id numRows = dims[AxisToSum::yindex] * dims[AxisToSum::zindex];
+    const viskores::Id row = threadIndices.GetInputIndex();
+    const viskores::Id numIsoValues = isovalues.GetNumberOfValues();
+    const viskores::Id end = this->PointDims[AxisToSum::xindex] - 1;
+
+    for (viskores::Id iso = 0; iso < numIsoValues; ++iso)
+    {
+      axis_sums.Set(iso * numRows + row, viskores::Id3{ 0, 0, 0 });
+      axis_mins.Set(iso * numRows + row, end + 1);
+      axis_maxs.Set(iso * numRows + row, 0);
+    }
 
-    const T value = this->IsoValue;
-    axis_min = this->PointDims[AxisToSum::xindex];
-    axis_max = 0;
     T s1 = field.Get(startPos);
     T s0 = s1;
-    axis_sum = { 0, 0, 0 };
-    const viskores::Id end = this->PointDims[AxisToSum::xindex] - 1;
     for (viskores::Id i = 0; i < end; ++i)
     {
       s0 = s1;
       s1 = field.Get(startPos + (offset * (i + 1)));
 
-      viskores::UInt8 edgeCase = FlyingEdges3D::Below;
-      if (s0 >= value)
-      {
-        edgeCase = FlyingEdges3D::LeftAbove;
-      }
-      if (s1 >= value)
+      for (viskores::Id iso = 0; iso < numIsoValues; ++iso)
       {
-        edgeCase |= FlyingEdges3D::RightAbove;
-      }
+        const T value = isovalues.Get(iso);
+        viskores::UInt8 edgeCase = FlyingEdges3D::Below;
+        if (s0 >= value)
+        {
+          edgeCase = FlyingEdges3D::LeftAbove;
+        }
+        if (s1 >= value)
+        {
+          edgeCase |= FlyingEdges3D::RightAbove;
+        }
 
-      write_edge(AxisToSum{}, startPos + (offset * i), edges, edgeCase);
+        write_edge(AxisToSum{}, iso * numPoints + startPos + (offset * i), edges, edgeCase);
 
-      if (edgeCase == FlyingEdges3D::LeftAbove || edgeCase == FlyingEdges3D::RightAbove)
-      {
-        axis_sum[AxisToSum::xindex] += 1; // increment number of intersections along axis
-        axis_max = i + 1;
-        if (axis_min == (end + 1))
+        if (edgeCase == FlyingEdges3D::LeftAbove || edgeCase == FlyingEdges3D::RightAbove)
         {
-          axis_min = i;
+          // increment number of intersections along axis
+          const viskores::Id metaIndex = iso * numRows + row;
+          viskores::Id3 sum = axis_sums.Get(metaIndex);
+          sum[AxisToSum::xindex] += 1;
+          axis_sums.Set(metaIndex, sum);
+          axis_maxs.Set(metaIndex, i + 1);
+          if (axis_mins.Get(metaIndex) == (end + 1))
+          {
+            axis_mins.Set(metaIndex, i);
+          }
         }
       }
     }
-    write_edge(AxisToSum{}, startPos + (offset * end), edges, FlyingEdges3D::Below);
+    for (viskores::Id iso = 0; iso < numIsoValues; ++iso)
+    {
+      write_edge(
+        AxisToSum{}, iso * numPoints + startPos + (offset * end), edges, FlyingEdges3D::Below);
+    }
   }
 };
 
@@ -168,21 +192,37 @@ struct launchComputePass1
             typename IVType,
             typename T,
             typename StorageTagField,
-            typename... Args>
+            typename MeshSums>
   VISKORES_CONT bool operator()(DeviceAdapterTag device,
                                 const ComputePass1<IVType>& worklet,
+                                const viskores::cont::ArrayHandle<IVType>& isovalues,
                                 const viskores::cont::ArrayHandle<T, StorageTagField>& inputField,
                                 viskores::cont::ArrayHandle<viskores::UInt8>& edgeCases,
                                 viskores::cont::CellSetStructured<2>& metaDataMesh2D,
-                                Args&&... args) const
+                                MeshSums& metaDataSums,
+                                viskores::cont::ArrayHandle<viskores::Id>& metaDataMin,
+                                viskores::cont::ArrayHandle<viskores::Id>& metaDataMax) const
   {
     using AxisToSum = typename select_AxisToSum<DeviceAdapterTag>::type;
 
     viskores::cont::Invoker invoke(device);
     metaDataMesh2D = make_metaDataMesh2D(AxisToSum{}, worklet.PointDims);
 
+    const viskores::Id numMetaData =
+      isovalues.GetNumberOfValues() * metaDataMesh2D.GetNumberOfPoints();
+    metaDataSums.Allocate(numMetaData);
+    metaDataMin.Allocate(numMetaData);
+    metaDataMax.Allocate(numMetaData);
+
     this->FillEdgeCases(edgeCases, AxisToSum{});
-    invoke(worklet, metaDataMesh2D, std::forward<Args>(args)..., edgeCases, inputField);
+    invoke(worklet,
+           metaDataMesh2D,
+           isovalues,
+           metaDataSums,
+           metaDataMin,
+           metaDataMax,
+           edgeCases,
+           inputField);
     return true;
   }
 };
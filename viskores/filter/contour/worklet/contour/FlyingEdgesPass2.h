@@ -34,70 +34,122 @@ namespace flying_edges
 struct ComputePass2 : public viskores::worklet::WorkletVisitCellsWithPoints
 {
   viskores::Id3 PointDims;
+  viskores::Id NumberOfIsoValues;
 
   ComputePass2() {}
-  explicit ComputePass2(const viskores::Id3& pdims)
+  ComputePass2(const viskores::Id3& pdims, viskores::Id numIsoValues)
     : PointDims(pdims)
+    , NumberOfIsoValues(numIsoValues)
   {
   }
 
   using ControlSignature = void(CellSetIn,
                                 WholeArrayInOut axis_sums,
-                                FieldInPoint axis_mins,
-                                FieldInPoint axis_maxs,
-                                FieldOutCell cell_tri_count,
+                                WholeArrayIn axis_mins,
+                                WholeArrayIn axis_maxs,
+                                WholeArrayOut cell_tri_count,
                                 WholeArrayIn edgeData);
   using ExecutionSignature = void(ThreadIndices, _2, _3, _4, _5, _6, Device);
   using InputDomain = _1;
 
+  // The meta data from pass 1 holds one block per isovalue. Each row of cells is
+  // counted for every isovalue.
   template <typename ThreadIndices,
             typename WholeSumField,
-            typename FieldInPointId,
+            typename WholeIdField,
+            typename WholeTriField,
             typename WholeEdgeField,
             typename Device>
   VISKORES_EXEC void operator()(const ThreadIndices& threadIndices,
                                 const WholeSumField& axis_sums,
-                                const FieldInPointId& axis_mins,
-                                const FieldInPointId& axis_maxs,
-                                viskores::Int32& cell_tri_count,
+                                const WholeIdField& axis_mins,
+                                const WholeIdField& axis_maxs,
+                                const WholeTriField& cell_tri_counts,
                                 const WholeEdgeField& edges,
                                 Device) const
   {
     using AxisToSum = typename select_AxisToSum<Device>::type;
 
+    const viskores::Id3 pdims = this->PointDims;
+    const viskores::Id numPoints = pdims[0] * pdims[1] * pdims[2];
+    const viskores::Id numRows = pdims[AxisToSum::yindex] * pdims[AxisToSum::zindex];
+    const viskores::Id numRowCells =
+      (pdims[AxisToSum::yindex] - 1) * (pdims[AxisToSum::zindex] - 1);
+    const auto& indices = threadIndices.GetIndicesIncident();
+    for (viskores::Id iso = 0; iso < this->NumberOfIsoValues; ++iso)
+    {
+      const viskores::Id4 metaIds(iso * numRows + indices[0],
+                                  iso * numRows + indices[1],
+                                  iso * numRows + indices[2],
+                                  iso * numRows + indices[3]);
+      cell_tri_counts.Set(iso * numRowCells + threadIndices.GetInputIndex(),
+                          this->CountRow(AxisToSum{},
+                                         threadIndices.GetInputIndex3D(),
+                                         metaIds,
+                                         iso * numPoints,
+                                         axis_sums,
+                                         axis_mins,
+                                         axis_maxs,
+                                         edges));
+    }
+  }
+
+  template <typename AxisToSum,
+            typename WholeSumField,
+            typename WholeIdField,
+            typename WholeEdgeField>
+  VISKORES_EXEC viskores::Int32 CountRow(AxisToSum,
+                                         const viskores::Id3& executionSpaceIJK,
+                                         const viskores::Id4& metaIds,
+                                         viskores::Id edgeOffset,
+                                         const WholeSumField& axis_sums,
+                                         const WholeIdField& axis_mins,
+                                         const WholeIdField& axis_maxs,
+                                         const WholeEdgeField& edges) const
+  {
     // Pass 2. Traverse all cells in the meta data plane. This allows us to
     // easily grab the four edge cases bounding this voxel-row
-    const viskores::Id3 ijk = compute_ijk(AxisToSum{}, threadIndices.GetInputIndex3D());
+    const viskores::Id3 ijk = compute_ijk(AxisToSum{}, executionSpaceIJK);
     const viskores::Id3 pdims = this->PointDims;
 
-    const viskores::Id4 startPos = compute_neighbor_starts(AxisToSum{}, ijk, pdims);
+    viskores::Id4 startPos = compute_neighbor_starts(AxisToSum{}, ijk, pdims);
+    startPos += viskores::Id4(edgeOffset);
     const viskores::Id axis_inc = compute_inc(AxisToSum{}, pdims);
 
+    const viskores::Id4 mins(axis_mins.Get(metaIds[0]),
+                             axis_mins.Get(metaIds[1]),
+                             axis_mins.Get(metaIds[2]),
+                             axis_mins.Get(metaIds[3]));
+    const viskores::Id4 maxs(axis_maxs.Get(metaIds[0]),
+                             axis_maxs.Get(metaIds[1]),
+                             axis_maxs.Get(metaIds[2]),
+                             axis_maxs.Get(metaIds[3]));
+
     // Compute the subset (start and end) of the row that we need
     // to iterate to generate triangles for the iso-surface
     viskores::Id left, right;
     bool hasWork = computeTrimBounds(
-      pdims[AxisToSum::xindex] - 1, edges, axis_mins, axis_maxs, startPos, axis_inc, left, right);
+      pdims[AxisToSum::xindex] - 1, edges, mins, maxs, startPos, axis_inc, left, right);
     if (!hasWork)
     {
-      return;
+      return 0;
     }
 
     viskores::Vec<bool, 3> onBoundary(false, false, false); //updated in for-loop
     onBoundary[AxisToSum::yindex] = (ijk[AxisToSum::yindex] >= (pdims[AxisToSum::yindex] - 2));
     onBoundary[AxisToSum::zindex] = (ijk[AxisToSum::zindex] >= (pdims[AxisToSum::zindex] - 2));
 
-    cell_tri_count = 0;
-    viskores::Id3 sums = axis_sums.Get(threadIndices.GetIndicesIncident()[0]);
+    viskores::Int32 cell_tri_count = 0;
+    viskores::Id3 sums = axis_sums.Get(metaIds[0]);
     viskores::Id3 adj_row_sum(0, 0, 0);
     viskores::Id3 adj_col_sum(0, 0, 0);
     if (onBoundary[AxisToSum::yindex])
     {
-      adj_row_sum = axis_sums.Get(threadIndices.GetIndicesIncident()[1]);
+      adj_row_sum = axis_sums.Get(metaIds[1]);
     }
     if (onBoundary[AxisToSum::zindex])
     {
-      adj_col_sum = axis_sums.Get(threadIndices.GetIndicesIncident()[3]);
+      adj_col_sum = axis_sums.Get(metaIds[3]);
     }
 
     for (viskores::Id i = left; i < right; ++i) // run along the trimmed voxels
@@ -126,15 +178,16 @@ struct ComputePass2 : public viskores::worklet::WorkletVisitCellsWithPoints
       }
     }
 
-    axis_sums.Set(threadIndices.GetIndicesIncident()[0], sums);
+    axis_sums.Set(metaIds[0], sums);
     if (onBoundary[AxisToSum::yindex])
     {
-      axis_sums.Set(threadIndices.GetIndicesIncident()[1], adj_row_sum);
+      axis_sums.Set(metaIds[1], adj_row_sum);
     }
     if (onBoundary[AxisToSum::zindex])
     {
-      axis_sums.Set(threadIndices.GetIndicesIncident()[3], adj_col_sum);
+      axis_sums.Set(metaIds[3], adj_col_sum);
     }
+    return cell_tri_count;
   }
 
   //----------------------------------------------------------------------------
@@ -54,7 +54,10 @@ struct launchComputePass4
             typename T,
             typename CoordsType,
             typename StorageTagField,
+            typename EdgeCases,
             typename MeshSums,
+            typename MeshIds,
+            typename MeshTris,
             typename PointType,
             typename NormalType>
   VISKORES_CONT bool LaunchXAxis(
@@ -63,12 +66,12 @@ struct launchComputePass4
     IVType isoval,
     CoordsType coordinateSystem,
     const viskores::cont::ArrayHandle<T, StorageTagField>& inputField,
-    viskores::cont::ArrayHandle<viskores::UInt8> edgeCases,
+    const EdgeCases& edgeCases,
     viskores::cont::CellSetStructured<2>& metaDataMesh2D,
     const MeshSums& metaDataSums,
-    const viskores::cont::ArrayHandle<viskores::Id>& metaDataMin,
-    const viskores::cont::ArrayHandle<viskores::Id>& metaDataMax,
-    const viskores::cont::ArrayHandle<viskores::Int32>& metaDataNumTris,
+    const MeshIds& metaDataMin,
+    const MeshIds& metaDataMax,
+    const MeshTris& metaDataNumTris,
     viskores::worklet::contour::CommonState& sharedState,
     viskores::cont::ArrayHandle<viskores::Id>& triangle_topology,
     PointType& points,
@@ -123,7 +126,10 @@ struct launchComputePass4
             typename T,
             typename CoordsType,
             typename StorageTagField,
+            typename EdgeCases,
             typename MeshSums,
+            typename MeshIds,
+            typename MeshTris,
             typename PointType,
             typename NormalType>
   VISKORES_CONT bool LaunchYAxis(
@@ -132,12 +138,12 @@ struct launchComputePass4
     IVType isoval,
     CoordsType coordinateSystem,
     const viskores::cont::ArrayHandle<T, StorageTagField>& inputField,
-    viskores::cont::ArrayHandle<viskores::UInt8> edgeCases,
+    const EdgeCases& edgeCases,
     viskores::cont::CellSetStructured<2>& metaDataMesh2D,
     const MeshSums& metaDataSums,
-    const viskores::cont::ArrayHandle<viskores::Id>& metaDataMin,
-    const viskores::cont::ArrayHandle<viskores::Id>& metaDataMax,
-    const viskores::cont::ArrayHandle<viskores::Int32>& metaDataNumTris,
+    const MeshIds& metaDataMin,
+    const MeshIds& metaDataMax,
+    const MeshTris& metaDataNumTris,
     viskores::worklet::contour::CommonState& sharedState,
     viskores::cont::ArrayHandle<viskores::Id>& triangle_topology,
     PointType& points,
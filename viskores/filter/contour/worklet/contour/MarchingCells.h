@@ -30,20 +30,21 @@
 #include <viskores/cont/ArrayCopyDevice.h>
 #include <viskores/cont/ArrayHandle.h>
 #include <viskores/cont/ArrayHandleIndex.h>
+#include <viskores/cont/ArrayHandlePermutation.h>
 #include <viskores/cont/ArrayHandleTransform.h>
 #include <viskores/cont/ArrayHandleZip.h>
 #include <viskores/cont/Invoker.h>
 
-#include <viskores/worklet/Keys.h>
 #include <viskores/worklet/ScatterCounting.h>
 #include <viskores/worklet/ScatterPermutation.h>
 
 #include <viskores/filter/contour/worklet/contour/CommonState.h>
 #include <viskores/filter/contour/worklet/contour/FieldPropagation.h>
 #include <viskores/filter/contour/worklet/contour/MarchingCellTables.h>
+#include <viskores/filter/contour/worklet/contour/SpanSpace.h>
+#include <viskores/filter/contour/worklet/contour/UniqueEdges.h>
 #include <viskores/filter/vector_analysis/worklet/gradient/PointGradient.h>
 #include <viskores/filter/vector_analysis/worklet/gradient/StructuredPointGradient.h>
-#include <viskores/worklet/WorkletReduceByKey.h>
 
 namespace viskores
 {
@@ -226,6 +227,29 @@ public:
   }
 };
 
+// ---------------------------------------------------------------------------
+// Classifies only the cells listed by a ScatterPermutation.
+template <viskores::UInt8 Dims, typename T>
+class ClassifyCandidateCell : public ClassifyCell<Dims, T>
+{
+public:
+  using ScatterType = viskores::worklet::ScatterPermutation<>;
+};
+
+struct CopyToCell : viskores::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn value, FieldIn cellId, WholeArrayOut cellValues);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename T, typename PortalType>
+  VISKORES_EXEC void operator()(const T& value,
+                                viskores::Id cellId,
+                                const PortalType& cellValues) const
+  {
+    cellValues.Set(cellId, value);
+  }
+};
+
 /// \brief Used to store data need for the EdgeWeightGenerate worklet.
 /// This information is not passed as part of the arguments to the worklet as
 /// that dramatically increase compile time by 200%
@@ -593,105 +617,36 @@ VISKORES_EXEC viskores::ErrorCode EdgeWeightGenerate<Dims>::CrossingLocalIndex(
   return viskores::exec::CellEdgeLocalIndex(numPoints, pointIndex, edgeIndex, shape, result);
 }
 
-// ---------------------------------------------------------------------------
-struct MultiContourLess
-{
-  template <typename T>
-  VISKORES_EXEC_CONT bool operator()(const T& a, const T& b) const
-  {
-    return a < b;
-  }
-
-  template <typename T, typename U>
-  VISKORES_EXEC_CONT bool operator()(const viskores::Pair<T, U>& a,
-                                     const viskores::Pair<T, U>& b) const
-  {
-    return (a.first < b.first) || (!(b.first < a.first) && (a.second < b.second));
-  }
-
-  template <typename T, typename U>
-  VISKORES_EXEC_CONT bool operator()(const viskores::internal::ArrayPortalValueReference<T>& a,
-                                     const U& b) const
-  {
-    U&& t = static_cast<U>(a);
-    return t < b;
-  }
-};
-
-// ---------------------------------------------------------------------------
-struct MergeDuplicateValues : viskores::worklet::WorkletReduceByKey
-{
-  using ControlSignature = void(KeysIn keys,
-                                ValuesIn valuesIn1,
-                                ValuesIn valuesIn2,
-                                ReducedValuesOut valueOut1,
-                                ReducedValuesOut valueOut2);
-  using ExecutionSignature = void(_1, _2, _3, _4, _5);
-  using InputDomain = _1;
-
-  template <typename T,
-            typename ValuesInType,
-            typename Values2InType,
-            typename ValuesOutType,
-            typename Values2OutType>
-  VISKORES_EXEC void operator()(const T&,
-                                const ValuesInType& values1,
-                                const Values2InType& values2,
-                                ValuesOutType& valueOut1,
-                                Values2OutType& valueOut2) const
-  {
-    valueOut1 = values1[0];
-    valueOut2 = values2[0];
-  }
-};
-
-// ---------------------------------------------------------------------------
-struct CopyEdgeIds : viskores::worklet::WorkletMapField
-{
-  using ControlSignature = void(FieldIn, FieldOut);
-  using ExecutionSignature = void(_1, _2);
-  using InputDomain = _1;
-
-  VISKORES_EXEC
-  void operator()(const viskores::Id2& input, viskores::Id2& output) const { output = input; }
-
-  template <typename T>
-  VISKORES_EXEC void operator()(const viskores::Pair<T, viskores::Id2>& input,
-                                viskores::Id2& output) const
-  {
-    output = input.second;
-  }
-};
-
 // ---------------------------------------------------------------------------
 template <typename KeyType, typename KeyStorage>
-void MergeDuplicates(const viskores::cont::Invoker& invoker,
-                     const viskores::cont::ArrayHandle<KeyType, KeyStorage>& original_keys,
+void MergeDuplicates(const viskores::cont::ArrayHandle<KeyType, KeyStorage>& original_keys,
                      viskores::cont::ArrayHandle<viskores::FloatDefault>& weights,
                      viskores::cont::ArrayHandle<viskores::Id2>& edgeIds,
                      viskores::cont::ArrayHandle<viskores::Id>& cellids,
                      viskores::cont::ArrayHandle<viskores::Id>& connectivity)
 {
-  viskores::cont::ArrayHandle<KeyType> input_keys;
-  viskores::cont::ArrayCopyDevice(original_keys, input_keys);
-  viskores::worklet::Keys<KeyType> keys(input_keys);
-  input_keys.ReleaseResources();
+  //keep the first point generated for each key, and connect to it
+  viskores::cont::ArrayHandle<viskores::Id> uniqueToInput;
+  viskores::worklet::contour::UniqueEdges(original_keys, uniqueToInput, connectivity);
 
   {
-    viskores::cont::ArrayHandle<viskores::Id> writeCells;
     viskores::cont::ArrayHandle<viskores::FloatDefault> writeWeights;
-    invoker(MergeDuplicateValues{}, keys, weights, cellids, writeWeights, writeCells);
+    viskores::cont::ArrayCopyDevice(
+      viskores::cont::make_ArrayHandlePermutation(uniqueToInput, weights), writeWeights);
     weights = writeWeights;
+  }
+  {
+    viskores::cont::ArrayHandle<viskores::Id> writeCells;
+    viskores::cont::ArrayCopyDevice(
+      viskores::cont::make_ArrayHandlePermutation(uniqueToInput, cellids), writeCells);
     cellids = writeCells;
   }
-
-  //need to build the new connectivity
-  auto uniqueKeys = keys.GetUniqueKeys();
-  viskores::cont::Algorithm::LowerBounds(
-    uniqueKeys, original_keys, connectivity, marching_cells::MultiContourLess());
-
-  //update the edge ids
-  invoker(CopyEdgeIds{}, uniqueKeys, edgeIds);
+  {
+    viskores::cont::ArrayHandle<viskores::Id2> writeEdgeIds;
+    viskores::cont::ArrayCopyDevice(
+      viskores::cont::make_ArrayHandlePermutation(uniqueToInput, edgeIds), writeEdgeIds);
+    edgeIds = writeEdgeIds;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -932,6 +887,27 @@ viskores::cont::CellSetSingleType<> execute(
   // Call the ClassifyCell functor to compute the Marching Cubes case numbers
   // for each cell, and the number of vertices to be generated
   viskores::cont::ArrayHandle<viskores::IdComponent> numOutputTrisPerCell;
+  if (sharedState.SpanSpaceIndices)
+  {
+    // Only classify the cells that the span space lists for these isovalues.
+    // All other cells generate nothing.
+    std::shared_ptr<const viskores::worklet::contour::SpanSpace> spanSpace =
+      sharedState.SpanSpaceIndices->Get(sharedState.SpanSpaceCellSet, cells, inputField);
+    viskores::cont::ArrayHandle<viskores::Id> candidateCells =
+      spanSpace->GetCandidateCells(isovalues);
+
+    using ClassifyType = marching_cells::ClassifyCandidateCell<Dims, ValueType>;
+    viskores::cont::ArrayHandle<viskores::IdComponent> numCandidateTris;
+    invoker(ClassifyType{},
+            typename ClassifyType::ScatterType(candidateCells),
+            isoValuesHandle,
+            inputField,
+            cells,
+            numCandidateTris);
+    numOutputTrisPerCell.AllocateAndFill(cells.GetNumberOfCells(), 0);
+    invoker(CopyToCell{}, numCandidateTris, candidateCells, numOutputTrisPerCell);
+  }
+  else
   {
     marching_cells::ClassifyCell<Dims, ValueType> classifyCell;
     invoker(classifyCell, isoValuesHandle, inputField, cells, numOutputTrisPerCell);
@@ -977,22 +953,20 @@ viskores::cont::CellSetSingleType<> execute(
     // output. But for InterpolationEdgeIds we need to do it manually once done
     if (isovalues.size() == 1)
     {
-      marching_cells::MergeDuplicates(invoker,
-                                      sharedState.InterpolationEdgeIds, //keys
+      marching_cells::MergeDuplicates(sharedState.InterpolationEdgeIds, //keys
                                       sharedState.InterpolationWeights, //values
                                       sharedState.InterpolationEdgeIds, //values
                                       originalCellIdsForPoints,         //values
-                                      connectivity); // computed using lower bounds
+                                      connectivity); // computed from the unique edges
     }
     else
     {
       marching_cells::MergeDuplicates(
-        invoker,
         viskores::cont::make_ArrayHandleZip(contourIds, sharedState.InterpolationEdgeIds), //keys
         sharedState.InterpolationWeights,                                                  //values
         sharedState.InterpolationEdgeIds,                                                  //values
         originalCellIdsForPoints,                                                          //values
-        connectivity); // computed using lower bounds
+        connectivity); // computed from the unique edges
     }
   }
   else
@@ -0,0 +1,364 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_worklet_contour_SpanSpace_h
+#define viskores_worklet_contour_SpanSpace_h
+
+#include <viskores/BinaryOperators.h>
+
+#include <viskores/cont/Algorithm.h>
+#include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/ArrayHandleIndex.h>
+#include <viskores/cont/Invoker.h>
+#include <viskores/cont/LocatorCache.h>
+#include <viskores/cont/UnknownCellSet.h>
+
+#include <viskores/worklet/ScatterCounting.h>
+#include <viskores/worklet/WorkletMapField.h>
+#include <viskores/worklet/WorkletMapTopology.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace viskores
+{
+namespace worklet
+{
+namespace contour
+{
+
+namespace span_space
+{
+
+VISKORES_EXEC_CONT inline viskores::Id ComputeBucket(viskores::Float64 value,
+                                                    viskores::Float64 rangeMin,
+                                                    viskores::Float64 bucketScale,
+                                                    viskores::Id numBuckets)
+{
+  const viskores::Id bucket = static_cast<viskores::Id>((value - rangeMin) * bucketScale);
+  return viskores::Max(viskores::Id{ 0 }, viskores::Min(bucket, numBuckets - 1));
+}
+
+class CellRange : public viskores::worklet::WorkletVisitCellsWithPoints
+{
+public:
+  using ControlSignature = void(CellSetIn cellSet,
+                                FieldInPoint fieldIn,
+                                FieldOutCell cellMin,
+                                FieldOutCell cellMax);
+  using ExecutionSignature = void(_2, _3, _4);
+
+  template <typename FieldInType>
+  VISKORES_EXEC void operator()(const FieldInType& fieldIn,
+                                viskores::Float64& cellMin,
+                                viskores::Float64& cellMax) const
+  {
+    cellMin = static_cast<viskores::Float64>(fieldIn[0]);
+    cellMax = cellMin;
+    for (viskores::IdComponent point = 1; point < fieldIn.GetNumberOfComponents(); ++point)
+    {
+      const viskores::Float64 value = static_cast<viskores::Float64>(fieldIn[point]);
+      cellMin = viskores::Min(cellMin, value);
+      cellMax = viskores::Max(cellMax, value);
+    }
+  }
+};
+
+class BucketKey : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn cellMin, FieldIn cellMax, FieldOut key);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  BucketKey(viskores::Float64 rangeMin, viskores::Float64 bucketScale, viskores::Id numBuckets)
+    : RangeMin(rangeMin)
+    , BucketScale(bucketScale)
+    , NumberOfBuckets(numBuckets)
+  {
+  }
+
+  VISKORES_EXEC void operator()(viskores::Float64 cellMin,
+                                viskores::Float64 cellMax,
+                                viskores::Id& key) const
+  {
+    key = ComputeBucket(cellMin, this->RangeMin, this->BucketScale, this->NumberOfBuckets) *
+        this->NumberOfBuckets +
+      ComputeBucket(cellMax, this->RangeMin, this->BucketScale, this->NumberOfBuckets);
+  }
+
+private:
+  viskores::Float64 RangeMin;
+  viskores::Float64 BucketScale;
+  viskores::Id NumberOfBuckets;
+};
+
+class GatherRanges : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn rangeStart, WholeArrayIn sortedCellIds, FieldOut cellId);
+  using ExecutionSignature = void(_1, VisitIndex, _2, _3);
+  using ScatterType = viskores::worklet::ScatterCounting;
+
+  template <typename CellIdsPortal>
+  VISKORES_EXEC void operator()(viskores::Id rangeStart,
+                                viskores::IdComponent visitIndex,
+                                const CellIdsPortal& sortedCellIds,
+                                viskores::Id& cellId) const
+  {
+    cellId = sortedCellIds.Get(rangeStart + visitIndex);
+  }
+};
+
+} // namespace span_space
+
+/// \brief Span space index of the cells of a mesh for contouring.
+///
+/// Every cell is placed in a bucket by the range of the scalar field over its
+/// points: the buckets are a grid over the (minimum, maximum) plane of the field
+/// range. Cells are sorted by bucket, so the cells that can contain an isovalue
+/// are a few contiguous runs of the sorted cells. The index is built once for a
+/// cell set and field and reused for any number of isovalues.
+class SpanSpace
+{
+public:
+  explicit SpanSpace(viskores::Id numBuckets = 128)
+    : NumberOfBuckets(numBuckets)
+  {
+  }
+
+  /// Builds the index of the field over the cells.
+  template <typename CellSetType, typename ArrayHandleType>
+  VISKORES_CONT void Build(const CellSetType& cells, const ArrayHandleType& field)
+  {
+    viskores::cont::Invoker invoke;
+
+    viskores::cont::ArrayHandle<viskores::Float64> cellMin;
+    viskores::cont::ArrayHandle<viskores::Float64> cellMax;
+    invoke(span_space::CellRange{}, cells, field, cellMin, cellMax);
+
+    const viskores::Id numCells = cellMin.GetNumberOfValues();
+    this->RangeMin = viskores::cont::Algorithm::Reduce(
+      cellMin, viskores::Infinity64(), viskores::Minimum{});
+    this->RangeMax = viskores::cont::Algorithm::Reduce(
+      cellMax, viskores::NegativeInfinity64(), viskores::Maximum{});
+    const viskores::Float64 rangeLength = this->RangeMax - this->RangeMin;
+    this->BucketScale = (rangeLength > 0)
+      ? static_cast<viskores::Float64>(this->NumberOfBuckets) / rangeLength
+      : 0;
+
+    viskores::cont::ArrayHandle<viskores::Id> keys;
+    invoke(span_space::BucketKey{ this->RangeMin, this->BucketScale, this->NumberOfBuckets },
+           cellMin,
+           cellMax,
+           keys);
+    viskores::cont::Algorithm::Copy(viskores::cont::ArrayHandleIndex(numCells),
+                                    this->SortedCellIds);
+    viskores::cont::Algorithm::SortByKey(keys, this->SortedCellIds);
+
+    // The offsets of the buckets are small enough to look up on the host.
+    viskores::cont::ArrayHandle<viskores::Id> bucketEnds;
+    viskores::cont::Algorithm::UpperBounds(
+      keys,
+      viskores::cont::ArrayHandleIndex(this->NumberOfBuckets * this->NumberOfBuckets),
+      bucketEnds);
+    auto bucketEndsPortal = bucketEnds.ReadPortal();
+    this->BucketOffsets.resize(static_cast<std::size_t>(bucketEnds.GetNumberOfValues() + 1));
+    this->BucketOffsets[0] = 0;
+    for (viskores::Id bucket = 0; bucket < bucketEnds.GetNumberOfValues(); ++bucket)
+    {
+      this->BucketOffsets[static_cast<std::size_t>(bucket + 1)] = bucketEndsPortal.Get(bucket);
+    }
+  }
+
+  /// Returns the cells that may contain any of the isovalues. These are the
+  /// cells whose minimum and maximum buckets bracket the bucket of an isovalue,
+  /// so every cell with `min <= isovalue < max` is listed.
+  template <typename ValueType>
+  VISKORES_CONT viskores::cont::ArrayHandle<viskores::Id> GetCandidateCells(
+    const std::vector<ValueType>& isovalues) const
+  {
+    const viskores::Id numBuckets = this->NumberOfBuckets;
+    std::vector<viskores::Id2> ranges;
+    for (const ValueType& isovalue : isovalues)
+    {
+      const viskores::Float64 value = static_cast<viskores::Float64>(isovalue);
+      if (!(value >= this->RangeMin && value < this->RangeMax))
+      {
+        continue;
+      }
+
+      // Cells with the minimum in a bucket up to the isovalue bucket and the
+      // maximum in a bucket from the isovalue bucket. Each minimum bucket is a
+      // contiguous run of sorted cells.
+      const viskores::Id bucket =
+        span_space::ComputeBucket(value, this->RangeMin, this->BucketScale, numBuckets);
+      for (viskores::Id minBucket = 0; minBucket <= bucket; ++minBucket)
+      {
+        const viskores::Id start =
+          this->BucketOffsets[static_cast<std::size_t>(minBucket * numBuckets + bucket)];
+        const viskores::Id end =
+          this->BucketOffsets[static_cast<std::size_t>((minBucket + 1) * numBuckets)];
+        if (end > start)
+        {
+          ranges.emplace_back(start, end);
+        }
+      }
+    }
+
+    // Merge the runs of all the isovalues so that no cell is listed twice.
+    std::sort(ranges.begin(),
+              ranges.end(),
+              [](const viskores::Id2& a, const viskores::Id2& b) { return a[0] < b[0]; });
+    std::vector<viskores::Id> rangeStarts;
+    std::vector<viskores::IdComponent> rangeLengths;
+    viskores::Id2 current(0, 0);
+    for (const viskores::Id2& range : ranges)
+    {
+      if (range[0] > current[1])
+      {
+        if (current[1] > current[0])
+        {
+          rangeStarts.push_back(current[0]);
+          rangeLengths.push_back(static_cast<viskores::IdComponent>(current[1] - current[0]));
+        }
+        current = range;
+      }
+      else
+      {
+        current[1] = viskores::Max(current[1], range[1]);
+      }
+    }
+    if (current[1] > current[0])
+    {
+      rangeStarts.push_back(current[0]);
+      rangeLengths.push_back(static_cast<viskores::IdComponent>(current[1] - current[0]));
+    }
+
+    viskores::cont::ArrayHandle<viskores::Id> candidates;
+    if (rangeStarts.empty())
+    {
+      return candidates;
+    }
+    auto lengthsHandle = viskores::cont::make_ArrayHandle(rangeLengths, viskores::CopyFlag::Off);
+    viskores::cont::Invoker invoke;
+    invoke(span_space::GatherRanges{},
+           span_space::GatherRanges::ScatterType(lengthsHandle),
+           viskores::cont::make_ArrayHandle(rangeStarts, viskores::CopyFlag::Off),
+           this->SortedCellIds,
+           candidates);
+    return candidates;
+  }
+
+  VISKORES_CONT viskores::Id GetNumberOfBuckets() const { return this->NumberOfBuckets; }
+
+private:
+  viskores::Id NumberOfBuckets;
+  viskores::Float64 RangeMin = 0;
+  viskores::Float64 RangeMax = 0;
+  viskores::Float64 BucketScale = 0;
+  viskores::cont::ArrayHandle<viskores::Id> SortedCellIds;
+  std::vector<viskores::Id> BucketOffsets;
+};
+
+/// \brief The span space indices built for the cell sets and fields a filter contours.
+///
+/// An index is found by the cell set object and by the buffers of the field and
+/// connectivity, along with how many times each buffer had been written, as for
+/// `viskores::cont::LocatorCache`. Thus, an index is rebuilt when the field values are
+/// modified in place. The cache can be used from several threads at once, such as
+/// for the partitions of a `PartitionedDataSet`, and holds one index per partition up
+/// to its capacity. The least recently used index is dropped when the cache is full.
+class SpanSpaceCache
+{
+public:
+  explicit SpanSpaceCache(std::size_t capacity = 16)
+    : Capacity(std::max(capacity, std::size_t{ 1 }))
+  {
+  }
+
+  /// Returns the index of the field over the cells, building it if it is not cached.
+  /// `cellSet` is the cell set that `cells` was taken from, which identifies the index.
+  template <typename CellSetType, typename ArrayHandleType>
+  VISKORES_CONT std::shared_ptr<const SpanSpace> Get(
+    const viskores::cont::UnknownCellSet& cellSet,
+    const CellSetType& cells,
+    const ArrayHandleType& field)
+  {
+    viskores::cont::detail::LocatorCacheKey key(cellSet, field);
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto entry = std::find_if(this->Entries.begin(),
+                                this->Entries.end(),
+                                [&](const Entry& candidate) { return candidate.Key == key; });
+      if (entry != this->Entries.end())
+      {
+        std::rotate(entry, entry + 1, this->Entries.end());
+        return this->Entries.back().Index;
+      }
+    }
+
+    // Build without holding the lock so that other partitions are not held up.
+    auto index = std::make_shared<SpanSpace>();
+    index->Build(cells, field);
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    ++this->NumberOfBuilds;
+    // An index of the same arrays, built before they were modified, is stale.
+    this->Entries.erase(std::remove_if(this->Entries.begin(),
+                                       this->Entries.end(),
+                                       [&](const Entry& entry)
+                                       {
+                                         return (entry.Key.CellSet == key.CellSet) &&
+                                           (entry.Key.Buffers == key.Buffers);
+                                       }),
+                        this->Entries.end());
+    if (this->Entries.size() >= this->Capacity)
+    {
+      this->Entries.erase(this->Entries.begin());
+    }
+    this->Entries.push_back(Entry{ cellSet, std::move(key), index });
+    return index;
+  }
+
+  /// The number of indices the cache has built.
+  VISKORES_CONT viskores::Id GetNumberOfBuilds() const
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->NumberOfBuilds;
+  }
+
+  /// The number of indices held by the cache.
+  VISKORES_CONT std::size_t GetNumberOfIndices() const
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Entries.size();
+  }
+
+private:
+  struct Entry
+  {
+    // Keeps the cell set alive so that the object in the key is not reused.
+    viskores::cont::UnknownCellSet CellSet;
+    viskores::cont::detail::LocatorCacheKey Key;
+    std::shared_ptr<const SpanSpace> Index;
+  };
+
+  mutable std::mutex Mutex;
+  std::size_t Capacity;
+  // Ordered from the least to the most recently used.
+  std::vector<Entry> Entries;
+  viskores::Id NumberOfBuilds = 0;
+};
+
+}
+}
+} // namespace viskores::worklet::contour
+
+#endif // viskores_worklet_contour_SpanSpace_h
@@ -0,0 +1,193 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_worklet_contour_UniqueEdges_h
+#define viskores_worklet_contour_UniqueEdges_h
+
+#include <viskores/Pair.h>
+#include <viskores/Types.h>
+
+#include <viskores/cont/Algorithm.h>
+#include <viskores/cont/ArrayCopyDevice.h>
+#include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/ArrayHandleIndex.h>
+#include <viskores/cont/ArrayHandlePermutation.h>
+#include <viskores/cont/Invoker.h>
+
+#include <viskores/worklet/WorkletMapField.h>
+
+namespace viskores
+{
+namespace worklet
+{
+namespace contour
+{
+
+namespace unique_edges
+{
+
+static constexpr viskores::Id EmptySlot = -1;
+
+/// The table is kept at most two thirds full.
+VISKORES_CONT inline viskores::Id GetTableSize(viskores::Id numberOfKeys)
+{
+  return numberOfKeys + (numberOfKeys / 2) + 1;
+}
+
+// 64-bit FNV-1a of the point ids of the edge.
+VISKORES_EXEC inline viskores::UInt64 HashKey(const viskores::Id2& edge)
+{
+  viskores::UInt64 hash = 14695981039346656037ULL;
+  hash = (hash ^ static_cast<viskores::UInt64>(edge[0])) * 1099511628211ULL;
+  hash = (hash ^ static_cast<viskores::UInt64>(edge[1])) * 1099511628211ULL;
+  return hash;
+}
+
+// Edges of different contours are different keys.
+template <typename T>
+VISKORES_EXEC inline viskores::UInt64 HashKey(const viskores::Pair<T, viskores::Id2>& key)
+{
+  return (HashKey(key.second) ^ static_cast<viskores::UInt64>(key.first)) * 1099511628211ULL;
+}
+
+// Worklet that inserts every key into the table. Each occupied slot ends up holding the
+// smallest index of the keys that hash to it and are equal, so the result does not depend
+// on the order the keys were inserted in.
+class InsertKeys : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn key, WholeArrayIn keys, AtomicArrayInOut table);
+  using ExecutionSignature = void(_1, InputIndex, _2, _3);
+
+  template <typename KeyType, typename KeysPortal, typename TableArray>
+  VISKORES_EXEC void operator()(const KeyType& key,
+                                viskores::Id index,
+                                const KeysPortal& keys,
+                                const TableArray& table) const
+  {
+    const viskores::Id tableSize = table.GetNumberOfValues();
+    viskores::Id slot =
+      static_cast<viskores::Id>(HashKey(key) % static_cast<viskores::UInt64>(tableSize));
+    while (true)
+    {
+      viskores::Id occupant = EmptySlot;
+      if (table.CompareExchange(slot, &occupant, index))
+      {
+        return;
+      }
+      if (keys.Get(occupant) == key)
+      {
+        // Only equal keys are ever stored in this slot, so keep the smaller index.
+        while ((index < occupant) && !table.CompareExchange(slot, &occupant, index))
+        {
+        }
+        return;
+      }
+      slot = (slot + 1 < tableSize) ? slot + 1 : 0;
+    }
+  }
+};
+
+// Worklet that finds the first index of every key once all keys are in the table.
+class LookupKeys : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn key,
+                                WholeArrayIn keys,
+                                WholeArrayIn table,
+                                FieldOut firstIndex,
+                                FieldOut isFirst);
+  using ExecutionSignature = void(_1, InputIndex, _2, _3, _4, _5);
+
+  template <typename KeyType, typename KeysPortal, typename TablePortal>
+  VISKORES_EXEC void operator()(const KeyType& key,
+                                viskores::Id index,
+                                const KeysPortal& keys,
+                                const TablePortal& table,
+                                viskores::Id& firstIndex,
+                                viskores::UInt8& isFirst) const
+  {
+    const viskores::Id tableSize = table.GetNumberOfValues();
+    viskores::Id slot =
+      static_cast<viskores::Id>(HashKey(key) % static_cast<viskores::UInt64>(tableSize));
+    firstIndex = table.Get(slot);
+    while (!(keys.Get(firstIndex) == key))
+    {
+      slot = (slot + 1 < tableSize) ? slot + 1 : 0;
+      firstIndex = table.Get(slot);
+    }
+    isFirst = (firstIndex == index) ? 1 : 0;
+  }
+};
+
+class ScatterRank : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn firstIndex, WholeArrayOut rank);
+  using ExecutionSignature = void(_1, WorkIndex, _2);
+
+  template <typename RankPortal>
+  VISKORES_EXEC void operator()(viskores::Id firstIndex,
+                                viskores::Id uniqueIndex,
+                                const RankPortal& rank) const
+  {
+    rank.Set(firstIndex, uniqueIndex);
+  }
+};
+
+} // namespace unique_edges
+
+/// \brief Finds the distinct keys of an array of edge keys.
+///
+/// The keys are `viskores::Id2` edges, optionally paired with a contour index.
+/// Equal keys are matched with a concurrent hash table, so only the distinct keys
+/// are sorted. The result is the same as sorting all the keys and removing the
+/// duplicates. `uniqueToInput` gets the index of the first occurrence of each
+/// distinct key, ordered by key. `inputToUnique` gets the position of every key
+/// in that order.
+template <typename KeyArrayType>
+VISKORES_CONT void UniqueEdges(const KeyArrayType& keys,
+                               viskores::cont::ArrayHandle<viskores::Id>& uniqueToInput,
+                               viskores::cont::ArrayHandle<viskores::Id>& inputToUnique)
+{
+  using KeyType = typename KeyArrayType::ValueType;
+  viskores::cont::Invoker invoke;
+
+  const viskores::Id numberOfKeys = keys.GetNumberOfValues();
+  viskores::cont::ArrayHandle<viskores::Id> firstIndex;
+  {
+    viskores::cont::ArrayHandle<viskores::Id> table;
+    table.AllocateAndFill(unique_edges::GetTableSize(numberOfKeys), unique_edges::EmptySlot);
+    invoke(unique_edges::InsertKeys{}, keys, keys, table);
+
+    viskores::cont::ArrayHandle<viskores::UInt8> isFirst;
+    invoke(unique_edges::LookupKeys{}, keys, keys, table, firstIndex, isFirst);
+    viskores::cont::Algorithm::CopyIf(
+      viskores::cont::ArrayHandleIndex(numberOfKeys), isFirst, uniqueToInput);
+  }
+
+  // Order the distinct keys like a sort of all the keys would.
+  {
+    viskores::cont::ArrayHandle<KeyType> uniqueKeys;
+    viskores::cont::ArrayCopyDevice(
+      viskores::cont::make_ArrayHandlePermutation(uniqueToInput, keys), uniqueKeys);
+    viskores::cont::Algorithm::SortByKey(uniqueKeys, uniqueToInput);
+  }
+
+  viskores::cont::ArrayHandle<viskores::Id> rank;
+  rank.Allocate(numberOfKeys);
+  invoke(unique_edges::ScatterRank{}, uniqueToInput, rank);
+  viskores::cont::ArrayCopyDevice(viskores::cont::make_ArrayHandlePermutation(firstIndex, rank),
+                                  inputToUnique);
+}
+
+}
+}
+} // namespace viskores::worklet::contour
+
+#endif // viskores_worklet_contour_UniqueEdges_h
@@ -86,6 +86,10 @@ viskores::cont::DataSet ExternalFaces::DoExecute(const viskores::cont::DataSet&
   {
     outCellSet = this->Worklet->Run(cells.AsCellSet<viskores::cont::CellSetStructured<3>>());
   }
+  else if (cells.CanConvert<viskores::cont::CellSetStructured<2>>())
+  {
+    outCellSet = this->Worklet->Run(cells.AsCellSet<viskores::cont::CellSetStructured<2>>());
+  }
   else
   {
     outCellSet =
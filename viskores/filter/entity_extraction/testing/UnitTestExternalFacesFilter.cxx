@@ -23,6 +23,9 @@
 #include <viskores/filter/clean_grid/CleanGrid.h>
 #include <viskores/filter/entity_extraction/ExternalFaces.h>
 
+#include <algorithm>
+#include <vector>
+
 using viskores::cont::testing::MakeTestDataSet;
 
 namespace
@@ -222,6 +225,50 @@ void TestWithCurvilinearGrid()
   TestExternalFacesStructuredGrid(ds, true);
 }
 
+std::vector<std::vector<viskores::Id>> GetSortedFaces(const viskores::cont::DataSet& ds)
+{
+  std::vector<std::vector<viskores::Id>> faces;
+  const viskores::cont::UnknownCellSet& cellSet = ds.GetCellSet();
+  for (viskores::Id cellIndex = 0; cellIndex < cellSet.GetNumberOfCells(); ++cellIndex)
+  {
+    std::vector<viskores::Id> face(
+      static_cast<std::size_t>(cellSet.GetNumberOfPointsInCell(cellIndex)));
+    cellSet.GetCellPointIds(cellIndex, face.data());
+    std::sort(face.begin(), face.end());
+    faces.push_back(face);
+  }
+  std::sort(faces.begin(), faces.end());
+  return faces;
+}
+
+void TestUnstructuredMatchesStructured()
+{
+  std::cout << "Testing unstructured faces match structured faces\n";
+  viskores::filter::entity_extraction::ExternalFaces externalFaces;
+  viskores::cont::DataSet structuredFaces = externalFaces.Execute(MakeDataTestSet3());
+  viskores::cont::DataSet unstructuredFaces = externalFaces.Execute(MakeDataTestSet1());
+  VISKORES_TEST_ASSERT(GetSortedFaces(structuredFaces) == GetSortedFaces(unstructuredFaces),
+                       "Unstructured external faces differ from structured external faces");
+}
+
+void TestWith2DStructuredGrid()
+{
+  std::cout << "Testing with 2D structured grid\n";
+  viskores::cont::DataSet ds = MakeTestDataSet().Make2DUniformDataSet1();
+
+  viskores::filter::entity_extraction::ExternalFaces externalFaces;
+  viskores::cont::DataSet resultds = externalFaces.Execute(ds);
+  VISKORES_TEST_ASSERT(resultds.GetNumberOfCells() == ds.GetNumberOfCells(),
+                       "2D cells should be passed as poly data");
+  VISKORES_TEST_ASSERT(resultds.HasField("cellvar"), "Cell field not mapped successfully");
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(resultds.GetField("cellvar").GetData(),
+                                               ds.GetField("cellvar").GetData()));
+
+  externalFaces.SetPassPolyData(false);
+  resultds = externalFaces.Execute(ds);
+  VISKORES_TEST_ASSERT(resultds.GetNumberOfCells() == 0, "2D cells should not be passed");
+}
+
 void TestExternalFacesFilter()
 {
   TestWithHeterogeneousMesh();
@@ -231,6 +278,8 @@ void TestExternalFacesFilter()
   TestWithMixed2Dand3DMesh();
   TestWithUniformGrid();
   TestWithCurvilinearGrid();
+  TestUnstructuredMatchesStructured();
+  TestWith2DStructuredGrid();
 }
 
 } // anonymous namespace
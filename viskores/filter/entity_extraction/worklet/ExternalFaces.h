@@ -19,9 +19,7 @@
 #define viskores_worklet_ExternalFaces_h
 
 #include <viskores/CellShape.h>
-#include <viskores/Hash.h>
 #include <viskores/Math.h>
-#include <viskores/Swap.h>
 
 #include <viskores/exec/CellFace.h>
 
@@ -30,6 +28,7 @@
 #include <viskores/cont/ArrayCopyDevice.h>
 #include <viskores/cont/ArrayGetValues.h>
 #include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/ArrayHandleCast.h>
 #include <viskores/cont/ArrayHandleConcatenate.h>
 #include <viskores/cont/ArrayHandleGroupVec.h>
 #include <viskores/cont/ArrayHandleGroupVecVariable.h>
@@ -200,58 +199,37 @@ struct ExternalFaces
     }
   };
 
-  // Worklet that returns the number of faces for each cell/shape
-  class NumFacesPerCell : public viskores::worklet::WorkletVisitCellsWithPoints
-  {
-  public:
-    using ControlSignature = void(CellSetIn inCellSet, FieldOut numFacesInCell);
-    using ExecutionSignature = void(CellShape, _2);
-    using InputDomain = _1;
-
-    template <typename CellShapeTag>
-    VISKORES_EXEC void operator()(CellShapeTag shape, viskores::IdComponent& numFacesInCell) const
-    {
-      viskores::exec::CellFaceNumberOfFaces(shape, numFacesInCell);
-    }
-  };
-
-  // Worklet that identifies a cell face by a hash value. Not necessarily completely unique.
-  class FaceHash : public viskores::worklet::WorkletVisitCellsWithPoints
+  // Worklet that copies the point indices of 2D structured cells.
+  class CopyStructuredQuads : public viskores::worklet::WorkletVisitCellsWithPoints
   {
   public:
-    using ControlSignature = void(CellSetIn cellset, FieldOutCell cellFaceHashes);
-    using ExecutionSignature = void(CellShape, PointIndices, _2);
+    using ControlSignature = void(CellSetIn inCellSet, FieldOutCell connections);
+    using ExecutionSignature = void(PointIndices, _2);
     using InputDomain = _1;
 
-    template <typename CellShapeTag, typename CellNodeVecType, typename CellFaceHashes>
-    VISKORES_EXEC void operator()(const CellShapeTag shape,
-                                  const CellNodeVecType& cellNodeIds,
-                                  CellFaceHashes& cellFaceHashes) const
+    template <typename PointIndicesType>
+    VISKORES_EXEC void operator()(const PointIndicesType& pointIndices,
+                                  viskores::Id4& connections) const
     {
-      const viskores::IdComponent numFaces = cellFaceHashes.GetNumberOfComponents();
-      for (viskores::IdComponent faceIndex = 0; faceIndex < numFaces; ++faceIndex)
+      for (viskores::IdComponent index = 0; index < 4; ++index)
       {
-        viskores::Id minFacePointId;
-        viskores::exec::CellFaceMinPointId(faceIndex, shape, cellNodeIds, minFacePointId);
-        cellFaceHashes[faceIndex] = static_cast<viskores::HashType>(minFacePointId);
+        connections[index] = pointIndices[index];
       }
     }
   };
 
-  // Worklet that identifies the number of faces per hash.
-  class NumFacesPerHash : public viskores::worklet::WorkletMapField
+  // Worklet that returns the number of faces for each cell/shape
+  class NumFacesPerCell : public viskores::worklet::WorkletVisitCellsWithPoints
   {
   public:
-    using ControlSignature = void(FieldIn faceHashes, AtomicArrayInOut numFacesPerHash);
-    using ExecutionSignature = void(_1, _2);
+    using ControlSignature = void(CellSetIn inCellSet, FieldOut numFacesInCell);
+    using ExecutionSignature = void(CellShape, _2);
     using InputDomain = _1;
 
-    template <typename NumFacesPerHashArray>
-    VISKORES_EXEC void operator()(const viskores::HashType& faceHash,
-                                  NumFacesPerHashArray& numFacesPerHash) const
+    template <typename CellShapeTag>
+    VISKORES_EXEC void operator()(CellShapeTag shape, viskores::IdComponent& numFacesInCell) const
     {
-      // MemoryOrder::Relaxed is safe here, since we're not using the atomics for synchronization.
-      numFacesPerHash.Add(faceHash, 1, viskores::MemoryOrder::Relaxed);
+      viskores::exec::CellFaceNumberOfFaces(shape, numFacesInCell);
     }
   };
 
@@ -294,227 +272,122 @@ struct ExternalFaces
     }
   };
 
-  // Worklet that writes out the cell and face ids of each face per hash.
-  class BuildFacesPerHash : public viskores::worklet::WorkletMapField
+  /// Open addressing table of faces keyed on the canonical face id. Each occupied slot
+  /// holds the packed cell and face id of the first face inserted with that canonical id.
+  /// The top bit of the slot is flipped for every other face that matches it, so a slot
+  /// with the bit clear holds a face that is not shared with another cell.
+  struct FaceTable
   {
-  public:
-    using ControlSignature = void(FieldIn cellFaceHashes,
-                                  AtomicArrayInOut numFacesPerHash,
-                                  WholeArrayOut cellAndFaceIdOfFacesPerHash);
-    using ExecutionSignature = void(InputIndex, _1, _2, _3);
-    using InputDomain = _1;
+    static constexpr CellFaceIdPacker::CellAndFaceIdType EmptySlot = ~0ULL;
+    static constexpr CellFaceIdPacker::CellAndFaceIdType SharedBit = 1ULL << 63;
 
-    template <typename CellFaceHashes,
-              typename NumFacesPerHashArray,
-              typename CellAndFaceIdOfFacePerHashArray>
-    VISKORES_EXEC void operator()(
-      viskores::Id inputIndex,
-      const CellFaceHashes& cellFaceHashes,
-      NumFacesPerHashArray& numFacesPerHash,
-      CellAndFaceIdOfFacePerHashArray& cellAndFaceIdOfFacesPerHash) const
+    /// The table is kept at most two thirds full.
+    VISKORES_CONT static viskores::Id GetTableSize(viskores::Id numberOfFaces)
     {
-      const viskores::IdComponent numFaces = cellFaceHashes.GetNumberOfComponents();
-      for (viskores::IdComponent faceIndex = 0; faceIndex < numFaces; ++faceIndex)
+      return numberOfFaces + (numberOfFaces / 2) + 1;
+    }
+
+    VISKORES_EXEC static viskores::UInt64 Hash(const viskores::Id3& faceId)
+    {
+      // 64-bit FNV-1a of the canonical point ids.
+      viskores::UInt64 hash = 14695981039346656037ULL;
+      for (viskores::IdComponent index = 0; index < 3; ++index)
       {
-        const auto& faceHash = cellFaceHashes[faceIndex];
-        // MemoryOrder::Relaxed is safe here, since we're not using the atomics for synchronization.
-        const viskores::IdComponent hashFaceIndex =
-          numFacesPerHash.Add(faceHash, -1, viskores::MemoryOrder::Relaxed) - 1;
-        cellAndFaceIdOfFacesPerHash.Get(faceHash)[hashFaceIndex] =
-          CellFaceIdPacker::Pack(inputIndex, static_cast<CellFaceIdPacker::FaceIdType>(faceIndex));
+        hash = (hash ^ static_cast<viskores::UInt64>(faceId[index])) * 1099511628211ULL;
       }
+      return hash;
     }
   };
 
-  // Worklet that identifies the number of external faces per Hash.
-  // Because there can be collisions in the hash, this instance hash might
-  // represent multiple faces, which have to be checked. The resulting
-  // number is the total number of external faces. It also reorders the
-  // faces so that the external faces are first, followed by the internal faces.
-  class FaceCounts : public viskores::worklet::WorkletMapField
+  // Worklet that inserts every face into the face table. A face that matches one already
+  // in the table is internal, so it only marks that slot as shared.
+  class InsertFaces : public viskores::worklet::WorkletVisitCellsWithPoints
   {
   public:
-    using ControlSignature = void(FieldInOut cellAndFaceIdOfFacesInHash,
+    using ControlSignature = void(CellSetIn cellSet,
                                   WholeCellSetIn<> inputCells,
-                                  FieldOut externalFacesInHash);
-    using ExecutionSignature = _3(_1, _2);
+                                  AtomicArrayInOut faceTable);
+    using ExecutionSignature = void(CellShape, PointIndices, InputIndex, _2, _3);
     using InputDomain = _1;
 
-    template <typename CellAndFaceIdOfFacesInHash, typename CellSetType>
-    VISKORES_EXEC viskores::IdComponent operator()(
-      CellAndFaceIdOfFacesInHash& cellAndFaceIdOfFacesInHash,
-      const CellSetType& cellSet) const
+    template <typename CellShapeTag,
+              typename CellNodeVecType,
+              typename CellSetType,
+              typename FaceTableArray>
+    VISKORES_EXEC void operator()(const CellShapeTag shape,
+                                  const CellNodeVecType& cellNodeIds,
+                                  viskores::Id cellIndex,
+                                  const CellSetType& cellSet,
+                                  const FaceTableArray& faceTable) const
     {
-      const viskores::IdComponent numFacesInHash =
-        cellAndFaceIdOfFacesInHash.GetNumberOfComponents();
-
-      static constexpr viskores::IdComponent FACE_CANONICAL_IDS_CACHE_SIZE = 100;
-      if (numFacesInHash <= 1)
-      {
-        // Either one or zero faces. If there is one, it's external, In either case, do nothing.
-        return numFacesInHash;
-      }
-      else if (numFacesInHash <= FACE_CANONICAL_IDS_CACHE_SIZE) // Fast path with caching
+      const viskores::Id tableSize = faceTable.GetNumberOfValues();
+      viskores::IdComponent numFaces;
+      viskores::exec::CellFaceNumberOfFaces(shape, numFaces);
+      for (viskores::IdComponent faceIndex = 0; faceIndex < numFaces; ++faceIndex)
       {
-        CellFaceIdPacker::CellIdType myCellId;
-        CellFaceIdPacker::FaceIdType myFaceId;
-        viskores::Vec<viskores::Id3, FACE_CANONICAL_IDS_CACHE_SIZE> faceCanonicalIds;
-        for (viskores::IdComponent faceIndex = 0; faceIndex < numFacesInHash; ++faceIndex)
-        {
-          CellFaceIdPacker::Unpack(cellAndFaceIdOfFacesInHash[faceIndex], myCellId, myFaceId);
-          viskores::exec::CellFaceCanonicalId(myFaceId,
-                                              cellSet.GetCellShape(myCellId),
-                                              cellSet.GetIndices(myCellId),
-                                              faceCanonicalIds[faceIndex]);
-        }
-        // Start by assuming all faces are duplicate, then remove two for each duplicate pair found.
-        viskores::IdComponent numExternalFaces = 0;
-        // Iterate over the faces in the hash in reverse order (to minimize the swaps being
-        // performed) and find duplicates faces. Put duplicates at the end and unique faces
-        // at the beginning. Narrow this range until all unique/duplicate are found.
-        for (viskores::IdComponent myIndex = numFacesInHash - 1; myIndex >= numExternalFaces;)
+        viskores::Id3 faceId;
+        viskores::exec::CellFaceCanonicalId(faceIndex, shape, cellNodeIds, faceId);
+        const CellFaceIdPacker::CellAndFaceIdType cellAndFaceId =
+          CellFaceIdPacker::Pack(cellIndex, static_cast<CellFaceIdPacker::FaceIdType>(faceIndex));
+
+        viskores::Id slot = static_cast<viskores::Id>(
+          FaceTable::Hash(faceId) % static_cast<viskores::UInt64>(tableSize));
+        while (true)
         {
-          bool isInternal = false;
-          const viskores::Id3& myFace = faceCanonicalIds[myIndex];
-          viskores::IdComponent otherIndex;
-          for (otherIndex = myIndex - 1; otherIndex >= numExternalFaces; --otherIndex)
+          CellFaceIdPacker::CellAndFaceIdType occupant = FaceTable::EmptySlot;
+          if (faceTable.CompareExchange(slot, &occupant, cellAndFaceId))
           {
-            const viskores::Id3& otherFace = faceCanonicalIds[otherIndex];
-            // The first id of the canonical face id is the minimum point id of the face. Since that
-            // is the hash function, we already know that all faces have the same minimum point id.
-            if (/*myFace[0] == otherFace[0] && */ myFace[1] == otherFace[1] &&
-                myFace[2] == otherFace[2])
-            {
-              // Faces are the same. Must be internal. We don't have to worry about otherFace
-              // matching anything else because a proper topology will have at most 2 cells sharing
-              // a face, so there should be no more matches.
-              isInternal = true;
-              break;
-            }
-          }
-          if (isInternal) // If two faces are internal,
-          {               // swap them to the end of the list to avoid revisiting them.
-            --myIndex;    // decrement for the first duplicate face, which is at the end
-            if (myIndex != otherIndex)
-            {
-              FaceCounts::SwapFace<CellFaceIdPacker::CellAndFaceIdType>(
-                cellAndFaceIdOfFacesInHash[otherIndex], cellAndFaceIdOfFacesInHash[myIndex]);
-              viskores::Swap(faceCanonicalIds[otherIndex], faceCanonicalIds[myIndex]);
-            }
-            --myIndex; // decrement for the second duplicate face
-          }
-          else // If the face is external
-          {    // swap it to the front of the list, to avoid revisiting it.
-            if (myIndex != numExternalFaces)
-            {
-              FaceCounts::SwapFace<CellFaceIdPacker::CellAndFaceIdType>(
-                cellAndFaceIdOfFacesInHash[myIndex], cellAndFaceIdOfFacesInHash[numExternalFaces]);
-              viskores::Swap(faceCanonicalIds[myIndex], faceCanonicalIds[numExternalFaces]);
-            }
-            ++numExternalFaces; // increment for the new external face
-            // myIndex remains the same, since we have a new face to check at the same myIndex.
-            // However, numExternalFaces has incremented, so the loop could still terminate.
+            break;
           }
-        }
-        return numExternalFaces;
-      }
-      else // Slow path without caching
-      {
-        CellFaceIdPacker::CellIdType myCellId, otherCellId;
-        CellFaceIdPacker::FaceIdType myFaceId, otherFaceId;
-        viskores::Id3 myFace, otherFace;
-        // Start by assuming all faces are duplicate, then remove two for each duplicate pair found.
-        viskores::IdComponent numExternalFaces = 0;
-        // Iterate over the faces in the hash in reverse order (to minimize the swaps being
-        // performed) and find duplicates faces. Put duplicates at the end and unique faces
-        // at the beginning. Narrow this range until all unique/duplicate are found.
-        for (viskores::IdComponent myIndex = numFacesInHash - 1; myIndex >= numExternalFaces;)
-        {
-          bool isInternal = false;
-          CellFaceIdPacker::Unpack(cellAndFaceIdOfFacesInHash[myIndex], myCellId, myFaceId);
-          viskores::exec::CellFaceCanonicalId(
-            myFaceId, cellSet.GetCellShape(myCellId), cellSet.GetIndices(myCellId), myFace);
-          viskores::IdComponent otherIndex;
-          for (otherIndex = myIndex - 1; otherIndex >= numExternalFaces; --otherIndex)
+
+          CellFaceIdPacker::CellIdType otherCellId;
+          CellFaceIdPacker::FaceIdType otherFaceId;
+          CellFaceIdPacker::Unpack(occupant & ~FaceTable::SharedBit, otherCellId, otherFaceId);
+          viskores::Id3 otherFace;
+          viskores::exec::CellFaceCanonicalId(otherFaceId,
+                                              cellSet.GetCellShape(otherCellId),
+                                              cellSet.GetIndices(otherCellId),
+                                              otherFace);
+          if (otherFace == faceId)
           {
-            CellFaceIdPacker::Unpack(
-              cellAndFaceIdOfFacesInHash[otherIndex], otherCellId, otherFaceId);
-            viskores::exec::CellFaceCanonicalId(otherFaceId,
-                                                cellSet.GetCellShape(otherCellId),
-                                                cellSet.GetIndices(otherCellId),
-                                                otherFace);
-            // The first id of the canonical face id is the minimum point id of the face. Since that
-            // is the hash function, we already know that all faces have the same minimum point id.
-            if (/*myFace[0] == otherFace[0] && */ myFace[1] == otherFace[1] &&
-                myFace[2] == otherFace[2])
-            {
-              // Faces are the same. Must be internal. We don't have to worry about otherFace
-              // matching anything else because a proper topology will have at most 2 cells sharing
-              // a face, so there should be no more matches.
-              isInternal = true;
-              break;
-            }
-          }
-          if (isInternal) // If two faces are internal,
-          {               // swap them to the end of the list to avoid revisiting them.
-            --myIndex;    // decrement for the first duplicate face, which is at the end
-            if (myIndex != otherIndex)
-            {
-              FaceCounts::SwapFace<CellFaceIdPacker::CellAndFaceIdType>(
-                cellAndFaceIdOfFacesInHash[otherIndex], cellAndFaceIdOfFacesInHash[myIndex]);
-            }
-            --myIndex; // decrement for the second duplicate face
-          }
-          else // If the face is external
-          {    // swap it to the front of the list, to avoid revisiting it.
-            if (myIndex != numExternalFaces)
-            {
-              FaceCounts::SwapFace<CellFaceIdPacker::CellAndFaceIdType>(
-                cellAndFaceIdOfFacesInHash[myIndex], cellAndFaceIdOfFacesInHash[numExternalFaces]);
-            }
-            ++numExternalFaces; // increment for the new external face
-            // myIndex remains the same, since we have a new face to check at the same myIndex.
-            // However, numExternalFaces has incremented, so the loop could still terminate.
+            // Adding the top bit flips it. A proper topology has at most two cells sharing
+            // a face, but this also leaves an odd number of matching faces external.
+            faceTable.Add(slot, FaceTable::SharedBit, viskores::MemoryOrder::Relaxed);
+            break;
           }
+          slot = (slot + 1 < tableSize) ? slot + 1 : 0;
         }
-        return numExternalFaces;
       }
     }
+  };
 
-  private:
-    template <typename FaceT, typename FaceRefT>
-    VISKORES_EXEC inline static void SwapFace(FaceRefT&& cellAndFace1, FaceRefT&& cellAndFace2)
+  struct IsExternalFace
+  {
+    VISKORES_EXEC_CONT bool operator()(CellFaceIdPacker::CellAndFaceIdType slot) const
     {
-      const FaceT tmpCellAndFace = cellAndFace1;
-      cellAndFace1 = cellAndFace2;
-      cellAndFace2 = tmpCellAndFace;
+      return (slot != FaceTable::EmptySlot) && ((slot & FaceTable::SharedBit) == 0);
     }
   };
 
 public:
   // Worklet that returns the number of points for each outputted face.
-  // Have to manage the case where multiple faces have the same hash.
   class NumPointsPerFace : public viskores::worklet::WorkletMapField
   {
   public:
-    using ControlSignature = void(FieldIn cellAndFaceIdOfFacesInHash,
+    using ControlSignature = void(FieldIn cellAndFaceIdOfExternalFaces,
                                   WholeCellSetIn<> inputCells,
                                   FieldOut numPointsInExternalFace);
-    using ExecutionSignature = void(_1, _2, VisitIndex, _3);
+    using ExecutionSignature = void(_1, _2, _3);
     using InputDomain = _1;
 
-    using ScatterType = viskores::worklet::ScatterCounting;
-
-    template <typename CellAndFaceIdOfFacesInHash, typename CellSetType>
-    VISKORES_EXEC void operator()(const CellAndFaceIdOfFacesInHash& cellAndFaceIdOfFacesInHash,
+    template <typename CellSetType>
+    VISKORES_EXEC void operator()(CellFaceIdPacker::CellAndFaceIdType cellAndFaceId,
                                   const CellSetType& cellSet,
-                                  viskores::IdComponent visitIndex,
                                   viskores::IdComponent& numPointsInExternalFace) const
     {
-      // external faces are first, so we can use the visit index directly
       CellFaceIdPacker::CellIdType myCellId;
       CellFaceIdPacker::FaceIdType myFaceId;
-      CellFaceIdPacker::Unpack(cellAndFaceIdOfFacesInHash[visitIndex], myCellId, myFaceId);
+      CellFaceIdPacker::Unpack(cellAndFaceId, myCellId, myFaceId);
 
       viskores::exec::CellFaceNumberOfPoints(
         myFaceId, cellSet.GetCellShape(myCellId), numPointsInExternalFace);
@@ -525,28 +398,24 @@ public:
   class BuildConnectivity : public viskores::worklet::WorkletMapField
   {
   public:
-    using ControlSignature = void(FieldIn cellAndFaceIdOfFacesInHash,
+    using ControlSignature = void(FieldIn cellAndFaceIdOfExternalFaces,
                                   WholeCellSetIn<> inputCells,
                                   FieldOut shapesOut,
                                   FieldOut connectivityOut,
                                   FieldOut cellIdMapOut);
-    using ExecutionSignature = void(_1, _2, VisitIndex, _3, _4, _5);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5);
     using InputDomain = _1;
 
-    using ScatterType = viskores::worklet::ScatterCounting;
-
-    template <typename CellAndFaceIdOfFacesInHash, typename CellSetType, typename ConnectivityType>
-    VISKORES_EXEC void operator()(const CellAndFaceIdOfFacesInHash& cellAndFaceIdOfFacesInHash,
+    template <typename CellSetType, typename ConnectivityType>
+    VISKORES_EXEC void operator()(CellFaceIdPacker::CellAndFaceIdType cellAndFaceId,
                                   const CellSetType& cellSet,
-                                  viskores::IdComponent visitIndex,
                                   viskores::UInt8& shapeOut,
                                   ConnectivityType& connectivityOut,
                                   viskores::Id& cellIdMapOut) const
     {
-      // external faces are first, so we can use the visit index directly
       CellFaceIdPacker::CellIdType myCellId;
       CellFaceIdPacker::FaceIdType myFaceId;
-      CellFaceIdPacker::Unpack(cellAndFaceIdOfFacesInHash[visitIndex], myCellId, myFaceId);
+      CellFaceIdPacker::Unpack(cellAndFaceId, myCellId, myFaceId);
 
       const typename CellSetType::CellShapeTag shapeIn = cellSet.GetCellShape(myCellId);
       viskores::exec::CellFaceShape(myFaceId, shapeIn, shapeOut);
@@ -707,6 +576,34 @@ public:
     return outCellSet;
   }
 
+  ///////////////////////////////////////////////////
+  /// \brief ExternalFaces: Pass the cells of a 2D structured grid.
+  ///
+  /// 2D cells have no faces, so like other poly data they are passed to the output when
+  /// PassPolyData is on. The quads are written directly without building the face table.
+  VISKORES_CONT viskores::cont::CellSetSingleType<> Run(
+    const viskores::cont::CellSetStructured<2>& inCellSet)
+  {
+    viskores::cont::ArrayHandle<viskores::Id> connections;
+    if (this->PassPolyData)
+    {
+      viskores::cont::Invoker invoke;
+      invoke(CopyStructuredQuads{},
+             inCellSet,
+             viskores::cont::make_ArrayHandleGroupVec<4>(connections));
+      viskores::cont::ArrayCopy(viskores::cont::ArrayHandleIndex(inCellSet.GetNumberOfCells()),
+                                this->CellIdMap);
+    }
+    else
+    {
+      this->CellIdMap.Allocate(0);
+    }
+
+    viskores::cont::CellSetSingleType<> outCellSet;
+    outCellSet.Fill(inCellSet.GetNumberOfPoints(), viskores::CELL_SHAPE_QUAD, 4, connections);
+    return outCellSet;
+  }
+
   ///////////////////////////////////////////////////
   /// \brief ExternalFaces: Extract Faces on outside of geometry
   template <typename InCellSetType>
@@ -726,11 +623,9 @@ public:
     // Compute the number of faces per cell
     invoke(NumFacesPerCell(), inCellSet, numFacesPerCell);
 
-    // Compute the offsets into a packed array holding face information for each cell.
-    viskores::Id totalNumberOfFaces;
-    viskores::cont::ArrayHandle<viskores::Id> facesPerCellOffsets;
-    viskores::cont::ConvertNumComponentsToOffsets(
-      numFacesPerCell, facesPerCellOffsets, totalNumberOfFaces);
+    // Count the faces to size the face table.
+    const viskores::Id totalNumberOfFaces = viskores::cont::Algorithm::Reduce(
+      viskores::cont::make_ArrayHandleCast<viskores::Id>(numFacesPerCell), viskores::Id(0));
     // Release the resources of numFacesPerCell that is not needed anymore
     numFacesPerCell.ReleaseResources();
 
@@ -788,71 +683,26 @@ public:
       }
     }
 
-    // Create an array to store the hash values of the faces
-    viskores::cont::ArrayHandle<viskores::HashType> faceHashes;
-    faceHashes.Allocate(totalNumberOfFaces);
-
-    // Create a group vec array to access the faces of each cell conveniently
-    auto faceHashesGroupVec =
-      viskores::cont::make_ArrayHandleGroupVecVariable(faceHashes, facesPerCellOffsets);
-
-    // Compute the hash values of the faces
-    invoke(FaceHash(), inCellSet, faceHashesGroupVec);
-
-    // Create an array to store the number of faces per hash
-    const viskores::Id numberOfHashes = inCellSet.GetNumberOfPoints();
-    viskores::cont::ArrayHandle<viskores::IdComponent> numFacesPerHash;
-    numFacesPerHash.AllocateAndFill(numberOfHashes, 0);
-
-    // Count the number of faces per hash
-    invoke(NumFacesPerHash(), faceHashes, numFacesPerHash);
-
-    // Compute the offsets for a packed array holding face information for each hash.
-    viskores::cont::ArrayHandle<viskores::Id> facesPerHashOffsets;
-    viskores::cont::ConvertNumComponentsToOffsets(numFacesPerHash, facesPerHashOffsets);
-
-    // Create an array to store the cell and face ids of each face per hash
-    viskores::cont::ArrayHandle<CellFaceIdPacker::CellAndFaceIdType> cellAndFaceIdOfFacesPerHash;
-    cellAndFaceIdOfFacesPerHash.Allocate(totalNumberOfFaces);
-
-    // Create a group vec array to access/write the cell and face ids of each face per hash
-    auto cellAndFaceIdOfFacesPerHashGroupVec = viskores::cont::make_ArrayHandleGroupVecVariable(
-      cellAndFaceIdOfFacesPerHash, facesPerHashOffsets);
-
-    // Build the cell and face ids of all faces per hash
-    invoke(BuildFacesPerHash(),
-           faceHashesGroupVec,
-           numFacesPerHash,
-           cellAndFaceIdOfFacesPerHashGroupVec);
-    // Release the resources of the arrays that are not needed anymore
-    facesPerCellOffsets.ReleaseResources();
-    faceHashes.ReleaseResources();
-    numFacesPerHash.ReleaseResources();
-
-    // Create an array to count the number of external faces per hash
-    viskores::cont::ArrayHandle<viskores::IdComponent> numExternalFacesPerHash;
-    numExternalFacesPerHash.Allocate(numberOfHashes);
-
-    // Compute the number of external faces per hash
-    invoke(FaceCounts(), cellAndFaceIdOfFacesPerHashGroupVec, inCellSet, numExternalFacesPerHash);
-
-    // Create a scatter counting object to only access the hashes with external faces
-    viskores::worklet::ScatterCounting scatterCullInternalFaces(numExternalFacesPerHash);
-    const viskores::Id numberOfExternalFaces =
-      scatterCullInternalFaces.GetOutputRange(numberOfHashes);
-    // Release the resources of externalFacesPerHash that is not needed anymore
-    numExternalFacesPerHash.ReleaseResources();
+    // Insert every face into a table keyed on its canonical id. Internal faces cancel in the
+    // table, which leaves only the external faces unmarked.
+    viskores::cont::ArrayHandle<CellFaceIdPacker::CellAndFaceIdType> faceTable;
+    faceTable.AllocateAndFill(FaceTable::GetTableSize(totalNumberOfFaces), FaceTable::EmptySlot);
+    invoke(InsertFaces(), inCellSet, inCellSet, faceTable);
+
+    // Collect the external faces. Sorting the packed ids orders them by cell, which makes the
+    // output independent of the order faces were inserted into the table.
+    viskores::cont::ArrayHandle<CellFaceIdPacker::CellAndFaceIdType> externalFaces;
+    viskores::cont::Algorithm::CopyIf(faceTable, faceTable, externalFaces, IsExternalFace());
+    faceTable.ReleaseResources();
+    viskores::cont::Algorithm::Sort(externalFaces);
+    const viskores::Id numberOfExternalFaces = externalFaces.GetNumberOfValues();
 
     // Create an array to store the number of points of the external faces
     PointCountArrayType numPointsPerExternalFace;
     numPointsPerExternalFace.Allocate(numberOfExternalFaces);
 
     // Compute the number of points of the external faces
-    invoke(NumPointsPerFace(),
-           scatterCullInternalFaces,
-           cellAndFaceIdOfFacesPerHashGroupVec,
-           inCellSet,
-           numPointsPerExternalFace);
+    invoke(NumPointsPerFace(), externalFaces, inCellSet, numPointsPerExternalFace);
 
     // Compute the offsets for a packed array holding the point connections for each external face.
     OffsetsArrayType pointsPerExternalFaceOffsets;
@@ -878,8 +728,7 @@ public:
 
     // Build the connectivity of the external faces
     invoke(BuildConnectivity(),
-           scatterCullInternalFaces,
-           cellAndFaceIdOfFacesPerHashGroupVec,
+           externalFaces,
            inCellSet,
            externalFacesShapes,
            externalFacesConnectivityGroupVec,
@@ -0,0 +1,160 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/ArrayExtractComponent.h>
+#include <viskores/cont/ArrayHandleRecombineVec.h>
+#include <viskores/cont/ErrorFilterExecution.h>
+#include <viskores/filter/field_transform/FieldMapChain.h>
+#include <viskores/filter/field_transform/worklet/FieldMapChain.h>
+
+namespace viskores
+{
+namespace filter
+{
+namespace field_transform
+{
+
+VISKORES_CONT void FieldMapChain::AddVectorMagnitude(const std::string& outputFieldName)
+{
+  Stage stage;
+  stage.Type = StageType::Magnitude;
+  stage.OutputFieldName = outputFieldName;
+  this->Stages.push_back(stage);
+}
+
+VISKORES_CONT void FieldMapChain::AddLogValues(LogValues::LogBase base,
+                                               viskores::FloatDefault minValue,
+                                               const std::string& outputFieldName)
+{
+  Stage stage;
+  stage.Type = StageType::LogValues;
+  stage.OutputFieldName = outputFieldName;
+  stage.Base = base;
+  stage.MinValue = minValue;
+  this->Stages.push_back(stage);
+}
+
+VISKORES_CONT void FieldMapChain::AddPointElevation(const viskores::Vec3f_64& lowPoint,
+                                                    const viskores::Vec3f_64& highPoint,
+                                                    viskores::Float64 rangeLow,
+                                                    viskores::Float64 rangeHigh,
+                                                    const std::string& outputFieldName)
+{
+  Stage stage;
+  stage.Type = StageType::Elevation;
+  stage.OutputFieldName = outputFieldName;
+  stage.LowPoint = lowPoint;
+  stage.HighPoint = highPoint;
+  stage.RangeLow = rangeLow;
+  stage.RangeHigh = rangeHigh;
+  this->Stages.push_back(stage);
+}
+
+VISKORES_CONT viskores::cont::DataSet FieldMapChain::DoExecute(
+  const viskores::cont::DataSet& inDataSet)
+{
+  if (this->Stages.empty())
+  {
+    throw viskores::cont::ErrorFilterExecution("FieldMapChain has no stages.");
+  }
+
+  const auto& field = this->GetFieldFromDataSet(inDataSet);
+  const viskores::IdComponent numInputComponents = field.GetData().GetNumberOfComponentsFlat();
+  const viskores::Id numValues = field.GetNumberOfValues();
+
+  // Convert the stages for the worklet and allocate an output array for the last stage and
+  // each selected intermediate stage.
+  std::vector<viskores::worklet::FieldMapStage> execStages;
+  std::vector<std::string> outputNames;
+  std::vector<viskores::cont::ArrayHandle<viskores::FloatDefault>> outputArrays;
+  viskores::cont::ArrayHandleRecombineVec<viskores::FloatDefault> outputs;
+  for (std::size_t stageIndex = 0; stageIndex < this->Stages.size(); ++stageIndex)
+  {
+    const Stage& stage = this->Stages[stageIndex];
+    const viskores::IdComponent numStageComponents = (stageIndex == 0) ? numInputComponents : 1;
+    viskores::worklet::FieldMapStage execStage;
+    switch (stage.Type)
+    {
+      case StageType::Magnitude:
+        execStage.Op = viskores::worklet::FieldMapStage::Operation::Magnitude;
+        break;
+      case StageType::LogValues:
+        if (numStageComponents != 1)
+        {
+          throw viskores::cont::ErrorFilterExecution("LogValues stage requires scalar values.");
+        }
+        switch (stage.Base)
+        {
+          case LogValues::LogBase::E:
+            execStage.Op = viskores::worklet::FieldMapStage::Operation::Log;
+            break;
+          case LogValues::LogBase::TWO:
+            execStage.Op = viskores::worklet::FieldMapStage::Operation::Log2;
+            break;
+          case LogValues::LogBase::TEN:
+            execStage.Op = viskores::worklet::FieldMapStage::Operation::Log10;
+            break;
+          default:
+            throw viskores::cont::ErrorFilterExecution("Unsupported base value.");
+        }
+        execStage.MinValue = stage.MinValue;
+        break;
+      case StageType::Elevation:
+      {
+        if (numStageComponents != 3)
+        {
+          throw viskores::cont::ErrorFilterExecution(
+            "PointElevation stage requires 3D vectors and must be the first stage.");
+        }
+        execStage.Op = viskores::worklet::FieldMapStage::Operation::Elevation;
+        const viskores::Vec3f_64 direction = stage.HighPoint - stage.LowPoint;
+        execStage.LowPoint = stage.LowPoint;
+        execStage.ScaledDirection = direction / viskores::Dot(direction, direction);
+        execStage.RangeLow = stage.RangeLow;
+        execStage.RangeLength = stage.RangeHigh - stage.RangeLow;
+        break;
+      }
+    }
+
+    if ((stageIndex == this->Stages.size() - 1) ||
+        this->FieldsToMaterialize.IsFieldSelected(stage.OutputFieldName, field.GetAssociation()))
+    {
+      execStage.OutputComponent = static_cast<viskores::IdComponent>(outputArrays.size());
+      viskores::cont::ArrayHandle<viskores::FloatDefault> outputArray;
+      outputArray.Allocate(numValues);
+      outputs.AppendComponentArray(viskores::cont::ArrayExtractComponent(outputArray, 0));
+      outputArrays.push_back(outputArray);
+      outputNames.push_back(stage.OutputFieldName);
+    }
+    execStages.push_back(execStage);
+  }
+
+  // All stages run in one worklet. The outputs are written through a Vec of the output
+  // arrays, so each output field still gets its own contiguous array.
+  auto resolveType = [&](const auto& concrete)
+  {
+    this->Invoke(viskores::worklet::FieldMapChain{},
+                 concrete,
+                 viskores::cont::make_ArrayHandle(execStages, viskores::CopyFlag::Off),
+                 outputs);
+  };
+  field.GetData().CastAndCallWithExtractedArray(resolveType);
+
+  viskores::cont::DataSet result = this->CreateResultField(
+    inDataSet, outputNames.back(), field.GetAssociation(), outputArrays.back());
+  for (std::size_t outputIndex = 0; outputIndex + 1 < outputArrays.size(); ++outputIndex)
+  {
+    result.AddField(viskores::cont::Field{
+      outputNames[outputIndex], field.GetAssociation(), outputArrays[outputIndex] });
+  }
+  return result;
+}
+
+} // namespace field_transform
+} // namespace filter
+} // namespace viskores
@@ -0,0 +1,133 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_filter_field_transform_FieldMapChain_h
+#define viskores_filter_field_transform_FieldMapChain_h
+
+#include <viskores/filter/FieldSelection.h>
+#include <viskores/filter/Filter.h>
+#include <viskores/filter/field_transform/LogValues.h>
+#include <viskores/filter/field_transform/viskores_filter_field_transform_export.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace viskores
+{
+namespace filter
+{
+namespace field_transform
+{
+
+/// @brief Applies a chain of per-value field maps in a single pass.
+///
+/// Filters such as `viskores::filter::vector_analysis::VectorMagnitude`,
+/// `viskores::filter::field_transform::LogValues`, and
+/// `viskores::filter::field_transform::PointElevation` compute each output value from
+/// the matching input value alone. Running them one after another writes every
+/// intermediate field out to memory only to read it back in the next filter.
+/// `FieldMapChain` instead runs all of its stages for a value in one worklet, so the
+/// intermediate values are never stored.
+///
+/// The first stage reads the active field. Each following stage reads the value
+/// produced by the stage before it. The output of the last stage is always added to the
+/// result. The outputs of the other stages are only computed into fields when they are
+/// selected with `SetFieldsToMaterialize()`. All outputs are `viskores::FloatDefault`
+/// fields with the same association as the input field.
+///
+/// ```cpp
+/// viskores::filter::field_transform::FieldMapChain chain;
+/// chain.SetActiveField("velocity");
+/// chain.AddVectorMagnitude("speed");
+/// chain.AddLogValues(viskores::filter::field_transform::LogValues::LogBase::TEN, 1e-6f,
+///                    "log_speed");
+/// viskores::cont::DataSet result = chain.Execute(input); // Only log_speed is stored.
+/// ```
+class VISKORES_FILTER_FIELD_TRANSFORM_EXPORT FieldMapChain : public viskores::filter::Filter
+{
+public:
+  /// @brief Adds a stage that computes the magnitude of each value.
+  ///
+  /// This matches `viskores::filter::vector_analysis::VectorMagnitude`. The magnitude of
+  /// a scalar is its absolute value.
+  VISKORES_CONT void AddVectorMagnitude(const std::string& outputFieldName = "magnitude");
+
+  /// @brief Adds a stage that takes the logarithm of each value.
+  ///
+  /// This matches `viskores::filter::field_transform::LogValues`. Values smaller than
+  /// @p minValue are clamped to it first. The stage requires scalar values.
+  VISKORES_CONT void AddLogValues(
+    LogValues::LogBase base = LogValues::LogBase::E,
+    viskores::FloatDefault minValue = std::numeric_limits<viskores::FloatDefault>::min(),
+    const std::string& outputFieldName = "log");
+
+  /// @brief Adds a stage that computes the elevation of each value along a line.
+  ///
+  /// This matches `viskores::filter::field_transform::PointElevation`. The stage requires
+  /// 3D vectors, so it can only be the first stage of the chain.
+  VISKORES_CONT void AddPointElevation(const viskores::Vec3f_64& lowPoint,
+                                       const viskores::Vec3f_64& highPoint,
+                                       viskores::Float64 rangeLow,
+                                       viskores::Float64 rangeHigh,
+                                       const std::string& outputFieldName = "elevation");
+
+  /// @brief Returns the number of stages in the chain.
+  VISKORES_CONT viskores::IdComponent GetNumberOfStages() const
+  {
+    return static_cast<viskores::IdComponent>(this->Stages.size());
+  }
+
+  /// @brief Removes all stages from the chain.
+  VISKORES_CONT void ClearStages() { this->Stages.clear(); }
+
+  /// @brief Specifies which intermediate stage outputs are added to the result.
+  ///
+  /// Stage outputs are matched by their output field name. By default, no intermediate
+  /// outputs are selected, so only the output of the last stage is computed into a field.
+  VISKORES_CONT void SetFieldsToMaterialize(const viskores::filter::FieldSelection& fields)
+  {
+    this->FieldsToMaterialize = fields;
+  }
+  /// @copydoc SetFieldsToMaterialize
+  VISKORES_CONT const viskores::filter::FieldSelection& GetFieldsToMaterialize() const
+  {
+    return this->FieldsToMaterialize;
+  }
+
+private:
+  enum struct StageType
+  {
+    Magnitude,
+    LogValues,
+    Elevation
+  };
+
+  struct Stage
+  {
+    StageType Type;
+    std::string OutputFieldName;
+    LogValues::LogBase Base = LogValues::LogBase::E;
+    viskores::FloatDefault MinValue = 0;
+    viskores::Vec3f_64 LowPoint = { 0, 0, 0 };
+    viskores::Vec3f_64 HighPoint = { 0, 0, 1 };
+    viskores::Float64 RangeLow = 0;
+    viskores::Float64 RangeHigh = 1;
+  };
+
+  VISKORES_CONT viskores::cont::DataSet DoExecute(const viskores::cont::DataSet& input) override;
+
+  std::vector<Stage> Stages;
+  viskores::filter::FieldSelection FieldsToMaterialize;
+};
+
+} // namespace field_transform
+} // namespace filter
+} // namespace viskores
+
+#endif // viskores_filter_field_transform_FieldMapChain_h
@@ -0,0 +1,156 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/ErrorFilterExecution.h>
+#include <viskores/cont/testing/MakeTestDataSet.h>
+#include <viskores/cont/testing/Testing.h>
+#include <viskores/filter/field_transform/FieldMapChain.h>
+#include <viskores/filter/field_transform/LogValues.h>
+#include <viskores/filter/field_transform/PointElevation.h>
+#include <viskores/filter/vector_analysis/VectorMagnitude.h>
+
+namespace
+{
+
+using LogBase = viskores::filter::field_transform::LogValues::LogBase;
+
+viskores::cont::DataSet MakeInput()
+{
+  return viskores::cont::testing::MakeTestDataSet().Make3DUniformDataSet1();
+}
+
+void CheckField(const viskores::cont::DataSet& result,
+                const std::string& resultName,
+                const viskores::cont::DataSet& expected,
+                const std::string& expectedName)
+{
+  VISKORES_TEST_ASSERT(result.HasPointField(resultName), "Missing field ", resultName);
+  VISKORES_TEST_ASSERT(
+    test_equal_ArrayHandles(result.GetPointField(resultName).GetDataAsDefaultFloat(),
+                            expected.GetPointField(expectedName).GetDataAsDefaultFloat()),
+    "Wrong values in ",
+    resultName);
+}
+
+void TestMagnitudeLog()
+{
+  std::cout << "Magnitude then log" << std::endl;
+  viskores::cont::DataSet input = MakeInput();
+  const std::string coordsName = input.GetCoordinateSystemName();
+
+  viskores::filter::vector_analysis::VectorMagnitude magnitude;
+  magnitude.SetActiveField(coordsName);
+  magnitude.SetOutputFieldName("speed");
+  viskores::filter::field_transform::LogValues log;
+  log.SetActiveField("speed");
+  log.SetOutputFieldName("log_speed");
+  log.SetBaseValue(LogBase::TEN);
+  log.SetMinValue(0.5f);
+  viskores::cont::DataSet expected = log.Execute(magnitude.Execute(input));
+
+  viskores::filter::field_transform::FieldMapChain chain;
+  chain.SetActiveField(coordsName);
+  chain.AddVectorMagnitude("speed");
+  chain.AddLogValues(LogBase::TEN, 0.5f, "log_speed");
+  VISKORES_TEST_ASSERT(chain.GetNumberOfStages() == 2);
+
+  viskores::cont::DataSet result = chain.Execute(input);
+  CheckField(result, "log_speed", expected, "log_speed");
+  VISKORES_TEST_ASSERT(!result.HasField("speed"), "Intermediate field should not be stored");
+  VISKORES_TEST_ASSERT(result.HasPointField("pointvar"), "Input fields should be passed");
+
+  chain.SetFieldsToMaterialize({ "speed" });
+  result = chain.Execute(input);
+  CheckField(result, "log_speed", expected, "log_speed");
+  CheckField(result, "speed", expected, "speed");
+}
+
+void TestElevationLog()
+{
+  std::cout << "Elevation then log" << std::endl;
+  viskores::cont::DataSet input = MakeInput();
+  const std::string coordsName = input.GetCoordinateSystemName();
+  const viskores::Vec3f_64 lowPoint(0, 0, 0);
+  const viskores::Vec3f_64 highPoint(4, 4, 0);
+
+  viskores::filter::field_transform::PointElevation elevation;
+  elevation.SetActiveField(coordsName);
+  elevation.SetLowPoint(lowPoint);
+  elevation.SetHighPoint(highPoint);
+  elevation.SetRange(1.0, 100.0);
+  viskores::filter::field_transform::LogValues log;
+  log.SetActiveField("elevation");
+  log.SetOutputFieldName("log_elevation");
+  viskores::cont::DataSet expected = log.Execute(elevation.Execute(input));
+
+  viskores::filter::field_transform::FieldMapChain chain;
+  chain.SetActiveField(coordsName);
+  chain.AddPointElevation(lowPoint, highPoint, 1.0, 100.0);
+  chain.AddLogValues(
+    LogBase::E, std::numeric_limits<viskores::FloatDefault>::min(), "log_elevation");
+  chain.AddVectorMagnitude("abs_log_elevation");
+  chain.SetFieldsToMaterialize({ "elevation", "log_elevation" });
+
+  viskores::cont::DataSet result = chain.Execute(input);
+  CheckField(result, "elevation", expected, "elevation");
+  CheckField(result, "log_elevation", expected, "log_elevation");
+  VISKORES_TEST_ASSERT(result.HasPointField("abs_log_elevation"));
+}
+
+void TestBadStages()
+{
+  std::cout << "Invalid stages" << std::endl;
+  viskores::cont::DataSet input = MakeInput();
+
+  viskores::filter::field_transform::FieldMapChain chain;
+  chain.SetActiveField(input.GetCoordinateSystemName());
+  try
+  {
+    chain.Execute(input);
+    VISKORES_TEST_FAIL("Empty chain should fail.");
+  }
+  catch (const viskores::cont::ErrorFilterExecution&)
+  {
+  }
+
+  chain.AddLogValues();
+  try
+  {
+    chain.Execute(input);
+    VISKORES_TEST_FAIL("Log of vectors should fail.");
+  }
+  catch (const viskores::cont::ErrorFilterExecution&)
+  {
+  }
+
+  chain.ClearStages();
+  chain.AddVectorMagnitude();
+  chain.AddPointElevation({ 0, 0, 0 }, { 0, 0, 1 }, 0, 1);
+  try
+  {
+    chain.Execute(input);
+    VISKORES_TEST_FAIL("Elevation of scalars should fail.");
+  }
+  catch (const viskores::cont::ErrorFilterExecution&)
+  {
+  }
+}
+
+void TestFieldMapChain()
+{
+  TestMagnitudeLog();
+  TestElevationLog();
+  TestBadStages();
+}
+
+} // anonymous namespace
+
+int UnitTestFieldMapChain(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestFieldMapChain, argc, argv);
+}
@@ -0,0 +1,139 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_worklet_FieldMapChain_h
+#define viskores_worklet_FieldMapChain_h
+
+#include <viskores/worklet/WorkletMapField.h>
+
+#include <viskores/Math.h>
+#include <viskores/VecTraits.h>
+#include <viskores/VectorAnalysis.h>
+
+namespace viskores
+{
+namespace worklet
+{
+
+/// One stage of a `FieldMapChain`. The parameters are those of the filter the stage
+/// stands in for.
+struct FieldMapStage
+{
+  enum struct Operation : viskores::UInt8
+  {
+    Magnitude,
+    Log,
+    Log2,
+    Log10,
+    Elevation
+  };
+
+  Operation Op = Operation::Magnitude;
+  /// The component of the output Vec that receives this stage's value, or -1 if the value
+  /// is only passed to the next stage.
+  viskores::IdComponent OutputComponent = -1;
+  viskores::FloatDefault MinValue = 0;
+  viskores::Vec3f_64 LowPoint = { 0, 0, 0 };
+  /// The direction from the low point to the high point divided by its squared length.
+  viskores::Vec3f_64 ScaledDirection = { 0, 0, 1 };
+  viskores::Float64 RangeLow = 0;
+  viskores::Float64 RangeLength = 1;
+};
+
+/// Evaluates a chain of per-value maps for each value of a field. The value produced by
+/// each stage is passed to the next one, and the stages with an output component write
+/// their value to that component of the output.
+class FieldMapChain : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn input, WholeArrayIn stages, FieldOut outputs);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename InVecType, typename StagesPortal, typename OutVecType>
+  VISKORES_EXEC void operator()(const InVecType& input,
+                                const StagesPortal& stages,
+                                OutVecType& outputs) const
+  {
+    FieldMapStage stage = stages.Get(0);
+    viskores::FloatDefault value = Apply(stage, input);
+    Store(stage, value, outputs);
+    const viskores::Id numStages = stages.GetNumberOfValues();
+    for (viskores::Id stageIndex = 1; stageIndex < numStages; ++stageIndex)
+    {
+      stage = stages.Get(stageIndex);
+      value = Apply(stage, value);
+      Store(stage, value, outputs);
+    }
+  }
+
+private:
+  template <typename VecType>
+  VISKORES_EXEC static viskores::FloatDefault Apply(const FieldMapStage& stage,
+                                                    const VecType& value)
+  {
+    using Traits = viskores::VecTraits<VecType>;
+    switch (stage.Op)
+    {
+      case FieldMapStage::Operation::Magnitude:
+      {
+        viskores::FloatDefault sum = 0;
+        const viskores::IdComponent numComponents = Traits::GetNumberOfComponents(value);
+        for (viskores::IdComponent index = 0; index < numComponents; ++index)
+        {
+          const auto component =
+            static_cast<viskores::FloatDefault>(Traits::GetComponent(value, index));
+          sum += component * component;
+        }
+        return viskores::Sqrt(sum);
+      }
+      case FieldMapStage::Operation::Log:
+        return viskores::Log(ClampedScalar(stage, value));
+      case FieldMapStage::Operation::Log2:
+        return viskores::Log2(ClampedScalar(stage, value));
+      case FieldMapStage::Operation::Log10:
+        return viskores::Log10(ClampedScalar(stage, value));
+      case FieldMapStage::Operation::Elevation:
+      {
+        viskores::Vec3f_64 point;
+        for (viskores::IdComponent index = 0; index < 3; ++index)
+        {
+          point[index] = static_cast<viskores::Float64>(Traits::GetComponent(value, index));
+        }
+        viskores::Float64 s = viskores::Dot(point - stage.LowPoint, stage.ScaledDirection);
+        s = viskores::Min(1.0, viskores::Max(0.0, s));
+        return static_cast<viskores::FloatDefault>(stage.RangeLow + (s * stage.RangeLength));
+      }
+    }
+    return viskores::Nan<viskores::FloatDefault>();
+  }
+
+  template <typename VecType>
+  VISKORES_EXEC static viskores::FloatDefault ClampedScalar(const FieldMapStage& stage,
+                                                            const VecType& value)
+  {
+    return viskores::Max(
+      stage.MinValue,
+      static_cast<viskores::FloatDefault>(viskores::VecTraits<VecType>::GetComponent(value, 0)));
+  }
+
+  template <typename OutVecType>
+  VISKORES_EXEC static void Store(const FieldMapStage& stage,
+                                  viskores::FloatDefault value,
+                                  OutVecType& outputs)
+  {
+    if (stage.OutputComponent >= 0)
+    {
+      outputs[stage.OutputComponent] = value;
+    }
+  }
+};
+
+}
+} // namespace viskores::worklet
+
+#endif // viskores_worklet_FieldMapChain_h
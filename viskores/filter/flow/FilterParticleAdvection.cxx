@@ -66,6 +66,13 @@ VISKORES_CONT void FilterParticleAdvection::ValidateOptions() const
     throw viskores::cont::ErrorFilterExecution("NumberOfSteps cannot be negative");
   if (this->StepSize < 0)
     throw viskores::cont::ErrorFilterExecution("StepSize cannot be negative");
+  if (this->CommunicationBatchSize < 1)
+    throw viskores::cont::ErrorFilterExecution("CommunicationBatchSize must be at least 1");
+  if (this->NumberOfWorkerThreads < 0)
+    throw viskores::cont::ErrorFilterExecution("NumberOfWorkerThreads cannot be negative");
+  if (this->PacketWidth != 0 && this->PacketWidth != 4 && this->PacketWidth != 8 &&
+      this->PacketWidth != 16)
+    throw viskores::cont::ErrorFilterExecution("PacketWidth must be 0, 4, 8, or 16");
 }
 
 }
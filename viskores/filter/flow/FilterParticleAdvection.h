@@ -22,6 +22,7 @@
 #include <viskores/Deprecated.h>
 #include <viskores/Particle.h>
 #include <viskores/cont/ErrorFilterExecution.h>
+#include <viskores/cont/LocatorCache.h>
 #include <viskores/filter/Filter.h>
 #include <viskores/filter/flow/FlowTypes.h>
 #include <viskores/filter/flow/internal/BoundsMap.h>
@@ -102,6 +103,68 @@ public:
   VISKORES_CONT
   void SetUseThreadedAlgorithm(bool val) { this->UseThreadedAlgorithm = val; }
 
+  /// @brief Specifies how many threads advect particles with the threaded algorithm.
+  ///
+  /// This only has an effect when `SetUseThreadedAlgorithm()` is on. The worker threads
+  /// share the particles of all local blocks, so several threads can advect in the same
+  /// block. The default of 0 starts one worker per hardware thread.
+  VISKORES_CONT void SetNumberOfWorkerThreads(viskores::Id numThreads)
+  {
+    this->NumberOfWorkerThreads = numThreads;
+  }
+  /// @copydoc SetNumberOfWorkerThreads
+  VISKORES_CONT viskores::Id GetNumberOfWorkerThreads() const
+  {
+    return this->NumberOfWorkerThreads;
+  }
+
+  /// @brief Specifies how many particles are aggregated into one message.
+  ///
+  /// When running with multiple MPI ranks, particles that leave the blocks of a rank are
+  /// sent to the rank that owns their next block while the local particles continue to
+  /// advect. Particles bound for the same rank are collected until this many are ready
+  /// and then sent in one message. A rank that runs out of local work sends its partial
+  /// batches right away, so a larger batch size never delays termination. Larger batches
+  /// mean fewer, bigger messages. The default of 1 sends particles as soon as they leave.
+  VISKORES_CONT void SetCommunicationBatchSize(viskores::Id batchSize)
+  {
+    this->CommunicationBatchSize = batchSize;
+  }
+  /// @copydoc SetCommunicationBatchSize
+  VISKORES_CONT viskores::Id GetCommunicationBatchSize() const
+  {
+    return this->CommunicationBatchSize;
+  }
+
+  /// @brief Specifies how many particles are advected together in a packet.
+  ///
+  /// When set to 4, 8, or 16, steady state RK4 advection on 3D uniform and rectilinear
+  /// grids advances that many particles together. The stages of the RK4 steps are computed
+  /// for all particles of the packet at once, which lets the compiler use the vector units
+  /// of the CPU. Particles that reach the boundary of the grid finish their step
+  /// individually. Other solvers, grids, and fields ignore this option. The default of 0
+  /// advects each particle on its own.
+  VISKORES_CONT void SetPacketWidth(viskores::IdComponent width) { this->PacketWidth = width; }
+  /// @copydoc SetPacketWidth
+  VISKORES_CONT viskores::IdComponent GetPacketWidth() const { return this->PacketWidth; }
+
+  /// @brief Specifies the cache of cell locators for the input blocks.
+  ///
+  /// The cell locator of a block is built when its particles are first advected and is
+  /// then kept in this cache. It is reused for the later rounds of advection and for
+  /// later executions on blocks with the same, unmodified cells and coordinates, such as
+  /// the time steps of a fixed mesh. Filters given copies of the same cache share
+  /// their locators.
+  VISKORES_CONT void SetLocatorCache(const viskores::cont::LocatorCache& cache)
+  {
+    this->Locators = cache;
+  }
+  /// @copydoc SetLocatorCache
+  VISKORES_CONT const viskores::cont::LocatorCache& GetLocatorCache() const
+  {
+    return this->Locators;
+  }
+
   VISKORES_DEPRECATED(2.2, "All communication is asynchronous now.")
   VISKORES_CONT
   void SetUseAsynchronousCommunication() {}
@@ -125,7 +188,11 @@ protected:
   bool BlockIdsSet = false;
   std::vector<viskores::Id> BlockIds;
   viskores::filter::flow::internal::BoundsMap BoundsMap;
+  viskores::Id CommunicationBatchSize = 1;
+  viskores::cont::LocatorCache Locators;
   viskores::Id NumberOfSteps = 0;
+  viskores::Id NumberOfWorkerThreads = 0;
+  viskores::IdComponent PacketWidth = 0;
   viskores::cont::UnknownArrayHandle Seeds;
   viskores::filter::flow::IntegrationSolverType SolverType =
     viskores::filter::flow::IntegrationSolverType::RK4_TYPE;
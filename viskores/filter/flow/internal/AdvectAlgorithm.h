@@ -81,6 +81,16 @@ public:
 
   void SetStepSize(viskores::FloatDefault stepSize) { this->StepSize = stepSize; }
 
+  //Number of particles bound for the same rank that are aggregated into one message.
+#ifdef VISKORES_ENABLE_MPI
+  void SetCommunicationBatchSize(viskores::Id batchSize)
+  {
+    this->Exchanger.SetBatchSize(batchSize);
+  }
+#else
+  void SetCommunicationBatchSize(viskores::Id viskoresNotUsed(batchSize)) {}
+#endif
+
   void SetSeeds(const viskores::cont::ArrayHandle<ParticleType>& seeds)
   {
     this->ClearParticles();
@@ -109,6 +119,9 @@ public:
     this->SetSeedArray(particles, blockIDs);
   }
 
+  //True while there are particles on this rank that still need to be advected.
+  virtual bool HaveLocalWork() { return !this->Active.empty(); }
+
   virtual bool HaveWork()
   {
     const bool haveParticles = !this->Active.empty() || !this->Inactive.empty();
@@ -246,8 +259,10 @@ public:
       std::vector<ParticleType> incoming;
       std::unordered_map<viskores::Id, std::vector<viskores::Id>> incomingBlockIDs;
 
+      //Partial batches are only held back while there are local particles to advect.
+      const bool flush = !this->HaveLocalWork();
       this->Exchanger.Exchange(
-        outgoing, outgoingRanks, this->ParticleBlockIDsMap, incoming, incomingBlockIDs);
+        outgoing, outgoingRanks, this->ParticleBlockIDsMap, incoming, incomingBlockIDs, flush);
 
       //Cleanup what was sent.
       for (const auto& p : outgoing)
@@ -64,6 +64,11 @@ namespace internal
 // In State 2, if the iallreduce returns true, there is new work, so return to State 0.
 // If the iallreduce returns false, then all work is complete and we can terminate.
 //
+// ParticleExchanger sends particles with synchronous mode sends, which only complete once the
+// receiver has matched them, and reports that it has work until its sends complete. A rank
+// therefore cannot enter State 1 while one of its particles is in flight, and the receiving
+// rank marks itself dirty when the particle arrives.
+//
 class AdvectAlgorithmTerminator
 {
 public:
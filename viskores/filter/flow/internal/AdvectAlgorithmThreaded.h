@@ -20,10 +20,16 @@
 #define viskores_filter_flow_internal_AdvectAlgorithmThreaded_h
 
 #include <viskores/cont/PartitionedDataSet.h>
+#include <viskores/cont/RuntimeDeviceTracker.h>
 #include <viskores/filter/flow/internal/AdvectAlgorithm.h>
 #include <viskores/filter/flow/internal/BoundsMap.h>
 #include <viskores/filter/flow/internal/DataSetIntegrator.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
 #include <thread>
 
 namespace viskores
@@ -35,6 +41,15 @@ namespace flow
 namespace internal
 {
 
+// Advects particles with several worker threads while the calling thread manages the
+// particles and the communication with other ranks.
+//
+// The manager splits the active particles of each block into batches and puts them in a
+// queue for that block. Each block belongs to one worker, which takes batches from the front
+// of the queues of its blocks. A worker without work of its own steals batches from the back
+// of the queues of other blocks, so all workers stay busy even when the particles gather in
+// a few blocks. The results of the workers go back to the manager, which routes the
+// particles to their next block and exchanges them with other ranks.
 template <typename DSIType>
 class AdvectAlgorithmThreaded : public AdvectAlgorithm<DSIType>
 {
@@ -53,101 +68,170 @@ public:
       block.SetCopySeedFlag(true);
   }
 
+  //Number of advection worker threads. 0 uses one per hardware thread.
+  void SetNumberOfWorkers(viskores::Id numWorkers) { this->NumberOfWorkers = numWorkers; }
+
   void Go() override
   {
+    std::size_t numWorkers = static_cast<std::size_t>(this->NumberOfWorkers);
+    if (numWorkers == 0)
+      numWorkers = std::max(std::thread::hardware_concurrency(), 1u);
+    this->NumWorkerThreads = numWorkers;
+
+    this->BlockOwners.clear();
+    for (std::size_t i = 0; i < this->Blocks.size(); i++)
+      this->BlockOwners[this->Blocks[i].GetID()] = i % numWorkers;
+
+    //Worker threads run with the device settings of the calling thread, which is blocked
+    //in Manage() until the workers are joined.
+    const viskores::cont::RuntimeDeviceTracker* callerTracker =
+      &viskores::cont::GetRuntimeDeviceTracker();
+
     std::vector<std::thread> workerThreads;
-    workerThreads.emplace_back(std::thread(AdvectAlgorithmThreaded::Worker, this));
-    this->Manage();
+    for (std::size_t i = 0; i < numWorkers; i++)
+      workerThreads.emplace_back(&AdvectAlgorithmThreaded::Work, this, i, callerTracker);
+
+    try
+    {
+      this->Manage();
+    }
+    catch (...)
+    {
+      this->SetDone();
+      for (auto& t : workerThreads)
+        t.join();
+      throw;
+    }
 
-    //This will only work for 1 thread. For > 1, the Blocks will need a mutex.
-    VISKORES_ASSERT(workerThreads.size() == 1);
     for (auto& t : workerThreads)
       t.join();
   }
 
 protected:
-  bool HaveWork() override
+  struct WorkItem
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    return this->AdvectAlgorithm<DSIType>::HaveWork() || this->WorkerActivate;
-  }
+    viskores::Id BlockId = -1;
+    std::vector<ParticleType> Particles;
+    std::unordered_map<viskores::Id, std::vector<viskores::Id>> BlockIDs;
+  };
 
-  virtual bool GetDone() override
+  bool HaveLocalWork() override
   {
     std::lock_guard<std::mutex> lock(this->Mutex);
-#ifndef VISKORES_ENABLE_MPI
-    return !this->CheckHaveWork();
-#else
-    return this->Terminator.Done();
-#endif
+    return !this->Active.empty() || this->NumQueuedBatches > 0 || this->NumBusyWorkers > 0;
   }
 
-  bool WorkerGetDone()
+  bool HaveWork() override
   {
     std::lock_guard<std::mutex> lock(this->Mutex);
-    return this->Done;
+    return this->AdvectAlgorithm<DSIType>::HaveWork() || this->NumQueuedBatches > 0 ||
+      this->NumBusyWorkers > 0 || !this->WorkerResults.empty();
   }
 
-  bool GetActiveParticles(std::vector<ParticleType>& particles, viskores::Id& blockId) override
+  void SetDone()
   {
     std::lock_guard<std::mutex> lock(this->Mutex);
-    bool val = this->AdvectAlgorithm<DSIType>::GetActiveParticles(particles, blockId);
-    this->WorkerActivate = val;
-    return val;
+    this->Done = true;
+    this->WorkerCondition.notify_all();
   }
 
-  void UpdateActive(
-    const std::vector<ParticleType>& particles,
-    const std::unordered_map<viskores::Id, std::vector<viskores::Id>>& idsMap) override
+  //Split the active particles of each block into batches for the workers.
+  void QueueActiveParticles()
   {
-    if (!particles.empty())
+    if (this->Active.empty())
+      return;
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto& it : this->Active)
     {
-      std::lock_guard<std::mutex> lock(this->Mutex);
-      this->AdvectAlgorithm<DSIType>::UpdateActive(particles, idsMap);
+      const auto& particles = it.second;
+      const std::size_t n = particles.size();
+      const std::size_t batchSize = (n + this->NumWorkerThreads - 1) / this->NumWorkerThreads;
+      for (std::size_t start = 0; start < n; start += batchSize)
+      {
+        WorkItem item;
+        item.BlockId = it.first;
+        item.Particles.assign(particles.begin() + static_cast<std::ptrdiff_t>(start),
+                              particles.begin() +
+                                static_cast<std::ptrdiff_t>(std::min(n, start + batchSize)));
+        for (const auto& p : item.Particles)
+          item.BlockIDs[p.GetID()] = this->ParticleBlockIDsMap[p.GetID()];
 
-      //Let workers know there is new work
-      this->WorkerActivateCondition.notify_all();
-      this->WorkerActivate = true;
+        this->Queues[it.first].emplace_back(std::move(item));
+        this->NumQueuedBatches++;
+      }
     }
+    this->Active.clear();
+    this->WorkerCondition.notify_all();
   }
 
-  void SetDone()
+  //Take the next batch for a worker. Must be called with the mutex locked.
+  bool TakeBatch(std::size_t workerIndex, WorkItem& item)
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    this->Done = true;
-    this->WorkerActivateCondition.notify_all();
-  }
+    if (this->NumQueuedBatches == 0)
+      return false;
 
-  static void Worker(AdvectAlgorithmThreaded* algo) { algo->Work(); }
+    //Work on the blocks owned by this worker first.
+    for (auto& it : this->Queues)
+    {
+      if (!it.second.empty() && this->BlockOwners[it.first] == workerIndex)
+      {
+        item = std::move(it.second.front());
+        it.second.pop_front();
+        this->NumQueuedBatches--;
+        return true;
+      }
+    }
 
-  void WorkerWait()
-  {
-    std::unique_lock<std::mutex> lock(this->Mutex);
-    this->WorkerActivateCondition.wait(lock, [this] { return WorkerActivate || Done; });
+    //Otherwise, steal from the back of another queue.
+    for (auto& it : this->Queues)
+    {
+      if (!it.second.empty())
+      {
+        item = std::move(it.second.back());
+        it.second.pop_back();
+        this->NumQueuedBatches--;
+        return true;
+      }
+    }
+    return false;
   }
 
-  void UpdateWorkerResult(viskores::Id blockId, DSIHelperInfo<ParticleType>& b)
+  void Work(std::size_t workerIndex, const viskores::cont::RuntimeDeviceTracker* callerTracker)
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    auto& it = this->WorkerResults[blockId];
-    it.emplace_back(b);
-  }
+    viskores::cont::GetRuntimeDeviceTracker().CopyStateFrom(*callerTracker);
 
-  void Work()
-  {
-    while (!this->WorkerGetDone())
+    while (true)
     {
-      std::vector<ParticleType> v;
-      viskores::Id blockId = -1;
-      if (this->GetActiveParticles(v, blockId))
+      WorkItem item;
       {
-        auto& block = this->GetDataSet(blockId);
-        DSIHelperInfo<ParticleType> bb(v, this->BoundsMap, this->ParticleBlockIDsMap);
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->WorkerCondition.wait(lock,
+                                   [this] { return this->Done || this->NumQueuedBatches > 0; });
+        if (this->Done)
+          return;
+        if (!this->TakeBatch(workerIndex, item))
+          continue;
+        this->NumBusyWorkers++;
+      }
+
+      try
+      {
+        auto& block = this->GetDataSet(item.BlockId);
+        DSIHelperInfo<ParticleType> bb(item.Particles, this->BoundsMap, item.BlockIDs);
         block.Advect(bb, this->StepSize);
-        this->UpdateWorkerResult(blockId, bb);
+
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->WorkerResults.emplace_back(std::move(bb));
+        this->NumBusyWorkers--;
       }
-      else
-        this->WorkerWait();
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->WorkerError = std::current_exception();
+        this->NumBusyWorkers--;
+      }
+      this->ManagerCondition.notify_one();
     }
   }
 
@@ -155,43 +239,54 @@ protected:
   {
     while (!this->GetDone())
     {
-      std::unordered_map<viskores::Id, std::vector<DSIHelperInfo<ParticleType>>> workerResults;
+      std::vector<DSIHelperInfo<ParticleType>> workerResults;
       this->GetWorkerResults(workerResults);
 
-      viskores::Id numTerm = 0;
-      for (auto& it : workerResults)
-        for (auto& r : it.second)
-          numTerm += this->UpdateResult(r);
+      for (const auto& r : workerResults)
+        this->UpdateResult(r);
 
       this->ExchangeParticles();
+      this->QueueActiveParticles();
     }
     this->SetDone();
   }
 
-  void GetWorkerResults(
-    std::unordered_map<viskores::Id, std::vector<DSIHelperInfo<ParticleType>>>& results)
+  void GetWorkerResults(std::vector<DSIHelperInfo<ParticleType>>& results)
   {
     results.clear();
 
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    if (!this->WorkerResults.empty())
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    //Wait a little for results while the workers are busy, but keep coming back to
+    //check for particles from other ranks.
+    if (this->WorkerResults.empty() && this->WorkerError == nullptr &&
+        (this->NumBusyWorkers > 0 || this->NumQueuedBatches > 0))
     {
-      results = this->WorkerResults;
-      this->WorkerResults.clear();
+      this->ManagerCondition.wait_for(
+        lock,
+        std::chrono::milliseconds(1),
+        [this] { return !this->WorkerResults.empty() || this->WorkerError != nullptr; });
     }
-  }
 
-private:
-  bool CheckHaveWork()
-  {
-    return this->AdvectAlgorithm<DSIType>::HaveWork() || this->WorkerActivate;
+    if (this->WorkerError != nullptr)
+      std::rethrow_exception(this->WorkerError);
+
+    results = std::move(this->WorkerResults);
+    this->WorkerResults.clear();
   }
 
-  std::atomic<bool> Done;
+private:
+  std::unordered_map<viskores::Id, std::size_t> BlockOwners;
+  bool Done;
+  std::condition_variable ManagerCondition;
   std::mutex Mutex;
-  bool WorkerActivate = false;
-  std::condition_variable WorkerActivateCondition;
-  std::unordered_map<viskores::Id, std::vector<DSIHelperInfo<ParticleType>>> WorkerResults;
+  std::size_t NumBusyWorkers = 0;
+  std::size_t NumQueuedBatches = 0;
+  std::size_t NumWorkerThreads = 1;
+  viskores::Id NumberOfWorkers = 0;
+  std::unordered_map<viskores::Id, std::deque<WorkItem>> Queues;
+  std::condition_variable WorkerCondition;
+  std::exception_ptr WorkerError;
+  std::vector<DSIHelperInfo<ParticleType>> WorkerResults;
 };
 
 }
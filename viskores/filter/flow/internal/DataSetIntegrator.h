@@ -22,6 +22,7 @@
 #include <viskores/cont/DataSet.h>
 #include <viskores/cont/EnvironmentTracker.h>
 #include <viskores/cont/ErrorFilterExecution.h>
+#include <viskores/cont/LocatorCache.h>
 #include <viskores/cont/ParticleArrayCopy.h>
 #include <viskores/filter/flow/FlowTypes.h>
 #include <viskores/filter/flow/internal/BoundsMap.h>
@@ -33,6 +34,9 @@
 
 #include <viskores/cont/Variant.h>
 
+#include <memory>
+#include <mutex>
+
 #include <viskores/thirdparty/diy/diy.h>
 
 namespace viskores
@@ -128,6 +132,13 @@ public:
 
   VISKORES_CONT viskores::Id GetID() const { return this->Id; }
   VISKORES_CONT void SetCopySeedFlag(bool val) { this->CopySeedArray = val; }
+  //Width of the particle packets for steady state advection. 0 advects one at a time.
+  VISKORES_CONT void SetPacketWidth(viskores::IdComponent width) { this->PacketWidth = width; }
+  //Cache that the cell locator of the block is taken from.
+  VISKORES_CONT void SetLocatorCache(const viskores::cont::LocatorCache& cache)
+  {
+    this->Locators = cache;
+  }
 
   VISKORES_CONT
   void Advect(DSIHelperInfo<ParticleType>& b,
@@ -154,6 +165,10 @@ protected:
   viskoresdiy::mpi::communicator Comm = viskores::cont::EnvironmentTracker::GetCommunicator();
   viskores::Id Rank;
   bool CopySeedArray = false;
+  viskores::IdComponent PacketWidth = 0;
+  viskores::cont::LocatorCache Locators;
+  // Guards the analysis results when several threads advect in the same block.
+  std::shared_ptr<std::mutex> ResultMutex = std::make_shared<std::mutex>();
 };
 
 template <typename Derived, typename ParticleType>
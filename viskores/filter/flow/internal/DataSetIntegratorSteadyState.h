@@ -48,34 +48,126 @@ public:
                        const viskores::cont::DataSet& dataset,
                        const TerminationType& termination,
                        viskores::FloatDefault stepSize,
+                       const viskores::cont::LocatorCache& locators,
                        AnalysisType& analysis)
   {
     using StepperType = viskores::worklet::flow::Stepper<SolverType<SteadyStateGridEvalType>,
                                                          SteadyStateGridEvalType>;
-    SteadyStateGridEvalType eval(dataset, field);
+    SteadyStateGridEvalType eval(dataset, field, locators);
     StepperType stepper(eval, stepSize);
 
     WorkletType worklet;
     worklet.Run(stepper, seedArray, termination, analysis);
   }
 
+  // Packet advection is instantiated for velocity fields of plain particles.
+  using SupportsPackets = std::integral_constant<
+    bool,
+    std::is_same<ParticleType, viskores::Particle>::value &&
+      std::is_same<FieldType,
+                   viskores::worklet::flow::VelocityField<
+                     viskores::cont::ArrayHandle<viskores::Vec3f>>>::value &&
+      std::is_same<TerminationType, viskores::worklet::flow::NormalTermination>::value &&
+      (std::is_same<AnalysisType, viskores::worklet::flow::NoAnalysis<ParticleType>>::value ||
+       std::is_same<AnalysisType,
+                    viskores::worklet::flow::StreamlineAnalysis<ParticleType>>::value)>;
+
+  template <typename LocatorType>
+  static void DoAdvectPackets(viskores::cont::ArrayHandle<ParticleType>& seedArray,
+                              const FieldType& field,
+                              const viskores::cont::DataSet& dataset,
+                              const TerminationType& termination,
+                              viskores::FloatDefault stepSize,
+                              viskores::IdComponent packetWidth,
+                              const viskores::cont::LocatorCache& locators,
+                              AnalysisType& analysis)
+  {
+    using IntegratorType = viskores::worklet::flow::RK4Integrator<SteadyStateGridEvalType>;
+    using StepperType = viskores::worklet::flow::Stepper<IntegratorType, SteadyStateGridEvalType>;
+    SteadyStateGridEvalType eval(dataset, field, locators);
+    StepperType stepper(eval, stepSize);
+    viskores::worklet::flow::PacketRK4Stepper<LocatorType> packetStepper(dataset, field, stepSize);
+
+    WorkletType::RunPackets(packetStepper, stepper, seedArray, termination, analysis, packetWidth);
+  }
+
+  static bool AdvectPackets(viskores::cont::ArrayHandle<ParticleType>& seedArray,
+                            const FieldType& field,
+                            const viskores::cont::DataSet& dataset,
+                            const TerminationType& termination,
+                            viskores::FloatDefault stepSize,
+                            viskores::IdComponent packetWidth,
+                            const viskores::cont::LocatorCache& locators,
+                            AnalysisType& analysis,
+                            std::true_type)
+  {
+    using UniformStepper =
+      viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorUniformGrid>;
+    using RectilinearStepper =
+      viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorRectilinearGrid>;
+    if (UniformStepper::IsSupported(dataset))
+    {
+      DoAdvectPackets<viskores::cont::CellLocatorUniformGrid>(
+        seedArray, field, dataset, termination, stepSize, packetWidth, locators, analysis);
+      return true;
+    }
+    if (RectilinearStepper::IsSupported(dataset))
+    {
+      DoAdvectPackets<viskores::cont::CellLocatorRectilinearGrid>(
+        seedArray, field, dataset, termination, stepSize, packetWidth, locators, analysis);
+      return true;
+    }
+    return false;
+  }
+
+  static bool AdvectPackets(viskores::cont::ArrayHandle<ParticleType>&,
+                            const FieldType&,
+                            const viskores::cont::DataSet&,
+                            const TerminationType&,
+                            viskores::FloatDefault,
+                            viskores::IdComponent,
+                            const viskores::cont::LocatorCache&,
+                            AnalysisType&,
+                            std::false_type)
+  {
+    return false;
+  }
+
   static void Advect(viskores::cont::ArrayHandle<ParticleType>& seedArray,
                      const FieldType& field,
                      const viskores::cont::DataSet& dataset,
                      const TerminationType& termination,
                      const IntegrationSolverType& solverType,
                      viskores::FloatDefault stepSize,
+                     viskores::IdComponent packetWidth,
+                     const viskores::cont::LocatorCache& locators,
                      AnalysisType& analysis)
   {
+    //Packets are used for RK4 on uniform and rectilinear grids. Everything else falls back
+    //to advecting one particle at a time.
+    if (packetWidth > 0 && solverType == IntegrationSolverType::RK4_TYPE &&
+        AdvectPackets(seedArray,
+                      field,
+                      dataset,
+                      termination,
+                      stepSize,
+                      packetWidth,
+                      locators,
+                      analysis,
+                      SupportsPackets{}))
+    {
+      return;
+    }
+
     if (solverType == IntegrationSolverType::RK4_TYPE)
     {
       DoAdvect<viskores::worklet::flow::RK4Integrator>(
-        seedArray, field, dataset, termination, stepSize, analysis);
+        seedArray, field, dataset, termination, stepSize, locators, analysis);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<viskores::worklet::flow::EulerIntegrator>(
-        seedArray, field, dataset, termination, stepSize, analysis);
+        seedArray, field, dataset, termination, stepSize, locators, analysis);
     }
     else
       throw viskores::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -133,6 +225,8 @@ public:
                             this->Termination,
                             this->SolverType,
                             stepSize,
+                            this->PacketWidth,
+                            this->Locators,
                             analysis);
 
     this->UpdateResult(analysis, block);
@@ -152,10 +246,12 @@ public:
       viskores::cont::ArrayHandle<ParticleType> termParticles;
       viskores::cont::Algorithm::Copy(termPerm, termParticles);
       analysis.FinalizeAnalysis(termParticles);
+      std::lock_guard<std::mutex> lock(*this->ResultMutex);
       this->Analyses.emplace_back(analysis);
     }
     else
     {
+      std::lock_guard<std::mutex> lock(*this->ResultMutex);
       this->Analyses.emplace_back(analysis);
     }
   }
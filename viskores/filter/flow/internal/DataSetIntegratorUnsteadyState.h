@@ -53,13 +53,14 @@ public:
                        viskores::FloatDefault t2,
                        const TerminationType& termination,
                        viskores::FloatDefault stepSize,
+                       const viskores::cont::LocatorCache& locators,
                        AnalysisType& analysis)
 
   {
     using StepperType = viskores::worklet::flow::Stepper<SolverType<UnsteadyStateGridEvalType>,
                                                          UnsteadyStateGridEvalType>;
     WorkletType worklet;
-    UnsteadyStateGridEvalType eval(ds1, t1, field1, ds2, t2, field2);
+    UnsteadyStateGridEvalType eval(ds1, t1, field1, ds2, t2, field2, locators);
     StepperType stepper(eval, stepSize);
     worklet.Run(stepper, seedArray, termination, analysis);
   }
@@ -74,17 +75,18 @@ public:
                      const TerminationType& termination,
                      const IntegrationSolverType& solverType,
                      viskores::FloatDefault stepSize,
+                     const viskores::cont::LocatorCache& locators,
                      AnalysisType& analysis)
   {
     if (solverType == IntegrationSolverType::RK4_TYPE)
     {
       DoAdvect<viskores::worklet::flow::RK4Integrator>(
-        seedArray, field1, ds1, t1, field2, ds2, t2, termination, stepSize, analysis);
+        seedArray, field1, ds1, t1, field2, ds2, t2, termination, stepSize, locators, analysis);
     }
     else if (solverType == IntegrationSolverType::EULER_TYPE)
     {
       DoAdvect<viskores::worklet::flow::EulerIntegrator>(
-        seedArray, field1, ds1, t1, field2, ds2, t2, termination, stepSize, analysis);
+        seedArray, field1, ds1, t1, field2, ds2, t2, termination, stepSize, locators, analysis);
     }
     else
       throw viskores::cont::ErrorFilterExecution("Unsupported Integrator type");
@@ -154,6 +156,7 @@ public:
                             this->Termination,
                             this->SolverType,
                             stepSize,
+                            this->Locators,
                             analysis);
     this->UpdateResult(analysis, block);
   }
@@ -172,10 +175,12 @@ public:
       viskores::cont::ArrayHandle<ParticleType> termParticles;
       viskores::cont::Algorithm::Copy(termPerm, termParticles);
       analysis.FinalizeAnalysis(termParticles);
+      std::lock_guard<std::mutex> lock(*this->ResultMutex);
       this->Analyses.emplace_back(analysis);
     }
     else
     {
+      std::lock_guard<std::mutex> lock(*this->ResultMutex);
       this->Analyses.emplace_back(analysis);
     }
   }
@@ -72,6 +72,13 @@ FilterParticleAdvectionSteadyState<Derived>::DoExecutePartitions(
   else
     this->BoundsMap = viskores::filter::flow::internal::BoundsMap(input);
 
+  // Keep the locators of all the local blocks between the rounds of advection.
+  const auto numBlocks = static_cast<std::size_t>(input.GetNumberOfPartitions());
+  if (this->Locators.GetCapacity() < numBlocks)
+  {
+    this->Locators.SetCapacity(numBlocks);
+  }
+
   std::vector<DSIType> dsi;
   for (viskores::Id i = 0; i < input.GetNumberOfPartitions(); i++)
   {
@@ -86,10 +93,16 @@ FilterParticleAdvectionSteadyState<Derived>::DoExecutePartitions(
     AnalysisType analysis = this->GetAnalysis(dataset);
 
     dsi.emplace_back(blockId, field, dataset, this->SolverType, termination, analysis);
+    dsi.back().SetPacketWidth(this->PacketWidth);
+    dsi.back().SetLocatorCache(this->Locators);
   }
 
   viskores::filter::flow::internal::ParticleAdvector<DSIType> pav(
-    this->BoundsMap, dsi, this->UseThreadedAlgorithm);
+    this->BoundsMap,
+    dsi,
+    this->UseThreadedAlgorithm,
+    this->CommunicationBatchSize,
+    this->NumberOfWorkerThreads);
 
   viskores::cont::ArrayHandle<ParticleType> particles;
   this->Seeds.AsArrayHandle(particles);
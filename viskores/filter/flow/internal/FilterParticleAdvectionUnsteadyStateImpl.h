@@ -70,6 +70,14 @@ FilterParticleAdvectionUnsteadyState<Derived>::DoExecutePartitions(
   else
     this->BoundsMap = viskores::filter::flow::internal::BoundsMap(input);
 
+  // Keep the locators of both time steps of all the local blocks between the rounds of
+  // advection.
+  const auto numLocators = 2 * static_cast<std::size_t>(input.GetNumberOfPartitions());
+  if (this->Locators.GetCapacity() < numLocators)
+  {
+    this->Locators.SetCapacity(numLocators);
+  }
+
   std::vector<DSIType> dsi;
   for (viskores::Id i = 0; i < input.GetNumberOfPartitions(); i++)
   {
@@ -96,9 +104,14 @@ FilterParticleAdvectionUnsteadyState<Derived>::DoExecutePartitions(
                      this->SolverType,
                      termination,
                      analysis);
+    dsi.back().SetLocatorCache(this->Locators);
   }
   viskores::filter::flow::internal::ParticleAdvector<DSIType> pav(
-    this->BoundsMap, dsi, this->UseThreadedAlgorithm);
+    this->BoundsMap,
+    dsi,
+    this->UseThreadedAlgorithm,
+    this->CommunicationBatchSize,
+    this->NumberOfWorkerThreads);
 
   viskores::cont::ArrayHandle<ParticleType> particles;
   this->Seeds.AsArrayHandle(particles);
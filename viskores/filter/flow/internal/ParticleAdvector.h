@@ -41,9 +41,13 @@ public:
 
   ParticleAdvector(const viskores::filter::flow::internal::BoundsMap& bm,
                    const std::vector<DSIType>& blocks,
-                   const bool& useThreaded)
+                   const bool& useThreaded,
+                   viskores::Id communicationBatchSize = 1,
+                   viskores::Id numberOfWorkerThreads = 0)
     : Blocks(blocks)
     , BoundsMap(bm)
+    , CommunicationBatchSize(communicationBatchSize)
+    , NumberOfWorkerThreads(numberOfWorkerThreads)
     , UseThreadedAlgorithm(useThreaded)
   {
   }
@@ -53,33 +57,34 @@ public:
   {
     if (!this->UseThreadedAlgorithm)
     {
-      using AlgorithmType = viskores::filter::flow::internal::AdvectAlgorithm<DSIType>;
-      return this->RunAlgo<AlgorithmType>(seeds, stepSize);
+      viskores::filter::flow::internal::AdvectAlgorithm<DSIType> algo(this->BoundsMap,
+                                                                       this->Blocks);
+      return this->RunAlgo(algo, seeds, stepSize);
     }
     else
     {
-      // There appears to be a race condition in AdvectAlgorithmThreaded, so it is
-      //  currently disabled.
-      // using AlgorithmType = viskores::filter::flow::internal::AdvectAlgorithmThreaded<DSIType>;
-      VISKORES_LOG_S(viskores::cont::LogLevel::Info,
-                     "Threaded flow management currently disabled.");
-      using AlgorithmType = viskores::filter::flow::internal::AdvectAlgorithm<DSIType>;
-      return this->RunAlgo<AlgorithmType>(seeds, stepSize);
+      viskores::filter::flow::internal::AdvectAlgorithmThreaded<DSIType> algo(this->BoundsMap,
+                                                                               this->Blocks);
+      algo.SetNumberOfWorkers(this->NumberOfWorkerThreads);
+      return this->RunAlgo(algo, seeds, stepSize);
     }
   }
 
 private:
   template <typename AlgorithmType>
-  viskores::cont::PartitionedDataSet RunAlgo(const viskores::cont::ArrayHandle<ParticleType>& seeds,
+  viskores::cont::PartitionedDataSet RunAlgo(AlgorithmType& algo,
+                                             const viskores::cont::ArrayHandle<ParticleType>& seeds,
                                              viskores::FloatDefault stepSize)
   {
-    AlgorithmType algo(this->BoundsMap, this->Blocks);
+    algo.SetCommunicationBatchSize(this->CommunicationBatchSize);
     algo.Execute(seeds, stepSize);
     return algo.GetOutput();
   }
 
   std::vector<DSIType> Blocks;
   viskores::filter::flow::internal::BoundsMap BoundsMap;
+  viskores::Id CommunicationBatchSize;
+  viskores::Id NumberOfWorkerThreads;
   bool UseThreadedAlgorithm;
 };
 
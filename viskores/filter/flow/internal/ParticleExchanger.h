@@ -19,6 +19,18 @@
 #ifndef viskores_filter_flow_internal_ParticleExchanger_h
 #define viskores_filter_flow_internal_ParticleExchanger_h
 
+#include <viskores/cont/ErrorFilterExecution.h>
+#include <viskores/cont/Logging.h>
+#include <viskores/thirdparty/diy/diy.h>
+#ifdef VISKORES_ENABLE_MPI
+#include <mpi.h>
+#include <viskores/thirdparty/diy/mpi-cast.h>
+#endif
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace viskores
 {
 namespace filter
@@ -28,6 +40,14 @@ namespace flow
 namespace internal
 {
 
+// Sends particles that leave the blocks of this rank to the ranks that own their next block
+// and receives the particles sent to this rank. All communication is non-blocking, so
+// ranks keep advecting their local particles while messages are in flight.
+//
+// Particles bound for the same rank are aggregated into batches. A batch is sent once it
+// holds `BatchSize` particles, or earlier when the caller asks for a flush because it has
+// run out of local work. With a single rank, the exchanger hands the batches back to the
+// caller, which makes the aggregation usable (and testable) without MPI.
 template <typename ParticleType>
 class ParticleExchanger
 {
@@ -46,46 +66,99 @@ public:
   ~ParticleExchanger() {} //{ this->CleanupSendBuffers(false); }
 #endif
 
-  bool HaveWork() const { return !this->SendBuffers.empty(); }
+  // True while particles are waiting in a batch or a send has not completed.
+  bool HaveWork() const
+  {
+#ifdef VISKORES_ENABLE_MPI
+    if (!this->SendBuffers.empty())
+      return true;
+#endif
+    return this->GetNumberOfPendingParticles() > 0;
+  }
+
+  // The number of particles for the same rank that are aggregated into one message.
+  void SetBatchSize(viskores::Id batchSize) { this->BatchSize = batchSize; }
+  viskores::Id GetBatchSize() const { return this->BatchSize; }
 
+  // The number of particles waiting in batches that have not been sent yet.
+  viskores::Id GetNumberOfPendingParticles() const
+  {
+    std::size_t num = 0;
+    for (const auto& it : this->PendingSends)
+      num += it.second.size();
+    return static_cast<viskores::Id>(num);
+  }
+
+  // Adds `outData` to the batches of their destination ranks, sends the batches that are
+  // full (or all of them when `flush` is set), and returns the particles that arrived.
   void Exchange(const std::vector<ParticleType>& outData,
                 const std::vector<viskores::Id>& outRanks,
                 const std::unordered_map<viskores::Id, std::vector<viskores::Id>>& outBlockIDsMap,
                 std::vector<ParticleType>& inData,
-                std::unordered_map<viskores::Id, std::vector<viskores::Id>>& inDataBlockIDsMap)
+                std::unordered_map<viskores::Id, std::vector<viskores::Id>>& inDataBlockIDsMap,
+                bool flush = true)
   {
     VISKORES_ASSERT(outData.size() == outRanks.size());
 
+    this->AddToBatches(outData, outRanks, outBlockIDsMap);
     if (this->NumRanks == 1)
-      this->SerialExchange(outData, outBlockIDsMap, inData, inDataBlockIDsMap);
+      this->SerialExchange(inData, inDataBlockIDsMap, flush);
 #ifdef VISKORES_ENABLE_MPI
     else
     {
       this->CleanupSendBuffers(true);
-      this->SendParticles(outData, outRanks, outBlockIDsMap);
+      this->SendParticles(flush);
       this->RecvParticles(inData, inDataBlockIDsMap);
     }
 #endif
   }
 
 private:
-  void SerialExchange(
+  using ParticleCommType = std::pair<ParticleType, std::vector<viskores::Id>>;
+
+  void AddToBatches(
     const std::vector<ParticleType>& outData,
-    const std::unordered_map<viskores::Id, std::vector<viskores::Id>>& outBlockIDsMap,
+    const std::vector<viskores::Id>& outRanks,
+    const std::unordered_map<viskores::Id, std::vector<viskores::Id>>& outBlockIDsMap)
+  {
+    std::size_t n = outData.size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+      const auto& bids = outBlockIDsMap.find(outData[i].GetID())->second;
+      this->PendingSends[static_cast<int>(outRanks[i])].emplace_back(
+        std::make_pair(outData[i], bids));
+    }
+  }
+
+  bool IsBatchReady(const std::vector<ParticleCommType>& batch, bool flush) const
+  {
+    return !batch.empty() &&
+      (flush || static_cast<viskores::Id>(batch.size()) >= this->BatchSize);
+  }
+
+  void SerialExchange(
     std::vector<ParticleType>& inData,
-    std::unordered_map<viskores::Id, std::vector<viskores::Id>>& inDataBlockIDsMap)
+    std::unordered_map<viskores::Id, std::vector<viskores::Id>>& inDataBlockIDsMap,
+    bool flush)
   {
-    //Copy output to input.
-    for (const auto& p : outData)
+    //Copy the ready batches to input.
+    for (auto it = this->PendingSends.begin(); it != this->PendingSends.end();)
     {
-      const auto& bids = outBlockIDsMap.find(p.GetID())->second;
-      inData.emplace_back(p);
-      inDataBlockIDsMap[p.GetID()] = bids;
+      if (this->IsBatchReady(it->second, flush))
+      {
+        for (const auto& d : it->second)
+        {
+          inData.emplace_back(d.first);
+          inDataBlockIDsMap[d.first.GetID()] = d.second;
+        }
+        it = this->PendingSends.erase(it);
+      }
+      else
+        it++;
     }
   }
 
 #ifdef VISKORES_ENABLE_MPI
-  using ParticleCommType = std::pair<ParticleType, std::vector<viskores::Id>>;
 
   void CleanupSendBuffers(bool checkRequests)
   {
@@ -138,29 +211,19 @@ private:
     }
   }
 
-  void SendParticles(
-    const std::vector<ParticleType>& outData,
-    const std::vector<viskores::Id>& outRanks,
-    const std::unordered_map<viskores::Id, std::vector<viskores::Id>>& outBlockIDsMap)
+  void SendParticles(bool flush)
   {
-    if (outData.empty())
-      return;
-
-    //create the send data: vector of particles, vector of vector of blockIds.
-    std::size_t n = outData.size();
-    std::unordered_map<int, std::vector<ParticleCommType>> sendData;
-
-    // dst, vector of pair(particles, blockIds)
-    for (std::size_t i = 0; i < n; i++)
+    //Send the ready batches to dst, vector<pair<particle, bids>>
+    for (auto it = this->PendingSends.begin(); it != this->PendingSends.end();)
     {
-      const auto& bids = outBlockIDsMap.find(outData[i].GetID())->second;
-      //sendData[outRanks[i]].emplace_back(std::make_pair(std::move(outData[i]), std::move(bids)));
-      sendData[outRanks[i]].emplace_back(std::make_pair(outData[i], bids));
+      if (this->IsBatchReady(it->second, flush))
+      {
+        this->SendParticlesToDst(it->first, it->second);
+        it = this->PendingSends.erase(it);
+      }
+      else
+        it++;
     }
-
-    //Send to dst, vector<pair<particle, bids>>
-    for (auto& si : sendData)
-      this->SendParticlesToDst(si.first, si.second);
   }
 
   void SendParticlesToDst(int dst, const std::vector<ParticleCommType>& data)
@@ -176,11 +239,14 @@ private:
     viskoresdiy::save(*bb, data);
     bb->reset();
 
+    //Use a synchronous mode send: it only completes once the receiver has matched it. As
+    //HaveWork() is true until the send completes, AdvectAlgorithmTerminator cannot decide
+    //that all work is done while particles are still in flight.
     MPI_Request req;
     int err =
-      MPI_Isend(bb->buffer.data(), bb->size(), MPI_BYTE, dst, this->Tag, this->MPIComm, &req);
+      MPI_Issend(bb->buffer.data(), bb->size(), MPI_BYTE, dst, this->Tag, this->MPIComm, &req);
     if (err != MPI_SUCCESS)
-      throw viskores::cont::ErrorFilterExecution("Error in MPI_Isend inside Messenger::SendData");
+      throw viskores::cont::ErrorFilterExecution("Error in MPI_Issend inside Messenger::SendData");
     this->SendBuffers[req] = bb;
   }
 
@@ -257,6 +323,8 @@ private:
   viskores::Id NumRanks = 1;
   viskores::Id Rank = 0;
 #endif
+  viskores::Id BatchSize = 1;
+  std::unordered_map<int, std::vector<ParticleCommType>> PendingSends;
 };
 
 }
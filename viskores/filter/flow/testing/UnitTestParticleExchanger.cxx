@@ -0,0 +1,98 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/Particle.h>
+#include <viskores/cont/EnvironmentTracker.h>
+#include <viskores/cont/testing/Testing.h>
+#include <viskores/filter/flow/internal/ParticleExchanger.h>
+
+namespace
+{
+
+using ExchangerType = viskores::filter::flow::internal::ParticleExchanger<viskores::Particle>;
+using BlockIDsMapType = std::unordered_map<viskores::Id, std::vector<viskores::Id>>;
+
+void Send(ExchangerType& exchanger,
+          viskores::Id firstId,
+          viskores::Id numParticles,
+          std::vector<viskores::Particle>& inData,
+          BlockIDsMapType& inBlockIDs,
+          bool flush)
+{
+  std::vector<viskores::Particle> outData;
+  std::vector<viskores::Id> outRanks;
+  BlockIDsMapType outBlockIDs;
+  for (viskores::Id id = firstId; id < firstId + numParticles; ++id)
+  {
+    outData.emplace_back(viskores::Vec3f(0, 0, 0), id);
+    outRanks.push_back(0);
+    outBlockIDs[id] = { id % 3, 7 };
+  }
+  exchanger.Exchange(outData, outRanks, outBlockIDs, inData, inBlockIDs, flush);
+}
+
+void TestImmediate()
+{
+  std::cout << "Batch size 1" << std::endl;
+  viskoresdiy::mpi::communicator comm = viskores::cont::EnvironmentTracker::GetCommunicator();
+  ExchangerType exchanger(comm);
+  VISKORES_TEST_ASSERT(exchanger.GetBatchSize() == 1);
+
+  std::vector<viskores::Particle> inData;
+  BlockIDsMapType inBlockIDs;
+  Send(exchanger, 0, 2, inData, inBlockIDs, false);
+  VISKORES_TEST_ASSERT(inData.size() == 2, "Particles should be sent right away");
+  VISKORES_TEST_ASSERT(!exchanger.HaveWork());
+  VISKORES_TEST_ASSERT(inBlockIDs[1] == std::vector<viskores::Id>{ 1, 7 });
+}
+
+void TestBatches()
+{
+  std::cout << "Batch size 3" << std::endl;
+  viskoresdiy::mpi::communicator comm = viskores::cont::EnvironmentTracker::GetCommunicator();
+  ExchangerType exchanger(comm);
+  exchanger.SetBatchSize(3);
+
+  std::vector<viskores::Particle> inData;
+  BlockIDsMapType inBlockIDs;
+  Send(exchanger, 0, 2, inData, inBlockIDs, false);
+  VISKORES_TEST_ASSERT(inData.empty(), "Partial batch should be held back");
+  VISKORES_TEST_ASSERT(exchanger.HaveWork(), "Held back particles are pending work");
+  VISKORES_TEST_ASSERT(exchanger.GetNumberOfPendingParticles() == 2);
+
+  Send(exchanger, 2, 2, inData, inBlockIDs, false);
+  VISKORES_TEST_ASSERT(inData.size() == 4, "Full batch should be sent");
+  VISKORES_TEST_ASSERT(!exchanger.HaveWork());
+  for (viskores::Id id = 0; id < 4; ++id)
+  {
+    VISKORES_TEST_ASSERT(inData[static_cast<std::size_t>(id)].GetID() == id);
+    VISKORES_TEST_ASSERT(inBlockIDs[id] == std::vector<viskores::Id>{ id % 3, 7 });
+  }
+
+  inData.clear();
+  inBlockIDs.clear();
+  Send(exchanger, 4, 1, inData, inBlockIDs, false);
+  VISKORES_TEST_ASSERT(inData.empty());
+  Send(exchanger, 5, 0, inData, inBlockIDs, true);
+  VISKORES_TEST_ASSERT(inData.size() == 1, "Flush should send partial batches");
+  VISKORES_TEST_ASSERT(inData[0].GetID() == 4);
+  VISKORES_TEST_ASSERT(!exchanger.HaveWork());
+}
+
+void TestParticleExchanger()
+{
+  TestImmediate();
+  TestBatches();
+}
+
+} // anonymous namespace
+
+int UnitTestParticleExchanger(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestParticleExchanger, argc, argv);
+}
@@ -464,6 +464,8 @@ void TestPartitionedDataSet(viskores::Id num, bool useGhost, FilterType fType, b
       {
         viskores::filter::flow::ParticleAdvection particleAdvection;
 
+        particleAdvection.SetUseThreadedAlgorithm(useThreaded);
+        particleAdvection.SetNumberOfWorkerThreads(3);
         particleAdvection.SetStepSize(0.1f);
         particleAdvection.SetNumberOfSteps(100000);
         particleAdvection.SetSeeds(seedArray);
@@ -477,6 +479,7 @@ void TestPartitionedDataSet(viskores::Id num, bool useGhost, FilterType fType, b
         AddVectorFields(pds2, fieldName, vecX);
 
         viskores::filter::flow::PathParticle pathParticle;
+        pathParticle.SetUseThreadedAlgorithm(useThreaded);
         pathParticle.SetPreviousTime(0);
         pathParticle.SetNextTime(1000);
         pathParticle.SetNextDataSet(pds2);
@@ -604,6 +607,82 @@ void TestStreamlineFile(const std::string& fileName,
   }
 }
 
+void TestPacketAdvection()
+{
+  std::cout << "Packet advection" << std::endl;
+  const viskores::Id3 dims(9, 9, 9);
+  const viskores::Bounds bounds(-2, 2, -2, 2, 0, 4);
+  const std::string fieldName = "vec";
+
+  std::vector<viskores::cont::DataSet> dataSets;
+  dataSets.push_back(viskores::worklet::testing::CreateUniformDataSet(bounds, dims, false));
+  dataSets.push_back(viskores::worklet::testing::CreateRectilinearDataSet(bounds, dims, false));
+  dataSets.push_back(viskores::worklet::testing::CreateUniformDataSet(bounds, dims, true));
+
+  //A swirl that carries some particles out of the top of the grid.
+  std::vector<viskores::Particle> seeds;
+  for (viskores::Id i = 0; i < 37; i++)
+  {
+    const viskores::FloatDefault t = static_cast<viskores::FloatDefault>(i) / 37;
+    seeds.emplace_back(viskores::Vec3f(1.5f * t - .7f, .3f, 3.5f * t + .2f), i);
+  }
+  auto seedArray = viskores::cont::make_ArrayHandle(seeds, viskores::CopyFlag::On);
+
+  for (auto& ds : dataSets)
+  {
+    auto coords = ds.GetCoordinateSystem().GetDataAsMultiplexer();
+    auto coordsPortal = coords.ReadPortal();
+    std::vector<viskores::Vec3f> velocities;
+    for (viskores::Id i = 0; i < coords.GetNumberOfValues(); i++)
+    {
+      const viskores::Vec3f pt = coordsPortal.Get(i);
+      velocities.emplace_back(-pt[1], pt[0], .2f + .05f * pt[0]);
+    }
+    ds.AddPointField(fieldName, velocities);
+
+    viskores::cont::DataSet expected;
+    for (viskores::IdComponent width : { 0, 4, 8, 16 })
+    {
+      viskores::filter::flow::ParticleAdvection particleAdvection;
+      particleAdvection.SetStepSize(0.05f);
+      particleAdvection.SetNumberOfSteps(500);
+      particleAdvection.SetSeeds(seedArray);
+      particleAdvection.SetActiveField(fieldName);
+      particleAdvection.SetPacketWidth(width);
+      auto output = particleAdvection.Execute(ds);
+      if (width == 0)
+      {
+        expected = output;
+        continue;
+      }
+
+      VISKORES_TEST_ASSERT(output.GetNumberOfPoints() == expected.GetNumberOfPoints(),
+                           "Wrong number of particles for packet width ",
+                           width);
+      VISKORES_TEST_ASSERT(
+        test_equal_ArrayHandles(output.GetCoordinateSystem().GetDataAsMultiplexer(),
+                                expected.GetCoordinateSystem().GetDataAsMultiplexer()),
+        "Wrong particle positions for packet width ",
+        width);
+    }
+
+    viskores::filter::flow::Streamline streamline;
+    streamline.SetStepSize(0.05f);
+    streamline.SetNumberOfSteps(500);
+    streamline.SetSeeds(seedArray);
+    streamline.SetActiveField(fieldName);
+    auto expectedLines = streamline.Execute(ds);
+    streamline.SetPacketWidth(8);
+    auto lines = streamline.Execute(ds);
+    VISKORES_TEST_ASSERT(lines.GetNumberOfCells() == expectedLines.GetNumberOfCells(),
+                         "Wrong number of streamlines with packets");
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(lines.GetCoordinateSystem().GetDataAsMultiplexer(),
+                              expectedLines.GetCoordinateSystem().GetDataAsMultiplexer()),
+      "Wrong streamline points with packets");
+  }
+}
+
 void TestStreamlineFilters()
 {
   std::vector<bool> flags = { true, false };
@@ -615,7 +694,8 @@ void TestStreamlineFilters()
   {
     for (auto useGhost : flags)
       for (auto ft : fTypes)
-        TestPartitionedDataSet(n, useGhost, ft, false);
+        for (auto useThreaded : flags)
+          TestPartitionedDataSet(n, useGhost, ft, useThreaded);
   }
 
   for (auto useThreaded : flags)
@@ -623,8 +703,10 @@ void TestStreamlineFilters()
     TestStreamline(useThreaded);
     TestPathline(useThreaded);
   }
+  TestPacketAdvection();
   for (auto useSL : flags)
-    TestAMRStreamline(useSL, false);
+    for (auto useThreaded : flags)
+      TestAMRStreamline(useSL, useThreaded);
 
   {
     //Rotate test.
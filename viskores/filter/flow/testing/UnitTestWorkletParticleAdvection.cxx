@@ -20,6 +20,7 @@
 #include <viskores/cont/Algorithm.h>
 #include <viskores/cont/ArrayCopy.h>
 #include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/ArrayHandleIndex.h>
 #include <viskores/cont/DataSet.h>
 #include <viskores/cont/testing/Testing.h>
 #include <viskores/filter/flow/testing/GenerateTestDataSets.h>
@@ -161,6 +162,45 @@ public:
   }
 };
 
+//A linear field, which every cell type interpolates exactly.
+VISKORES_EXEC_CONT viskores::Vec3f LinearField(const viskores::Vec3f& point)
+{
+  return viskores::Vec3f(point[0] + 2 * point[1], point[1] - point[2], 3 * point[2] + 1);
+}
+
+class TestCellHintEvaluatorWorklet : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn start,
+                                WholeArrayIn points,
+                                ExecObject evaluator,
+                                FieldOut valid);
+
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename PointsPortal, typename EvaluatorType>
+  VISKORES_EXEC void operator()(viskores::Id start,
+                                const PointsPortal& points,
+                                const EvaluatorType& evaluator,
+                                bool& valid) const
+  {
+    //Carry one hint through all of the points. Each work item starts at a different point, so
+    //the hint is left from the same cell, a neighboring cell, or a cell far away.
+    typename EvaluatorType::CellHint hint;
+    const viskores::Id numPoints = points.GetNumberOfValues();
+    valid = true;
+    for (viskores::Id offset = 0; offset < numPoints; offset++)
+    {
+      viskores::Vec3f point = points.Get((start + offset) % numPoints);
+      viskores::VecVariable<viskores::Vec3f, 2> values;
+      viskores::worklet::flow::GridEvaluatorStatus status =
+        evaluator.Evaluate(point, 0, values, hint);
+      if (status.CheckFail() || !test_equal(values[0], LinearField(point)))
+        valid = false;
+    }
+  }
+};
+
 template <typename EvalType>
 void ValidateEvaluator(const EvalType& eval,
                        const std::vector<viskores::Particle>& pointIns,
@@ -371,6 +411,55 @@ void TestEvaluators()
   }
 }
 
+void TestCellHintEvaluators()
+{
+  using FieldHandle = viskores::cont::ArrayHandle<viskores::Vec3f>;
+  using FieldType = viskores::worklet::flow::VelocityField<FieldHandle>;
+  using GridEvalType = viskores::worklet::flow::GridEvaluator<FieldType>;
+
+  viskores::Bounds bounds(0, 4, 0, 4, 0, 4);
+  viskores::Id3 dims(5, 5, 5);
+  std::vector<viskores::cont::DataSet> dataSets;
+  dataSets.push_back(viskores::worklet::testing::CreateUniformDataSet(bounds, dims, false));
+  dataSets.push_back(viskores::worklet::testing::CreateRectilinearDataSet(bounds, dims, false));
+  dataSets.push_back(viskores::worklet::testing::CreateExplicitFromStructuredDataSet(
+    bounds, dims, viskores::worklet::testing::ExplicitDataSetOption::EXPLICIT, false));
+
+  //The cells are unit cubes. Points in the same cell, in neighboring cells, in cells far apart,
+  //on a face shared by two cells, on an edge and on a vertex.
+  std::vector<viskores::Vec3f> points;
+  points.push_back(viskores::Vec3f(0.5f, 0.5f, 0.5f));
+  points.push_back(viskores::Vec3f(0.75f, 0.25f, 0.6f));
+  points.push_back(viskores::Vec3f(1.5f, 0.5f, 0.5f));
+  points.push_back(viskores::Vec3f(1.0f, 2.5f, 2.5f));
+  points.push_back(viskores::Vec3f(3.7f, 3.2f, 0.3f));
+  points.push_back(viskores::Vec3f(1.25f, 1.0f, 3.0f));
+  points.push_back(viskores::Vec3f(2.0f, 2.0f, 2.0f));
+  points.push_back(viskores::Vec3f(0.1f, 3.9f, 3.5f));
+  auto pointsHandle = viskores::cont::make_ArrayHandle(points, viskores::CopyFlag::Off);
+
+  for (auto& ds : dataSets)
+  {
+    FieldHandle fieldValues;
+    viskores::cont::ArrayCopy(ds.GetCoordinateSystem().GetData(), fieldValues);
+    auto fieldPortal = fieldValues.WritePortal();
+    for (viskores::Id index = 0; index < fieldPortal.GetNumberOfValues(); index++)
+      fieldPortal.Set(index, LinearField(fieldPortal.Get(index)));
+    FieldType velocities(fieldValues);
+
+    GridEvalType gridEval(ds.GetCoordinateSystem(), ds.GetCellSet(), velocities);
+    viskores::cont::ArrayHandle<bool> valid;
+    viskores::worklet::DispatcherMapField<TestCellHintEvaluatorWorklet> dispatcher;
+    dispatcher.Invoke(viskores::cont::ArrayHandleIndex(pointsHandle.GetNumberOfValues()),
+                      pointsHandle,
+                      gridEval,
+                      valid);
+    auto validPortal = valid.ReadPortal();
+    for (viskores::Id index = 0; index < validPortal.GetNumberOfValues(); index++)
+      VISKORES_TEST_ASSERT(validPortal.Get(index), "Wrong value evaluated with a cell hint");
+  }
+}
+
 void TestGhostCellEvaluators()
 {
   using FieldHandle = viskores::cont::ArrayHandle<viskores::Vec3f>;
@@ -958,6 +1047,7 @@ void TestParticleAdvection()
 {
   TestIntegrators();
   TestEvaluators();
+  TestCellHintEvaluators();
   TestGhostCellEvaluators();
 
   TestParticleStatus();
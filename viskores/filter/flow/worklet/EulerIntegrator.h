@@ -35,6 +35,8 @@ template <typename EvaluatorType>
 class ExecEulerIntegrator
 {
 public:
+  using CellHint = typename EvaluatorType::CellHint;
+
   VISKORES_EXEC_CONT
   ExecEulerIntegrator(const EvaluatorType& evaluator)
     : Evaluator(evaluator)
@@ -45,11 +47,21 @@ public:
   VISKORES_EXEC IntegratorStatus CheckStep(const Particle& particle,
                                            viskores::FloatDefault stepLength,
                                            viskores::Vec3f& velocity) const
+  {
+    CellHint hint;
+    return this->CheckStep(particle, stepLength, velocity, hint);
+  }
+
+  template <typename Particle>
+  VISKORES_EXEC IntegratorStatus CheckStep(const Particle& particle,
+                                           viskores::FloatDefault stepLength,
+                                           viskores::Vec3f& velocity,
+                                           CellHint& hint) const
   {
     auto time = particle.GetTime();
     auto inpos = particle.GetEvaluationPosition(stepLength);
     viskores::VecVariable<viskores::Vec3f, 2> vectors;
-    GridEvaluatorStatus evalStatus = this->Evaluator.Evaluate(inpos, time, vectors);
+    GridEvaluatorStatus evalStatus = this->Evaluator.Evaluate(inpos, time, vectors, hint);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus, false);
 
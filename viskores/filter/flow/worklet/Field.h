@@ -127,6 +127,9 @@ public:
     return ExecutionType(this->FieldValues, this->Assoc, device, token);
   }
 
+  VISKORES_CONT const FieldArrayType& GetFieldValues() const { return this->FieldValues; }
+  VISKORES_CONT Association GetAssociation() const { return this->Assoc; }
+
 private:
   FieldArrayType FieldValues;
   Association Assoc;
@@ -28,6 +28,7 @@
 #include <viskores/cont/CellLocatorUniformGrid.h>
 #include <viskores/cont/CellSetStructured.h>
 #include <viskores/cont/DataSet.h>
+#include <viskores/cont/LocatorCache.h>
 
 #include <viskores/filter/flow/worklet/CellInterpolationHelper.h>
 #include <viskores/filter/flow/worklet/Field.h>
@@ -45,8 +46,14 @@ class ExecutionGridEvaluator
 {
   using GhostCellArrayType = viskores::cont::ArrayHandle<viskores::UInt8>;
   using ExecFieldType = typename FieldType::ExecutionType;
+  using ExecLocatorType = typename viskores::cont::CellLocatorGeneral::ExecObjType;
 
 public:
+  /// Remembers where the last point of a particle was found. A particle usually stays in
+  /// the same cell or moves to a nearby one, so passing the same hint to successive calls
+  /// to `Evaluate()` lets the cell locator check there before searching.
+  using CellHint = typename ExecLocatorType::LastCell;
+
   VISKORES_CONT
   ExecutionGridEvaluator() = default;
 
@@ -101,7 +108,8 @@ public:
   template <typename Point>
   VISKORES_EXEC GridEvaluatorStatus HelpEvaluate(const Point& point,
                                                  const viskores::FloatDefault& time,
-                                                 viskores::VecVariable<Point, 2>& out) const
+                                                 viskores::VecVariable<Point, 2>& out,
+                                                 CellHint& hint) const
   {
     viskores::Id cellId = -1;
     Point parametric;
@@ -114,7 +122,7 @@ public:
       status.SetTemporalBounds();
     }
 
-    this->Locator.FindCell(point, cellId, parametric);
+    this->Locator.FindCell(point, cellId, parametric, hint);
     if (cellId == -1)
     {
       status.SetFail();
@@ -170,11 +178,12 @@ public:
   template <typename Point>
   VISKORES_EXEC GridEvaluatorStatus Evaluate(const Point& point,
                                              const viskores::FloatDefault& time,
-                                             viskores::VecVariable<Point, 2>& out) const
+                                             viskores::VecVariable<Point, 2>& out,
+                                             CellHint& hint) const
   {
     if (!ExecFieldType::DelegateToField::value)
     {
-      return this->HelpEvaluate(point, time, out);
+      return this->HelpEvaluate(point, time, out, hint);
     }
     else
     {
@@ -182,6 +191,15 @@ public:
     }
   }
 
+  template <typename Point>
+  VISKORES_EXEC GridEvaluatorStatus Evaluate(const Point& point,
+                                             const viskores::FloatDefault& time,
+                                             viskores::VecVariable<Point, 2>& out) const
+  {
+    CellHint hint;
+    return this->Evaluate(point, time, out, hint);
+  }
+
 private:
   VISKORES_EXEC bool InGhostCell(const viskores::Id& cellId) const
   {
@@ -198,7 +216,7 @@ private:
   GhostCellPortal GhostCells;
   bool HaveGhostCells;
   viskores::exec::CellInterpolationHelper InterpolationHelper;
-  typename viskores::cont::CellLocatorGeneral::ExecObjType Locator;
+  ExecLocatorType Locator;
 };
 
 template <typename FieldType>
@@ -218,11 +236,21 @@ public:
 
   VISKORES_CONT
   GridEvaluator(const viskores::cont::DataSet& dataSet, const FieldType& field)
+    : GridEvaluator(dataSet, field, viskores::cont::LocatorCache{ 1 })
+  {
+  }
+
+  /// Takes the cell locator from `locators`, so that it is only built once for
+  /// evaluators created over and over for the same geometry.
+  VISKORES_CONT
+  GridEvaluator(const viskores::cont::DataSet& dataSet,
+                const FieldType& field,
+                viskores::cont::LocatorCache locators)
     : Bounds(dataSet.GetCoordinateSystem().GetBounds())
     , Field(field)
     , GhostCellArray()
   {
-    this->InitializeLocator(dataSet.GetCoordinateSystem(), dataSet.GetCellSet());
+    this->InitializeLocator(dataSet.GetCoordinateSystem(), dataSet.GetCellSet(), locators);
 
     if (dataSet.HasGhostCellField())
     {
@@ -235,11 +263,20 @@ public:
   GridEvaluator(const viskores::cont::CoordinateSystem& coordinates,
                 const viskores::cont::UnknownCellSet& cellset,
                 const FieldType& field)
+    : GridEvaluator(coordinates, cellset, field, viskores::cont::LocatorCache{ 1 })
+  {
+  }
+
+  VISKORES_CONT
+  GridEvaluator(const viskores::cont::CoordinateSystem& coordinates,
+                const viskores::cont::UnknownCellSet& cellset,
+                const FieldType& field,
+                viskores::cont::LocatorCache locators)
     : Bounds(coordinates.GetBounds())
     , Field(field)
     , GhostCellArray()
   {
-    this->InitializeLocator(coordinates, cellset);
+    this->InitializeLocator(coordinates, cellset, locators);
   }
 
   VISKORES_CONT ExecutionGridEvaluator<FieldType> PrepareForExecution(
@@ -257,11 +294,11 @@ public:
 
 private:
   VISKORES_CONT void InitializeLocator(const viskores::cont::CoordinateSystem& coordinates,
-                                       const viskores::cont::UnknownCellSet& cellset)
+                                       const viskores::cont::UnknownCellSet& cellset,
+                                       viskores::cont::LocatorCache& locators)
   {
-    this->Locator.SetCoordinates(coordinates);
-    this->Locator.SetCellSet(cellset);
-    this->Locator.Update();
+    this->Locator =
+      locators.GetCellLocator<viskores::cont::CellLocatorGeneral>(cellset, coordinates);
     this->InterpolationHelper = viskores::cont::CellInterpolationHelper(cellset);
   }
 
@@ -0,0 +1,306 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_filter_flow_worklet_PacketStepper_h
+#define viskores_filter_flow_worklet_PacketStepper_h
+
+#include <viskores/CellClassification.h>
+#include <viskores/VectorAnalysis.h>
+#include <viskores/cont/ArrayCopy.h>
+#include <viskores/cont/ArrayHandleCartesianProduct.h>
+#include <viskores/cont/ArrayHandleUniformPointCoordinates.h>
+#include <viskores/cont/CellLocatorRectilinearGrid.h>
+#include <viskores/cont/CellLocatorUniformGrid.h>
+#include <viskores/cont/CellSetStructured.h>
+#include <viskores/cont/DataSet.h>
+#include <viskores/cont/ExecutionObjectBase.h>
+#include <viskores/filter/flow/worklet/Field.h>
+#include <viskores/filter/flow/worklet/GridEvaluatorStatus.h>
+#include <viskores/filter/flow/worklet/IntegratorStatus.h>
+
+namespace viskores
+{
+namespace worklet
+{
+namespace flow
+{
+
+/// Positions or velocities of the particles in a packet. The values are stored one
+/// component at a time, so each component of all the lanes is contiguous.
+template <viskores::IdComponent Width>
+using PacketVec3f = viskores::Vec<viskores::Vec<viskores::FloatDefault, Width>, 3>;
+
+template <typename ExecLocatorType, typename FieldPortalType>
+class ExecPacketRK4Stepper
+{
+public:
+  using GhostCellPortalType = viskores::cont::ArrayHandle<viskores::UInt8>::ReadPortalType;
+
+  VISKORES_CONT
+  ExecPacketRK4Stepper(const ExecLocatorType& locator,
+                       const viskores::Id3& cellDims,
+                       const FieldPortalType& velocities,
+                       bool pointField,
+                       const GhostCellPortalType& ghostCells,
+                       bool haveGhostCells,
+                       viskores::FloatDefault deltaT)
+    : CellDims(cellDims)
+    , DeltaT(deltaT)
+    , GhostCells(ghostCells)
+    , HaveGhostCells(haveGhostCells)
+    , Locator(locator)
+    , PointField(pointField)
+    , Velocities(velocities)
+  {
+  }
+
+  /// Takes one RK4 step for each lane in `mask`. The status of each lane matches what
+  /// `StepperImpl::Step()` returns for the same particle. Lanes that fail keep their
+  /// position, so they can be retried with the scalar stepper.
+  template <viskores::IdComponent Width>
+  VISKORES_EXEC void Step(const PacketVec3f<Width>& pos,
+                          const viskores::Vec<bool, Width>& mask,
+                          PacketVec3f<Width>& outpos,
+                          viskores::Vec<IntegratorStatus, Width>& status) const
+  {
+    const viskores::FloatDefault halfStep = this->DeltaT / static_cast<viskores::FloatDefault>(2);
+
+    viskores::Vec<bool, Width> ok = mask;
+    viskores::Vec<GridEvaluatorStatus, Width> evalStatus;
+    PacketVec3f<Width> k1, k2, k3, k4, p;
+
+    this->Evaluate(pos, ok, evalStatus, k1);
+    this->Advance(pos, k1, halfStep, p);
+    this->Evaluate(p, ok, evalStatus, k2);
+    this->Advance(pos, k2, halfStep, p);
+    this->Evaluate(p, ok, evalStatus, k3);
+    this->Advance(pos, k3, this->DeltaT, p);
+    this->Evaluate(p, ok, evalStatus, k4);
+
+    const viskores::FloatDefault sixth = static_cast<viskores::FloatDefault>(1) / 6;
+    PacketVec3f<Width> velocity;
+    for (viskores::IdComponent c = 0; c < 3; c++)
+    {
+      VISKORES_VECTORIZATION_PRE_LOOP
+      for (viskores::IdComponent lane = 0; lane < Width; lane++)
+      {
+        VISKORES_VECTORIZATION_IN_LOOP
+        velocity[c][lane] = (k1[c][lane] + 2 * k2[c][lane] + 2 * k3[c][lane] + k4[c][lane]) * sixth;
+        outpos[c][lane] = ok[lane] ? pos[c][lane] + this->DeltaT * velocity[c][lane] : pos[c][lane];
+      }
+    }
+
+    for (viskores::IdComponent lane = 0; lane < Width; lane++)
+    {
+      const viskores::FloatDefault speedSquared = velocity[0][lane] * velocity[0][lane] +
+        velocity[1][lane] * velocity[1][lane] + velocity[2][lane] * velocity[2][lane];
+      const bool isZero =
+        ok[lane] && (speedSquared <= viskores::Epsilon<viskores::FloatDefault>());
+      status[lane] = IntegratorStatus(evalStatus[lane], isZero);
+    }
+  }
+
+private:
+  template <viskores::IdComponent Width>
+  VISKORES_EXEC void Advance(const PacketVec3f<Width>& pos,
+                             const PacketVec3f<Width>& velocity,
+                             viskores::FloatDefault stepLength,
+                             PacketVec3f<Width>& result) const
+  {
+    for (viskores::IdComponent c = 0; c < 3; c++)
+    {
+      VISKORES_VECTORIZATION_PRE_LOOP
+      for (viskores::IdComponent lane = 0; lane < Width; lane++)
+      {
+        VISKORES_VECTORIZATION_IN_LOOP
+        result[c][lane] = pos[c][lane] + stepLength * velocity[c][lane];
+      }
+    }
+  }
+
+  // Evaluates the velocity of the lanes that are still ok. A lane that leaves the grid
+  // or enters a ghost cell is marked as failed, as in `ExecutionGridEvaluator`.
+  template <viskores::IdComponent Width>
+  VISKORES_EXEC void Evaluate(const PacketVec3f<Width>& pos,
+                              viskores::Vec<bool, Width>& ok,
+                              viskores::Vec<GridEvaluatorStatus, Width>& evalStatus,
+                              PacketVec3f<Width>& velocity) const
+  {
+    for (viskores::IdComponent lane = 0; lane < Width; lane++)
+    {
+      viskores::Vec3f value(0, 0, 0);
+      if (ok[lane])
+      {
+        const viskores::Vec3f point(pos[0][lane], pos[1][lane], pos[2][lane]);
+        viskores::Id cellId = -1;
+        viskores::Vec3f parametric;
+        this->Locator.FindCell(point, cellId, parametric);
+        GridEvaluatorStatus laneStatus;
+        laneStatus.SetOk();
+        if (cellId == -1)
+        {
+          laneStatus.SetFail();
+          laneStatus.SetSpatialBounds();
+        }
+        else if (this->HaveGhostCells &&
+                 this->GhostCells.Get(cellId) == viskores::CellClassification::Ghost)
+        {
+          laneStatus.SetFail();
+          laneStatus.SetInGhostCell();
+          laneStatus.SetSpatialBounds();
+        }
+        else
+        {
+          value = this->Interpolate(cellId, parametric);
+        }
+        evalStatus[lane] = laneStatus;
+        ok[lane] = laneStatus.CheckOk();
+      }
+      velocity[0][lane] = value[0];
+      velocity[1][lane] = value[1];
+      velocity[2][lane] = value[2];
+    }
+  }
+
+  VISKORES_EXEC viskores::Vec3f Interpolate(viskores::Id cellId,
+                                            const viskores::Vec3f& parametric) const
+  {
+    if (!this->PointField)
+      return this->Velocities.Get(cellId);
+
+    const viskores::Id cellsPerSlice = this->CellDims[0] * this->CellDims[1];
+    const viskores::Id i = cellId % this->CellDims[0];
+    const viskores::Id j = (cellId / this->CellDims[0]) % this->CellDims[1];
+    const viskores::Id k = cellId / cellsPerSlice;
+    const viskores::Id rowSize = this->CellDims[0] + 1;
+    const viskores::Id sliceSize = rowSize * (this->CellDims[1] + 1);
+    const viskores::Id p0 = i + j * rowSize + k * sliceSize;
+
+    const viskores::Vec3f v00 = viskores::Lerp(
+      this->Velocities.Get(p0), this->Velocities.Get(p0 + 1), parametric[0]);
+    const viskores::Vec3f v10 = viskores::Lerp(this->Velocities.Get(p0 + rowSize),
+                                               this->Velocities.Get(p0 + rowSize + 1),
+                                               parametric[0]);
+    const viskores::Vec3f v01 = viskores::Lerp(this->Velocities.Get(p0 + sliceSize),
+                                               this->Velocities.Get(p0 + sliceSize + 1),
+                                               parametric[0]);
+    const viskores::Vec3f v11 = viskores::Lerp(this->Velocities.Get(p0 + sliceSize + rowSize),
+                                               this->Velocities.Get(p0 + sliceSize + rowSize + 1),
+                                               parametric[0]);
+    return viskores::Lerp(viskores::Lerp(v00, v10, parametric[1]),
+                          viskores::Lerp(v01, v11, parametric[1]),
+                          parametric[2]);
+  }
+
+  viskores::Id3 CellDims;
+  viskores::FloatDefault DeltaT;
+  GhostCellPortalType GhostCells;
+  bool HaveGhostCells;
+  ExecLocatorType Locator;
+  bool PointField;
+  FieldPortalType Velocities;
+};
+
+/// @brief Takes RK4 steps for packets of particles on a uniform or rectilinear grid.
+///
+/// `Stepper` advances one particle at a time through a general cell locator and a
+/// scalar field evaluation. For a 3D uniform or rectilinear grid, this stepper advances
+/// a fixed width packet of particles together. The positions and velocities are kept
+/// one component at a time for all lanes, and lanes that stop are masked off, so the
+/// arithmetic of the RK4 stages runs across the lanes. It is used by
+/// `ParticleAdvectPacketWorklet` together with a scalar `Stepper` that handles the
+/// steps at the boundary of the grid.
+///
+/// `LocatorType` is `viskores::cont::CellLocatorUniformGrid` or
+/// `viskores::cont::CellLocatorRectilinearGrid`.
+template <typename LocatorType>
+class PacketRK4Stepper : public viskores::cont::ExecutionObjectBase
+{
+public:
+  using FieldArrayType = viskores::cont::ArrayHandle<viskores::Vec3f>;
+  using ExecLocatorType = decltype(std::declval<LocatorType>().PrepareForExecution(
+    std::declval<viskores::cont::DeviceAdapterId>(),
+    std::declval<viskores::cont::Token&>()));
+
+  VISKORES_CONT
+  PacketRK4Stepper(const viskores::cont::DataSet& dataSet,
+                   const viskores::worklet::flow::VelocityField<FieldArrayType>& field,
+                   viskores::FloatDefault deltaT)
+    : DeltaT(deltaT)
+    , PointField(field.GetAssociation() == viskores::cont::Field::Association::Points)
+    , Velocities(field.GetFieldValues())
+  {
+    this->Locator.SetCoordinates(dataSet.GetCoordinateSystem());
+    this->Locator.SetCellSet(dataSet.GetCellSet());
+    this->Locator.Update();
+
+    viskores::cont::CellSetStructured<3> cellSet;
+    dataSet.GetCellSet().AsCellSet(cellSet);
+    this->CellDims = cellSet.GetCellDimensions();
+
+    if (dataSet.HasGhostCellField())
+    {
+      auto arr = dataSet.GetGhostCellField().GetData();
+      viskores::cont::ArrayCopyShallowIfPossible(arr, this->GhostCellArray);
+    }
+  }
+
+  /// Returns true when the packet stepper supports the grid of `dataSet`.
+  VISKORES_CONT static bool IsSupported(const viskores::cont::DataSet& dataSet)
+  {
+    return dataSet.GetCellSet().IsType<viskores::cont::CellSetStructured<3>>() &&
+      LocatorSupportsCoordinates(dataSet.GetCoordinateSystem(),
+                                 static_cast<LocatorType*>(nullptr));
+  }
+
+  VISKORES_CONT ExecPacketRK4Stepper<ExecLocatorType, typename FieldArrayType::ReadPortalType>
+  PrepareForExecution(viskores::cont::DeviceAdapterId device, viskores::cont::Token& token) const
+  {
+    using ExecType =
+      ExecPacketRK4Stepper<ExecLocatorType, typename FieldArrayType::ReadPortalType>;
+    ExecLocatorType locator = this->Locator.PrepareForExecution(device, token);
+    return ExecType(locator,
+                    this->CellDims,
+                    this->Velocities.PrepareForInput(device, token),
+                    this->PointField,
+                    this->GhostCellArray.PrepareForInput(device, token),
+                    this->GhostCellArray.GetNumberOfValues() > 0,
+                    this->DeltaT);
+  }
+
+private:
+  using AxisHandle = viskores::cont::ArrayHandle<viskores::FloatDefault>;
+
+  VISKORES_CONT static bool LocatorSupportsCoordinates(
+    const viskores::cont::CoordinateSystem& coords,
+    const viskores::cont::CellLocatorUniformGrid*)
+  {
+    return coords.GetData().IsType<viskores::cont::ArrayHandleUniformPointCoordinates>();
+  }
+
+  VISKORES_CONT static bool LocatorSupportsCoordinates(
+    const viskores::cont::CoordinateSystem& coords,
+    const viskores::cont::CellLocatorRectilinearGrid*)
+  {
+    return coords.GetData()
+      .IsType<viskores::cont::ArrayHandleCartesianProduct<AxisHandle, AxisHandle, AxisHandle>>();
+  }
+
+  viskores::Id3 CellDims;
+  viskores::FloatDefault DeltaT;
+  viskores::cont::ArrayHandle<viskores::UInt8> GhostCellArray;
+  LocatorType Locator;
+  bool PointField;
+  FieldArrayType Velocities;
+};
+
+}
+}
+} //viskores::worklet::flow
+
+#endif // viskores_filter_flow_worklet_PacketStepper_h
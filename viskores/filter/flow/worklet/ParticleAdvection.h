@@ -72,6 +72,22 @@ public:
                   const TerminationType& termination,
                   AnalysisType& analysis);
 
+  /// Advances the particles in packets of `packetWidth` (4, 8, or 16) particles with
+  /// `packetStepper`, which is a `PacketRK4Stepper`. The scalar stepper `it` is used for
+  /// the steps that cross the boundary of the grid.
+  template <typename PacketStepperType,
+            typename IntegratorType,
+            typename ParticleType,
+            typename ParticleStorage,
+            typename TerminationType,
+            typename AnalysisType>
+  static void RunPackets(const PacketStepperType& packetStepper,
+                         const IntegratorType& it,
+                         viskores::cont::ArrayHandle<ParticleType, ParticleStorage>& particles,
+                         const TerminationType& termination,
+                         AnalysisType& analysis,
+                         viskores::IdComponent packetWidth);
+
   template <typename IntegratorType,
             typename ParticleType,
             typename PointStorage,
@@ -111,6 +127,7 @@ public:
 #include <viskores/filter/flow/worklet/Analysis.h>
 #include <viskores/filter/flow/worklet/EulerIntegrator.h>
 #include <viskores/filter/flow/worklet/GridEvaluators.h>
+#include <viskores/filter/flow/worklet/PacketStepper.h>
 #include <viskores/filter/flow/worklet/RK4Integrator.h>
 #include <viskores/filter/flow/worklet/Stepper.h>
 #include <viskores/filter/flow/worklet/TemporalGridEvaluators.h>
@@ -346,4 +363,112 @@ extern template VISKORES_FILTER_FLOW_EXPORT void viskores::worklet::flow::Partic
   viskores::worklet::flow::StreamlineAnalysis<viskores::Particle>&);
 VISKORES_INSTANTIATION_END
 
+VISKORES_INSTANTIATION_BEGIN
+extern template VISKORES_FILTER_FLOW_EXPORT void
+viskores::worklet::flow::ParticleAdvection::RunPackets<
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorUniformGrid>,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+  viskores::Particle,
+  viskores::cont::StorageTagBasic,
+  viskores::worklet::flow::NormalTermination,
+  viskores::worklet::flow::NoAnalysis<viskores::Particle>>(
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorUniformGrid> const&,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>> const&,
+  viskores::cont::ArrayHandle<viskores::Particle, viskores::cont::StorageTagBasic>&,
+  viskores::worklet::flow::NormalTermination const&,
+  viskores::worklet::flow::NoAnalysis<viskores::Particle>&,
+  viskores::IdComponent);
+VISKORES_INSTANTIATION_END
+
+VISKORES_INSTANTIATION_BEGIN
+extern template VISKORES_FILTER_FLOW_EXPORT void
+viskores::worklet::flow::ParticleAdvection::RunPackets<
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorUniformGrid>,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+  viskores::Particle,
+  viskores::cont::StorageTagBasic,
+  viskores::worklet::flow::NormalTermination,
+  viskores::worklet::flow::StreamlineAnalysis<viskores::Particle>>(
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorUniformGrid> const&,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>> const&,
+  viskores::cont::ArrayHandle<viskores::Particle, viskores::cont::StorageTagBasic>&,
+  viskores::worklet::flow::NormalTermination const&,
+  viskores::worklet::flow::StreamlineAnalysis<viskores::Particle>&,
+  viskores::IdComponent);
+VISKORES_INSTANTIATION_END
+
+VISKORES_INSTANTIATION_BEGIN
+extern template VISKORES_FILTER_FLOW_EXPORT void
+viskores::worklet::flow::ParticleAdvection::RunPackets<
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorRectilinearGrid>,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+  viskores::Particle,
+  viskores::cont::StorageTagBasic,
+  viskores::worklet::flow::NormalTermination,
+  viskores::worklet::flow::NoAnalysis<viskores::Particle>>(
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorRectilinearGrid> const&,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>> const&,
+  viskores::cont::ArrayHandle<viskores::Particle, viskores::cont::StorageTagBasic>&,
+  viskores::worklet::flow::NormalTermination const&,
+  viskores::worklet::flow::NoAnalysis<viskores::Particle>&,
+  viskores::IdComponent);
+VISKORES_INSTANTIATION_END
+
+VISKORES_INSTANTIATION_BEGIN
+extern template VISKORES_FILTER_FLOW_EXPORT void
+viskores::worklet::flow::ParticleAdvection::RunPackets<
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorRectilinearGrid>,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+  viskores::Particle,
+  viskores::cont::StorageTagBasic,
+  viskores::worklet::flow::NormalTermination,
+  viskores::worklet::flow::StreamlineAnalysis<viskores::Particle>>(
+  viskores::worklet::flow::PacketRK4Stepper<viskores::cont::CellLocatorRectilinearGrid> const&,
+  viskores::worklet::flow::Stepper<
+    viskores::worklet::flow::RK4Integrator<
+      viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+        viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>>,
+    viskores::worklet::flow::GridEvaluator<viskores::worklet::flow::VelocityField<
+      viskores::cont::ArrayHandle<viskores::Vec3f, viskores::cont::StorageTagBasic>>>> const&,
+  viskores::cont::ArrayHandle<viskores::Particle, viskores::cont::StorageTagBasic>&,
+  viskores::worklet::flow::NormalTermination const&,
+  viskores::worklet::flow::StreamlineAnalysis<viskores::Particle>&,
+  viskores::IdComponent);
+VISKORES_INSTANTIATION_END
+
 #endif // viskores_filter_flow_worklet_ParticleAdvection_h
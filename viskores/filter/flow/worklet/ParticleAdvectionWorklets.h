@@ -27,10 +27,12 @@
 #include <viskores/cont/Algorithm.h>
 #include <viskores/cont/CellSetExplicit.h>
 #include <viskores/cont/ConvertNumComponentsToOffsets.h>
+#include <viskores/cont/ErrorBadValue.h>
 #include <viskores/cont/ExecutionObjectBase.h>
 #include <viskores/cont/Invoker.h>
 
 #include <viskores/Particle.h>
+#include <viskores/filter/flow/worklet/PacketStepper.h>
 #include <viskores/filter/flow/worklet/Particles.h>
 #include <viskores/worklet/WorkletMapField.h>
 
@@ -74,6 +76,9 @@ public:
     auto particle = integralCurve.GetParticle(idx);
     viskores::FloatDefault time = particle.GetTime();
     bool tookAnySteps = false;
+    //The particle usually stays in the same cell between steps, so the locator checks the
+    //cell it was last found in before searching.
+    typename IntegratorType::CellHint cellHint;
 
     //the integrator status needs to be more robust:
     // 1. you could have success AND at temporal boundary.
@@ -84,7 +89,7 @@ public:
     {
       particle = integralCurve.GetParticle(idx);
       viskores::Vec3f outpos;
-      auto status = integrator.Step(particle, time, outpos);
+      auto status = integrator.Step(particle, time, outpos, cellHint);
       if (status.CheckOk())
       {
         integralCurve.StepUpdate(idx, particle, time, outpos);
@@ -95,7 +100,7 @@ public:
       //Try and take a step just past the boundary.
       else if (status.CheckSpatialBounds() && this->PushOutOfBounds)
       {
-        status = integrator.SmallStep(particle, time, outpos);
+        status = integrator.SmallStep(particle, time, outpos, cellHint);
         if (status.CheckOk())
         {
           integralCurve.StepUpdate(idx, particle, time, outpos);
@@ -114,6 +119,113 @@ private:
 };
 
 
+// Advances the particles of a packet of `Width` particles together. The common RK4 steps
+// are taken by the packet stepper for all lanes at once. A lane that cannot step inside
+// the grid takes the same scalar `SmallStep()` as in `ParticleAdvectWorklet`, and lanes
+// that terminate are masked off until the whole packet is done.
+template <viskores::IdComponent Width>
+class ParticleAdvectPacketWorklet : public viskores::worklet::WorkletMapField
+{
+public:
+  VISKORES_EXEC_CONT
+  ParticleAdvectPacketWorklet(viskores::Id numParticles, bool pushOutOfBounds)
+    : NumParticles(numParticles)
+    , PushOutOfBounds(pushOutOfBounds)
+  {
+  }
+
+  using ControlSignature = void(FieldIn packetIdx,
+                                ExecObject packetStepper,
+                                ExecObject integrator,
+                                ExecObject integralCurve);
+  using ExecutionSignature = void(_1 packetIdx, _2 packetStepper, _3 integrator, _4 integralCurve);
+  using InputDomain = _1;
+
+  template <typename PacketStepperType, typename IntegratorType, typename IntegralCurveType>
+  VISKORES_EXEC void operator()(const viskores::Id& packetIdx,
+                                const PacketStepperType& packetStepper,
+                                const IntegratorType& integrator,
+                                IntegralCurveType& integralCurve) const
+  {
+    const viskores::Id firstIdx = packetIdx * Width;
+    const viskores::IdComponent numLanes =
+      static_cast<viskores::IdComponent>(
+        viskores::Min(this->NumParticles - firstIdx, static_cast<viskores::Id>(Width)));
+
+    viskores::Vec<bool, Width> active(false);
+    viskores::Vec<bool, Width> tookAnySteps(false);
+    viskores::Vec<viskores::FloatDefault, Width> time(0);
+    PacketVec3f<Width> pos, outpos;
+    viskores::Vec<IntegratorStatus, Width> status;
+    for (viskores::IdComponent lane = 0; lane < Width; lane++)
+    {
+      viskores::Vec3f position(0, 0, 0);
+      if (lane < numLanes)
+      {
+        auto particle = integralCurve.GetParticle(firstIdx + lane);
+        time[lane] = particle.GetTime();
+        position = particle.GetPosition();
+        integralCurve.PreStepUpdate(firstIdx + lane, particle);
+        active[lane] = true;
+      }
+      pos[0][lane] = position[0];
+      pos[1][lane] = position[1];
+      pos[2][lane] = position[2];
+    }
+
+    viskores::IdComponent numActive = numLanes;
+    while (numActive > 0)
+    {
+      packetStepper.Step(pos, active, outpos, status);
+
+      numActive = 0;
+      for (viskores::IdComponent lane = 0; lane < numLanes; lane++)
+      {
+        if (!active[lane])
+          continue;
+
+        const viskores::Id idx = firstIdx + lane;
+        auto particle = integralCurve.GetParticle(idx);
+        IntegratorStatus laneStatus = status[lane];
+        viskores::Vec3f laneOutpos(outpos[0][lane], outpos[1][lane], outpos[2][lane]);
+        if (laneStatus.CheckOk())
+        {
+          time[lane] += integrator.GetDeltaT();
+          integralCurve.StepUpdate(idx, particle, time[lane], laneOutpos);
+          tookAnySteps[lane] = true;
+        }
+        else if (laneStatus.CheckSpatialBounds() && this->PushOutOfBounds)
+        {
+          laneStatus = integrator.SmallStep(particle, time[lane], laneOutpos);
+          if (laneStatus.CheckOk())
+          {
+            integralCurve.StepUpdate(idx, particle, time[lane], laneOutpos);
+            tookAnySteps[lane] = true;
+          }
+        }
+        integralCurve.StatusUpdate(idx, laneStatus);
+
+        active[lane] = integralCurve.CanContinue(idx);
+        if (active[lane])
+        {
+          const viskores::Vec3f position = integralCurve.GetParticle(idx).GetPosition();
+          pos[0][lane] = position[0];
+          pos[1][lane] = position[1];
+          pos[2][lane] = position[2];
+          numActive++;
+        }
+      }
+    }
+
+    for (viskores::IdComponent lane = 0; lane < numLanes; lane++)
+      integralCurve.UpdateTookSteps(firstIdx + lane, tookAnySteps[lane]);
+  }
+
+private:
+  viskores::Id NumParticles;
+  bool PushOutOfBounds;
+};
+
 template <typename IntegratorType,
           typename ParticleType,
           typename TerminationType,
@@ -166,6 +278,76 @@ public:
   }
 };
 
+namespace detail
+{
+template <viskores::IdComponent Width,
+          typename PacketStepperType,
+          typename IntegratorType,
+          typename ParticleType,
+          typename ParticleStorage,
+          typename TerminationType,
+          typename AnalysisType>
+void RunPackets(const PacketStepperType& packetStepper,
+                const IntegratorType& integrator,
+                viskores::cont::ArrayHandle<ParticleType, ParticleStorage>& particles,
+                const TerminationType& termination,
+                AnalysisType& analysis)
+{
+  using ParticleArrayType =
+    viskores::worklet::flow::Particles<ParticleType, TerminationType, AnalysisType>;
+
+  const viskores::Id numParticles = particles.GetNumberOfValues();
+  const viskores::Id numPackets = (numParticles + Width - 1) / Width;
+
+#ifdef VISKORES_CUDA
+  // This worklet needs some extra space on CUDA.
+  viskores::cont::cuda::internal::ScopedCudaStackSize stack(16 * 1024);
+  (void)stack;
+#endif // VISKORES_CUDA
+
+  analysis.InitializeAnalysis(particles);
+  ParticleArrayType particlesObj(particles, termination, analysis);
+
+  viskores::worklet::flow::ParticleAdvectPacketWorklet<Width> worklet(
+    numParticles, analysis.SupportPushOutOfBounds());
+  viskores::cont::Invoker invoker;
+  invoker(
+    worklet, viskores::cont::ArrayHandleIndex(numPackets), packetStepper, integrator, particlesObj);
+
+  analysis.FinalizeAnalysis(particles);
+}
+} // namespace detail
+
+template <typename PacketStepperType,
+          typename IntegratorType,
+          typename ParticleType,
+          typename ParticleStorage,
+          typename TerminationType,
+          typename AnalysisType>
+void ParticleAdvection::RunPackets(
+  const PacketStepperType& packetStepper,
+  const IntegratorType& it,
+  viskores::cont::ArrayHandle<ParticleType, ParticleStorage>& particles,
+  const TerminationType& termination,
+  AnalysisType& analysis,
+  viskores::IdComponent packetWidth)
+{
+  switch (packetWidth)
+  {
+    case 4:
+      detail::RunPackets<4>(packetStepper, it, particles, termination, analysis);
+      break;
+    case 8:
+      detail::RunPackets<8>(packetStepper, it, particles, termination, analysis);
+      break;
+    case 16:
+      detail::RunPackets<16>(packetStepper, it, particles, termination, analysis);
+      break;
+    default:
+      throw viskores::cont::ErrorBadValue("Particle packet width must be 4, 8, or 16.");
+  }
+}
+
 template <typename IntegratorType,
           typename ParticleType,
           typename ParticleStorage,
@@ -35,6 +35,8 @@ template <typename ExecEvaluatorType>
 class ExecRK4Integrator
 {
 public:
+  using CellHint = typename ExecEvaluatorType::CellHint;
+
   VISKORES_EXEC_CONT
   ExecRK4Integrator(const ExecEvaluatorType& evaluator)
     : Evaluator(evaluator)
@@ -45,6 +47,16 @@ public:
   VISKORES_EXEC IntegratorStatus CheckStep(const Particle& particle,
                                            viskores::FloatDefault stepLength,
                                            viskores::Vec3f& velocity) const
+  {
+    CellHint hint;
+    return this->CheckStep(particle, stepLength, velocity, hint);
+  }
+
+  template <typename Particle>
+  VISKORES_EXEC IntegratorStatus CheckStep(const Particle& particle,
+                                           viskores::FloatDefault stepLength,
+                                           viskores::Vec3f& velocity,
+                                           CellHint& hint) const
   {
     auto time = particle.GetTime();
     auto inpos = particle.GetEvaluationPosition(stepLength);
@@ -69,22 +81,22 @@ public:
 
     GridEvaluatorStatus evalStatus;
 
-    evalStatus = this->Evaluator.Evaluate(inpos, time, k1);
+    evalStatus = this->Evaluator.Evaluate(inpos, time, k1, hint);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus, false);
     v1 = particle.Velocity(k1, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v1, var2, k2);
+    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v1, var2, k2, hint);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus, false);
     v2 = particle.Velocity(k2, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v2, var2, k3);
+    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v2, var2, k3, hint);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus, false);
     v3 = particle.Velocity(k3, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + stepLength * v3, var3, k4);
+    evalStatus = this->Evaluator.Evaluate(inpos + stepLength * v3, var3, k4, hint);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus, false);
     v4 = particle.Velocity(k4, stepLength);
@@ -44,6 +44,9 @@ private:
   viskores::FloatDefault Tolerance;
 
 public:
+  /// Carries the cell a particle was last found in from one step to the next.
+  using CellHint = typename ExecEvaluatorType::CellHint;
+
   VISKORES_EXEC_CONT
   StepperImpl(const ExecIntegratorType& integrator,
               const ExecEvaluatorType& evaluator,
@@ -56,13 +59,25 @@ public:
   {
   }
 
+  VISKORES_EXEC_CONT viskores::FloatDefault GetDeltaT() const { return this->DeltaT; }
+
   template <typename Particle>
   VISKORES_EXEC IntegratorStatus Step(Particle& particle,
                                       viskores::FloatDefault& time,
                                       viskores::Vec3f& outpos) const
+  {
+    CellHint hint;
+    return this->Step(particle, time, outpos, hint);
+  }
+
+  template <typename Particle>
+  VISKORES_EXEC IntegratorStatus Step(Particle& particle,
+                                      viskores::FloatDefault& time,
+                                      viskores::Vec3f& outpos,
+                                      CellHint& hint) const
   {
     viskores::Vec3f velocity(0, 0, 0);
-    auto status = this->Integrator.CheckStep(particle, this->DeltaT, velocity);
+    auto status = this->Integrator.CheckStep(particle, this->DeltaT, velocity, hint);
     if (status.CheckOk())
     {
       outpos = particle.GetPosition() + this->DeltaT * velocity;
@@ -78,6 +93,16 @@ public:
   VISKORES_EXEC IntegratorStatus SmallStep(Particle& particle,
                                            viskores::FloatDefault& time,
                                            viskores::Vec3f& outpos) const
+  {
+    CellHint hint;
+    return this->SmallStep(particle, time, outpos, hint);
+  }
+
+  template <typename Particle>
+  VISKORES_EXEC IntegratorStatus SmallStep(Particle& particle,
+                                           viskores::FloatDefault& time,
+                                           viskores::Vec3f& outpos,
+                                           CellHint& hint) const
   {
     //Stepping by this->DeltaT goes beyond the bounds of the dataset.
     //We need to take an Euler step that goes outside of the dataset.
@@ -92,7 +117,7 @@ public:
     viskores::Vec3f currPos(particle.GetEvaluationPosition(this->DeltaT));
     viskores::Vec3f currVelocity(0, 0, 0);
     viskores::VecVariable<viskores::Vec3f, 2> currValue, tmp;
-    auto evalStatus = this->Evaluator.Evaluate(currPos, particle.GetTime(), currValue);
+    auto evalStatus = this->Evaluator.Evaluate(currPos, particle.GetTime(), currValue, hint);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus, false);
 
@@ -105,13 +130,13 @@ public:
       viskores::FloatDefault currStep = stepRange[0] + (this->DeltaT / div);
 
       //See if we can step by currStep
-      IntegratorStatus status = this->Integrator.CheckStep(particle, currStep, currVelocity);
+      IntegratorStatus status = this->Integrator.CheckStep(particle, currStep, currVelocity, hint);
 
       if (status.CheckOk()) //Integration step succedded.
       {
         //See if this point is in/out.
         auto newPos = particle.GetPosition() + currStep * currVelocity;
-        evalStatus = this->Evaluator.Evaluate(newPos, particle.GetTime() + currStep, tmp);
+        evalStatus = this->Evaluator.Evaluate(newPos, particle.GetTime() + currStep, tmp, hint);
         if (evalStatus.CheckOk())
         {
           //Point still in. Update currPos and set range to {currStep, stepRange[1]}
@@ -132,7 +157,8 @@ public:
       }
     }
 
-    evalStatus = this->Evaluator.Evaluate(currPos, particle.GetTime() + stepRange[0], currValue);
+    evalStatus =
+      this->Evaluator.Evaluate(currPos, particle.GetTime() + stepRange[0], currValue, hint);
     // The eval at Time + stepRange[0] better be *inside*
     VISKORES_ASSERT(evalStatus.CheckOk() && !evalStatus.CheckSpatialBounds());
     if (evalStatus.CheckFail() || evalStatus.CheckSpatialBounds())
@@ -144,7 +170,7 @@ public:
     time += stepRange[1];
 
     // Get the evaluation status for the point that is moved by the euler step.
-    evalStatus = this->Evaluator.Evaluate(outpos, time, currValue);
+    evalStatus = this->Evaluator.Evaluate(outpos, time, currValue, hint);
 
     IntegratorStatus status(evalStatus,
                             viskores::MagnitudeSquared(velocity) <=
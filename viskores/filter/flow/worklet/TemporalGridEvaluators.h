@@ -37,6 +37,13 @@ private:
   using ExecutionGridEvaluator = viskores::worklet::flow::ExecutionGridEvaluator<FieldType>;
 
 public:
+  /// Cell hints for the evaluators of both time slices.
+  struct CellHint
+  {
+    typename ExecutionGridEvaluator::CellHint One;
+    typename ExecutionGridEvaluator::CellHint Two;
+  };
+
   VISKORES_CONT
   ExecutionTemporalGridEvaluator() = default;
 
@@ -80,7 +87,8 @@ public:
   template <typename Point>
   VISKORES_EXEC GridEvaluatorStatus Evaluate(const Point& particle,
                                              viskores::FloatDefault time,
-                                             viskores::VecVariable<Point, 2>& out) const
+                                             viskores::VecVariable<Point, 2>& out,
+                                             CellHint& hint) const
   {
     // Validate time is in bounds for the current two slices.
     GridEvaluatorStatus status;
@@ -93,10 +101,10 @@ public:
     }
 
     viskores::VecVariable<Point, 2> e1, e2;
-    status = this->EvaluatorOne.Evaluate(particle, time, e1);
+    status = this->EvaluatorOne.Evaluate(particle, time, e1, hint.One);
     if (status.CheckFail())
       return status;
-    status = this->EvaluatorTwo.Evaluate(particle, time, e2);
+    status = this->EvaluatorTwo.Evaluate(particle, time, e2, hint.Two);
     if (status.CheckFail())
       return status;
 
@@ -112,6 +120,15 @@ public:
     return status;
   }
 
+  template <typename Point>
+  VISKORES_EXEC GridEvaluatorStatus Evaluate(const Point& particle,
+                                             viskores::FloatDefault time,
+                                             viskores::VecVariable<Point, 2>& out) const
+  {
+    CellHint hint;
+    return this->Evaluate(particle, time, out, hint);
+  }
+
 private:
   ExecutionGridEvaluator EvaluatorOne;
   ExecutionGridEvaluator EvaluatorTwo;
@@ -143,6 +160,22 @@ public:
   {
   }
 
+  /// Takes the cell locators of both time steps from `locators`. When the time steps
+  /// share their geometry, one locator is built and used for both.
+  VISKORES_CONT TemporalGridEvaluator(const viskores::cont::DataSet& ds1,
+                                      const viskores::FloatDefault t1,
+                                      const FieldType& field1,
+                                      const viskores::cont::DataSet& ds2,
+                                      const viskores::FloatDefault t2,
+                                      const FieldType& field2,
+                                      const viskores::cont::LocatorCache& locators)
+    : EvaluatorOne(GridEvaluator(ds1, field1, locators))
+    , EvaluatorTwo(GridEvaluator(ds2, field2, locators))
+    , TimeOne(t1)
+    , TimeTwo(t2)
+  {
+  }
+
 
   VISKORES_CONT TemporalGridEvaluator(GridEvaluator& evaluatorOne,
                                       const viskores::FloatDefault timeOne,
@@ -111,6 +111,7 @@ void Probe::SetGeometry(const viskores::cont::ArrayHandle<viskores::Vec3f>& poin
 viskores::cont::DataSet Probe::DoExecute(const viskores::cont::DataSet& input)
 {
   viskores::worklet::Probe worklet;
+  worklet.SetLocatorCache(this->Locators);
   worklet.Run(input.GetCellSet(),
               input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex()),
               this->Geometry.GetCoordinateSystem().GetData());
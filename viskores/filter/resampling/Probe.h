@@ -19,6 +19,7 @@
 #define viskores_filter_resampling_Probe_h
 
 #include <viskores/cont/ArrayCopy.h>
+#include <viskores/cont/LocatorCache.h>
 #include <viskores/filter/Filter.h>
 #include <viskores/filter/resampling/viskores_filter_resampling_export.h>
 
@@ -94,12 +95,31 @@ public:
   /// @copydoc SetInvalidValue
   VISKORES_CONT viskores::Float64 GetInvalidValue() const { return this->InvalidValue; }
 
+  /// @brief Specify the cache of cell locators for the input.
+  ///
+  /// Finding the cells of the probe points requires a cell locator for the input.
+  /// The locators are kept in this cache, so executing the filter again on an input
+  /// with the same, unmodified cells and coordinates (such as the time steps of a
+  /// fixed mesh) does not rebuild the locator. Filters given copies of the same cache
+  /// share their locators.
+  VISKORES_CONT void SetLocatorCache(const viskores::cont::LocatorCache& cache)
+  {
+    this->Locators = cache;
+  }
+  /// @copydoc SetLocatorCache
+  VISKORES_CONT const viskores::cont::LocatorCache& GetLocatorCache() const
+  {
+    return this->Locators;
+  }
+
 private:
   VISKORES_CONT viskores::cont::DataSet DoExecute(const viskores::cont::DataSet& input) override;
 
   viskores::cont::DataSet Geometry;
 
   viskores::Float64 InvalidValue = viskores::Nan64();
+
+  viskores::cont::LocatorCache Locators;
 };
 
 } // namespace resampling
@@ -395,12 +395,33 @@ private:
     }
   }
 
+  static void ReuseLocator()
+  {
+    std::cout << "Testing Probe locator reuse:\n";
+
+    auto input = ConvertDataSetUniformToExplicit(MakeInputDataSet());
+    viskores::filter::resampling::Probe probe;
+    probe.SetGeometry(ConvertDataSetUniformToExplicit(MakeGeometryDataSet()));
+    probe.SetFieldsToPass({ "pointdata" });
+
+    //Probing the same input again does not build another locator.
+    for (int i = 0; i < 2; i++)
+    {
+      auto output = probe.Execute(input);
+      TestResultArray(viskores::cont::Cast<FieldArrayType>(output.GetField("pointdata").GetData()),
+                      GetExpectedPointData());
+    }
+    VISKORES_TEST_ASSERT(probe.GetLocatorCache().GetNumberOfBuilds() == 1,
+                         "Locator was rebuilt for the same input.");
+  }
+
 public:
   static void Run()
   {
     ExplicitToUnifrom();
     UniformToExplict();
     ExplicitToExplict();
+    ReuseLocator();
   }
 };
 
@@ -22,6 +22,7 @@
 #include <viskores/cont/ArrayHandle.h>
 #include <viskores/cont/CellLocatorChooser.h>
 #include <viskores/cont/Invoker.h>
+#include <viskores/cont/LocatorCache.h>
 #include <viskores/exec/CellInside.h>
 #include <viskores/exec/CellInterpolate.h>
 #include <viskores/exec/ParametricCoordinates.h>
@@ -65,8 +66,12 @@ private:
     template <typename LocatorType, typename PointsType>
     void operator()(const LocatorType& locator, Probe& worklet, const PointsType& points) const
     {
+      // The chooser only picks the locator type. A locator already built for this geometry
+      // is reused from the cache.
+      LocatorType cachedLocator = worklet.Locators.GetCellLocator<LocatorType>(
+        worklet.InputCellSet, locator.GetCoordinates());
       worklet.Invoke(
-        FindCellWorklet{}, points, locator, worklet.CellIds, worklet.ParametricCoordinates);
+        FindCellWorklet{}, points, cachedLocator, worklet.CellIds, worklet.ParametricCoordinates);
     }
   };
 
@@ -179,6 +184,11 @@ private:
   };
 
 public:
+  /// Sets the cache the cell locators are taken from. Copies of a cache share their
+  /// locators, so passing the same cache to several runs over the same geometry builds
+  /// the locator only once.
+  void SetLocatorCache(const viskores::cont::LocatorCache& cache) { this->Locators = cache; }
+
   template <typename CellSetType, typename PointsArrayType>
   void Run(const CellSetType& cells,
            const viskores::cont::CoordinateSystem& coords,
@@ -307,6 +317,7 @@ private:
   viskores::cont::ArrayHandle<viskores::Id> CellIds;
   viskores::cont::ArrayHandle<viskores::Vec3f> ParametricCoordinates;
   viskores::cont::UnknownCellSet InputCellSet;
+  viskores::cont::LocatorCache Locators;
 
   viskores::cont::Invoker Invoke;
 };
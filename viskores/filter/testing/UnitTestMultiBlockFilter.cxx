@@ -118,6 +118,8 @@ void TestMultiBlockFilter()
     clip.SetFieldsToPass("tangle", viskores::cont::Field::Association::Points);
     auto result = clip.Execute(pds);
     VISKORES_TEST_ASSERT(result.GetNumberOfPartitions() == pds.GetNumberOfPartitions());
+    VISKORES_TEST_ASSERT(clip.GetPartitionTimings().size() ==
+                         static_cast<std::size_t>(pds.GetNumberOfPartitions()));
     results.push_back(result);
   }
   ValidateResults(results[0], results[1], "tangle");
@@ -0,0 +1,162 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/ErrorBadValue.h>
+#include <viskores/cont/testing/Testing.h>
+
+#include <viskores/filter/PartitionScheduler.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+constexpr viskores::Id NumTasks = 37;
+
+void TestRunAllTasks(viskores::filter::PartitionScheduler& scheduler)
+{
+  std::cout << "Run all tasks" << std::endl;
+  std::vector<std::atomic<viskores::Id>> counts(NumTasks);
+  for (auto& count : counts)
+  {
+    count = 0;
+  }
+
+  std::vector<viskores::filter::PartitionTiming> timings;
+  scheduler.Execute(
+    NumTasks,
+    4,
+    [&](viskores::Id index)
+    {
+      // Uneven work so that workers have to steal from each other.
+      std::this_thread::sleep_for(std::chrono::microseconds((index % 5) * 200));
+      ++counts[static_cast<std::size_t>(index)];
+    },
+    timings);
+
+  VISKORES_TEST_ASSERT(scheduler.GetNumberOfWorkers() == 4, "Wrong number of workers");
+  VISKORES_TEST_ASSERT(timings.size() == static_cast<std::size_t>(NumTasks), "Bad timings");
+  for (viskores::Id index = 0; index < NumTasks; ++index)
+  {
+    VISKORES_TEST_ASSERT(counts[static_cast<std::size_t>(index)] == 1, "Task not run once");
+    const auto& timing = timings[static_cast<std::size_t>(index)];
+    VISKORES_TEST_ASSERT(timing.PartitionIndex == index, "Bad timing index");
+    VISKORES_TEST_ASSERT((timing.WorkerIndex >= 0) && (timing.WorkerIndex < 4), "Bad worker");
+    VISKORES_TEST_ASSERT(timing.ElapsedTime >= 0.0, "Bad elapsed time");
+  }
+
+  std::cout << "Reuse workers" << std::endl;
+  std::atomic<viskores::Id> total{ 0 };
+  scheduler.Execute(NumTasks, 2, [&](viskores::Id index) { total += index; });
+  VISKORES_TEST_ASSERT(total == (NumTasks * (NumTasks - 1)) / 2, "Wrong sum of tasks");
+  VISKORES_TEST_ASSERT(scheduler.GetNumberOfWorkers() == 4, "Workers were not reused");
+}
+
+void TestSerial(viskores::filter::PartitionScheduler& scheduler)
+{
+  std::cout << "Run serial" << std::endl;
+  std::vector<viskores::Id> order;
+  std::vector<viskores::filter::PartitionTiming> timings;
+  const auto callerId = std::this_thread::get_id();
+  scheduler.Execute(
+    NumTasks,
+    1,
+    [&](viskores::Id index)
+    {
+      VISKORES_TEST_ASSERT(std::this_thread::get_id() == callerId, "Not run on caller");
+      order.push_back(index);
+    },
+    timings);
+  for (viskores::Id index = 0; index < NumTasks; ++index)
+  {
+    VISKORES_TEST_ASSERT(order[static_cast<std::size_t>(index)] == index, "Out of order");
+    VISKORES_TEST_ASSERT(timings[static_cast<std::size_t>(index)].WorkerIndex == -1,
+                         "Serial task reported a worker");
+  }
+}
+
+void TestNested(viskores::filter::PartitionScheduler& scheduler)
+{
+  std::cout << "Run nested" << std::endl;
+  std::atomic<viskores::Id> total{ 0 };
+  scheduler.Execute(NumTasks,
+                    3,
+                    [&](viskores::Id)
+                    {
+                      VISKORES_TEST_ASSERT(viskores::filter::PartitionScheduler::InWorkerThread(),
+                                           "Task not on worker thread");
+                      // Nested calls run inline rather than waiting on the busy workers.
+                      scheduler.Execute(4, 4, [&](viskores::Id) { ++total; });
+                    });
+  VISKORES_TEST_ASSERT(total == NumTasks * 4, "Nested tasks not run");
+  VISKORES_TEST_ASSERT(!viskores::filter::PartitionScheduler::InWorkerThread(),
+                       "Caller reported as worker");
+}
+
+void TestException(viskores::filter::PartitionScheduler& scheduler)
+{
+  std::cout << "Propagate exception" << std::endl;
+  bool caught = false;
+  try
+  {
+    scheduler.Execute(NumTasks,
+                      4,
+                      [&](viskores::Id index)
+                      {
+                        if (index == 5)
+                        {
+                          throw viskores::cont::ErrorBadValue("Expected error");
+                        }
+                      });
+  }
+  catch (viskores::cont::ErrorBadValue&)
+  {
+    caught = true;
+  }
+  VISKORES_TEST_ASSERT(caught, "Exception not propagated");
+
+  // The scheduler is still usable after a failure.
+  std::atomic<viskores::Id> count{ 0 };
+  scheduler.Execute(NumTasks, 4, [&](viskores::Id) { ++count; });
+  VISKORES_TEST_ASSERT(count == NumTasks, "Scheduler broken after exception");
+}
+
+void TestVaryingWorkers(viskores::filter::PartitionScheduler& scheduler)
+{
+  std::cout << "Vary the number of workers" << std::endl;
+  // Batches that use fewer workers than the pool has leave idle workers that wake up while,
+  // or after, the batch finishes. Short batches make these wakeups race with the next batch.
+  for (viskores::Id iteration = 0; iteration < 1000; ++iteration)
+  {
+    const viskores::Id numWorkers = 2 + (iteration * 5) % 7;
+    const viskores::Id numTasks = 1 + (iteration * 3) % NumTasks;
+    std::atomic<viskores::Id> total{ 0 };
+    scheduler.Execute(numTasks, numWorkers, [&](viskores::Id index) { total += index + 1; });
+    VISKORES_TEST_ASSERT(total == (numTasks * (numTasks + 1)) / 2, "Wrong sum of tasks");
+  }
+  VISKORES_TEST_ASSERT(scheduler.GetNumberOfWorkers() == 8, "Wrong number of workers");
+}
+
+void TestPartitionScheduler()
+{
+  viskores::filter::PartitionScheduler scheduler;
+  TestRunAllTasks(scheduler);
+  TestSerial(scheduler);
+  TestNested(scheduler);
+  TestException(scheduler);
+  TestVaryingWorkers(scheduler);
+}
+
+} // anonymous namespace
+
+int UnitTestPartitionScheduler(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestPartitionScheduler, argc, argv);
+}
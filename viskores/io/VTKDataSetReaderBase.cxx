@@ -21,19 +21,107 @@
 #include <viskores/VecTraits.h>
 #include <viskores/cont/ArrayCopy.h>
 #include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/ArrayHandleBasic.h>
+#include <viskores/cont/ArrayHandleGroupVec.h>
 #include <viskores/cont/ArrayHandleOffsetsToNumComponents.h>
 #include <viskores/cont/ArrayHandleRuntimeVec.h>
+#include <viskores/cont/ArrayHandleTransform.h>
 #include <viskores/cont/ArrayPortalToIterators.h>
 #include <viskores/cont/Logging.h>
 #include <viskores/cont/UnknownArrayHandle.h>
 
 #include <algorithm>
+#include <cstring>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace
 {
 
+template <std::size_t Size>
+struct UnsignedOfSize;
+template <>
+struct UnsignedOfSize<1>
+{
+  using Type = viskores::UInt8;
+};
+template <>
+struct UnsignedOfSize<2>
+{
+  using Type = viskores::UInt16;
+};
+template <>
+struct UnsignedOfSize<4>
+{
+  using Type = viskores::UInt32;
+};
+template <>
+struct UnsignedOfSize<8>
+{
+  using Type = viskores::UInt64;
+};
+
+inline void FlipCopiedValues(viskores::cont::ArrayHandle<viskores::UInt8>&)
+{
+  // Single bytes have no byte order.
+}
+template <typename T>
+inline void FlipCopiedValues(viskores::cont::ArrayHandle<T>& values)
+{
+  viskores::io::internal::FlipEndiannessInPlace(values);
+}
+
+template <typename T, typename BitsType>
+bool MakeFlippedArray(const viskores::cont::ArrayHandle<BitsType>&,
+                      viskores::IdComponent,
+                      viskores::cont::UnknownArrayHandle&,
+                      std::false_type)
+{
+  // Single bytes have no byte order.
+  return false;
+}
+
+// Wraps big-endian values on the mapping in an array that swaps them on access. Tuples with a
+// common number of components become `Vec`s. Returns false for other sizes.
+template <typename T, typename BitsType>
+bool MakeFlippedArray(const viskores::cont::ArrayHandle<BitsType>& bits,
+                      viskores::IdComponent numComponents,
+                      viskores::cont::UnknownArrayHandle& data,
+                      std::true_type)
+{
+  using Functor = viskores::io::internal::FlipEndiannessFunctor<T>;
+  switch (numComponents)
+  {
+    case 1:
+      data = viskores::cont::make_ArrayHandleTransform(bits, Functor{});
+      return true;
+    case 2:
+      data = viskores::cont::make_ArrayHandleTransform(
+        viskores::cont::make_ArrayHandleGroupVec<2>(bits), Functor{});
+      return true;
+    case 3:
+      data = viskores::cont::make_ArrayHandleTransform(
+        viskores::cont::make_ArrayHandleGroupVec<3>(bits), Functor{});
+      return true;
+    case 4:
+      data = viskores::cont::make_ArrayHandleTransform(
+        viskores::cont::make_ArrayHandleGroupVec<4>(bits), Functor{});
+      return true;
+    case 9:
+      data = viskores::cont::make_ArrayHandleTransform(
+        viskores::cont::make_ArrayHandleGroupVec<9>(bits), Functor{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+void ReleaseMappedFile(void* container)
+{
+  delete static_cast<std::shared_ptr<viskores::io::internal::MemoryMappedFile>*>(container);
+}
+
 inline void PrintVTKDataFileSummary(const viskores::io::internal::VTKDataSetFile& df,
                                     std::ostream& out)
 {
@@ -148,6 +236,13 @@ void VTKDataSetReaderBase::ReadCells(viskores::cont::ArrayHandle<viskores::Id>&
     internal::parseAssert(tag == "OFFSETS");
     auto offsets =
       this->DoReadArrayVariant(viskores::cont::Field::Association::Any, dataType, offsetsSize, 1);
+    if (!offsets.IsStorageType<viskores::cont::StorageTagBasic>())
+    {
+      // Offsets read from a memory mapping may be swapped on access. They are only needed here.
+      viskores::cont::UnknownArrayHandle basicOffsets = offsets.NewInstanceBasic();
+      basicOffsets.DeepCopyFrom(offsets);
+      offsets = basicOffsets;
+    }
     offsets.CastAndCallForTypes<viskores::List<viskores::Int64, viskores::Int32>,
                                 viskores::List<viskores::cont::StorageTagBasic>>(
       [&](const auto& offsetsAH)
@@ -271,6 +366,8 @@ void VTKDataSetReaderBase::ReadAttributes()
 void VTKDataSetReaderBase::CloseFile()
 {
   this->DataFile->Stream.close();
+  // Arrays taken from the mapping hold their own reference to it.
+  this->DataFile->MappedFile.reset();
 }
 
 void VTKDataSetReaderBase::OpenFile()
@@ -534,6 +631,85 @@ void VTKDataSetReaderBase::ReadGlobalOrPedigreeIds(viskores::cont::Field::Associ
   this->SkipArrayMetaData(1);
 }
 
+template <typename T>
+bool VTKDataSetReaderBase::ReadArrayMapped(std::size_t numValues,
+                                           viskores::IdComponent numComponents,
+                                           viskores::cont::UnknownArrayHandle& data)
+{
+  internal::VTKDataSetFile& file = *this->DataFile;
+  if (!file.MappedFile)
+  {
+    try
+    {
+      file.MappedFile = std::make_shared<internal::MemoryMappedFile>(file.FileName);
+    }
+    catch (viskores::io::ErrorIO& error)
+    {
+      VISKORES_LOG_S(viskores::cont::LogLevel::Warn,
+                     error.GetMessage() << " Reading " << file.FileName << " without mapping.");
+      file.UseMemoryMapping = false;
+      return false;
+    }
+  }
+
+  const std::size_t numBytes = numValues * sizeof(T);
+  const std::size_t offset = static_cast<std::size_t>(file.Stream.tellg());
+  if ((numBytes == 0) || (offset + numBytes > file.MappedFile->GetSize()))
+  {
+    // Let the stream handle (and report) empty and truncated arrays.
+    return false;
+  }
+
+  file.Stream.seekg(static_cast<std::streamoff>(numBytes), std::ios_base::cur);
+
+  using BitsType = typename UnsignedOfSize<sizeof(T)>::Type;
+  const bool flip = (sizeof(T) > 1) && viskores::io::internal::IsLittleEndian();
+  const char* values = file.MappedFile->GetData() + offset;
+  if ((offset % alignof(T)) == 0)
+  {
+    // The mapped bytes are never written, so the pages stay shared with the file cache.
+    viskores::cont::ArrayHandleBasic<T> array(
+      reinterpret_cast<T*>(const_cast<char*>(values)),
+      new std::shared_ptr<internal::MemoryMappedFile>(file.MappedFile),
+      static_cast<viskores::Id>(numValues),
+      ReleaseMappedFile);
+    if (!flip)
+    {
+      data = viskores::cont::make_ArrayHandleRuntimeVec(numComponents, array);
+    }
+    else if (!MakeFlippedArray<T>(viskores::cont::ArrayHandle<BitsType>(array.GetBuffers()),
+                                  numComponents,
+                                  data,
+                                  std::integral_constant<bool, (sizeof(T) > 1)>{}))
+    {
+      // No fixed size `Vec` for this many components, so fall back to a swapped copy.
+      viskores::cont::ArrayHandleBasic<T> copy;
+      copy.DeepCopyFrom(array);
+      viskores::cont::ArrayHandle<BitsType> rawValues(copy.GetBuffers());
+      FlipCopiedValues(rawValues);
+      data = viskores::cont::make_ArrayHandleRuntimeVec(numComponents, copy);
+    }
+  }
+  else
+  {
+    // The text header leaves binary sections at arbitrary offsets. Values must be aligned, so
+    // a misaligned section is copied (and swapped) into its own buffer.
+    viskores::cont::ArrayHandleBasic<T> copy;
+    copy.Allocate(static_cast<viskores::Id>(numValues));
+    std::memcpy(copy.GetWritePointer(), values, numBytes);
+    if (flip)
+    {
+      viskores::cont::ArrayHandle<BitsType> rawValues(copy.GetBuffers());
+      FlipCopiedValues(rawValues);
+    }
+    data = viskores::cont::make_ArrayHandleRuntimeVec(numComponents, copy);
+  }
+
+  file.Stream >> std::ws;
+  this->SkipArrayMetaData(numComponents);
+  return true;
+}
+
 class VTKDataSetReaderBase::SkipArrayVariant
 {
 public:
@@ -574,10 +750,18 @@ public:
   template <typename T>
   void operator()(T) const
   {
+    const bool permute = (this->Association == viskores::cont::Field::Association::Cells) &&
+      (this->Reader->GetCellsPermutation().GetNumberOfValues() > 0);
+    if (std::is_arithmetic<T>::value && !permute && this->Reader->DataFile->IsBinary &&
+        this->Reader->DataFile->UseMemoryMapping &&
+        this->Reader->ReadArrayMapped<T>(this->TotalSize, this->NumComponents, *this->Data))
+    {
+      return;
+    }
+
     std::vector<T> buffer(this->TotalSize);
     this->Reader->ReadArray(buffer);
-    if ((this->Association != viskores::cont::Field::Association::Cells) ||
-        (this->Reader->GetCellsPermutation().GetNumberOfValues() < 1))
+    if (!permute)
     {
       *this->Data =
         viskores::cont::make_ArrayHandleRuntimeVecMove(this->NumComponents, std::move(buffer));
@@ -24,10 +24,13 @@
 #include <viskores/io/viskores_io_export.h>
 
 #include <viskores/io/internal/Endian.h>
+#include <viskores/io/internal/MemoryMappedFile.h>
+#include <viskores/io/internal/ParseASCII.h>
 #include <viskores/io/internal/VTKDataSetStructures.h>
 #include <viskores/io/internal/VTKDataSetTypes.h>
 
 #include <fstream>
+#include <memory>
 #include <sstream>
 
 namespace viskores
@@ -46,6 +49,9 @@ struct VTKDataSetFile
   bool IsBinary;
   viskores::io::internal::DataSetStructure Structure;
   std::ifstream Stream;
+
+  bool UseMemoryMapping = false;
+  std::shared_ptr<viskores::io::internal::MemoryMappedFile> MappedFile;
 };
 
 inline void parseAssert(bool condition)
@@ -142,6 +148,29 @@ public:
 
   virtual VISKORES_CONT void PrintSummary(std::ostream& out) const;
 
+  /// @brief Specify whether binary arrays are read from a memory mapping of the file.
+  ///
+  /// When on, the file is mapped into memory (copy-on-write) and the arrays of a binary
+  /// file are built directly on the mapped pages rather than read through a stream into
+  /// newly allocated buffers. The mapped data is never modified, so it is not copied.
+  ///
+  /// Legacy VTK files store data big-endian. On little-endian hosts, arrays of multi-byte
+  /// values are read-only `ArrayHandleTransform`s that swap the bytes of each value on access
+  /// (with tuples of 2, 3, 4, or 9 components grouped into `Vec`s). Filters that need a basic
+  /// array copy the data when they first use it. Arrays with other numbers of components, and
+  /// arrays that the text header leaves misaligned in the file, are copied and swapped when
+  /// they are read.
+  ///
+  /// Arrays read this way keep the mapping alive after the reader is destroyed. They cannot
+  /// be resized in place. Arrays that need reordering (such as cell data of cells that are
+  /// split) and ASCII files are still read through the stream, as are all files on platforms
+  /// that do not support memory mapping. This option is off by default.
+  VISKORES_CONT void SetUseMemoryMapping(bool useMemoryMapping)
+  {
+    this->DataFile->UseMemoryMapping = useMemoryMapping;
+  }
+  VISKORES_CONT bool GetUseMemoryMapping() const { return this->DataFile->UseMemoryMapping; }
+
 protected:
   VISKORES_CONT void ReadPoints();
 
@@ -201,6 +230,13 @@ private:
   class SkipArrayVariant;
   class ReadArrayVariant;
 
+  // Builds `data` on the memory mapping of the file. Returns false (without consuming any
+  // input) if the array has to be read through the stream instead.
+  template <typename T>
+  VISKORES_CONT bool ReadArrayMapped(std::size_t numValues,
+                                     viskores::IdComponent numComponents,
+                                     viskores::cont::UnknownArrayHandle& data);
+
   //Make the Array parsing methods protected so that derived classes
   //can call the methods.
 protected:
@@ -231,15 +267,9 @@ protected:
     }
     else
     {
-      for (std::size_t i = 0; i < numElements; ++i)
-      {
-        for (viskores::IdComponent j = 0; j < numComponents; ++j)
-        {
-          typename internal::StreamIOType<ComponentType>::Type val;
-          this->DataFile->Stream >> val;
-          viskores::VecTraits<T>::SetComponent(buffer[i], j, static_cast<ComponentType>(val));
-        }
-      }
+      internal::ParseASCIIValues(this->DataFile->Stream,
+                                 reinterpret_cast<ComponentType*>(buffer.data()),
+                                 numElements * static_cast<std::size_t>(numComponents));
     }
     this->DataFile->Stream >> std::ws;
     this->SkipArrayMetaData(numComponents);
@@ -0,0 +1,762 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/io/VTKXMLDataSetReader.h>
+
+#include <viskores/cont/ArrayCopy.h>
+#include <viskores/cont/ArrayHandleBasic.h>
+#include <viskores/cont/ArrayHandleCartesianProduct.h>
+#include <viskores/cont/ArrayHandleRuntimeVec.h>
+#include <viskores/cont/ArrayHandleUniformPointCoordinates.h>
+#include <viskores/cont/CellSetExplicit.h>
+#include <viskores/cont/CellSetSingleType.h>
+#include <viskores/cont/ConvertNumComponentsToOffsets.h>
+
+#include <viskores/io/ErrorIO.h>
+#include <viskores/io/VTKDataSetReaderBase.h>
+#include <viskores/io/internal/Endian.h>
+#include <viskores/io/internal/MemoryMappedFile.h>
+#include <viskores/io/internal/VTKDataSetCells.h>
+#include <viskores/io/internal/VTKXMLTypes.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace
+{
+
+struct XMLElement
+{
+  std::string Name;
+  std::map<std::string, std::string> Attributes;
+  std::vector<XMLElement> Children;
+
+  bool HasAttribute(const std::string& name) const
+  {
+    return this->Attributes.find(name) != this->Attributes.end();
+  }
+
+  std::string GetAttribute(const std::string& name, const std::string& defaultValue = {}) const
+  {
+    auto attribute = this->Attributes.find(name);
+    return (attribute != this->Attributes.end()) ? attribute->second : defaultValue;
+  }
+
+  const XMLElement* FindChild(const std::string& name) const
+  {
+    for (const XMLElement& child : this->Children)
+    {
+      if (child.Name == name)
+      {
+        return &child;
+      }
+    }
+    return nullptr;
+  }
+
+  const XMLElement& GetChild(const std::string& name) const
+  {
+    const XMLElement* child = this->FindChild(name);
+    if (child == nullptr)
+    {
+      throw viskores::io::ErrorIO("Missing <" + name + "> element in <" + this->Name + ">.");
+    }
+    return *child;
+  }
+};
+
+inline bool IsXMLSpace(char c)
+{
+  return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t');
+}
+
+// Parses the element structure of the XML text before the appended data. This is far from a
+// complete XML parser; it only handles what VTK writes: elements, attributes, comments, and
+// processing instructions. Character data is ignored, and elements left open at the end of
+// the text are closed implicitly.
+XMLElement ParseXMLElements(const std::string& text)
+{
+  XMLElement document;
+  std::vector<XMLElement*> open = { &document };
+  std::size_t position = 0;
+  auto fail = []() { throw viskores::io::ErrorIO("Malformed VTK XML header."); };
+
+  while ((position = text.find('<', position)) != std::string::npos)
+  {
+    if (text.compare(position, 4, "<!--") == 0)
+    {
+      position = text.find("-->", position);
+      position = (position == std::string::npos) ? text.size() : position + 3;
+    }
+    else if ((text.compare(position, 2, "<?") == 0) || (text.compare(position, 2, "<!") == 0))
+    {
+      position = text.find('>', position);
+      position = (position == std::string::npos) ? text.size() : position + 1;
+    }
+    else if (text.compare(position, 2, "</") == 0)
+    {
+      if (open.size() < 2)
+      {
+        fail();
+      }
+      open.pop_back();
+      position = text.find('>', position);
+      position = (position == std::string::npos) ? text.size() : position + 1;
+    }
+    else
+    {
+      // Only the innermost open element gets new children, so pointers to the open elements
+      // stay valid.
+      open.back()->Children.emplace_back();
+      XMLElement& element = open.back()->Children.back();
+      ++position;
+      std::size_t nameEnd = position;
+      while ((nameEnd < text.size()) && !IsXMLSpace(text[nameEnd]) && (text[nameEnd] != '>') &&
+             (text[nameEnd] != '/'))
+      {
+        ++nameEnd;
+      }
+      element.Name = text.substr(position, nameEnd - position);
+      position = nameEnd;
+
+      bool closed = false;
+      while (true)
+      {
+        while ((position < text.size()) && IsXMLSpace(text[position]))
+        {
+          ++position;
+        }
+        if (position >= text.size())
+        {
+          fail();
+        }
+        if (text[position] == '>')
+        {
+          ++position;
+          break;
+        }
+        if (text.compare(position, 2, "/>") == 0)
+        {
+          position += 2;
+          closed = true;
+          break;
+        }
+
+        std::size_t equals = text.find('=', position);
+        if ((equals == std::string::npos) || (equals + 1 >= text.size()))
+        {
+          fail();
+        }
+        std::string name = text.substr(position, equals - position);
+        name.erase(std::find_if(name.begin(), name.end(), IsXMLSpace), name.end());
+        std::size_t quote = equals + 1;
+        while ((quote < text.size()) && IsXMLSpace(text[quote]))
+        {
+          ++quote;
+        }
+        if ((quote >= text.size()) || ((text[quote] != '"') && (text[quote] != '\'')))
+        {
+          fail();
+        }
+        std::size_t valueEnd = text.find(text[quote], quote + 1);
+        if (valueEnd == std::string::npos)
+        {
+          fail();
+        }
+        element.Attributes[name] = viskores::io::internal::UnescapeXMLAttribute(
+          text.substr(quote + 1, valueEnd - quote - 1));
+        position = valueEnd + 1;
+      }
+
+      if (!closed)
+      {
+        open.push_back(&element);
+      }
+    }
+  }
+  return document;
+}
+
+struct XMLFileInfo
+{
+  XMLElement Root;
+  bool SwapBytes = false;
+  bool HeaderIs64Bit = false;
+  // File offset of the first byte after the `_` that starts the appended data.
+  std::streamoff AppendedBase = -1;
+};
+
+XMLFileInfo ReadXMLHeader(std::ifstream& stream, const std::string& fileName)
+{
+  if (!stream.is_open())
+  {
+    throw viskores::io::ErrorIO("Could not open file \"" + fileName + "\".");
+  }
+
+  // Read blocks until the start of the appended data. Everything before it is XML text.
+  XMLFileInfo info;
+  const std::string appendedTag = "<AppendedData";
+  std::string text;
+  std::size_t searchFrom = 0;
+  std::size_t appendedStart = std::string::npos;
+  char block[64 * 1024];
+  while (true)
+  {
+    stream.read(block, sizeof(block));
+    const std::size_t numRead = static_cast<std::size_t>(stream.gcount());
+    text.append(block, numRead);
+
+    if (appendedStart == std::string::npos)
+    {
+      appendedStart = text.find(appendedTag, searchFrom);
+      searchFrom = (text.size() > appendedTag.size()) ? text.size() - appendedTag.size() : 0;
+    }
+    if (appendedStart != std::string::npos)
+    {
+      std::size_t tagEnd = text.find('>', appendedStart);
+      std::size_t marker =
+        (tagEnd != std::string::npos) ? text.find('_', tagEnd) : std::string::npos;
+      if (marker != std::string::npos)
+      {
+        info.AppendedBase = static_cast<std::streamoff>(marker + 1);
+        text.resize(tagEnd + 1);
+        break;
+      }
+    }
+    if (numRead < sizeof(block))
+    {
+      break;
+    }
+  }
+  stream.clear();
+
+  XMLElement document = ParseXMLElements(text);
+  const XMLElement* root = document.FindChild("VTKFile");
+  if (root == nullptr)
+  {
+    throw viskores::io::ErrorIO("\"" + fileName + "\" is not a VTK XML file.");
+  }
+  info.Root = *root;
+
+  if (info.Root.HasAttribute("compressor"))
+  {
+    throw viskores::io::ErrorIO("Compressed VTK XML files are not supported.");
+  }
+  const std::string byteOrder = info.Root.GetAttribute("byte_order", "LittleEndian");
+  info.SwapBytes = ((byteOrder == "BigEndian") == viskores::io::internal::IsLittleEndian());
+  const std::string headerType = info.Root.GetAttribute("header_type", "UInt32");
+  if (headerType == "UInt64")
+  {
+    info.HeaderIs64Bit = true;
+  }
+  else if (headerType != "UInt32")
+  {
+    throw viskores::io::ErrorIO("Unsupported VTK XML header_type: " + headerType);
+  }
+  return info;
+}
+
+inline void FlipValues(viskores::cont::ArrayHandleBasic<viskores::Int8>&) {}
+inline void FlipValues(viskores::cont::ArrayHandleBasic<viskores::UInt8>&) {}
+template <typename T>
+inline void FlipValues(viskores::cont::ArrayHandleBasic<T>& values)
+{
+  using UnsignedType = std::conditional_t<
+    sizeof(T) == 2,
+    viskores::UInt16,
+    std::conditional_t<sizeof(T) == 4, viskores::UInt32, viskores::UInt64>>;
+  viskores::cont::ArrayHandle<UnsignedType> rawValues(values.GetBuffers());
+  viskores::io::internal::FlipEndiannessInPlace(rawValues);
+}
+
+template <typename T>
+viskores::cont::ArrayHandleBasic<T> ReadAppendedBlock(std::ifstream& stream,
+                                                      const XMLFileInfo& info,
+                                                      viskores::UInt64 offset)
+{
+  if (info.AppendedBase < 0)
+  {
+    throw viskores::io::ErrorIO("VTK XML file has no appended data.");
+  }
+  stream.seekg(info.AppendedBase + static_cast<std::streamoff>(offset));
+
+  // Each block starts with its size in bytes.
+  viskores::UInt8 header[sizeof(viskores::UInt64)];
+  const std::size_t headerSize = info.HeaderIs64Bit ? 8 : 4;
+  stream.read(reinterpret_cast<char*>(header), static_cast<std::streamsize>(headerSize));
+  if (info.SwapBytes)
+  {
+    std::reverse(header, header + headerSize);
+  }
+  viskores::UInt64 numBytes;
+  if (info.HeaderIs64Bit)
+  {
+    std::memcpy(&numBytes, header, sizeof(numBytes));
+  }
+  else
+  {
+    viskores::UInt32 numBytes32;
+    std::memcpy(&numBytes32, header, sizeof(numBytes32));
+    numBytes = numBytes32;
+  }
+  if (!stream || (numBytes % sizeof(T) != 0))
+  {
+    throw viskores::io::ErrorIO("Invalid data block in VTK XML appended data.");
+  }
+
+  // Read straight into the array memory.
+  viskores::cont::ArrayHandleBasic<T> values;
+  values.Allocate(static_cast<viskores::Id>(numBytes / sizeof(T)));
+  if (numBytes > 0)
+  {
+    stream.read(reinterpret_cast<char*>(values.GetWritePointer()),
+                static_cast<std::streamsize>(numBytes));
+    if (static_cast<viskores::UInt64>(stream.gcount()) != numBytes)
+    {
+      throw viskores::io::ErrorIO("Unexpected end of file in VTK XML appended data.");
+    }
+  }
+  if (info.SwapBytes)
+  {
+    FlipValues(values);
+  }
+  return values;
+}
+
+template <typename T>
+void PermuteTuples(viskores::cont::ArrayHandleBasic<T>& components,
+                   viskores::IdComponent numComponents,
+                   const viskores::cont::ArrayHandle<viskores::Id>& permutation)
+{
+  viskores::cont::ArrayHandleBasic<T> permuted;
+  permuted.Allocate(permutation.GetNumberOfValues() * numComponents);
+  const T* source = components.GetReadPointer();
+  T* destination = permuted.GetWritePointer();
+  auto permutationPortal = permutation.ReadPortal();
+  for (viskores::Id index = 0; index < permutation.GetNumberOfValues(); ++index)
+  {
+    std::copy_n(source + permutationPortal.Get(index) * numComponents,
+                numComponents,
+                destination + index * numComponents);
+  }
+  components = permuted;
+}
+
+// Parses an integer attribute of a DataArray that must be at least `minimum`.
+viskores::Int64 ParseDataArrayInteger(const XMLElement& element,
+                                      const std::string& name,
+                                      const std::string& defaultValue,
+                                      viskores::Int64 minimum)
+{
+  const std::string text = element.GetAttribute(name, defaultValue);
+  std::istringstream parse(text);
+  parse.imbue(std::locale::classic());
+  viskores::Int64 value;
+  parse >> value;
+  if (!parse || !(parse >> std::ws).eof() || (value < minimum))
+  {
+    throw viskores::io::ErrorIO("Invalid " + name + " \"" + text + "\" in DataArray \"" +
+                                element.GetAttribute("Name") + "\".");
+  }
+  return value;
+}
+
+viskores::cont::UnknownArrayHandle ReadDataArray(
+  std::ifstream& stream,
+  const XMLFileInfo& info,
+  const XMLElement& element,
+  const viskores::cont::ArrayHandle<viskores::Id>& permutation = {})
+{
+  const std::string format = element.GetAttribute("format");
+  if (format != "appended")
+  {
+    throw viskores::io::ErrorIO("Unsupported VTK XML DataArray format \"" + format +
+                                "\". Only appended raw data is supported.");
+  }
+  const viskores::Int64 parsedComponents =
+    ParseDataArrayInteger(element, "NumberOfComponents", "1", 1);
+  if (parsedComponents > std::numeric_limits<viskores::IdComponent>::max())
+  {
+    throw viskores::io::ErrorIO("Too many components in DataArray \"" +
+                                element.GetAttribute("Name") + "\".");
+  }
+  const viskores::IdComponent numComponents = static_cast<viskores::IdComponent>(parsedComponents);
+  const viskores::UInt64 offset =
+    static_cast<viskores::UInt64>(ParseDataArrayInteger(element, "offset", "0", 0));
+
+  viskores::cont::UnknownArrayHandle result;
+  viskores::io::internal::CallForVTKXMLType(
+    element.GetAttribute("type"),
+    [&](auto typeTag)
+    {
+      using T = decltype(typeTag);
+      viskores::cont::ArrayHandleBasic<T> components = ReadAppendedBlock<T>(stream, info, offset);
+      if (components.GetNumberOfValues() % numComponents != 0)
+      {
+        throw viskores::io::ErrorIO("Size of DataArray \"" + element.GetAttribute("Name") +
+                                    "\" is not a multiple of its number of components.");
+      }
+      if (permutation.GetNumberOfValues() > 0)
+      {
+        PermuteTuples(components, numComponents, permutation);
+      }
+      result = viskores::cont::make_ArrayHandleRuntimeVec(numComponents, components);
+    });
+  return result;
+}
+
+template <typename T>
+viskores::cont::ArrayHandle<T> ReadDataArrayAs(std::ifstream& stream,
+                                               const XMLFileInfo& info,
+                                               const XMLElement& element)
+{
+  viskores::cont::ArrayHandle<T> array;
+  viskores::cont::ArrayCopyShallowIfPossible(ReadDataArray(stream, info, element), array);
+  return array;
+}
+
+const XMLElement& FindDataArray(const XMLElement& parent, const std::string& name)
+{
+  for (const XMLElement& child : parent.Children)
+  {
+    if ((child.Name == "DataArray") && (child.GetAttribute("Name") == name))
+    {
+      return child;
+    }
+  }
+  throw viskores::io::ErrorIO("Missing DataArray \"" + name + "\" in <" + parent.Name + ">.");
+}
+
+const XMLElement& GetSinglePiece(const XMLElement& dataSetElement)
+{
+  const XMLElement* piece = nullptr;
+  for (const XMLElement& child : dataSetElement.Children)
+  {
+    if (child.Name == "Piece")
+    {
+      if (piece != nullptr)
+      {
+        throw viskores::io::ErrorIO("VTK XML files with more than one piece are not supported.");
+      }
+      piece = &child;
+    }
+  }
+  if (piece == nullptr)
+  {
+    throw viskores::io::ErrorIO("Missing <Piece> element in <" + dataSetElement.Name + ">.");
+  }
+  return *piece;
+}
+
+template <typename VecType>
+VecType ParseVec(const std::string& text, const VecType& defaultValue)
+{
+  if (text.empty())
+  {
+    return defaultValue;
+  }
+  VecType result;
+  std::istringstream parse(text);
+  parse.imbue(std::locale::classic());
+  for (viskores::IdComponent index = 0; index < VecType::NUM_COMPONENTS; ++index)
+  {
+    parse >> result[index];
+  }
+  if (!parse)
+  {
+    throw viskores::io::ErrorIO("Invalid VTK XML attribute value \"" + text + "\".");
+  }
+  return result;
+}
+
+// Returns the point dimensions and the index of the first point of an extent.
+void ParseExtent(const std::string& text, viskores::Id3& dimensions, viskores::Id3& start)
+{
+  viskores::Vec<viskores::Id, 6> extent = ParseVec(text, viskores::Vec<viskores::Id, 6>(0));
+  for (viskores::IdComponent axis = 0; axis < 3; ++axis)
+  {
+    start[axis] = extent[2 * axis];
+    dimensions[axis] = extent[2 * axis + 1] - extent[2 * axis] + 1;
+    if (dimensions[axis] < 1)
+    {
+      throw viskores::io::ErrorIO("Invalid VTK XML extent \"" + text + "\".");
+    }
+  }
+}
+
+// Shapes that need no conversion from VTK to Viskores.
+inline bool IsDirectShape(viskores::UInt8 shape)
+{
+  switch (shape)
+  {
+    case viskores::CELL_SHAPE_VERTEX:
+    case viskores::CELL_SHAPE_LINE:
+    case viskores::CELL_SHAPE_POLY_LINE:
+    case viskores::CELL_SHAPE_TRIANGLE:
+    case viskores::CELL_SHAPE_QUAD:
+    case viskores::CELL_SHAPE_TETRA:
+    case viskores::CELL_SHAPE_HEXAHEDRON:
+    case viskores::CELL_SHAPE_WEDGE:
+    case viskores::CELL_SHAPE_PYRAMID:
+      return true;
+    default:
+      return false;
+  }
+}
+
+viskores::cont::UnknownCellSet ReadUnstructuredCells(
+  std::ifstream& stream,
+  const XMLFileInfo& info,
+  const XMLElement& piece,
+  viskores::Id numPoints,
+  viskores::cont::ArrayHandle<viskores::Id>& permutation)
+{
+  const XMLElement& cells = piece.GetChild("Cells");
+  viskores::cont::ArrayHandle<viskores::Id> connectivity =
+    ReadDataArrayAs<viskores::Id>(stream, info, FindDataArray(cells, "connectivity"));
+  viskores::cont::ArrayHandle<viskores::Id> endOffsets =
+    ReadDataArrayAs<viskores::Id>(stream, info, FindDataArray(cells, "offsets"));
+  viskores::cont::ArrayHandle<viskores::UInt8> shapes =
+    ReadDataArrayAs<viskores::UInt8>(stream, info, FindDataArray(cells, "types"));
+
+  const viskores::Id numCells = shapes.GetNumberOfValues();
+  if (endOffsets.GetNumberOfValues() != numCells)
+  {
+    throw viskores::io::ErrorIO("Number of cell offsets does not match the number of cells.");
+  }
+
+  // VTK stores the end of each cell. Viskores also wants the start of the first.
+  viskores::cont::ArrayHandle<viskores::Id> offsets;
+  offsets.Allocate(numCells + 1);
+  {
+    auto endPortal = endOffsets.ReadPortal();
+    auto offsetsPortal = offsets.WritePortal();
+    offsetsPortal.Set(0, 0);
+    for (viskores::Id cell = 0; cell < numCells; ++cell)
+    {
+      offsetsPortal.Set(cell + 1, endPortal.Get(cell));
+    }
+  }
+
+  bool direct = true;
+  bool singleShape = (numCells > 0);
+  {
+    auto shapesPortal = shapes.ReadPortal();
+    auto offsetsPortal = offsets.ReadPortal();
+    const viskores::Id firstSize = (numCells > 0) ? offsetsPortal.Get(1) : 0;
+    for (viskores::Id cell = 0; cell < numCells; ++cell)
+    {
+      const viskores::UInt8 shape = shapesPortal.Get(cell);
+      direct = direct && IsDirectShape(shape);
+      singleShape = singleShape && (shape == shapesPortal.Get(0)) &&
+        (offsetsPortal.Get(cell + 1) - offsetsPortal.Get(cell) == firstSize);
+    }
+  }
+
+  if (!direct)
+  {
+    // Some VTK cell types have to be converted. Do it the same way as the legacy reader.
+    viskores::cont::ArrayHandle<viskores::IdComponent> numIndices;
+    numIndices.Allocate(numCells);
+    {
+      auto offsetsPortal = offsets.ReadPortal();
+      auto numIndicesPortal = numIndices.WritePortal();
+      for (viskores::Id cell = 0; cell < numCells; ++cell)
+      {
+        numIndicesPortal.Set(cell,
+                             static_cast<viskores::IdComponent>(offsetsPortal.Get(cell + 1) -
+                                                                offsetsPortal.Get(cell)));
+      }
+    }
+    viskores::io::internal::FixupCellSet(connectivity, numIndices, shapes, permutation);
+    singleShape = viskores::io::internal::IsSingleShape(shapes, numIndices);
+    offsets = viskores::cont::ConvertNumComponentsToOffsets(numIndices);
+  }
+
+  if (singleShape)
+  {
+    auto offsetsPortal = offsets.ReadPortal();
+    viskores::cont::CellSetSingleType<> cellSet;
+    cellSet.Fill(numPoints,
+                 shapes.ReadPortal().Get(0),
+                 static_cast<viskores::IdComponent>(offsetsPortal.Get(1) - offsetsPortal.Get(0)),
+                 connectivity);
+    return cellSet;
+  }
+  viskores::cont::CellSetExplicit<> cellSet;
+  cellSet.Fill(numPoints, shapes, connectivity, offsets);
+  return cellSet;
+}
+
+} // anonymous namespace
+
+namespace viskores
+{
+namespace io
+{
+
+VTKXMLDataSetReader::VTKXMLDataSetReader(const char* fileName)
+  : FileName(fileName)
+{
+}
+
+VTKXMLDataSetReader::VTKXMLDataSetReader(const std::string& fileName)
+  : FileName(fileName)
+{
+}
+
+void VTKXMLDataSetReader::SetArraySelection(const std::vector<std::string>& names)
+{
+  this->ArraySelection = names;
+  this->Loaded = false;
+}
+
+std::vector<std::string> VTKXMLDataSetReader::ReadFieldNames() const
+{
+  std::ifstream stream(this->FileName.c_str(), std::ios_base::in | std::ios_base::binary);
+  XMLFileInfo info = ReadXMLHeader(stream, this->FileName);
+  const std::string type = info.Root.GetAttribute("type");
+  const XMLElement& piece = GetSinglePiece(info.Root.GetChild(type));
+
+  std::vector<std::string> names;
+  for (const char* group : { "PointData", "CellData" })
+  {
+    if (const XMLElement* data = piece.FindChild(group))
+    {
+      for (const XMLElement& array : data->Children)
+      {
+        if (array.Name == "DataArray")
+        {
+          names.push_back(array.GetAttribute("Name"));
+        }
+      }
+    }
+  }
+  return names;
+}
+
+const viskores::cont::DataSet& VTKXMLDataSetReader::ReadDataSet()
+{
+  if (this->Loaded)
+  {
+    return this->DataSet;
+  }
+
+  std::ifstream stream(this->FileName.c_str(), std::ios_base::in | std::ios_base::binary);
+  XMLFileInfo info = ReadXMLHeader(stream, this->FileName);
+  const std::string type = info.Root.GetAttribute("type");
+  const XMLElement* dataSetElement = info.Root.FindChild(type);
+  if (dataSetElement == nullptr)
+  {
+    throw viskores::io::ErrorIO("Unsupported VTK XML file type \"" + type + "\".");
+  }
+  const XMLElement& piece = GetSinglePiece(*dataSetElement);
+
+  viskores::cont::DataSet dataSet;
+  viskores::cont::ArrayHandle<viskores::Id> cellsPermutation;
+  if (type == "ImageData")
+  {
+    viskores::Id3 dimensions, start;
+    ParseExtent(piece.GetAttribute("Extent", dataSetElement->GetAttribute("WholeExtent")),
+                dimensions,
+                start);
+    viskores::Vec3f origin =
+      ParseVec(dataSetElement->GetAttribute("Origin"), viskores::Vec3f(0.0f));
+    viskores::Vec3f spacing =
+      ParseVec(dataSetElement->GetAttribute("Spacing"), viskores::Vec3f(1.0f));
+    origin += viskores::Vec3f(start) * spacing;
+    dataSet.AddCoordinateSystem(viskores::cont::CoordinateSystem(
+      "coordinates",
+      viskores::cont::ArrayHandleUniformPointCoordinates(dimensions, origin, spacing)));
+    dataSet.SetCellSet(viskores::io::internal::CreateCellSetStructured(dimensions));
+  }
+  else if (type == "RectilinearGrid")
+  {
+    viskores::Id3 dimensions, start;
+    ParseExtent(piece.GetAttribute("Extent"), dimensions, start);
+    const XMLElement& coordinates = piece.GetChild("Coordinates");
+    std::vector<viskores::cont::ArrayHandle<viskores::FloatDefault>> axes;
+    for (const XMLElement& array : coordinates.Children)
+    {
+      if (array.Name == "DataArray")
+      {
+        axes.push_back(ReadDataArrayAs<viskores::FloatDefault>(stream, info, array));
+      }
+    }
+    if ((axes.size() != 3) || (axes[0].GetNumberOfValues() != dimensions[0]) ||
+        (axes[1].GetNumberOfValues() != dimensions[1]) ||
+        (axes[2].GetNumberOfValues() != dimensions[2]))
+    {
+      throw viskores::io::ErrorIO("Rectilinear coordinates do not match the extent.");
+    }
+    dataSet.AddCoordinateSystem(viskores::cont::CoordinateSystem(
+      "coordinates", viskores::cont::make_ArrayHandleCartesianProduct(axes[0], axes[1], axes[2])));
+    dataSet.SetCellSet(viskores::io::internal::CreateCellSetStructured(dimensions));
+  }
+  else if (type == "StructuredGrid")
+  {
+    viskores::Id3 dimensions, start;
+    ParseExtent(piece.GetAttribute("Extent"), dimensions, start);
+    const XMLElement& points = piece.GetChild("Points").GetChild("DataArray");
+    dataSet.AddCoordinateSystem(
+      viskores::cont::CoordinateSystem("coordinates", ReadDataArray(stream, info, points)));
+    dataSet.SetCellSet(viskores::io::internal::CreateCellSetStructured(dimensions));
+  }
+  else if (type == "UnstructuredGrid")
+  {
+    const XMLElement& points = piece.GetChild("Points").GetChild("DataArray");
+    viskores::cont::UnknownArrayHandle coordinates = ReadDataArray(stream, info, points);
+    dataSet.AddCoordinateSystem(viskores::cont::CoordinateSystem("coordinates", coordinates));
+    dataSet.SetCellSet(ReadUnstructuredCells(
+      stream, info, piece, coordinates.GetNumberOfValues(), cellsPermutation));
+  }
+  else
+  {
+    throw viskores::io::ErrorIO("Unsupported VTK XML file type \"" + type + "\".");
+  }
+
+  auto isSelected = [this](const std::string& name)
+  {
+    return this->ArraySelection.empty() ||
+      (std::find(this->ArraySelection.begin(), this->ArraySelection.end(), name) !=
+       this->ArraySelection.end());
+  };
+  if (const XMLElement* pointData = piece.FindChild("PointData"))
+  {
+    for (const XMLElement& array : pointData->Children)
+    {
+      const std::string name = array.GetAttribute("Name");
+      if ((array.Name == "DataArray") && isSelected(name))
+      {
+        dataSet.AddPointField(name, ReadDataArray(stream, info, array));
+      }
+    }
+  }
+  if (const XMLElement* cellData = piece.FindChild("CellData"))
+  {
+    for (const XMLElement& array : cellData->Children)
+    {
+      const std::string name = array.GetAttribute("Name");
+      if ((array.Name == "DataArray") && isSelected(name))
+      {
+        dataSet.AddCellField(name, ReadDataArray(stream, info, array, cellsPermutation));
+      }
+    }
+  }
+
+  this->DataSet = dataSet;
+  this->Loaded = true;
+  return this->DataSet;
+}
+
+}
+} // namespace viskores::io
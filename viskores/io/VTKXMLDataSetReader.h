@@ -0,0 +1,74 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+#ifndef viskores_io_VTKXMLDataSetReader_h
+#define viskores_io_VTKXMLDataSetReader_h
+
+#include <viskores/cont/DataSet.h>
+
+#include <viskores/io/viskores_io_export.h>
+
+#include <string>
+#include <vector>
+
+namespace viskores
+{
+namespace io
+{
+
+/// @brief Reads a VTK XML file with its data stored in appended raw binary blocks.
+///
+/// Image data (`.vti`), rectilinear grid (`.vtr`), structured grid (`.vts`), and
+/// unstructured grid (`.vtu`) files with a single piece are supported. This is the
+/// format written by `viskores::io::VTKXMLDataSetWriter`. Data in either byte order
+/// with 32 or 64-bit block headers can be read. Compressed and inline (ASCII or
+/// base64) data arrays are not supported.
+///
+/// Only the XML header is parsed up front. The arrays are then read by seeking to
+/// their offsets in the appended data, so point and cell fields that are not in the
+/// array selection are never read from the file.
+class VISKORES_IO_EXPORT VTKXMLDataSetReader
+{
+public:
+  VISKORES_CONT VTKXMLDataSetReader(const char* fileName);
+  /// @brief Construct a reader to load data from the given file.
+  VISKORES_CONT VTKXMLDataSetReader(const std::string& fileName);
+
+  /// @brief Restricts the point and cell fields loaded to those with the given names.
+  ///
+  /// The geometry and topology are always loaded. An empty selection (the default)
+  /// loads all fields. Names that are not in the file are ignored.
+  VISKORES_CONT void SetArraySelection(const std::vector<std::string>& names);
+  /// @brief Loads all point and cell fields.
+  VISKORES_CONT void ClearArraySelection() { this->SetArraySelection({}); }
+  VISKORES_CONT const std::vector<std::string>& GetArraySelection() const
+  {
+    return this->ArraySelection;
+  }
+
+  /// @brief Returns the names of the point and cell fields in the file.
+  ///
+  /// Only the XML header is read, so this is cheap even for large files. It can be
+  /// used to pick an array selection.
+  VISKORES_CONT std::vector<std::string> ReadFieldNames() const;
+
+  /// @brief Load data from the file and return it in a `DataSet` object.
+  VISKORES_CONT const viskores::cont::DataSet& ReadDataSet();
+
+  VISKORES_CONT const viskores::cont::DataSet& GetDataSet() const { return this->DataSet; }
+
+private:
+  std::string FileName;
+  std::vector<std::string> ArraySelection;
+  viskores::cont::DataSet DataSet;
+  bool Loaded = false;
+};
+
+}
+} // namespace viskores::io
+
+#endif //viskores_io_VTKXMLDataSetReader_h
@@ -0,0 +1,510 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/io/VTKXMLDataSetWriter.h>
+
+#include <viskores/TypeList.h>
+
+#include <viskores/cont/ArrayCopy.h>
+#include <viskores/cont/ArrayHandleBasic.h>
+#include <viskores/cont/ArrayHandleCartesianProduct.h>
+#include <viskores/cont/ArrayHandleRuntimeVec.h>
+#include <viskores/cont/ArrayHandleUniformPointCoordinates.h>
+#include <viskores/cont/CellSetExplicit.h>
+#include <viskores/cont/CellSetSingleType.h>
+#include <viskores/cont/CellSetStructured.h>
+#include <viskores/cont/ErrorBadValue.h>
+
+#include <viskores/io/ErrorIO.h>
+#include <viskores/io/internal/Endian.h>
+#include <viskores/io/internal/VTKXMLTypes.h>
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+enum struct XMLDataSetKind
+{
+  ImageData,
+  RectilinearGrid,
+  StructuredGrid,
+  UnstructuredGrid
+};
+
+template <typename T>
+using XMLRectilinearCoordinates =
+  viskores::cont::ArrayHandleCartesianProduct<viskores::cont::ArrayHandle<T>,
+                                              viskores::cont::ArrayHandle<T>,
+                                              viskores::cont::ArrayHandle<T>>;
+
+bool IsStructured(const viskores::cont::UnknownCellSet& cellSet)
+{
+  return cellSet.IsType<viskores::cont::CellSetStructured<1>>() ||
+    cellSet.IsType<viskores::cont::CellSetStructured<2>>() ||
+    cellSet.IsType<viskores::cont::CellSetStructured<3>>();
+}
+
+XMLDataSetKind GetXMLDataSetKind(const viskores::cont::DataSet& dataSet)
+{
+  if (!IsStructured(dataSet.GetCellSet()))
+  {
+    return XMLDataSetKind::UnstructuredGrid;
+  }
+  auto coords = dataSet.GetCoordinateSystem().GetData();
+  if (coords.IsType<viskores::cont::ArrayHandleUniformPointCoordinates>())
+  {
+    return XMLDataSetKind::ImageData;
+  }
+  if (coords.IsType<XMLRectilinearCoordinates<viskores::Float32>>() ||
+      coords.IsType<XMLRectilinearCoordinates<viskores::Float64>>())
+  {
+    return XMLDataSetKind::RectilinearGrid;
+  }
+  return XMLDataSetKind::StructuredGrid;
+}
+
+const char* GetXMLDataSetKindName(XMLDataSetKind kind)
+{
+  switch (kind)
+  {
+    case XMLDataSetKind::ImageData:
+      return "ImageData";
+    case XMLDataSetKind::RectilinearGrid:
+      return "RectilinearGrid";
+    case XMLDataSetKind::StructuredGrid:
+      return "StructuredGrid";
+    case XMLDataSetKind::UnstructuredGrid:
+    default:
+      return "UnstructuredGrid";
+  }
+}
+
+// An array to be written in the appended data section. `FirstValue` values at the front are
+// left out, which lets the leading zero of the cell offsets be dropped without a copy.
+struct AppendedArray
+{
+  viskores::cont::UnknownArrayHandle Array;
+  viskores::Id FirstValue;
+};
+
+struct AppendedArrayList
+{
+  std::vector<AppendedArray> Arrays;
+  viskores::UInt64 NextOffset = 0;
+};
+
+struct GetXMLArrayTypeFunctor
+{
+  template <typename T>
+  void operator()(T,
+                  const viskores::cont::UnknownArrayHandle& array,
+                  std::string& typeName,
+                  std::size_t& componentSize) const
+  {
+    if (typeName.empty() && array.IsBaseComponentType<T>())
+    {
+      typeName = viskores::io::internal::VTKXMLTypeName<T>::Name();
+      componentSize = sizeof(T);
+    }
+  }
+};
+
+void WriteDataArrayElement(std::ostream& out,
+                           const std::string& indent,
+                           const std::string& name,
+                           const viskores::cont::UnknownArrayHandle& array,
+                           AppendedArrayList& appended,
+                           viskores::Id firstValue = 0)
+{
+  std::string typeName;
+  std::size_t componentSize = 0;
+  viskores::ListForEach(
+    GetXMLArrayTypeFunctor{}, viskores::TypeListScalarAll{}, array, typeName, componentSize);
+  if (typeName.empty())
+  {
+    std::ostringstream message;
+    message << "Unrecognized base type in array to be written out.\nArray: ";
+    array.PrintSummary(message);
+    throw viskores::cont::ErrorBadValue(message.str());
+  }
+
+  viskores::IdComponent numComponents = array.GetNumberOfComponentsFlat();
+  out << indent << "<DataArray type=\"" << typeName << "\"";
+  if (!name.empty())
+  {
+    out << " Name=\"" << viskores::io::internal::EscapeXMLAttribute(name) << "\"";
+  }
+  out << " NumberOfComponents=\"" << numComponents << "\" format=\"appended\" offset=\""
+      << appended.NextOffset << "\"/>\n";
+
+  appended.Arrays.push_back({ array, firstValue });
+  appended.NextOffset += sizeof(viskores::UInt64) +
+    static_cast<viskores::UInt64>(array.GetNumberOfValues() - firstValue) *
+      static_cast<viskores::UInt64>(numComponents) * componentSize;
+}
+
+struct WriteRawArrayFunctor
+{
+  template <typename T>
+  void operator()(T, const AppendedArray& appended, std::ostream& out, bool& written) const
+  {
+    if (written || !appended.Array.IsBaseComponentType<T>())
+    {
+      return;
+    }
+    written = true;
+
+    // Basic arrays (of any Vec size) are pulled out shallowly and their memory written as is.
+    viskores::IdComponent numComponents = appended.Array.GetNumberOfComponentsFlat();
+    viskores::cont::ArrayHandleRuntimeVec<T> runtimeVecArray(numComponents);
+    viskores::cont::ArrayCopyShallowIfPossible(appended.Array, runtimeVecArray);
+    viskores::cont::ArrayHandleBasic<T> components = runtimeVecArray.GetComponentsArray();
+
+    const viskores::Id firstComponent = appended.FirstValue * numComponents;
+    const viskores::UInt64 numBytes =
+      static_cast<viskores::UInt64>(components.GetNumberOfValues() - firstComponent) * sizeof(T);
+    out.write(reinterpret_cast<const char*>(&numBytes), sizeof(numBytes));
+    if (numBytes > 0)
+    {
+      out.write(reinterpret_cast<const char*>(components.GetReadPointer() + firstComponent),
+                static_cast<std::streamsize>(numBytes));
+    }
+  }
+};
+
+void WriteAppendedData(std::ostream& out, const AppendedArrayList& appended)
+{
+  out << "  <AppendedData encoding=\"raw\">\n   _";
+  for (const AppendedArray& array : appended.Arrays)
+  {
+    bool written = false;
+    viskores::ListForEach(
+      WriteRawArrayFunctor{}, viskores::TypeListScalarAll{}, array, out, written);
+  }
+  out << "\n  </AppendedData>\n";
+}
+
+void WriteExtent(std::ostream& out, const char* attribute, const viskores::Id3& pointDimensions)
+{
+  out << " " << attribute << "=\"0 " << pointDimensions[0] - 1 << " 0 " << pointDimensions[1] - 1
+      << " 0 " << pointDimensions[2] - 1 << "\"";
+}
+
+// The point dimensions written to the extents. Image data and rectilinear grids use the size of
+// their coordinates so that the geometry matches even when the cell set drops an axis.
+viskores::Id3 GetPointDimensions(const viskores::cont::DataSet& dataSet, XMLDataSetKind kind)
+{
+  auto coords = dataSet.GetCoordinateSystem().GetData();
+  viskores::cont::UnknownCellSet cellSet = dataSet.GetCellSet();
+  if (kind == XMLDataSetKind::ImageData)
+  {
+    return coords.AsArrayHandle<viskores::cont::ArrayHandleUniformPointCoordinates>()
+      .ReadPortal()
+      .GetDimensions();
+  }
+  else if (kind == XMLDataSetKind::RectilinearGrid)
+  {
+    auto getSizes = [](auto rectilinear)
+    {
+      return viskores::Id3(rectilinear.GetFirstArray().GetNumberOfValues(),
+                           rectilinear.GetSecondArray().GetNumberOfValues(),
+                           rectilinear.GetThirdArray().GetNumberOfValues());
+    };
+    if (coords.IsType<XMLRectilinearCoordinates<viskores::Float32>>())
+    {
+      return getSizes(coords.AsArrayHandle<XMLRectilinearCoordinates<viskores::Float32>>());
+    }
+    return getSizes(coords.AsArrayHandle<XMLRectilinearCoordinates<viskores::Float64>>());
+  }
+  else if (cellSet.IsType<viskores::cont::CellSetStructured<1>>())
+  {
+    auto dims = cellSet.AsCellSet<viskores::cont::CellSetStructured<1>>().GetPointDimensions();
+    return viskores::Id3(dims, 1, 1);
+  }
+  else if (cellSet.IsType<viskores::cont::CellSetStructured<2>>())
+  {
+    auto dims = cellSet.AsCellSet<viskores::cont::CellSetStructured<2>>().GetPointDimensions();
+    return viskores::Id3(dims[0], dims[1], 1);
+  }
+  else
+  {
+    return cellSet.AsCellSet<viskores::cont::CellSetStructured<3>>().GetPointDimensions();
+  }
+}
+
+void WriteFields(std::ostream& out,
+                 const viskores::cont::DataSet& dataSet,
+                 viskores::cont::Field::Association association,
+                 AppendedArrayList& appended)
+{
+  const bool isPoints = (association == viskores::cont::Field::Association::Points);
+  out << (isPoints ? "      <PointData>\n" : "      <CellData>\n");
+  for (viskores::IdComponent fieldIndex = 0; fieldIndex < dataSet.GetNumberOfFields();
+       ++fieldIndex)
+  {
+    const viskores::cont::Field& field = dataSet.GetField(fieldIndex);
+    if (field.GetAssociation() != association)
+    {
+      continue;
+    }
+    if (isPoints && (field.GetName() == dataSet.GetCoordinateSystemName()))
+    {
+      // The first coordinate system is written as the geometry, not as a field.
+      continue;
+    }
+    WriteDataArrayElement(out, "        ", field.GetName(), field.GetData(), appended);
+  }
+  out << (isPoints ? "      </PointData>\n" : "      </CellData>\n");
+}
+
+template <typename T, typename S>
+viskores::cont::ArrayHandle<T> AsBasicArray(const viskores::cont::ArrayHandle<T, S>& array)
+{
+  viskores::cont::ArrayHandle<T> basicArray;
+  viskores::cont::ArrayCopy(array, basicArray);
+  return basicArray;
+}
+
+template <typename T>
+viskores::cont::ArrayHandle<T> AsBasicArray(const viskores::cont::ArrayHandle<T>& array)
+{
+  return array;
+}
+
+template <typename CellSetType>
+void WriteExplicitCells(std::ostream& out,
+                        const CellSetType& cellSet,
+                        AppendedArrayList& appended)
+{
+  viskores::TopologyElementTagCell visit;
+  viskores::TopologyElementTagPoint incident;
+  // Single type cell sets have implicit offsets and shapes, which are expanded here.
+  WriteDataArrayElement(out,
+                        "        ",
+                        "connectivity",
+                        AsBasicArray(cellSet.GetConnectivityArray(visit, incident)),
+                        appended);
+  // VTK XML files store the end offset of each cell, so skip the leading 0.
+  WriteDataArrayElement(out,
+                        "        ",
+                        "offsets",
+                        AsBasicArray(cellSet.GetOffsetsArray(visit, incident)),
+                        appended,
+                        1);
+  WriteDataArrayElement(
+    out, "        ", "types", AsBasicArray(cellSet.GetShapesArray(visit, incident)), appended);
+}
+
+void WriteGenericCells(std::ostream& out,
+                       const viskores::cont::CellSet& cellSet,
+                       AppendedArrayList& appended)
+{
+  viskores::Id numCells = cellSet.GetNumberOfCells();
+  std::vector<viskores::Id> offsets(static_cast<std::size_t>(numCells));
+  std::vector<viskores::UInt8> shapes(static_cast<std::size_t>(numCells));
+  std::vector<viskores::Id> connectivity;
+  for (viskores::Id cellIndex = 0; cellIndex < numCells; ++cellIndex)
+  {
+    std::size_t start = connectivity.size();
+    connectivity.resize(start +
+                        static_cast<std::size_t>(cellSet.GetNumberOfPointsInCell(cellIndex)));
+    cellSet.GetCellPointIds(cellIndex, connectivity.data() + start);
+    offsets[static_cast<std::size_t>(cellIndex)] = static_cast<viskores::Id>(connectivity.size());
+    shapes[static_cast<std::size_t>(cellIndex)] = cellSet.GetCellShape(cellIndex);
+  }
+  WriteDataArrayElement(out,
+                        "        ",
+                        "connectivity",
+                        viskores::cont::make_ArrayHandleMove(std::move(connectivity)),
+                        appended);
+  WriteDataArrayElement(
+    out, "        ", "offsets", viskores::cont::make_ArrayHandleMove(std::move(offsets)), appended);
+  WriteDataArrayElement(
+    out, "        ", "types", viskores::cont::make_ArrayHandleMove(std::move(shapes)), appended);
+}
+
+void WritePiece(std::ostream& out,
+                const viskores::cont::DataSet& dataSet,
+                XMLDataSetKind kind,
+                AppendedArrayList& appended)
+{
+  viskores::cont::UnknownCellSet cellSet = dataSet.GetCellSet();
+  auto coords = dataSet.GetCoordinateSystem().GetData();
+
+  // The whole data set is always written as a single piece.
+  out << "    <Piece";
+  switch (kind)
+  {
+    case XMLDataSetKind::ImageData:
+    case XMLDataSetKind::RectilinearGrid:
+    case XMLDataSetKind::StructuredGrid:
+      WriteExtent(out, "Extent", GetPointDimensions(dataSet, kind));
+      break;
+    case XMLDataSetKind::UnstructuredGrid:
+      out << " NumberOfPoints=\"" << dataSet.GetNumberOfPoints() << "\" NumberOfCells=\""
+          << dataSet.GetNumberOfCells() << "\"";
+      break;
+  }
+  out << ">\n";
+
+  WriteFields(out, dataSet, viskores::cont::Field::Association::Points, appended);
+  WriteFields(out, dataSet, viskores::cont::Field::Association::Cells, appended);
+
+  switch (kind)
+  {
+    case XMLDataSetKind::ImageData:
+      break;
+    case XMLDataSetKind::RectilinearGrid:
+    {
+      out << "      <Coordinates>\n";
+      auto writeAxes = [&](auto rectilinear)
+      {
+        WriteDataArrayElement(out, "        ", "x", rectilinear.GetFirstArray(), appended);
+        WriteDataArrayElement(out, "        ", "y", rectilinear.GetSecondArray(), appended);
+        WriteDataArrayElement(out, "        ", "z", rectilinear.GetThirdArray(), appended);
+      };
+      if (coords.IsType<XMLRectilinearCoordinates<viskores::Float32>>())
+      {
+        writeAxes(coords.AsArrayHandle<XMLRectilinearCoordinates<viskores::Float32>>());
+      }
+      else
+      {
+        writeAxes(coords.AsArrayHandle<XMLRectilinearCoordinates<viskores::Float64>>());
+      }
+      out << "      </Coordinates>\n";
+      break;
+    }
+    case XMLDataSetKind::StructuredGrid:
+      out << "      <Points>\n";
+      WriteDataArrayElement(out, "        ", "Points", coords, appended);
+      out << "      </Points>\n";
+      break;
+    case XMLDataSetKind::UnstructuredGrid:
+      out << "      <Points>\n";
+      WriteDataArrayElement(out, "        ", "Points", coords, appended);
+      out << "      </Points>\n";
+      out << "      <Cells>\n";
+      if (cellSet.IsType<viskores::cont::CellSetExplicit<>>())
+      {
+        WriteExplicitCells(out, cellSet.AsCellSet<viskores::cont::CellSetExplicit<>>(), appended);
+      }
+      else if (cellSet.IsType<viskores::cont::CellSetSingleType<>>())
+      {
+        WriteExplicitCells(
+          out, cellSet.AsCellSet<viskores::cont::CellSetSingleType<>>(), appended);
+      }
+      else
+      {
+        WriteGenericCells(out, *cellSet.GetCellSetBase(), appended);
+      }
+      out << "      </Cells>\n";
+      break;
+  }
+
+  out << "    </Piece>\n";
+}
+
+void WriteXML(std::ostream& out, const viskores::cont::DataSet& dataSet)
+{
+  out << std::setprecision(std::numeric_limits<viskores::Float64>::max_digits10);
+
+  XMLDataSetKind kind = GetXMLDataSetKind(dataSet);
+  const char* kindName = GetXMLDataSetKindName(kind);
+  out << "<?xml version=\"1.0\"?>\n";
+  out << "<VTKFile type=\"" << kindName << "\" version=\"1.0\" byte_order=\""
+      << (viskores::io::internal::IsLittleEndian() ? "LittleEndian" : "BigEndian")
+      << "\" header_type=\"UInt64\">\n";
+
+  out << "  <" << kindName;
+  if (kind != XMLDataSetKind::UnstructuredGrid)
+  {
+    WriteExtent(out, "WholeExtent", GetPointDimensions(dataSet, kind));
+  }
+  if (kind == XMLDataSetKind::ImageData)
+  {
+    auto portal = dataSet.GetCoordinateSystem()
+                    .GetData()
+                    .AsArrayHandle<viskores::cont::ArrayHandleUniformPointCoordinates>()
+                    .ReadPortal();
+    auto origin = portal.GetOrigin();
+    auto spacing = portal.GetSpacing();
+    out << " Origin=\"" << origin[0] << " " << origin[1] << " " << origin[2] << "\"";
+    out << " Spacing=\"" << spacing[0] << " " << spacing[1] << " " << spacing[2] << "\"";
+  }
+  out << ">\n";
+
+  AppendedArrayList appended;
+  WritePiece(out, dataSet, kind, appended);
+
+  out << "  </" << kindName << ">\n";
+  WriteAppendedData(out, appended);
+  out << "</VTKFile>\n";
+}
+
+} // anonymous namespace
+
+namespace viskores
+{
+namespace io
+{
+
+VTKXMLDataSetWriter::VTKXMLDataSetWriter(const char* fileName)
+  : FileName(fileName)
+{
+}
+
+VTKXMLDataSetWriter::VTKXMLDataSetWriter(const std::string& fileName)
+  : FileName(fileName)
+{
+}
+
+void VTKXMLDataSetWriter::WriteDataSet(const viskores::cont::DataSet& dataSet) const
+{
+  if (dataSet.GetNumberOfCoordinateSystems() < 1)
+  {
+    throw viskores::cont::ErrorBadValue(
+      "DataSet has no coordinate system, which is not supported by VTK file format.");
+  }
+
+  std::ofstream fileStream(this->FileName.c_str(), std::fstream::trunc | std::fstream::binary);
+  if (!fileStream)
+  {
+    throw viskores::io::ErrorIO("Could not open file \"" + this->FileName + "\" for writing.");
+  }
+  WriteXML(fileStream, dataSet);
+  fileStream.close();
+  if (fileStream.fail())
+  {
+    throw viskores::io::ErrorIO("Error writing file \"" + this->FileName + "\".");
+  }
+}
+
+std::string VTKXMLDataSetWriter::GetFileExtension(const viskores::cont::DataSet& dataSet)
+{
+  switch (GetXMLDataSetKind(dataSet))
+  {
+    case XMLDataSetKind::ImageData:
+      return ".vti";
+    case XMLDataSetKind::RectilinearGrid:
+      return ".vtr";
+    case XMLDataSetKind::StructuredGrid:
+      return ".vts";
+    case XMLDataSetKind::UnstructuredGrid:
+    default:
+      return ".vtu";
+  }
+}
+
+}
+} // namespace viskores::io
@@ -0,0 +1,52 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+#ifndef viskores_io_VTKXMLDataSetWriter_h
+#define viskores_io_VTKXMLDataSetWriter_h
+
+#include <viskores/cont/DataSet.h>
+
+#include <viskores/io/viskores_io_export.h>
+
+namespace viskores
+{
+namespace io
+{
+
+/// @brief Writes a VTK XML file with the data stored in appended raw binary blocks.
+///
+/// The kind of file written is determined by the structure of the `DataSet`:
+/// a uniform structured grid is written as image data (`.vti`), a structured
+/// grid with rectilinear coordinates as a rectilinear grid (`.vtr`), any other
+/// structured grid as a structured grid (`.vts`), and everything else as an
+/// unstructured grid (`.vtu`). The file name is used as given, so it should
+/// have the matching extension.
+///
+/// The arrays are written in the native byte order directly from the memory of
+/// each `ArrayHandle`. Arrays not stored in a basic layout are copied to one first.
+/// Point and cell fields are written. Fields with other associations are skipped.
+class VISKORES_IO_EXPORT VTKXMLDataSetWriter
+{
+public:
+  VISKORES_CONT VTKXMLDataSetWriter(const char* fileName);
+  /// @brief Construct a writer to save data to the given file.
+  VISKORES_CONT VTKXMLDataSetWriter(const std::string& fileName);
+
+  /// @brief Write data from the given `DataSet` object to the file specified in the constructor.
+  VISKORES_CONT void WriteDataSet(const viskores::cont::DataSet& dataSet) const;
+
+  /// @brief Returns the conventional file extension (including the dot) for the given data.
+  VISKORES_CONT static std::string GetFileExtension(const viskores::cont::DataSet& dataSet);
+
+private:
+  std::string FileName;
+};
+
+}
+} // namespace viskores::io
+
+#endif //viskores_io_VTKXMLDataSetWriter_h
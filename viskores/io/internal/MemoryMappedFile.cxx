@@ -0,0 +1,179 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/io/internal/MemoryMappedFile.h>
+
+#include <viskores/cont/Invoker.h>
+#include <viskores/cont/Logging.h>
+#include <viskores/io/ErrorIO.h>
+#include <viskores/worklet/WorkletMapField.h>
+
+#if defined(VISKORES_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+
+namespace viskores
+{
+namespace io
+{
+namespace internal
+{
+
+namespace
+{
+
+struct FlipEndiannessWorklet : public viskores::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldInOut);
+  using ExecutionSignature = void(_1);
+
+  template <typename T>
+  VISKORES_EXEC void operator()(T& value) const
+  {
+    value = FlipBytes(value);
+  }
+};
+
+struct FlipEndiannessCopyWorklet : public viskores::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = void(_1, _2);
+
+  template <typename T>
+  VISKORES_EXEC void operator()(const T& value, T& flipped) const
+  {
+    flipped = FlipBytes(value);
+  }
+};
+
+template <typename T>
+void DoFlipEndiannessInPlace(viskores::cont::ArrayHandle<T>& array)
+{
+  viskores::cont::Invoker invoke;
+  invoke(FlipEndiannessWorklet{}, array);
+}
+
+template <typename T>
+void DoFlipEndiannessCopy(const viskores::cont::ArrayHandleStride<T>& source,
+                          viskores::cont::ArrayHandle<T>& destination)
+{
+  viskores::cont::Invoker invoke;
+  invoke(FlipEndiannessCopyWorklet{}, source, destination);
+}
+
+} // anonymous namespace
+
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName)
+{
+#if defined(VISKORES_POSIX)
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw viskores::io::ErrorIO("Could not open " + fileName +
+                                " for memory mapping: " + std::strerror(errno));
+  }
+
+  struct stat fileStatus;
+  if (fstat(fd, &fileStatus) != 0)
+  {
+    int error = errno;
+    close(fd);
+    throw viskores::io::ErrorIO("Could not get size of " + fileName + ": " + std::strerror(error));
+  }
+  this->Size = static_cast<std::size_t>(fileStatus.st_size);
+
+  if (this->Size > 0)
+  {
+    // A private mapping is copy-on-write, so arrays built on it can be written without changing
+    // the file. The file descriptor is not needed once the mapping exists.
+    void* data = mmap(nullptr, this->Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      throw viskores::io::ErrorIO("Could not memory map " + fileName + ": " +
+                                  std::strerror(error));
+    }
+    this->Data = static_cast<char*>(data);
+  }
+  else
+  {
+    close(fd);
+  }
+#else
+  throw viskores::io::ErrorIO("Memory mapping of " + fileName +
+                              " is not supported on this platform.");
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(VISKORES_POSIX)
+  if (this->Data != nullptr)
+  {
+    if (munmap(this->Data, this->Size) != 0)
+    {
+      VISKORES_LOG_F(viskores::cont::LogLevel::Warn,
+                     "Failed to unmap memory mapped file: %s",
+                     std::strerror(errno));
+    }
+  }
+#endif
+}
+
+bool MemoryMappedFile::IsSupported()
+{
+#if defined(VISKORES_POSIX)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void FlipEndiannessInPlace(viskores::cont::ArrayHandle<viskores::UInt16>& array)
+{
+  DoFlipEndiannessInPlace(array);
+}
+
+void FlipEndiannessInPlace(viskores::cont::ArrayHandle<viskores::UInt32>& array)
+{
+  DoFlipEndiannessInPlace(array);
+}
+
+void FlipEndiannessInPlace(viskores::cont::ArrayHandle<viskores::UInt64>& array)
+{
+  DoFlipEndiannessInPlace(array);
+}
+
+void FlipEndiannessCopy(const viskores::cont::ArrayHandleStride<viskores::UInt16>& source,
+                        viskores::cont::ArrayHandle<viskores::UInt16>& destination)
+{
+  DoFlipEndiannessCopy(source, destination);
+}
+
+void FlipEndiannessCopy(const viskores::cont::ArrayHandleStride<viskores::UInt32>& source,
+                        viskores::cont::ArrayHandle<viskores::UInt32>& destination)
+{
+  DoFlipEndiannessCopy(source, destination);
+}
+
+void FlipEndiannessCopy(const viskores::cont::ArrayHandleStride<viskores::UInt64>& source,
+                        viskores::cont::ArrayHandle<viskores::UInt64>& destination)
+{
+  DoFlipEndiannessCopy(source, destination);
+}
+
+}
+}
+} // namespace viskores::io::internal
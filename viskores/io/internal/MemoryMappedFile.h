@@ -0,0 +1,174 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+#ifndef viskores_io_internal_MemoryMappedFile_h
+#define viskores_io_internal_MemoryMappedFile_h
+
+#include <viskores/cont/ArrayExtractComponent.h>
+#include <viskores/cont/ArrayHandle.h>
+#include <viskores/cont/ArrayHandleStride.h>
+#include <viskores/cont/ArrayHandleTransform.h>
+#include <viskores/cont/ErrorBadType.h>
+#include <viskores/io/viskores_io_export.h>
+
+#include <cstring>
+#include <string>
+
+namespace viskores
+{
+namespace io
+{
+namespace internal
+{
+
+/// \brief A private, writable memory mapping of an entire file.
+///
+/// The mapping is copy-on-write: pages are shared with the operating system's file cache
+/// until they are modified, and modifications are never written back to the file. Arrays built
+/// on the mapping can therefore be written by their users without touching the file. Readers
+/// should leave the mapped data alone, because every page they write is copied.
+///
+/// The constructor throws `viskores::io::ErrorIO` if the file cannot be mapped, including on
+/// platforms where mapping is not supported (see `IsSupported`).
+class VISKORES_IO_EXPORT MemoryMappedFile
+{
+public:
+  VISKORES_CONT explicit MemoryMappedFile(const std::string& fileName);
+  VISKORES_CONT ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  void operator=(const MemoryMappedFile&) = delete;
+
+  /// Returns true if files can be memory mapped on this platform.
+  VISKORES_CONT static bool IsSupported();
+
+  VISKORES_CONT char* GetData() const { return this->Data; }
+  VISKORES_CONT std::size_t GetSize() const { return this->Size; }
+
+private:
+  char* Data = nullptr;
+  std::size_t Size = 0;
+};
+
+/// Reverses the bytes of an unsigned integer.
+template <typename BitsType>
+VISKORES_EXEC_CONT inline BitsType FlipBytes(BitsType bits)
+{
+  BitsType flipped = 0;
+  for (std::size_t byteIndex = 0; byteIndex < sizeof(BitsType); ++byteIndex)
+  {
+    flipped = static_cast<BitsType>((flipped << 8) | (bits & 0xFF));
+    bits = static_cast<BitsType>(bits >> 8);
+  }
+  return flipped;
+}
+
+/// \brief Reads values of type `T` that are stored with the opposite byte order.
+///
+/// The functor takes the raw bits of a value (or a `Vec` of them) as unsigned integers of the
+/// same size as `T` and returns the value with its bytes reversed. Used with
+/// `ArrayHandleTransform`, it gives a read-only view of foreign-endian data, such as a memory
+/// mapped file, that swaps on access and never modifies or copies the data.
+template <typename T>
+struct FlipEndiannessFunctor
+{
+  template <typename BitsType>
+  VISKORES_EXEC_CONT T operator()(BitsType bits) const
+  {
+    return Flip(bits);
+  }
+
+  template <typename BitsType, viskores::IdComponent N>
+  VISKORES_EXEC_CONT viskores::Vec<T, N> operator()(const viskores::Vec<BitsType, N>& bits) const
+  {
+    viskores::Vec<T, N> values;
+    for (viskores::IdComponent index = 0; index < N; ++index)
+    {
+      values[index] = Flip(bits[index]);
+    }
+    return values;
+  }
+
+private:
+  template <typename BitsType>
+  VISKORES_EXEC_CONT static T Flip(BitsType bits)
+  {
+    VISKORES_STATIC_ASSERT(sizeof(BitsType) == sizeof(T));
+    // Swap as integers so that a float never holds the bits in the wrong order.
+    BitsType flipped = FlipBytes(bits);
+    T value;
+    std::memcpy(&value, &flipped, sizeof(T));
+    return value;
+  }
+};
+
+/// Reverses the bytes of every value in the array. The swap is done in place on whatever
+/// device the scheduler picks.
+VISKORES_IO_EXPORT void FlipEndiannessInPlace(viskores::cont::ArrayHandle<viskores::UInt16>& array);
+VISKORES_IO_EXPORT void FlipEndiannessInPlace(viskores::cont::ArrayHandle<viskores::UInt32>& array);
+VISKORES_IO_EXPORT void FlipEndiannessInPlace(viskores::cont::ArrayHandle<viskores::UInt64>& array);
+
+/// Copies `source` into `destination` with the bytes of every value reversed. The copy is done
+/// on whatever device the scheduler picks.
+VISKORES_IO_EXPORT void FlipEndiannessCopy(
+  const viskores::cont::ArrayHandleStride<viskores::UInt16>& source,
+  viskores::cont::ArrayHandle<viskores::UInt16>& destination);
+VISKORES_IO_EXPORT void FlipEndiannessCopy(
+  const viskores::cont::ArrayHandleStride<viskores::UInt32>& source,
+  viskores::cont::ArrayHandle<viskores::UInt32>& destination);
+VISKORES_IO_EXPORT void FlipEndiannessCopy(
+  const viskores::cont::ArrayHandleStride<viskores::UInt64>& source,
+  viskores::cont::ArrayHandle<viskores::UInt64>& destination);
+
+}
+}
+} // namespace viskores::io::internal
+
+namespace viskores
+{
+namespace cont
+{
+namespace internal
+{
+
+// Extracting a component of a byte-swapping view has to copy, but the copy swaps the strided
+// source component in parallel instead of going through the serial fallback.
+template <typename SourceArrayType, typename T>
+struct ArrayExtractComponentImpl<
+  viskores::cont::internal::StorageTagTransform<SourceArrayType,
+                                                viskores::io::internal::FlipEndiannessFunctor<T>>>
+  : viskores::cont::internal::ArrayExtractComponentImplInefficient
+{
+  template <typename ValueType, typename StorageTag>
+  viskores::cont::ArrayHandleStride<T> operator()(
+    const viskores::cont::ArrayHandle<ValueType, StorageTag>& src,
+    viskores::IdComponent componentIndex,
+    viskores::CopyFlag allowCopy) const
+  {
+    if (allowCopy != viskores::CopyFlag::On)
+    {
+      throw viskores::cont::ErrorBadType(
+        "Cannot extract component of a byte swapped array without copying");
+    }
+    SourceArrayType source = viskores::cont::internal::Storage<ValueType, StorageTag>::GetArray(
+      src.GetBuffers());
+    auto bits =
+      viskores::cont::ArrayExtractComponent(source, componentIndex, viskores::CopyFlag::Off);
+    using BitsType = typename decltype(bits)::ValueType;
+    viskores::cont::ArrayHandle<BitsType> flipped;
+    viskores::io::internal::FlipEndiannessCopy(bits, flipped);
+    // Same bytes, now in the order of `T`.
+    viskores::cont::ArrayHandle<T> values(flipped.GetBuffers());
+    return viskores::cont::ArrayHandleStride<T>(values, values.GetNumberOfValues(), 1, 0);
+  }
+};
+
+}
+}
+} // namespace viskores::cont::internal
+
+#endif //viskores_io_internal_MemoryMappedFile_h
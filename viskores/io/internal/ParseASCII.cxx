@@ -0,0 +1,347 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/io/internal/ParseASCII.h>
+
+#include <viskores/cont/DeviceAdapter.h>
+#include <viskores/cont/TryExecute.h>
+#include <viskores/exec/FunctorBase.h>
+#include <viskores/io/ErrorIO.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace viskores
+{
+namespace io
+{
+namespace internal
+{
+
+namespace
+{
+
+// Text is read in windows of at most this many bytes, and each window is split into chunks of
+// about this many bytes to convert in parallel.
+constexpr std::size_t MaxWindowSize = std::size_t{ 32 } << 20;
+constexpr std::size_t MinWindowSize = std::size_t{ 4 } << 10;
+constexpr std::size_t ChunkSize = std::size_t{ 256 } << 10;
+
+using HostDeviceList = viskores::List<viskores::cont::DeviceAdapterTagTBB,
+                                      viskores::cont::DeviceAdapterTagOpenMP,
+                                      viskores::cont::DeviceAdapterTagSerial>;
+
+// 8-bit values are numbers in the file, not characters.
+template <typename T>
+struct ParseType
+{
+  using Type = T;
+};
+template <>
+struct ParseType<viskores::Int8>
+{
+  using Type = viskores::Int16;
+};
+template <>
+struct ParseType<viskores::UInt8>
+{
+  using Type = viskores::UInt16;
+};
+
+inline bool IsSpace(char c)
+{
+  return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') || (c == '\v') || (c == '\f');
+}
+
+template <typename T>
+bool ParseToken(const char* first, const char* last, T& value, std::false_type)
+{
+  auto result = std::from_chars(first, last, value);
+  return (result.ec == std::errc{}) && (result.ptr == last);
+}
+
+template <typename T>
+bool ParseToken(const char* first, const char* last, T& value, std::true_type)
+{
+#if defined(__cpp_lib_to_chars)
+  auto result = std::from_chars(first, last, value);
+  if ((result.ec == std::errc::result_out_of_range) && (result.ptr == last))
+  {
+    // Stream extraction accepts values that underflow or overflow. Do the same.
+    double wide;
+    result = std::from_chars(first, last, wide);
+    value = static_cast<T>(wide);
+  }
+  return (result.ec == std::errc{}) && (result.ptr == last);
+#else
+  // Floating point std::from_chars is not available. strtod stops at the whitespace (or the
+  // null terminator) that follows every token.
+  char* end;
+  value = static_cast<T>(std::strtod(first, &end));
+  return end == last;
+#endif
+}
+
+template <typename T>
+bool ParseToken(const char* first, const char* last, T& value)
+{
+  if ((first != last) && (*first == '+'))
+  {
+    ++first;
+  }
+  return ParseToken(first, last, value, typename std::is_floating_point<T>::type{});
+}
+
+template <typename T>
+struct ParseChunksKernel : public viskores::exec::FunctorBase
+{
+  const char* Text;
+  const std::size_t* ChunkBegins;
+  const std::size_t* ValueBegins;
+  T* Values;
+  viskores::UInt8* Failed;
+
+  void operator()(viskores::Id chunk) const
+  {
+    using IOType = typename ParseType<T>::Type;
+
+    const char* next = this->Text + this->ChunkBegins[chunk];
+    const char* end = this->Text + this->ChunkBegins[chunk + 1];
+    T* out = this->Values + this->ValueBegins[chunk];
+    while (true)
+    {
+      while ((next != end) && IsSpace(*next))
+      {
+        ++next;
+      }
+      if (next == end)
+      {
+        break;
+      }
+      const char* tokenEnd = next;
+      while ((tokenEnd != end) && !IsSpace(*tokenEnd))
+      {
+        ++tokenEnd;
+      }
+      IOType value;
+      if (!ParseToken(next, tokenEnd, value))
+      {
+        this->Failed[chunk] = 1;
+        return;
+      }
+      *out++ = static_cast<T>(value);
+      next = tokenEnd;
+    }
+  }
+};
+
+struct ScheduleOnHost
+{
+  template <typename Device, typename Kernel>
+  bool operator()(Device, const Kernel& kernel, viskores::Id numChunks) const
+  {
+    viskores::cont::DeviceAdapterAlgorithm<Device>::Schedule(kernel, numChunks);
+    return true;
+  }
+};
+
+template <typename IOType>
+std::string FindBadToken(const char* first, const char* last)
+{
+  while (first != last)
+  {
+    while ((first != last) && IsSpace(*first))
+    {
+      ++first;
+    }
+    const char* tokenEnd = first;
+    while ((tokenEnd != last) && !IsSpace(*tokenEnd))
+    {
+      ++tokenEnd;
+    }
+    IOType value;
+    if ((first != tokenEnd) && !ParseToken(first, tokenEnd, value))
+    {
+      return std::string(first, tokenEnd);
+    }
+    first = tokenEnd;
+  }
+  return std::string();
+}
+
+template <typename T>
+void DoParseASCIIValues(std::istream& stream, T* values, std::size_t numValues)
+{
+  if (numValues == 0)
+  {
+    return;
+  }
+
+  const std::streampos start = stream.tellg();
+  std::streambuf* source = stream.rdbuf();
+
+  std::string text;
+  std::size_t consumed = 0;
+  std::size_t parsed = 0;
+  std::vector<std::size_t> chunkBegins;
+  std::vector<std::size_t> valueBegins;
+  std::vector<viskores::UInt8> failed;
+  while (parsed < numValues)
+  {
+    // Most values are written in fewer than 16 characters. Read about enough for the rest of
+    // the array, so that small arrays do not pull in much of what follows them.
+    const std::size_t windowSize =
+      std::min(std::max((numValues - parsed) * 16, MinWindowSize), MaxWindowSize);
+    const std::size_t carry = text.size();
+    text.resize(carry + windowSize);
+    const std::size_t numRead = static_cast<std::size_t>(
+      source->sgetn(&text[carry], static_cast<std::streamsize>(windowSize)));
+    text.resize(carry + numRead);
+    const bool atEnd = (numRead < windowSize);
+
+    // Find the token boundaries of the window serially; converting is the expensive part.
+    const std::size_t size = text.size();
+    const std::size_t limit = numValues - parsed;
+    std::size_t count = 0;
+    std::size_t position = 0;
+    std::size_t keepFrom = 0;
+    chunkBegins.assign(1, 0);
+    valueBegins.assign(1, 0);
+    while (count < limit)
+    {
+      while ((position < size) && IsSpace(text[position]))
+      {
+        ++position;
+      }
+      if (position == size)
+      {
+        keepFrom = size;
+        break;
+      }
+      const std::size_t tokenBegin = position;
+      while ((position < size) && !IsSpace(text[position]))
+      {
+        ++position;
+      }
+      if ((position == size) && !atEnd)
+      {
+        // The token may continue in the next window.
+        keepFrom = tokenBegin;
+        break;
+      }
+      ++count;
+      keepFrom = position;
+      if ((position - chunkBegins.back() >= ChunkSize) && (count < limit))
+      {
+        chunkBegins.push_back(position);
+        valueBegins.push_back(count);
+      }
+    }
+    chunkBegins.push_back(keepFrom);
+
+    const viskores::Id numChunks = static_cast<viskores::Id>(valueBegins.size());
+    failed.assign(valueBegins.size(), 0);
+    ParseChunksKernel<T> kernel;
+    kernel.Text = text.data();
+    kernel.ChunkBegins = chunkBegins.data();
+    kernel.ValueBegins = valueBegins.data();
+    kernel.Values = values + parsed;
+    kernel.Failed = failed.data();
+    if ((numChunks < 2) ||
+        !viskores::cont::TryExecute(ScheduleOnHost{}, HostDeviceList{}, kernel, numChunks))
+    {
+      for (viskores::Id chunk = 0; chunk < numChunks; ++chunk)
+      {
+        kernel(chunk);
+      }
+    }
+
+    for (std::size_t chunk = 0; chunk < failed.size(); ++chunk)
+    {
+      if (failed[chunk])
+      {
+        throw viskores::io::ErrorIO(
+          "Parse Error: invalid value '" +
+          FindBadToken<typename ParseType<T>::Type>(text.data() + chunkBegins[chunk],
+                                                    text.data() + chunkBegins[chunk + 1]) +
+          "'");
+      }
+    }
+
+    parsed += count;
+    consumed += keepFrom;
+    text.erase(0, keepFrom);
+    if ((parsed < numValues) && atEnd)
+    {
+      throw viskores::io::ErrorIO("Parse Error: expected " + std::to_string(numValues) +
+                                  " values but the file ended after " + std::to_string(parsed));
+    }
+  }
+
+  // Leave the stream just past the last value, as if it was read with operator>>.
+  stream.seekg(start + static_cast<std::streamoff>(consumed));
+}
+
+} // anonymous namespace
+
+void ParseASCIIValues(std::istream& stream, viskores::Int8* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::UInt8* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::Int16* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::UInt16* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::Int32* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::UInt32* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::Int64* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::UInt64* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::Float32* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+void ParseASCIIValues(std::istream& stream, viskores::Float64* values, std::size_t numValues)
+{
+  DoParseASCIIValues(stream, values, numValues);
+}
+
+}
+}
+} // namespace viskores::io::internal
@@ -0,0 +1,68 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+#ifndef viskores_io_internal_ParseASCII_h
+#define viskores_io_internal_ParseASCII_h
+
+#include <viskores/Types.h>
+#include <viskores/io/viskores_io_export.h>
+
+#include <istream>
+
+namespace viskores
+{
+namespace io
+{
+namespace internal
+{
+
+/// @{
+/// \brief Reads `numValues` whitespace separated numbers from `stream` into `values`.
+///
+/// The text is read in large blocks that are split into chunks at whitespace boundaries.
+/// The chunks are converted concurrently on a host device (TBB, OpenMP, or serial) with
+/// `std::from_chars`, which does not depend on the locale. The stream is left positioned
+/// just past the last number read. 8-bit integers are read as numbers, not characters.
+///
+/// Throws `viskores::io::ErrorIO` if a token is not a valid number or the stream ends early.
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::Int8* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::UInt8* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::Int16* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::UInt16* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::Int32* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::UInt32* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::Int64* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::UInt64* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::Float32* values,
+                                         std::size_t numValues);
+VISKORES_IO_EXPORT void ParseASCIIValues(std::istream& stream,
+                                         viskores::Float64* values,
+                                         std::size_t numValues);
+/// @}
+
+}
+}
+} // namespace viskores::io::internal
+
+#endif //viskores_io_internal_ParseASCII_h
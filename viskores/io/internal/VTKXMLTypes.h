@@ -0,0 +1,169 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+#ifndef viskores_io_internal_VTKXMLTypes_h
+#define viskores_io_internal_VTKXMLTypes_h
+
+#include <viskores/Types.h>
+#include <viskores/io/ErrorIO.h>
+
+#include <string>
+#include <utility>
+
+namespace viskores
+{
+namespace io
+{
+namespace internal
+{
+
+/// Names used for the `type` attribute of `DataArray` elements in VTK XML files.
+template <typename T>
+struct VTKXMLTypeName;
+
+#define VISKORES_IO_VTK_XML_TYPE_NAME(T, name) \
+  template <>                                  \
+  struct VTKXMLTypeName<T>                     \
+  {                                            \
+    static const char* Name() { return name; } \
+  }
+
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::Int8, "Int8");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::UInt8, "UInt8");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::Int16, "Int16");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::UInt16, "UInt16");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::Int32, "Int32");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::UInt32, "UInt32");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::Int64, "Int64");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::UInt64, "UInt64");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::Float32, "Float32");
+VISKORES_IO_VTK_XML_TYPE_NAME(viskores::Float64, "Float64");
+
+#undef VISKORES_IO_VTK_XML_TYPE_NAME
+
+/// Calls `functor` with a default constructed value of the type named by a VTK XML `type`
+/// attribute. Throws `viskores::io::ErrorIO` for unknown names.
+template <typename Functor>
+inline void CallForVTKXMLType(const std::string& name, Functor&& functor)
+{
+  // Older files use the C type names.
+  if ((name == "Int8") || (name == "Char"))
+  {
+    functor(viskores::Int8{});
+  }
+  else if ((name == "UInt8") || (name == "UnsignedChar"))
+  {
+    functor(viskores::UInt8{});
+  }
+  else if ((name == "Int16") || (name == "Short"))
+  {
+    functor(viskores::Int16{});
+  }
+  else if ((name == "UInt16") || (name == "UnsignedShort"))
+  {
+    functor(viskores::UInt16{});
+  }
+  else if ((name == "Int32") || (name == "Int"))
+  {
+    functor(viskores::Int32{});
+  }
+  else if ((name == "UInt32") || (name == "UnsignedInt"))
+  {
+    functor(viskores::UInt32{});
+  }
+  else if ((name == "Int64") || (name == "IdType"))
+  {
+    functor(viskores::Int64{});
+  }
+  else if (name == "UInt64")
+  {
+    functor(viskores::UInt64{});
+  }
+  else if ((name == "Float32") || (name == "Float"))
+  {
+    functor(viskores::Float32{});
+  }
+  else if ((name == "Float64") || (name == "Double"))
+  {
+    functor(viskores::Float64{});
+  }
+  else
+  {
+    throw viskores::io::ErrorIO("Unsupported VTK XML data type: " + name);
+  }
+}
+
+/// Escapes the characters that cannot appear in an XML attribute value.
+inline std::string EscapeXMLAttribute(const std::string& value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value)
+  {
+    switch (c)
+    {
+      case '&':
+        escaped += "&amp;";
+        break;
+      case '<':
+        escaped += "&lt;";
+        break;
+      case '>':
+        escaped += "&gt;";
+        break;
+      case '"':
+        escaped += "&quot;";
+        break;
+      case '\'':
+        escaped += "&apos;";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+/// Reverses `EscapeXMLAttribute`.
+inline std::string UnescapeXMLAttribute(const std::string& value)
+{
+  static const std::pair<const char*, char> entities[] = {
+    { "&amp;", '&' }, { "&lt;", '<' }, { "&gt;", '>' }, { "&quot;", '"' }, { "&apos;", '\'' }
+  };
+
+  std::string unescaped;
+  unescaped.reserve(value.size());
+  for (std::size_t index = 0; index < value.size(); ++index)
+  {
+    bool replaced = false;
+    if (value[index] == '&')
+    {
+      for (const auto& entity : entities)
+      {
+        std::size_t length = std::char_traits<char>::length(entity.first);
+        if (value.compare(index, length, entity.first) == 0)
+        {
+          unescaped += entity.second;
+          index += length - 1;
+          replaced = true;
+          break;
+        }
+      }
+    }
+    if (!replaced)
+    {
+      unescaped += value[index];
+    }
+  }
+  return unescaped;
+}
+
+}
+}
+} // namespace viskores::io::internal
+
+#endif //viskores_io_internal_VTKXMLTypes_h
@@ -21,13 +21,19 @@
 #include <viskores/cont/testing/Testing.h>
 #include <viskores/io/FileUtils.h>
 #include <viskores/io/VTKDataSetReader.h>
+#include <viskores/io/internal/Endian.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef _MSC_VER
 #include <process.h>
@@ -112,7 +118,7 @@ public:
   {
     // Keep generated fixtures out of the source tree and away from the data
     // submodule so these regressions stay self-contained.
-    std::ofstream out(this->FileName);
+    std::ofstream out(this->FileName, std::ios_base::out | std::ios_base::binary);
     VISKORES_TEST_ASSERT(out.is_open(), "Could not create ", this->FileName);
     out << contents;
     out.close();
@@ -127,6 +133,22 @@ private:
   std::string FileName;
 };
 
+template <typename T>
+void AppendBigEndian(std::string& contents, const std::vector<T>& values)
+{
+  for (const T& value : values)
+  {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (viskores::io::internal::IsLittleEndian())
+    {
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+    contents.append(bytes, sizeof(T));
+  }
+  contents += "\n";
+}
+
 viskores::cont::ArrayHandle<viskores::Vec3f> GetCoordinateArray(const viskores::cont::DataSet& ds)
 {
   viskores::cont::ArrayHandle<viskores::Vec3f> coords;
@@ -844,6 +866,175 @@ void TestStructuredGridDegenerateDimensions()
                                                           viskores::Vec3f(0.0f, 0.0f, 1.0f) });
 }
 
+void TestMemoryMappedBinary()
+{
+  constexpr viskores::Id numPoints = 12;
+  std::vector<viskores::Float32> floats(numPoints);
+  std::vector<viskores::Float64> doubles(numPoints);
+  std::vector<viskores::UInt8> bytes(numPoints);
+  std::vector<viskores::Int16> shorts(numPoints);
+  std::vector<viskores::Float32> vectors(numPoints * 3);
+  for (viskores::Id index = 0; index < numPoints; ++index)
+  {
+    std::size_t i = static_cast<std::size_t>(index);
+    floats[i] = TestValue(index, viskores::Float32{});
+    doubles[i] = TestValue(index, viskores::Float64{});
+    bytes[i] = TestValue(index, viskores::UInt8{});
+    shorts[i] = TestValue(index, viskores::Int16{});
+    for (std::size_t component = 0; component < 3; ++component)
+    {
+      vectors[i * 3 + component] = TestValue(index, viskores::Vec3f_32{})[component];
+    }
+  }
+
+  // The odd-length names leave each binary section at a different alignment.
+  std::string contents = "# vtk DataFile Version 3.0\n"
+                         "memory mapped\n"
+                         "BINARY\n"
+                         "DATASET STRUCTURED_POINTS\n"
+                         "DIMENSIONS 3 2 2\n"
+                         "SPACING 1 1 1\n"
+                         "ORIGIN 0 0 0\n"
+                         "POINT_DATA 12\n"
+                         "SCALARS ff float 1\n"
+                         "LOOKUP_TABLE default\n";
+  AppendBigEndian(contents, floats);
+  contents += "SCALARS bb unsigned_char 1\nLOOKUP_TABLE default\n";
+  AppendBigEndian(contents, bytes);
+  contents += "SCALARS ddd double 1\nLOOKUP_TABLE default\n";
+  AppendBigEndian(contents, doubles);
+  contents += "SCALARS s short 1\nLOOKUP_TABLE default\n";
+  AppendBigEndian(contents, shorts);
+  contents += "VECTORS vect float\n";
+  AppendBigEndian(contents, vectors);
+  ScopedVTKTestFile vtkFile("vtk_reader_memory_mapped.vtk", contents);
+
+  auto checkDataSet = [&](const viskores::cont::DataSet& ds)
+  {
+    VISKORES_TEST_ASSERT(ds.GetNumberOfPoints() == numPoints);
+    auto checkField = [&](const std::string& name, const auto& expected)
+    {
+      using T = typename std::decay_t<decltype(expected)>::value_type;
+      viskores::cont::ArrayHandle<T> array;
+      viskores::cont::ArrayCopyShallowIfPossible(ds.GetField(name).GetData(), array);
+      auto expectedArray = viskores::cont::make_ArrayHandle(expected, viskores::CopyFlag::Off);
+      VISKORES_TEST_ASSERT(test_equal_ArrayHandles(array, expectedArray), "Bad values in ", name);
+    };
+    checkField("ff", floats);
+    checkField("bb", bytes);
+    checkField("ddd", doubles);
+    checkField("s", shorts);
+
+    viskores::cont::ArrayHandle<viskores::Vec3f_32> vecArray;
+    viskores::cont::ArrayCopyShallowIfPossible(ds.GetField("vect").GetData(), vecArray);
+    auto portal = vecArray.ReadPortal();
+    for (viskores::Id index = 0; index < numPoints; ++index)
+    {
+      VISKORES_TEST_ASSERT(test_equal(portal.Get(index), TestValue(index, viskores::Vec3f_32{})));
+    }
+
+    auto component =
+      ds.GetField("vect").GetData().ExtractComponent<viskores::Float32>(1, viskores::CopyFlag::On);
+    auto componentPortal = component.ReadPortal();
+    for (viskores::Id index = 0; index < numPoints; ++index)
+    {
+      VISKORES_TEST_ASSERT(
+        test_equal(componentPortal.Get(index), TestValue(index, viskores::Vec3f_32{})[1]));
+    }
+  };
+
+  viskores::cont::DataSet mapped;
+  {
+    viskores::io::VTKDataSetReader reader(vtkFile.GetFileName());
+    reader.SetUseMemoryMapping(true);
+    VISKORES_TEST_ASSERT(reader.GetUseMemoryMapping());
+    mapped = reader.ReadDataSet();
+  }
+  // The arrays remain valid after the reader (and its copy of the mapping) is gone.
+  checkDataSet(mapped);
+
+  // Aligned sections are used in place, as views that swap on little-endian hosts. Only the
+  // misaligned "ddd" is copied into a basic array.
+  const bool swapped = viskores::io::internal::IsLittleEndian();
+  auto isBasic = [&](const std::string& name, auto value)
+  {
+    using ArrayType = viskores::cont::ArrayHandle<decltype(value)>;
+    return mapped.GetField(name).GetData().CanConvert<ArrayType>();
+  };
+  VISKORES_TEST_ASSERT(isBasic("ff", viskores::Float32{}) != swapped);
+  VISKORES_TEST_ASSERT(isBasic("s", viskores::Int16{}) != swapped);
+  VISKORES_TEST_ASSERT(isBasic("vect", viskores::Vec3f_32{}) != swapped);
+  VISKORES_TEST_ASSERT(isBasic("bb", viskores::UInt8{}));
+  VISKORES_TEST_ASSERT(isBasic("ddd", viskores::Float64{}));
+
+  checkDataSet(readVTKDataSet(vtkFile.GetFileName()));
+}
+
+void TestReadingLargeASCII()
+{
+  // Enough long values to span several parse windows and chunks.
+  constexpr viskores::Id numPoints = 50 * 40 * 25;
+  std::stringstream contents;
+  contents << "# vtk DataFile Version 3.0\n"
+           << "large ascii\n"
+           << "ASCII\n"
+           << "DATASET STRUCTURED_POINTS\n"
+           << "DIMENSIONS 50 40 25\n"
+           << "SPACING 1 1 1\n"
+           << "ORIGIN 0 0 0\n"
+           << "POINT_DATA " << numPoints << "\n"
+           << "SCALARS f double 1\n"
+           << "LOOKUP_TABLE default\n";
+  contents << std::scientific << std::setprecision(20);
+  for (viskores::Id index = 0; index < numPoints; ++index)
+  {
+    contents << ((index % 3 == 0) ? "+" : "") << (static_cast<double>(index) * 0.25)
+             << ((index % 7 == 0) ? "\n" : " \t");
+  }
+  contents << "\nSCALARS c unsigned_char 1\nLOOKUP_TABLE default\n";
+  for (viskores::Id index = 0; index < numPoints; ++index)
+  {
+    contents << (index % 256) << " ";
+  }
+  contents << "\n";
+  ScopedVTKTestFile vtkFile("vtk_reader_large_ascii.vtk", contents.str());
+
+  viskores::cont::DataSet ds = readVTKDataSet(vtkFile.GetFileName());
+  VISKORES_TEST_ASSERT(ds.GetNumberOfPoints() == numPoints);
+
+  viskores::cont::ArrayHandle<viskores::Float64> doubles;
+  ds.GetField("f").GetData().AsArrayHandle(doubles);
+  auto doublePortal = doubles.ReadPortal();
+  viskores::cont::ArrayHandle<viskores::UInt8> bytes;
+  ds.GetField("c").GetData().AsArrayHandle(bytes);
+  auto bytePortal = bytes.ReadPortal();
+  for (viskores::Id index = 0; index < numPoints; ++index)
+  {
+    VISKORES_TEST_ASSERT(doublePortal.Get(index) == static_cast<double>(index) * 0.25,
+                         "Bad double at ",
+                         index);
+    VISKORES_TEST_ASSERT(bytePortal.Get(index) == index % 256, "Bad byte at ", index);
+  }
+
+  ScopedVTKTestFile badFile("vtk_reader_bad_ascii.vtk",
+                            "# vtk DataFile Version 3.0\n"
+                            "bad value\n"
+                            "ASCII\n"
+                            "DATASET POLYDATA\n"
+                            "POINTS 2 float\n"
+                            "0 0 0 1 x 0\n");
+  try
+  {
+    viskores::io::VTKDataSetReader reader(badFile.GetFileName());
+    reader.ReadDataSet();
+    VISKORES_TEST_FAIL("Did not report bad value.");
+  }
+  catch (viskores::io::ErrorIO& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
 void TestReadingVTKDataSet()
 {
   std::cout << "Test reading VTK Polydata file in ASCII" << std::endl;
@@ -908,6 +1099,10 @@ void TestReadingVTKDataSet()
   TestRectilinearGridDegenerateDimensions();
   std::cout << "Test reading structured grids with degenerate dimensions" << std::endl;
   TestStructuredGridDegenerateDimensions();
+  std::cout << "Test reading binary arrays from a memory mapping" << std::endl;
+  TestMemoryMappedBinary();
+  std::cout << "Test reading large ASCII arrays" << std::endl;
+  TestReadingLargeASCII();
 }
 
 int UnitTestVTKDataSetReader(int argc, char* argv[])
@@ -0,0 +1,315 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/ArrayCopy.h>
+#include <viskores/cont/ArrayHandleSOA.h>
+#include <viskores/cont/DataSetBuilderUniform.h>
+#include <viskores/io/ErrorIO.h>
+#include <viskores/io/VTKXMLDataSetReader.h>
+#include <viskores/io/VTKXMLDataSetWriter.h>
+#include <viskores/io/internal/Endian.h>
+
+#include <viskores/cont/testing/MakeTestDataSet.h>
+#include <viskores/cont/testing/Testing.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+
+#define WRITE_FILE(MakeTestDataMethod) \
+  TestVTKXMLWriteTestData(#MakeTestDataMethod, tds.MakeTestDataMethod())
+
+void CheckWrittenReadData(const viskores::cont::DataSet& originalData,
+                          const viskores::cont::DataSet& fileData)
+{
+  VISKORES_TEST_ASSERT(originalData.GetNumberOfPoints() == fileData.GetNumberOfPoints());
+  VISKORES_TEST_ASSERT(originalData.GetNumberOfCells() == fileData.GetNumberOfCells());
+
+  for (viskores::IdComponent fieldId = 0; fieldId < originalData.GetNumberOfFields(); ++fieldId)
+  {
+    viskores::cont::Field originalField = originalData.GetField(fieldId);
+    if (originalField.IsPointField() &&
+        (originalField.GetName() == originalData.GetCoordinateSystemName()))
+    {
+      continue;
+    }
+    VISKORES_TEST_ASSERT(
+      fileData.HasField(originalField.GetName(), originalField.GetAssociation()));
+    viskores::cont::Field fileField =
+      fileData.GetField(originalField.GetName(), originalField.GetAssociation());
+    VISKORES_TEST_ASSERT(test_equal_ArrayHandles(originalField.GetData(), fileField.GetData()));
+  }
+
+  VISKORES_TEST_ASSERT(fileData.GetNumberOfCoordinateSystems() > 0);
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(originalData.GetCoordinateSystem().GetData(),
+                                               fileData.GetCoordinateSystem().GetData()));
+
+  for (viskores::Id cellId = 0; cellId < originalData.GetNumberOfCells(); ++cellId)
+  {
+    const viskores::cont::CellSet* originalCells = originalData.GetCellSet().GetCellSetBase();
+    const viskores::cont::CellSet* fileCells = fileData.GetCellSet().GetCellSetBase();
+    // Like the legacy reader, polygons with 3 or 4 points are read as triangles and quads.
+    if (originalCells->GetCellShape(cellId) != viskores::CELL_SHAPE_POLYGON)
+    {
+      VISKORES_TEST_ASSERT(originalCells->GetCellShape(cellId) ==
+                           fileCells->GetCellShape(cellId));
+    }
+    viskores::IdComponent numPoints = originalCells->GetNumberOfPointsInCell(cellId);
+    VISKORES_TEST_ASSERT(numPoints == fileCells->GetNumberOfPointsInCell(cellId));
+    std::vector<viskores::Id> originalIds(static_cast<std::size_t>(numPoints));
+    std::vector<viskores::Id> fileIds(static_cast<std::size_t>(numPoints));
+    originalCells->GetCellPointIds(cellId, originalIds.data());
+    fileCells->GetCellPointIds(cellId, fileIds.data());
+    VISKORES_TEST_ASSERT(originalIds == fileIds);
+  }
+}
+
+void TestVTKXMLWriteTestData(const std::string& methodName, const viskores::cont::DataSet& data)
+{
+  const std::string fileName =
+    methodName + viskores::io::VTKXMLDataSetWriter::GetFileExtension(data);
+  std::cout << "Writing " << fileName << std::endl;
+  viskores::io::VTKXMLDataSetWriter writer(fileName);
+  writer.WriteDataSet(data);
+
+  // Read back and check.
+  viskores::io::VTKXMLDataSetReader reader(fileName);
+  CheckWrittenReadData(data, reader.ReadDataSet());
+  std::remove(fileName.c_str());
+}
+
+void TestFileTypes()
+{
+  viskores::cont::testing::MakeTestDataSet tds;
+  VISKORES_TEST_ASSERT(viskores::io::VTKXMLDataSetWriter::GetFileExtension(
+                         tds.Make3DUniformDataSet0()) == ".vti");
+  VISKORES_TEST_ASSERT(viskores::io::VTKXMLDataSetWriter::GetFileExtension(
+                         tds.Make3DRectilinearDataSet0()) == ".vtr");
+  VISKORES_TEST_ASSERT(viskores::io::VTKXMLDataSetWriter::GetFileExtension(
+                         tds.Make3DExplicitDataSet0()) == ".vtu");
+
+  // A structured grid with explicit point coordinates.
+  viskores::cont::DataSet structured = tds.Make3DUniformDataSet0();
+  viskores::cont::ArrayHandle<viskores::Vec3f> points;
+  viskores::cont::ArrayCopy(structured.GetCoordinateSystem().GetData(), points);
+  structured.AddCoordinateSystem(viskores::cont::CoordinateSystem("coords", points));
+  VISKORES_TEST_ASSERT(viskores::io::VTKXMLDataSetWriter::GetFileExtension(structured) ==
+                       ".vts");
+  TestVTKXMLWriteTestData("StructuredPoints", structured);
+}
+
+void TestExplicitWrite()
+{
+  viskores::cont::testing::MakeTestDataSet tds;
+
+  WRITE_FILE(Make1DExplicitDataSet0);
+  WRITE_FILE(Make2DExplicitDataSet0);
+  WRITE_FILE(Make3DExplicitDataSet0);
+  WRITE_FILE(Make3DExplicitDataSet3);
+  WRITE_FILE(Make3DExplicitDataSet5);
+  WRITE_FILE(Make3DExplicitDataSet7);
+  WRITE_FILE(Make3DExplicitDataSetZoo);
+  WRITE_FILE(Make3DExplicitDataSetPolygonal);
+  WRITE_FILE(Make3DExplicitDataSetCowNose);
+}
+
+void TestStructuredWrite()
+{
+  viskores::cont::testing::MakeTestDataSet tds;
+
+  WRITE_FILE(Make1DUniformDataSet0);
+  WRITE_FILE(Make2DUniformDataSet1);
+  WRITE_FILE(Make3DUniformDataSet0);
+  WRITE_FILE(Make3DUniformDataSet1);
+  WRITE_FILE(Make3DRegularDataSet0);
+  WRITE_FILE(Make2DRectilinearDataSet0);
+  WRITE_FILE(Make3DRectilinearDataSet0);
+}
+
+void TestOddVecSizes()
+{
+  viskores::cont::DataSetBuilderUniform dsb;
+  viskores::cont::DataSet dataSet = dsb.Create({ 2, 2, 2 });
+
+  viskores::cont::ArrayHandle<viskores::Vec<viskores::FloatDefault, 5>> vec5Array;
+  vec5Array.Allocate(dataSet.GetNumberOfPoints());
+  SetPortal(vec5Array.WritePortal());
+  dataSet.AddPointField("vec5 & more", vec5Array);
+
+  viskores::cont::ArrayHandleSOA<viskores::Vec<viskores::FloatDefault, 13>> vec13Array;
+  vec13Array.Allocate(dataSet.GetNumberOfPoints());
+  SetPortal(vec13Array.WritePortal());
+  dataSet.AddPointField("vec13", vec13Array);
+
+  TestVTKXMLWriteTestData("OddVecSizes", dataSet);
+}
+
+void TestArraySelection()
+{
+  viskores::cont::testing::MakeTestDataSet tds;
+  viskores::cont::DataSet data = tds.Make3DExplicitDataSet0();
+  viskores::io::VTKXMLDataSetWriter writer("Selection.vtu");
+  writer.WriteDataSet(data);
+
+  viskores::io::VTKXMLDataSetReader reader("Selection.vtu");
+  std::vector<std::string> names = reader.ReadFieldNames();
+  VISKORES_TEST_ASSERT(names.size() == 2);
+  VISKORES_TEST_ASSERT(names[0] == "pointvar");
+  VISKORES_TEST_ASSERT(names[1] == "cellvar");
+
+  reader.SetArraySelection({ "cellvar" });
+  const viskores::cont::DataSet& fileData = reader.ReadDataSet();
+  VISKORES_TEST_ASSERT(!fileData.HasPointField("pointvar"));
+  VISKORES_TEST_ASSERT(fileData.HasCellField("cellvar"));
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(data.GetCellField("cellvar").GetData(),
+                                               fileData.GetCellField("cellvar").GetData()));
+  VISKORES_TEST_ASSERT(fileData.GetNumberOfCells() == data.GetNumberOfCells());
+  std::remove("Selection.vtu");
+}
+
+void TestReadBigEndian()
+{
+  // A hand written big endian file with 32-bit block headers and a pixel cell,
+  // which is converted to a quad.
+  const char header[] = R"(<?xml version="1.0"?>
+<!-- written by hand -->
+<VTKFile type="UnstructuredGrid" version="0.1" byte_order="BigEndian">
+  <UnstructuredGrid>
+    <Piece NumberOfPoints="4" NumberOfCells="1">
+      <CellData>
+        <DataArray type="Float64" Name="id" format="appended" offset="0"/>
+      </CellData>
+      <Points>
+        <DataArray type="Float32" NumberOfComponents="3" format="appended" offset="12"/>
+      </Points>
+      <Cells>
+        <DataArray type="Int32" Name="connectivity" format="appended" offset="64"/>
+        <DataArray type="Int32" Name="offsets" format="appended" offset="84"/>
+        <DataArray type="UInt8" Name="types" format="appended" offset="92"/>
+      </Cells>
+    </Piece>
+  </UnstructuredGrid>
+  <AppendedData encoding="raw">
+   _)";
+  std::string data;
+  auto appendBigEndian = [&data](const void* value, std::size_t size)
+  {
+    const char* bytes = static_cast<const char*>(value);
+    bool little = viskores::io::internal::IsLittleEndian();
+    for (std::size_t index = 0; index < size; ++index)
+    {
+      data += bytes[little ? size - index - 1 : index];
+    }
+  };
+  auto appendSize = [&](viskores::UInt32 size) { appendBigEndian(&size, sizeof(size)); };
+
+  viskores::Float64 id = 42.5;
+  appendSize(8);
+  appendBigEndian(&id, sizeof(id));
+  appendSize(48);
+  for (viskores::Float32 coord : { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f })
+  {
+    appendBigEndian(&coord, sizeof(coord));
+  }
+  appendSize(16);
+  for (viskores::Int32 index : { 0, 1, 2, 3 })
+  {
+    appendBigEndian(&index, sizeof(index));
+  }
+  appendSize(4);
+  viskores::Int32 offset = 4;
+  appendBigEndian(&offset, sizeof(offset));
+  appendSize(1);
+  data += static_cast<char>(8); // VTK_PIXEL
+
+  {
+    std::ofstream file("BigEndian.vtu", std::ios_base::binary);
+    file << header << data << "\n  </AppendedData>\n</VTKFile>\n";
+  }
+
+  viskores::io::VTKXMLDataSetReader reader("BigEndian.vtu");
+  const viskores::cont::DataSet& fileData = reader.ReadDataSet();
+  VISKORES_TEST_ASSERT(fileData.GetNumberOfPoints() == 4);
+  VISKORES_TEST_ASSERT(fileData.GetNumberOfCells() == 1);
+  const viskores::cont::CellSet* cells = fileData.GetCellSet().GetCellSetBase();
+  VISKORES_TEST_ASSERT(cells->GetCellShape(0) == viskores::CELL_SHAPE_QUAD);
+  viskores::Id ids[4];
+  cells->GetCellPointIds(0, ids);
+  VISKORES_TEST_ASSERT(ids[0] == 0 && ids[1] == 1 && ids[2] == 3 && ids[3] == 2);
+
+  viskores::cont::ArrayHandle<viskores::Float64> idArray;
+  fileData.GetCellField("id").GetData().AsArrayHandle(idArray);
+  VISKORES_TEST_ASSERT(test_equal(idArray.ReadPortal().Get(0), 42.5));
+  viskores::cont::ArrayHandle<viskores::Vec3f_32> points;
+  fileData.GetCoordinateSystem().GetData().AsArrayHandle(points);
+  VISKORES_TEST_ASSERT(test_equal(points.ReadPortal().Get(3), viskores::Vec3f_32(1, 1, 0)));
+  std::remove("BigEndian.vtu");
+}
+
+void TestReadMalformedAttributes()
+{
+  viskores::cont::testing::MakeTestDataSet tds;
+  viskores::io::VTKXMLDataSetWriter writer("Malformed.vtu");
+  writer.WriteDataSet(tds.Make3DExplicitDataSet0());
+  std::string contents;
+  {
+    std::ifstream file("Malformed.vtu", std::ios_base::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+
+  auto checkRejected = [&](const std::string& attribute, const std::string& value)
+  {
+    const std::string::size_type start = contents.find(attribute + "=\"");
+    VISKORES_TEST_ASSERT(start != std::string::npos, "No ", attribute, " in written file");
+    const std::string::size_type valueStart = start + attribute.size() + 2;
+    std::string malformed = contents;
+    malformed.replace(valueStart, contents.find('"', valueStart) - valueStart, value);
+    {
+      std::ofstream file("Malformed.vtu", std::ios_base::binary);
+      file << malformed;
+    }
+    try
+    {
+      viskores::io::VTKXMLDataSetReader reader("Malformed.vtu");
+      reader.ReadDataSet();
+      VISKORES_TEST_FAIL("Read ", attribute, "=\"", value, "\" without an error");
+    }
+    catch (const viskores::io::ErrorIO& error)
+    {
+      std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+  };
+  checkRejected("NumberOfComponents", "0");
+  checkRejected("NumberOfComponents", "-3");
+  checkRejected("NumberOfComponents", "three");
+  checkRejected("NumberOfComponents", "3x");
+  checkRejected("offset", "-1");
+  checkRejected("offset", "end");
+  std::remove("Malformed.vtu");
+}
+
+void TestVTKXMLDataSet()
+{
+  TestFileTypes();
+  TestExplicitWrite();
+  TestStructuredWrite();
+  TestOddVecSizes();
+  TestArraySelection();
+  TestReadBigEndian();
+  TestReadMalformedAttributes();
+}
+
+} //Anonymous namespace
+
+int UnitTestVTKXMLDataSet(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestVTKXMLDataSet, argc, argv);
+}
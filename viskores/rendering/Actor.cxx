@@ -272,6 +272,31 @@ void Actor::Render(viskores::rendering::Mapper& mapper,
                                 this->Internals->ScalarRange);
 }
 
+void Actor::Render(viskores::rendering::Mapper& mapper,
+                   const std::vector<viskores::rendering::Canvas*>& canvases,
+                   const std::vector<viskores::rendering::Camera>& cameras) const
+{
+  if (this->Internals->Data.GetNumberOfPartitions() != 1)
+  {
+    // The order of the partitions depends on the camera, so render each camera on its own.
+    for (std::size_t i = 0; i < cameras.size(); ++i)
+    {
+      this->Render(mapper, *canvases[i], cameras[i]);
+    }
+    return;
+  }
+
+  mapper.SetActiveColorTable(this->Internals->ColorTable);
+  auto partition = this->Internals->Data.GetPartition(0);
+  mapper.RenderCellsBatch(partition.GetCellSet(),
+                          partition.GetCoordinateSystem(),
+                          partition.GetField(this->Internals->FieldName),
+                          this->Internals->ColorTable,
+                          cameras,
+                          canvases,
+                          this->Internals->ScalarRange,
+                          partition.GetGhostCellField());
+}
 
 const viskores::cont::UnknownCellSet& Actor::GetCells() const
 {
@@ -25,6 +25,7 @@
 #include <viskores/rendering/Mapper.h>
 
 #include <memory>
+#include <vector>
 
 namespace viskores
 {
@@ -170,6 +171,13 @@ public:
               viskores::rendering::Canvas& canvas,
               const viskores::rendering::Camera& camera) const;
 
+  /// @brief Renders the actor from several cameras, each into the canvas with its index.
+  ///
+  /// See `Mapper::RenderCellsBatch()`.
+  void Render(viskores::rendering::Mapper& mapper,
+              const std::vector<viskores::rendering::Canvas*>& canvases,
+              const std::vector<viskores::rendering::Camera>& cameras) const;
+
   const viskores::cont::UnknownCellSet& GetCells() const;
 
   viskores::cont::CoordinateSystem GetCoordinates() const;
@@ -0,0 +1,369 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/rendering/Compositor.h>
+
+#include <viskores/cont/EnvironmentTracker.h>
+#include <viskores/cont/ErrorBadValue.h>
+
+#include <viskores/thirdparty/diy/diy.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace viskores
+{
+namespace rendering
+{
+
+namespace
+{
+
+// Each pixel is stored as red, green, blue, alpha, and depth.
+constexpr std::size_t PixelSize = 5;
+
+// The part of the image a rank is responsible for during compositing.
+struct ImageBlock
+{
+  viskores::Id Begin = 0;
+  viskores::Id End = 0;
+  std::vector<viskores::Float32> Pixels;
+
+  const viskores::Float32* GetPixel(viskores::Id pixel) const
+  {
+    return this->Pixels.data() + static_cast<std::size_t>(pixel - this->Begin) * PixelSize;
+  }
+  viskores::Float32* GetPixel(viskores::Id pixel)
+  {
+    return this->Pixels.data() + static_cast<std::size_t>(pixel - this->Begin) * PixelSize;
+  }
+};
+
+// Pixels of a part of the image with the empty pixels removed. Runs holds the first
+// pixel and the number of pixels of each run of non-empty pixels.
+struct SparseImage
+{
+  std::vector<viskores::Id> Runs;
+  std::vector<viskores::Float32> Pixels;
+};
+
+// A pixel is empty when nothing was rendered to it since the canvas was cleared.
+inline bool IsEmpty(const viskores::Float32* pixel)
+{
+  return (pixel[0] == 0.f) && (pixel[1] == 0.f) && (pixel[2] == 0.f) && (pixel[3] == 0.f) &&
+    (pixel[4] >= VISKORES_DEFAULT_CANVAS_DEPTH);
+}
+
+inline void ClearPixels(ImageBlock& block)
+{
+  block.Pixels.resize(static_cast<std::size_t>(block.End - block.Begin) * PixelSize);
+  for (std::size_t index = 0; index < block.Pixels.size(); index += PixelSize)
+  {
+    std::fill_n(block.Pixels.begin() + static_cast<std::ptrdiff_t>(index), 4, 0.f);
+    block.Pixels[index + 4] = VISKORES_DEFAULT_CANVAS_DEPTH;
+  }
+}
+
+SparseImage Compress(const ImageBlock& block, viskores::Id begin, viskores::Id end)
+{
+  SparseImage image;
+  viskores::Id pixel = begin;
+  while (pixel < end)
+  {
+    if (IsEmpty(block.GetPixel(pixel)))
+    {
+      ++pixel;
+      continue;
+    }
+    const viskores::Id runStart = pixel;
+    while ((pixel < end) && !IsEmpty(block.GetPixel(pixel)))
+    {
+      ++pixel;
+    }
+    image.Runs.push_back(runStart);
+    image.Runs.push_back(pixel - runStart);
+    image.Pixels.insert(image.Pixels.end(), block.GetPixel(runStart), block.GetPixel(pixel));
+  }
+  return image;
+}
+
+// Composites a pixel behind the pixel accumulated so far. In visibility order, the
+// accumulated pixel is in front of all the pixels that follow.
+inline void CompositePixel(viskores::rendering::Compositor::CompositeMode mode,
+                           viskores::Float32* front,
+                           const viskores::Float32* back)
+{
+  if (mode == viskores::rendering::Compositor::CompositeMode::ZBuffer)
+  {
+    if (back[4] < front[4])
+    {
+      std::copy_n(back, PixelSize, front);
+    }
+  }
+  else
+  {
+    const viskores::Float32 transmission = 1.f - front[3];
+    for (std::size_t channel = 0; channel < 4; ++channel)
+    {
+      front[channel] += transmission * back[channel];
+    }
+    front[4] = std::min(front[4], back[4]);
+  }
+}
+
+void CompositeSparse(viskores::rendering::Compositor::CompositeMode mode,
+                     ImageBlock& result,
+                     const SparseImage& image)
+{
+  const viskores::Float32* pixels = image.Pixels.data();
+  for (std::size_t run = 0; run < image.Runs.size(); run += 2)
+  {
+    const viskores::Id runStart = image.Runs[run];
+    for (viskores::Id pixel = runStart; pixel < runStart + image.Runs[run + 1]; ++pixel)
+    {
+      CompositePixel(mode, result.GetPixel(pixel), pixels);
+      pixels += PixelSize;
+    }
+  }
+}
+
+void CompositeDense(viskores::rendering::Compositor::CompositeMode mode,
+                    ImageBlock& result,
+                    const ImageBlock& image)
+{
+  for (viskores::Id pixel = result.Begin; pixel < result.End; ++pixel)
+  {
+    const viskores::Float32* imagePixel = image.GetPixel(pixel);
+    if (!IsEmpty(imagePixel))
+    {
+      CompositePixel(mode, result.GetPixel(pixel), imagePixel);
+    }
+  }
+}
+
+// Places the blocks so that the global ids of the blocks are their position in
+// visibility order. The partners of a round are then adjacent in that order.
+class VisibilityOrderAssigner : public viskoresdiy::StaticAssigner
+{
+public:
+  VisibilityOrderAssigner(const std::vector<int>& ranks)
+    : StaticAssigner(static_cast<int>(ranks.size()), static_cast<int>(ranks.size()))
+    , Ranks(ranks)
+    , Positions(ranks.size())
+  {
+    for (std::size_t position = 0; position < ranks.size(); ++position)
+    {
+      this->Positions[static_cast<std::size_t>(ranks[position])] = static_cast<int>(position);
+    }
+  }
+
+  int rank(int gid) const override { return this->Ranks[static_cast<std::size_t>(gid)]; }
+
+  void local_gids(int rank, std::vector<int>& gids) const override
+  {
+    gids.push_back(this->Positions[static_cast<std::size_t>(rank)]);
+  }
+
+private:
+  std::vector<int> Ranks;
+  std::vector<int> Positions;
+};
+
+} // anonymous namespace
+
+void Compositor::SetRadixK(viskores::IdComponent k)
+{
+  if (k < 2)
+  {
+    throw viskores::cont::ErrorBadValue("Compositor: radix k must be at least 2");
+  }
+  this->RadixK = k;
+}
+
+void Compositor::Composite(viskores::rendering::Canvas& canvas,
+                           viskores::Float64 visibilityDepth) const
+{
+  viskoresdiy::mpi::communicator comm = viskores::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.size() == 1)
+  {
+    return;
+  }
+
+  const viskores::Id numPixels = canvas.GetWidth() * canvas.GetHeight();
+  std::vector<viskores::Id> allNumPixels;
+  viskoresdiy::mpi::all_gather(comm, numPixels, allNumPixels);
+  if (std::any_of(allNumPixels.begin(),
+                  allNumPixels.end(),
+                  [&](viskores::Id size) { return size != numPixels; }))
+  {
+    throw viskores::cont::ErrorBadValue(
+      "Compositor: canvases of all ranks must have the same size");
+  }
+
+  std::vector<int> ranks(static_cast<std::size_t>(comm.size()));
+  std::iota(ranks.begin(), ranks.end(), 0);
+  if (this->Mode == CompositeMode::VisibilityOrder)
+  {
+    std::vector<viskores::Float64> depths;
+    viskoresdiy::mpi::all_gather(comm, visibilityDepth, depths);
+    std::stable_sort(ranks.begin(),
+                     ranks.end(),
+                     [&](int a, int b) {
+                       return depths[static_cast<std::size_t>(a)] <
+                         depths[static_cast<std::size_t>(b)];
+                     });
+  }
+
+  viskoresdiy::Master master(
+    comm,
+    1,
+    -1,
+    []() -> void* { return new ImageBlock(); },
+    [](void* ptr) { delete static_cast<ImageBlock*>(ptr); });
+  VisibilityOrderAssigner assigner(ranks);
+  std::vector<int> gids;
+  assigner.local_gids(comm.rank(), gids);
+
+  auto block = new ImageBlock();
+  block->End = numPixels;
+  block->Pixels.resize(static_cast<std::size_t>(numPixels) * PixelSize);
+  {
+    auto colorPortal = canvas.GetColorBuffer().ReadPortal();
+    auto depthPortal = canvas.GetDepthBuffer().ReadPortal();
+    for (viskores::Id pixel = 0; pixel < numPixels; ++pixel)
+    {
+      const viskores::Vec4f_32 color = colorPortal.Get(pixel);
+      viskores::Float32* blockPixel = block->GetPixel(pixel);
+      std::copy_n(&color[0], 4, blockPixel);
+      blockPixel[4] = depthPortal.Get(pixel);
+    }
+  }
+  master.add(gids[0], block, new viskoresdiy::Link);
+
+  const int k = (this->Algorithm == CompositeAlgorithm::BinarySwap) ? 2 : this->RadixK;
+  viskoresdiy::RegularDecomposer<viskoresdiy::DiscreteBounds> decomposer(
+    1, viskoresdiy::interval(0, comm.size() - 1), comm.size());
+  viskoresdiy::RegularSwapPartners partners(decomposer, k, /*contiguous*/ true);
+
+  const CompositeMode mode = this->Mode;
+  auto callback = [mode](ImageBlock* image,
+                         const viskoresdiy::ReduceProxy& srp,
+                         const viskoresdiy::RegularSwapPartners&)
+  {
+    // Composite the pieces of the group in visibility order. The partners are listed
+    // in the order of their global ids.
+    if (srp.in_link().size() > 0)
+    {
+      ImageBlock result;
+      result.Begin = image->Begin;
+      result.End = image->End;
+      ClearPixels(result);
+      for (int i = 0; i < srp.in_link().size(); ++i)
+      {
+        const int gid = srp.in_link().target(i).gid;
+        if (gid == srp.gid())
+        {
+          CompositeDense(mode, result, *image);
+        }
+        else
+        {
+          SparseImage piece;
+          srp.dequeue(gid, piece.Runs);
+          srp.dequeue(gid, piece.Pixels);
+          CompositeSparse(mode, result, piece);
+        }
+      }
+      *image = std::move(result);
+    }
+
+    // Split the part of the image among the next group and send the pieces.
+    const int groupSize = srp.out_link().size();
+    if (groupSize == 0)
+    {
+      return;
+    }
+    const viskores::Id begin = image->Begin;
+    const viskores::Id length = image->End - begin;
+    viskores::Id keepBegin = begin;
+    viskores::Id keepEnd = begin;
+    for (int i = 0; i < groupSize; ++i)
+    {
+      const viskores::Id pieceBegin = begin + (length * i) / groupSize;
+      const viskores::Id pieceEnd = begin + (length * (i + 1)) / groupSize;
+      const viskoresdiy::BlockID target = srp.out_link().target(i);
+      if (target.gid == srp.gid())
+      {
+        keepBegin = pieceBegin;
+        keepEnd = pieceEnd;
+      }
+      else
+      {
+        SparseImage piece = Compress(*image, pieceBegin, pieceEnd);
+        srp.enqueue(target, piece.Runs);
+        srp.enqueue(target, piece.Pixels);
+      }
+    }
+    image->Pixels.erase(image->Pixels.begin() +
+                          static_cast<std::ptrdiff_t>(keepEnd - begin) *
+                            static_cast<std::ptrdiff_t>(PixelSize),
+                        image->Pixels.end());
+    image->Pixels.erase(image->Pixels.begin(),
+                        image->Pixels.begin() +
+                          static_cast<std::ptrdiff_t>(keepBegin - begin) *
+                            static_cast<std::ptrdiff_t>(PixelSize));
+    image->Begin = keepBegin;
+    image->End = keepEnd;
+  };
+  viskoresdiy::reduce(master, assigner, partners, callback);
+
+  // Every rank now holds the final pixels of one part of the image. Collect them on
+  // rank 0. The messages start with the part of the image, so they are never empty.
+  const ImageBlock* result = master.block<ImageBlock>(0);
+  SparseImage piece = Compress(*result, result->Begin, result->End);
+  piece.Runs.insert(piece.Runs.begin(), { result->Begin, result->End });
+  piece.Pixels.insert(piece.Pixels.begin(), 0.f);
+  if (comm.rank() != 0)
+  {
+    viskoresdiy::mpi::gather(comm, piece.Runs, 0);
+    viskoresdiy::mpi::gather(comm, piece.Pixels, 0);
+    return;
+  }
+
+  std::vector<std::vector<viskores::Id>> allRuns;
+  std::vector<std::vector<viskores::Float32>> allPixels;
+  viskoresdiy::mpi::gather(comm, piece.Runs, allRuns, 0);
+  viskoresdiy::mpi::gather(comm, piece.Pixels, allPixels, 0);
+
+  // The parts of the image do not overlap, so their pixels are copied into place.
+  ImageBlock image;
+  image.End = numPixels;
+  ClearPixels(image);
+  for (std::size_t rank = 0; rank < allRuns.size(); ++rank)
+  {
+    const viskores::Float32* pixels = allPixels[rank].data() + 1;
+    for (std::size_t run = 2; run < allRuns[rank].size(); run += 2)
+    {
+      const std::size_t runLength = static_cast<std::size_t>(allRuns[rank][run + 1]);
+      std::copy_n(pixels, runLength * PixelSize, image.GetPixel(allRuns[rank][run]));
+      pixels += runLength * PixelSize;
+    }
+  }
+
+  auto colorPortal = canvas.GetColorBuffer().WritePortal();
+  auto depthPortal = canvas.GetDepthBuffer().WritePortal();
+  for (viskores::Id pixel = 0; pixel < numPixels; ++pixel)
+  {
+    const viskores::Float32* imagePixel = image.GetPixel(pixel);
+    colorPortal.Set(pixel,
+                    viskores::Vec4f_32(imagePixel[0], imagePixel[1], imagePixel[2], imagePixel[3]));
+    depthPortal.Set(pixel, imagePixel[4]);
+  }
+}
+
+}
+} // namespace viskores::rendering
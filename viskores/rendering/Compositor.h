@@ -0,0 +1,107 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#ifndef viskores_rendering_Compositor_h
+#define viskores_rendering_Compositor_h
+
+#include <viskores/rendering/viskores_rendering_export.h>
+
+#include <viskores/rendering/Canvas.h>
+
+namespace viskores
+{
+namespace rendering
+{
+
+/// @brief Composites the images rendered on all ranks into one image.
+///
+/// For sort-last parallel rendering, every rank renders its own part of the data into
+/// a `Canvas` of the same size with the same camera. `Compositor` combines the color
+/// and depth buffers of these canvases into the canvas of rank 0.
+///
+/// The image is composited with a radix-k exchange: in every round the ranks form groups
+/// of k, split the part of the image they are responsible for into k pieces, and each
+/// rank of a group composites one of the pieces. Binary swap is the special case of
+/// groups of 2. Only the pixels that something was rendered to are sent.
+///
+/// `Composite()` is called on all ranks of the communicator of
+/// `viskores::cont::EnvironmentTracker` after the render and before
+/// `Canvas::BlendBackground()`, which would make every pixel non-empty.
+class VISKORES_RENDERING_EXPORT Compositor
+{
+public:
+  /// @brief How the pixels of the ranks are combined.
+  enum struct CompositeMode
+  {
+    /// @brief The pixel closest to the camera is kept.
+    ///
+    /// Use this mode for opaque surfaces.
+    ZBuffer,
+    /// @brief The pixels are blended front to back with the "over" operator.
+    ///
+    /// Use this mode for volumes and other translucent renders. The images are ordered
+    /// by the visibility depth given to `Composite()`. The colors are expected to have
+    /// premultiplied alpha, as the mappers render them.
+    VisibilityOrder
+  };
+
+  /// @brief The communication pattern used to exchange the pieces of the image.
+  enum struct CompositeAlgorithm
+  {
+    /// @brief Ranks exchange halves of their part of the image in pairs.
+    BinarySwap,
+    /// @brief Ranks exchange pieces of their part of the image in groups of `GetRadixK()`.
+    RadixK
+  };
+
+  /// @brief Specifies how the pixels of the ranks are combined.
+  ///
+  /// The default is `CompositeMode::ZBuffer`.
+  VISKORES_CONT void SetCompositeMode(CompositeMode mode) { this->Mode = mode; }
+  /// @copydoc SetCompositeMode
+  VISKORES_CONT CompositeMode GetCompositeMode() const { return this->Mode; }
+
+  /// @brief Specifies the communication pattern.
+  ///
+  /// The default is `CompositeAlgorithm::RadixK`.
+  VISKORES_CONT void SetCompositeAlgorithm(CompositeAlgorithm algorithm)
+  {
+    this->Algorithm = algorithm;
+  }
+  /// @copydoc SetCompositeAlgorithm
+  VISKORES_CONT CompositeAlgorithm GetCompositeAlgorithm() const { return this->Algorithm; }
+
+  /// @brief Specifies the size of the groups of `CompositeAlgorithm::RadixK`.
+  ///
+  /// The number of ranks is factored into group sizes of at most k, so any number of
+  /// ranks is supported. Larger groups mean fewer rounds but more messages per round.
+  /// The default is 8.
+  VISKORES_CONT void SetRadixK(viskores::IdComponent k);
+  /// @copydoc SetRadixK
+  VISKORES_CONT viskores::IdComponent GetRadixK() const { return this->RadixK; }
+
+  /// @brief Composites the canvases of all ranks into the canvas of rank 0.
+  ///
+  /// All canvases must have the same size. The canvases of the other ranks are left
+  /// unchanged. `visibilityDepth` orders the images of the ranks front to back for
+  /// `CompositeMode::VisibilityOrder`. It is typically the distance from the camera to
+  /// the data rendered on the rank, which must not overlap the data of other ranks.
+  /// Ranks with equal depth are ordered by rank.
+  VISKORES_CONT void Composite(viskores::rendering::Canvas& canvas,
+                               viskores::Float64 visibilityDepth = 0) const;
+
+private:
+  CompositeMode Mode = CompositeMode::ZBuffer;
+  CompositeAlgorithm Algorithm = CompositeAlgorithm::RadixK;
+  viskores::IdComponent RadixK = 8;
+};
+
+}
+} // namespace viskores::rendering
+
+#endif //viskores_rendering_Compositor_h
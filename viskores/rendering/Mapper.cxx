@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <viskores/cont/BoundsCompute.h>
+#include <viskores/cont/ErrorBadValue.h>
 #include <viskores/rendering/Mapper.h>
 
 namespace viskores
@@ -55,6 +56,90 @@ void Mapper::RenderCells(const viskores::cont::UnknownCellSet& cellset,
   RenderCellsImpl(cellset, coords, scalarField, colorTable, camera, scalarRange, ghostField);
 };
 
+void Mapper::RenderCellsBatch(const viskores::cont::UnknownCellSet& cellset,
+                              const viskores::cont::CoordinateSystem& coords,
+                              const viskores::cont::Field& scalarField,
+                              const viskores::cont::ColorTable& colorTable,
+                              const std::vector<viskores::rendering::Camera>& cameras,
+                              const std::vector<viskores::rendering::Canvas*>& canvases,
+                              const viskores::Range& scalarRange)
+{
+  this->RenderCellsBatch(cellset,
+                         coords,
+                         scalarField,
+                         colorTable,
+                         cameras,
+                         canvases,
+                         scalarRange,
+                         make_FieldCell(viskores::cont::GetGlobalGhostCellFieldName(),
+                                        viskores::cont::ArrayHandleConstant<viskores::UInt8>(
+                                          0, cellset.GetNumberOfCells())));
+}
+
+void Mapper::RenderCellsBatch(const viskores::cont::UnknownCellSet& cellset,
+                              const viskores::cont::CoordinateSystem& coords,
+                              const viskores::cont::Field& scalarField,
+                              const viskores::cont::ColorTable& colorTable,
+                              const std::vector<viskores::rendering::Camera>& cameras,
+                              const std::vector<viskores::rendering::Canvas*>& canvases,
+                              const viskores::Range& scalarRange,
+                              const viskores::cont::Field& ghostField)
+{
+  if (cameras.size() != canvases.size())
+  {
+    throw viskores::cont::ErrorBadValue("Batch render needs one canvas for every camera.");
+  }
+
+  // The rays of a group of cameras are traced together. The groups are kept to a
+  // bounded number of pixels so that the rays of all the cameras are not in memory at once.
+  constexpr viskores::Id maxPixelsPerGroup = 1 << 22;
+  viskores::rendering::Canvas* canvas = this->GetCanvas();
+  std::size_t groupStart = 0;
+  while (groupStart < cameras.size())
+  {
+    std::size_t groupEnd = groupStart;
+    viskores::Id numPixels = 0;
+    do
+    {
+      numPixels += canvases[groupEnd]->GetWidth() * canvases[groupEnd]->GetHeight();
+      ++groupEnd;
+    } while ((groupEnd < cameras.size()) &&
+             (numPixels + canvases[groupEnd]->GetWidth() * canvases[groupEnd]->GetHeight() <=
+              maxPixelsPerGroup));
+
+    this->RenderCellsBatchImpl(
+      cellset,
+      coords,
+      scalarField,
+      colorTable,
+      std::vector<viskores::rendering::Camera>(cameras.begin() + groupStart,
+                                               cameras.begin() + groupEnd),
+      std::vector<viskores::rendering::Canvas*>(canvases.begin() + groupStart,
+                                                canvases.begin() + groupEnd),
+      scalarRange,
+      ghostField);
+    groupStart = groupEnd;
+  }
+  this->SetCanvas(canvas);
+}
+
+void Mapper::RenderCellsBatchImpl(const viskores::cont::UnknownCellSet& cellset,
+                                  const viskores::cont::CoordinateSystem& coords,
+                                  const viskores::cont::Field& scalarField,
+                                  const viskores::cont::ColorTable& colorTable,
+                                  const std::vector<viskores::rendering::Camera>& cameras,
+                                  const std::vector<viskores::rendering::Canvas*>& canvases,
+                                  const viskores::Range& scalarRange,
+                                  const viskores::cont::Field& ghostField)
+{
+  for (std::size_t i = 0; i < cameras.size(); ++i)
+  {
+    this->SetCanvas(canvases[i]);
+    this->RenderCellsImpl(
+      cellset, coords, scalarField, colorTable, cameras[i], scalarRange, ghostField);
+  }
+}
+
 struct CompareIndices
 {
   viskores::Vec3f CameraDirection;
@@ -25,6 +25,9 @@
 #include <viskores/cont/UnknownCellSet.h>
 #include <viskores/rendering/Camera.h>
 #include <viskores/rendering/Canvas.h>
+
+#include <vector>
+
 namespace viskores
 {
 namespace rendering
@@ -57,6 +60,30 @@ public:
                    const viskores::Range& scalarRange,
                    const viskores::cont::Field& ghostField);
 
+  /// @brief Renders the same cells from several cameras.
+  ///
+  /// The image of `cameras[i]` is rendered to `canvases[i]`, which gives the same images
+  /// as calling `RenderCells()` once per camera. Mappers that support it set up the data
+  /// once for all the cameras and trace the rays of several cameras together. The canvas
+  /// of the mapper is left unchanged.
+  void RenderCellsBatch(const viskores::cont::UnknownCellSet& cellset,
+                        const viskores::cont::CoordinateSystem& coords,
+                        const viskores::cont::Field& scalarField,
+                        const viskores::cont::ColorTable& colorTable,
+                        const std::vector<viskores::rendering::Camera>& cameras,
+                        const std::vector<viskores::rendering::Canvas*>& canvases,
+                        const viskores::Range& scalarRange);
+
+  /// @copydoc RenderCellsBatch
+  void RenderCellsBatch(const viskores::cont::UnknownCellSet& cellset,
+                        const viskores::cont::CoordinateSystem& coords,
+                        const viskores::cont::Field& scalarField,
+                        const viskores::cont::ColorTable& colorTable,
+                        const std::vector<viskores::rendering::Camera>& cameras,
+                        const std::vector<viskores::rendering::Canvas*>& canvases,
+                        const viskores::Range& scalarRange,
+                        const viskores::cont::Field& ghostField);
+
   virtual void RenderCellsPartitioned(const viskores::cont::PartitionedDataSet partitionedData,
                                       const std::string fieldName,
                                       const viskores::cont::ColorTable& colorTable,
@@ -89,6 +116,17 @@ protected:
                                const viskores::rendering::Camera& camera,
                                const viskores::Range& scalarRange,
                                const viskores::cont::Field& ghostField) = 0;
+
+  // Renders one group of the cameras given to RenderCellsBatch. The default renders the
+  // cameras one after the other with RenderCellsImpl.
+  virtual void RenderCellsBatchImpl(const viskores::cont::UnknownCellSet& cellset,
+                                    const viskores::cont::CoordinateSystem& coords,
+                                    const viskores::cont::Field& scalarField,
+                                    const viskores::cont::ColorTable& colorTable,
+                                    const std::vector<viskores::rendering::Camera>& cameras,
+                                    const std::vector<viskores::rendering::Canvas*>& canvases,
+                                    const viskores::Range& scalarRange,
+                                    const viskores::cont::Field& ghostField);
 };
 }
 } //namespace viskores::rendering
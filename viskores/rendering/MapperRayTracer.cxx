@@ -18,7 +18,9 @@
 
 #include <viskores/rendering/MapperRayTracer.h>
 
+#include <viskores/cont/ArrayHandleConstant.h>
 #include <viskores/cont/BoundsCompute.h>
+#include <viskores/cont/LocatorCache.h>
 #include <viskores/cont/Timer.h>
 #include <viskores/cont/TryExecute.h>
 
@@ -31,6 +33,9 @@
 #include <viskores/rendering/raytracing/SphereExtractor.h>
 #include <viskores/rendering/raytracing/SphereIntersector.h>
 #include <viskores/rendering/raytracing/TriangleExtractor.h>
+#include <viskores/rendering/raytracing/TriangleIntersector.h>
+
+#include <algorithm>
 
 namespace viskores
 {
@@ -41,15 +46,32 @@ struct MapperRayTracer::InternalsType
 {
   viskores::rendering::CanvasRayTracer* Canvas;
   viskores::rendering::raytracing::RayTracer Tracer;
-  viskores::rendering::raytracing::Camera RayCamera;
-  viskores::rendering::raytracing::Ray<viskores::Float32> Rays;
   bool CompositeBackground;
   bool Shade;
+  bool UsePacketTraversal;
+
+  // The triangles of recently rendered cells. When the same cells are rendered again,
+  // they are not extracted again and their BVH is reused or refit to moved points.
+  struct CacheEntry
+  {
+    viskores::cont::UnknownCellSet Cells;
+    viskores::cont::detail::LocatorCacheKey CellsKey;
+    raytracing::ArrayVersions GhostVersions;
+    viskores::UInt8 GhostValue;
+    std::shared_ptr<raytracing::TriangleIntersector> TriIntersector;
+    viskores::cont::ArrayHandle<viskores::Id4> Triangles;
+  };
+  // Ordered from the least to the most recently rendered.
+  std::vector<CacheEntry> Cache;
+  std::size_t CacheCapacity = 8;
+  viskores::Id NumberOfBVHBuilds = 0;
+
   VISKORES_CONT
   InternalsType()
     : Canvas(nullptr)
     , CompositeBackground(true)
     , Shade(true)
+    , UsePacketTraversal(false)
   {
   }
 };
@@ -88,10 +110,30 @@ viskores::rendering::Canvas* MapperRayTracer::GetCanvas() const
 void MapperRayTracer::RenderCellsImpl(const viskores::cont::UnknownCellSet& cellset,
                                       const viskores::cont::CoordinateSystem& coords,
                                       const viskores::cont::Field& scalarField,
-                                      const viskores::cont::ColorTable& viskoresNotUsed(colorTable),
+                                      const viskores::cont::ColorTable& colorTable,
                                       const viskores::rendering::Camera& camera,
                                       const viskores::Range& scalarRange,
                                       const viskores::cont::Field& ghostField)
+{
+  this->RenderCellsBatchImpl(cellset,
+                             coords,
+                             scalarField,
+                             colorTable,
+                             { camera },
+                             { this->Internals->Canvas },
+                             scalarRange,
+                             ghostField);
+}
+
+void MapperRayTracer::RenderCellsBatchImpl(
+  const viskores::cont::UnknownCellSet& cellset,
+  const viskores::cont::CoordinateSystem& coords,
+  const viskores::cont::Field& scalarField,
+  const viskores::cont::ColorTable& viskoresNotUsed(colorTable),
+  const std::vector<viskores::rendering::Camera>& cameras,
+  const std::vector<viskores::rendering::Canvas*>& canvases,
+  const viskores::Range& scalarRange,
+  const viskores::cont::Field& ghostField)
 {
   raytracing::Logger* logger = raytracing::Logger::GetInstance();
   logger->OpenLogEntry("mapper_ray_tracer");
@@ -105,13 +147,66 @@ void MapperRayTracer::RenderCellsImpl(const viskores::cont::UnknownCellSet& cell
   // Add supported shapes
   //
   viskores::Bounds shapeBounds;
-  raytracing::TriangleExtractor triExtractor;
-  triExtractor.ExtractCells(cellset, ghostField);
+  // The key of the cells alone: the coordinates only change the BVH, not the triangles.
+  viskores::cont::detail::LocatorCacheKey cellsKey(cellset, viskores::cont::CoordinateSystem{});
+  raytracing::ArrayVersions ghostVersions;
+  viskores::UInt8 ghostValue = 0;
+  using ConstantGhosts = viskores::cont::ArrayHandleConstant<viskores::UInt8>;
+  if (ghostField.GetData().IsType<ConstantGhosts>())
+  {
+    // Renders without ghost cells make a new constant array every time, so compare its value.
+    ghostValue = ghostField.GetData().AsArrayHandle<ConstantGhosts>().GetValue();
+  }
+  else
+  {
+    ghostVersions = raytracing::GetArrayVersions(ghostField.GetData());
+  }
+  auto& cache = this->Internals->Cache;
+  auto entry = std::find_if(cache.begin(),
+                            cache.end(),
+                            [&](const InternalsType::CacheEntry& candidate)
+                            {
+                              return (candidate.CellsKey == cellsKey) &&
+                                (candidate.GhostVersions == ghostVersions) &&
+                                (candidate.GhostValue == ghostValue);
+                            });
+  if (entry != cache.end())
+  {
+    std::rotate(entry, entry + 1, cache.end());
+  }
+  else
+  {
+    // Triangles extracted before the cells were modified are stale.
+    cache.erase(std::remove_if(cache.begin(),
+                               cache.end(),
+                               [&](const InternalsType::CacheEntry& candidate)
+                               {
+                                 return (candidate.CellsKey.CellSet == cellsKey.CellSet) &&
+                                   (candidate.CellsKey.Buffers == cellsKey.Buffers);
+                               }),
+                cache.end());
+    if (cache.size() >= this->Internals->CacheCapacity)
+    {
+      cache.erase(cache.begin());
+    }
+
+    raytracing::TriangleExtractor triExtractor;
+    triExtractor.ExtractCells(cellset, ghostField);
+    cache.push_back(InternalsType::CacheEntry{ cellset,
+                                               std::move(cellsKey),
+                                               std::move(ghostVersions),
+                                               ghostValue,
+                                               std::make_shared<raytracing::TriangleIntersector>(),
+                                               triExtractor.GetTriangles() });
+  }
 
-  if (triExtractor.GetNumberOfTriangles() > 0)
+  if (cache.back().Triangles.GetNumberOfValues() > 0)
   {
-    auto triIntersector = std::make_shared<raytracing::TriangleIntersector>();
-    triIntersector->SetData(coords, triExtractor.GetTriangles());
+    auto& triIntersector = cache.back().TriIntersector;
+    const viskores::Id numBuilds = triIntersector->GetNumberOfBVHBuilds();
+    triIntersector->SetData(coords, cache.back().Triangles);
+    this->Internals->NumberOfBVHBuilds += triIntersector->GetNumberOfBVHBuilds() - numBuilds;
+    triIntersector->SetUsePacketTraversal(this->Internals->UsePacketTraversal);
     this->Internals->Tracer.AddShapeIntersector(triIntersector);
     shapeBounds.Include(triIntersector->GetShapeBounds());
   }
@@ -119,30 +214,50 @@ void MapperRayTracer::RenderCellsImpl(const viskores::cont::UnknownCellSet& cell
   //
   // Create rays
   //
-  viskores::Int32 width = (viskores::Int32)this->Internals->Canvas->GetWidth();
-  viskores::Int32 height = (viskores::Int32)this->Internals->Canvas->GetHeight();
-
-  this->Internals->RayCamera = camera.CreateRaytracingCamera(width, height);
+  std::vector<raytracing::Camera> rayCameras;
+  std::vector<raytracing::Ray<viskores::Float32>> rays(cameras.size());
+  std::vector<viskores::Id> numRays;
+  for (std::size_t i = 0; i < cameras.size(); ++i)
+  {
+    this->SetCanvas(canvases[i]);
+    viskores::Int32 width = (viskores::Int32)this->Internals->Canvas->GetWidth();
+    viskores::Int32 height = (viskores::Int32)this->Internals->Canvas->GetHeight();
 
-  this->Internals->RayCamera.CreateRays(this->Internals->Rays, shapeBounds);
-  this->Internals->Tracer.GetCamera() = this->Internals->RayCamera;
-  this->Internals->Rays.Buffers.at(0).InitConst(0.f);
-  raytracing::RayOperations::MapCanvasToRays(
-    this->Internals->Rays, camera.CreateRaytracingCamera(width, height), *this->Internals->Canvas);
+    rayCameras.push_back(cameras[i].CreateRaytracingCamera(width, height));
+    rayCameras.back().CreateRays(rays[i], shapeBounds);
+    rays[i].Buffers.at(0).InitConst(0.f);
+    raytracing::RayOperations::MapCanvasToRays(
+      rays[i], rayCameras.back(), *this->Internals->Canvas);
+    numRays.push_back(rays[i].NumRays);
+  }
 
   this->Internals->Tracer.SetField(scalarField, scalarRange);
 
   this->Internals->Tracer.SetColorMap(this->ColorMap);
   this->Internals->Tracer.SetShadingOn(this->Internals->Shade);
-  this->Internals->Tracer.Render(this->Internals->Rays);
+  if (rays.size() == 1)
+  {
+    this->Internals->Tracer.Render(rays[0], rayCameras, numRays);
+  }
+  else
+  {
+    // Trace the rays of all the cameras together.
+    raytracing::Ray<viskores::Float32> combined;
+    raytracing::RayOperations::Concatenate(rays, combined);
+    this->Internals->Tracer.Render(combined, rayCameras, numRays);
+    raytracing::RayOperations::Split(combined, rays);
+  }
 
   timer.Start();
-  this->Internals->Canvas->WriteToCanvas(
-    this->Internals->Rays, this->Internals->Rays.Buffers.at(0).Buffer, camera);
-
-  if (this->Internals->CompositeBackground)
+  for (std::size_t i = 0; i < cameras.size(); ++i)
   {
-    this->Internals->Canvas->BlendBackground();
+    this->SetCanvas(canvases[i]);
+    this->Internals->Canvas->WriteToCanvas(rays[i], rays[i].Buffers.at(0).Buffer, cameras[i]);
+
+    if (this->Internals->CompositeBackground)
+    {
+      this->Internals->Canvas->BlendBackground();
+    }
   }
 
   viskores::Float64 time = timer.GetElapsedTime();
@@ -161,6 +276,28 @@ void MapperRayTracer::SetShadingOn(bool on)
   this->Internals->Shade = on;
 }
 
+void MapperRayTracer::SetUsePacketTraversal(bool on)
+{
+  this->Internals->UsePacketTraversal = on;
+}
+
+void MapperRayTracer::SetCacheCapacity(std::size_t capacity)
+{
+  auto& cache = this->Internals->Cache;
+  this->Internals->CacheCapacity = std::max(capacity, std::size_t{ 1 });
+  if (cache.size() > this->Internals->CacheCapacity)
+  {
+    cache.erase(cache.begin(),
+                cache.begin() +
+                  static_cast<std::ptrdiff_t>(cache.size() - this->Internals->CacheCapacity));
+  }
+}
+
+viskores::Id MapperRayTracer::GetNumberOfBVHBuilds() const
+{
+  return this->Internals->NumberOfBVHBuilds;
+}
+
 viskores::rendering::Mapper* MapperRayTracer::NewCopy() const
 {
   return new viskores::rendering::MapperRayTracer(*this);
@@ -46,6 +46,21 @@ public:
   void SetCompositeBackground(bool on);
   viskores::rendering::Mapper* NewCopy() const override;
   void SetShadingOn(bool on);
+  /// @brief Trace groups of neighboring rays together.
+  ///
+  /// This is faster on CPU devices, but slower on GPUs. It is off by default.
+  void SetUsePacketTraversal(bool on);
+
+  /// @brief Set the number of cell sets whose triangles and BVH are kept between renders.
+  ///
+  /// A `Scene` renders all of its actors with the same mapper, so the mapper keeps the
+  /// triangles and BVH of several cell sets. When the cache is full, the cell set rendered
+  /// least recently is dropped. The default is 8.
+  void SetCacheCapacity(std::size_t capacity);
+  /// @brief The number of BVHs the mapper has built.
+  ///
+  /// A cached BVH that is refit to moved points is not counted.
+  viskores::Id GetNumberOfBVHBuilds() const;
 
 private:
   struct InternalsType;
@@ -59,6 +74,15 @@ private:
                        const viskores::rendering::Camera& camera,
                        const viskores::Range& scalarRange,
                        const viskores::cont::Field& ghostField) override;
+
+  void RenderCellsBatchImpl(const viskores::cont::UnknownCellSet& cellset,
+                            const viskores::cont::CoordinateSystem& coords,
+                            const viskores::cont::Field& scalarField,
+                            const viskores::cont::ColorTable& colorTable,
+                            const std::vector<viskores::rendering::Camera>& cameras,
+                            const std::vector<viskores::rendering::Canvas*>& canvases,
+                            const viskores::Range& scalarRange,
+                            const viskores::cont::Field& ghostField) override;
 };
 }
 } //namespace viskores::rendering
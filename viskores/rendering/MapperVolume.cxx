@@ -41,6 +41,8 @@ struct MapperVolume::InternalsType
   viskores::rendering::CanvasRayTracer* Canvas;
   viskores::Float32 SampleDistance;
   bool CompositeBackground;
+  // Kept between renders so that it reuses what it computed for unchanged data.
+  viskores::rendering::raytracing::VolumeRendererStructured Tracer;
 
   VISKORES_CONT
   InternalsType()
@@ -83,10 +85,30 @@ viskores::rendering::Canvas* MapperVolume::GetCanvas() const
 void MapperVolume::RenderCellsImpl(const viskores::cont::UnknownCellSet& cellset,
                                    const viskores::cont::CoordinateSystem& coords,
                                    const viskores::cont::Field& scalarField,
-                                   const viskores::cont::ColorTable& viskoresNotUsed(colorTable),
+                                   const viskores::cont::ColorTable& colorTable,
                                    const viskores::rendering::Camera& camera,
                                    const viskores::Range& scalarRange,
-                                   const viskores::cont::Field& viskoresNotUsed(ghostField))
+                                   const viskores::cont::Field& ghostField)
+{
+  this->RenderCellsBatchImpl(cellset,
+                             coords,
+                             scalarField,
+                             colorTable,
+                             { camera },
+                             { this->Internals->Canvas },
+                             scalarRange,
+                             ghostField);
+}
+
+void MapperVolume::RenderCellsBatchImpl(
+  const viskores::cont::UnknownCellSet& cellset,
+  const viskores::cont::CoordinateSystem& coords,
+  const viskores::cont::Field& scalarField,
+  const viskores::cont::ColorTable& viskoresNotUsed(colorTable),
+  const std::vector<viskores::rendering::Camera>& cameras,
+  const std::vector<viskores::rendering::Canvas*>& canvases,
+  const viskores::Range& scalarRange,
+  const viskores::cont::Field& viskoresNotUsed(ghostField))
 {
   if (!cellset.CanConvert<viskores::cont::CellSetStructured<3>>())
   {
@@ -104,18 +126,21 @@ void MapperVolume::RenderCellsImpl(const viskores::cont::UnknownCellSet& cellset
     tot_timer.Start();
     viskores::cont::Timer timer;
 
-    viskores::rendering::raytracing::VolumeRendererStructured tracer;
+    viskores::rendering::raytracing::VolumeRendererStructured& tracer = this->Internals->Tracer;
 
-    viskores::Int32 width = (viskores::Int32)this->Internals->Canvas->GetWidth();
-    viskores::Int32 height = (viskores::Int32)this->Internals->Canvas->GetHeight();
-    viskores::rendering::raytracing::Camera rayCamera =
-      camera.CreateRaytracingCamera(width, height);
-
-    viskores::rendering::raytracing::Ray<viskores::Float32> rays;
-    rayCamera.CreateRays(rays, coords.GetBounds());
-    rays.Buffers.at(0).InitConst(0.f);
-    raytracing::RayOperations::MapCanvasToRays(
-      rays, camera.CreateRaytracingCamera(width, height), *this->Internals->Canvas);
+    std::vector<viskores::rendering::raytracing::Ray<viskores::Float32>> rays(cameras.size());
+    for (std::size_t i = 0; i < cameras.size(); ++i)
+    {
+      this->SetCanvas(canvases[i]);
+      viskores::Int32 width = (viskores::Int32)this->Internals->Canvas->GetWidth();
+      viskores::Int32 height = (viskores::Int32)this->Internals->Canvas->GetHeight();
+      viskores::rendering::raytracing::Camera rayCamera =
+        cameras[i].CreateRaytracingCamera(width, height);
+
+      rayCamera.CreateRays(rays[i], coords.GetBounds());
+      rays[i].Buffers.at(0).InitConst(0.f);
+      raytracing::RayOperations::MapCanvasToRays(rays[i], rayCamera, *this->Internals->Canvas);
+    }
 
 
     if (this->Internals->SampleDistance != DEFAULT_SAMPLE_DISTANCE)
@@ -127,14 +152,30 @@ void MapperVolume::RenderCellsImpl(const viskores::cont::UnknownCellSet& cellset
       coords, scalarField, cellset.AsCellSet<viskores::cont::CellSetStructured<3>>(), scalarRange);
     tracer.SetColorMap(this->ColorMap);
 
-    tracer.Render(rays);
+    if (rays.size() == 1)
+    {
+      tracer.Render(rays[0]);
+    }
+    else
+    {
+      // Trace the rays of all the cameras together.
+      viskores::rendering::raytracing::Ray<viskores::Float32> combined;
+      raytracing::RayOperations::Concatenate(rays, combined);
+      tracer.Render(combined);
+      raytracing::RayOperations::Split(combined, rays);
+    }
 
     timer.Start();
-    this->Internals->Canvas->WriteToCanvas(rays, rays.Buffers.at(0).Buffer, camera, true);
-
-    if (this->Internals->CompositeBackground)
+    for (std::size_t i = 0; i < cameras.size(); ++i)
     {
-      this->Internals->Canvas->BlendBackground();
+      this->SetCanvas(canvases[i]);
+      this->Internals->Canvas->WriteToCanvas(
+        rays[i], rays[i].Buffers.at(0).Buffer, cameras[i], true);
+
+      if (this->Internals->CompositeBackground)
+      {
+        this->Internals->Canvas->BlendBackground();
+      }
     }
     viskores::Float64 time = timer.GetElapsedTime();
     logger->AddLogData("write_to_canvas", time);
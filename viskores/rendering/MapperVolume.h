@@ -58,6 +58,15 @@ private:
                                const viskores::rendering::Camera& camera,
                                const viskores::Range& scalarRange,
                                const viskores::cont::Field& ghostField) override;
+
+  virtual void RenderCellsBatchImpl(const viskores::cont::UnknownCellSet& cellset,
+                                    const viskores::cont::CoordinateSystem& coords,
+                                    const viskores::cont::Field& scalarField,
+                                    const viskores::cont::ColorTable&, //colorTable
+                                    const std::vector<viskores::rendering::Camera>& cameras,
+                                    const std::vector<viskores::rendering::Canvas*>& canvases,
+                                    const viskores::Range& scalarRange,
+                                    const viskores::cont::Field& ghostField) override;
 };
 }
 } //namespace viskores::rendering
@@ -60,6 +60,16 @@ void Scene::Render(viskores::rendering::Mapper& mapper,
   }
 }
 
+void Scene::Render(viskores::rendering::Mapper& mapper,
+                   const std::vector<viskores::rendering::Canvas*>& canvases,
+                   const std::vector<viskores::rendering::Camera>& cameras) const
+{
+  for (const auto& actor : this->Internals->Actors)
+  {
+    actor.Render(mapper, canvases, cameras);
+  }
+}
+
 viskores::Bounds Scene::GetSpatialBounds() const
 {
   viskores::Bounds bounds;
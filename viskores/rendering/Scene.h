@@ -26,6 +26,7 @@
 #include <viskores/rendering/Mapper.h>
 
 #include <memory>
+#include <vector>
 
 namespace viskores
 {
@@ -53,6 +54,15 @@ public:
               viskores::rendering::Canvas& canvas,
               const viskores::rendering::Camera& camera) const;
 
+  /// @brief Renders the scene from several cameras, each into the canvas with its index.
+  ///
+  /// This gives the same images as calling `Render()` for every camera, but mappers
+  /// that support it share the setup of the data across the cameras and trace their rays
+  /// together, which is much faster when rendering many views of the same scene.
+  void Render(viskores::rendering::Mapper& mapper,
+              const std::vector<viskores::rendering::Canvas*>& canvases,
+              const std::vector<viskores::rendering::Camera>& cameras) const;
+
   /// @brief The computed spatial bounds of combined data from all contained `Actor`s.
   viskores::Bounds GetSpatialBounds() const;
 
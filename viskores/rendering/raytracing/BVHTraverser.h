@@ -22,6 +22,7 @@
 #include <viskores/rendering/raytracing/Ray.h>
 #include <viskores/rendering/raytracing/RayTracingTypeDefs.h>
 
+#include <viskores/cont/ArrayHandleIndex.h>
 #include <viskores/worklet/DispatcherMapField.h>
 #include <viskores/worklet/WorkletMapField.h>
 
@@ -230,12 +231,388 @@ public:
   };
 
 
+  // Traces packets of consecutive rays together. Primary rays of a camera are made in
+  // pixel order, so the rays of a packet go through neighboring pixels and mostly visit the
+  // same nodes. Each node is first tested against bounds of the whole packet, which rejects
+  // most of the nodes that no ray of the packet hits, and only then against every ray of the
+  // packet. These per-ray loops have a fixed length so that the compiler can vectorize them.
+  class PacketIntersector : public viskores::worklet::WorkletMapField
+  {
+  public:
+    static constexpr viskores::IdComponent PacketSize = 16;
+    using LaneMask = viskores::UInt32;
+
+  private:
+    VISKORES_EXEC
+    static inline viskores::Float32 rcp_safe(viskores::Float32 f)
+    {
+      return 1.0f / ((viskores::Abs(f) < 1e-8f) ? 1e-8f : f);
+    }
+    VISKORES_EXEC
+    static inline viskores::Float64 rcp_safe(viskores::Float64 f)
+    {
+      return 1.0 / ((viskores::Abs(f) < 1e-8f) ? 1e-8f : f);
+    }
+
+    template <typename Precision>
+    struct Packet
+    {
+      viskores::Vec<Precision, 3> Origin[PacketSize];
+      viskores::Vec<Precision, 3> Dir[PacketSize];
+      Precision InvDir[3][PacketSize];
+      Precision OriginDir[3][PacketSize];
+      Precision MinDistance[PacketSize];
+      Precision ClosestDistance[PacketSize];
+      Precision MinU[PacketSize];
+      Precision MinV[PacketSize];
+      viskores::Id HitIndex[PacketSize];
+      // Bounds of InvDir and OriginDir over the rays of the packet.
+      viskores::Vec<Precision, 3> InvDirLow;
+      viskores::Vec<Precision, 3> InvDirHigh;
+      viskores::Vec<Precision, 3> OriginDirLow;
+      viskores::Vec<Precision, 3> OriginDirHigh;
+      Precision PacketMinDistance;
+    };
+
+    // Whether any ray of the packet can hit the box before maxDistance. The distances to
+    // the planes of the box are bounded over all the rays with interval arithmetic, using
+    // the same operations as the test of a single ray so that the bounds hold exactly.
+    template <typename Precision>
+    VISKORES_EXEC static bool PacketMayHit(const Packet<Precision>& packet,
+                                           const viskores::Vec<Precision, 3>& boxMin,
+                                           const viskores::Vec<Precision, 3>& boxMax,
+                                           const Precision& maxDistance)
+    {
+      Precision entry = packet.PacketMinDistance;
+      Precision exit = maxDistance;
+      for (viskores::IdComponent axis = 0; axis < 3; ++axis)
+      {
+        const Precision minLow = viskores::Min(boxMin[axis] * packet.InvDirLow[axis],
+                                               boxMin[axis] * packet.InvDirHigh[axis]) -
+          packet.OriginDirHigh[axis];
+        const Precision minHigh = viskores::Max(boxMin[axis] * packet.InvDirLow[axis],
+                                                boxMin[axis] * packet.InvDirHigh[axis]) -
+          packet.OriginDirLow[axis];
+        const Precision maxLow = viskores::Min(boxMax[axis] * packet.InvDirLow[axis],
+                                               boxMax[axis] * packet.InvDirHigh[axis]) -
+          packet.OriginDirHigh[axis];
+        const Precision maxHigh = viskores::Max(boxMax[axis] * packet.InvDirLow[axis],
+                                                boxMax[axis] * packet.InvDirHigh[axis]) -
+          packet.OriginDirLow[axis];
+        entry = viskores::Max(entry, viskores::Min(minLow, maxLow));
+        exit = viskores::Min(exit, viskores::Max(minHigh, maxHigh));
+      }
+      return exit >= entry;
+    }
+
+    // Finds the rays of the mask that hit each child of the node, as IntersectAABB does
+    // for a single ray.
+    template <typename BVHPortalType, typename Precision>
+    VISKORES_EXEC static void IntersectChildren(const BVHPortalType& bvh,
+                                                const viskores::Int32& currentNode,
+                                                const Packet<Precision>& packet,
+                                                const LaneMask& mask,
+                                                LaneMask& hitLeftChild,
+                                                LaneMask& hitRightChild,
+                                                bool& rightCloser)
+    {
+      hitLeftChild = 0;
+      hitRightChild = 0;
+      rightCloser = false;
+
+      const viskores::Vec4f_32 first4 = bvh.Get(currentNode);
+      const viskores::Vec4f_32 second4 = bvh.Get(currentNode + 1);
+      const viskores::Vec4f_32 third4 = bvh.Get(currentNode + 2);
+      const viskores::Vec<Precision, 3> leftMin(first4[0], first4[1], first4[2]);
+      const viskores::Vec<Precision, 3> leftMax(first4[3], second4[0], second4[1]);
+      const viskores::Vec<Precision, 3> rightMin(second4[2], second4[3], third4[0]);
+      const viskores::Vec<Precision, 3> rightMax(third4[1], third4[2], third4[3]);
+
+      Precision maxDistance = 0;
+      for (viskores::IdComponent lane = 0; lane < PacketSize; ++lane)
+      {
+        if ((mask >> lane) & 1)
+        {
+          maxDistance = viskores::Max(maxDistance, packet.ClosestDistance[lane]);
+        }
+      }
+      if (!PacketMayHit(packet, leftMin, leftMax, maxDistance) &&
+          !PacketMayHit(packet, rightMin, rightMax, maxDistance))
+      {
+        return;
+      }
+
+      Precision min0[PacketSize];
+      Precision min1[PacketSize];
+      bool hit0[PacketSize];
+      bool hit1[PacketSize];
+      for (viskores::IdComponent lane = 0; lane < PacketSize; ++lane)
+      {
+        const Precision xmin0 = leftMin[0] * packet.InvDir[0][lane] - packet.OriginDir[0][lane];
+        const Precision ymin0 = leftMin[1] * packet.InvDir[1][lane] - packet.OriginDir[1][lane];
+        const Precision zmin0 = leftMin[2] * packet.InvDir[2][lane] - packet.OriginDir[2][lane];
+        const Precision xmax0 = leftMax[0] * packet.InvDir[0][lane] - packet.OriginDir[0][lane];
+        const Precision ymax0 = leftMax[1] * packet.InvDir[1][lane] - packet.OriginDir[1][lane];
+        const Precision zmax0 = leftMax[2] * packet.InvDir[2][lane] - packet.OriginDir[2][lane];
+        min0[lane] = viskores::Max(
+          viskores::Max(viskores::Max(viskores::Min(ymin0, ymax0), viskores::Min(xmin0, xmax0)),
+                        viskores::Min(zmin0, zmax0)),
+          packet.MinDistance[lane]);
+        const Precision max0 = viskores::Min(
+          viskores::Min(viskores::Min(viskores::Max(ymin0, ymax0), viskores::Max(xmin0, xmax0)),
+                        viskores::Max(zmin0, zmax0)),
+          packet.ClosestDistance[lane]);
+        hit0[lane] = (max0 >= min0[lane]);
+
+        const Precision xmin1 = rightMin[0] * packet.InvDir[0][lane] - packet.OriginDir[0][lane];
+        const Precision ymin1 = rightMin[1] * packet.InvDir[1][lane] - packet.OriginDir[1][lane];
+        const Precision zmin1 = rightMin[2] * packet.InvDir[2][lane] - packet.OriginDir[2][lane];
+        const Precision xmax1 = rightMax[0] * packet.InvDir[0][lane] - packet.OriginDir[0][lane];
+        const Precision ymax1 = rightMax[1] * packet.InvDir[1][lane] - packet.OriginDir[1][lane];
+        const Precision zmax1 = rightMax[2] * packet.InvDir[2][lane] - packet.OriginDir[2][lane];
+        min1[lane] = viskores::Max(
+          viskores::Max(viskores::Max(viskores::Min(ymin1, ymax1), viskores::Min(xmin1, xmax1)),
+                        viskores::Min(zmin1, zmax1)),
+          packet.MinDistance[lane]);
+        const Precision max1 = viskores::Min(
+          viskores::Min(viskores::Min(viskores::Max(ymin1, ymax1), viskores::Max(xmin1, xmax1)),
+                        viskores::Max(zmin1, zmax1)),
+          packet.ClosestDistance[lane]);
+        hit1[lane] = (max1 >= min1[lane]);
+      }
+
+      for (viskores::IdComponent lane = 0; lane < PacketSize; ++lane)
+      {
+        hitLeftChild |= static_cast<LaneMask>(hit0[lane]) << lane;
+        hitRightChild |= static_cast<LaneMask>(hit1[lane]) << lane;
+      }
+      hitLeftChild &= mask;
+      hitRightChild &= mask;
+
+      // The order of the children is taken from the first ray that hits both.
+      for (viskores::IdComponent lane = 0; lane < PacketSize; ++lane)
+      {
+        if ((hitLeftChild & hitRightChild) & (LaneMask(1) << lane))
+        {
+          rightCloser = (min0[lane] > min1[lane]);
+          break;
+        }
+      }
+    }
+
+  public:
+    VISKORES_CONT
+    PacketIntersector() {}
+    using ControlSignature = void(FieldIn,
+                                  WholeArrayIn,
+                                  WholeArrayIn,
+                                  WholeArrayOut,
+                                  WholeArrayIn,
+                                  WholeArrayIn,
+                                  WholeArrayOut,
+                                  WholeArrayOut,
+                                  WholeArrayOut,
+                                  WholeArrayIn,
+                                  ExecObject leafIntersector,
+                                  WholeArrayIn,
+                                  WholeArrayIn);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13);
+
+    template <typename DirPortalType,
+              typename OriginPortalType,
+              typename DistancePortalType,
+              typename RangePortalType,
+              typename UVPortalType,
+              typename HitPortalType,
+              typename PointPortalType,
+              typename LeafType,
+              typename InnerNodePortalType,
+              typename LeafPortalType>
+    VISKORES_EXEC void operator()(const viskores::Id& packetIndex,
+                                  const DirPortalType& dirs,
+                                  const OriginPortalType& origins,
+                                  DistancePortalType& distances,
+                                  const RangePortalType& minDistances,
+                                  const RangePortalType& maxDistances,
+                                  UVPortalType& us,
+                                  UVPortalType& vs,
+                                  HitPortalType& hitIndices,
+                                  const PointPortalType& points,
+                                  LeafType& leafIntersector,
+                                  const InnerNodePortalType& flatBVH,
+                                  const LeafPortalType& leafs) const
+    {
+      using Precision = typename DistancePortalType::ValueType;
+      const viskores::Id firstRay = packetIndex * PacketSize;
+      const viskores::Id numLanes =
+        viskores::Min(viskores::Id(PacketSize), distances.GetNumberOfValues() - firstRay);
+
+      // Lanes past the last ray repeat it, so that the per-ray loops have a fixed length.
+      Packet<Precision> packet;
+      LaneMask active = 0;
+      for (viskores::IdComponent lane = 0; lane < PacketSize; ++lane)
+      {
+        const viskores::Id ray = firstRay + viskores::Min(viskores::Id(lane), numLanes - 1);
+        active |= static_cast<LaneMask>(lane < numLanes) << lane;
+        packet.Origin[lane] = origins.Get(ray);
+        packet.Dir[lane] = dirs.Get(ray);
+        for (viskores::IdComponent axis = 0; axis < 3; ++axis)
+        {
+          packet.InvDir[axis][lane] = rcp_safe(packet.Dir[lane][axis]);
+          packet.OriginDir[axis][lane] = packet.Origin[lane][axis] * packet.InvDir[axis][lane];
+        }
+        packet.MinDistance[lane] = minDistances.Get(ray);
+        packet.ClosestDistance[lane] = maxDistances.Get(ray);
+        packet.MinU[lane] = 0;
+        packet.MinV[lane] = 0;
+        packet.HitIndex[lane] = -1;
+      }
+
+      packet.PacketMinDistance = packet.MinDistance[0];
+      for (viskores::IdComponent axis = 0; axis < 3; ++axis)
+      {
+        packet.InvDirLow[axis] = packet.InvDirHigh[axis] = packet.InvDir[axis][0];
+        packet.OriginDirLow[axis] = packet.OriginDirHigh[axis] = packet.OriginDir[axis][0];
+      }
+      for (viskores::IdComponent lane = 1; lane < PacketSize; ++lane)
+      {
+        packet.PacketMinDistance =
+          viskores::Min(packet.PacketMinDistance, packet.MinDistance[lane]);
+        for (viskores::IdComponent axis = 0; axis < 3; ++axis)
+        {
+          packet.InvDirLow[axis] = viskores::Min(packet.InvDirLow[axis], packet.InvDir[axis][lane]);
+          packet.InvDirHigh[axis] =
+            viskores::Max(packet.InvDirHigh[axis], packet.InvDir[axis][lane]);
+          packet.OriginDirLow[axis] =
+            viskores::Min(packet.OriginDirLow[axis], packet.OriginDir[axis][lane]);
+          packet.OriginDirHigh[axis] =
+            viskores::Max(packet.OriginDirHigh[axis], packet.OriginDir[axis][lane]);
+        }
+      }
+
+      // Along with each node, the stack holds the rays that may hit it.
+      viskores::Int32 todo[64];
+      LaneMask todoMask[64];
+      viskores::Int32 stackptr = 0;
+      viskores::Int32 barrier = (viskores::Int32)END_FLAG;
+      viskores::Int32 currentNode = 0;
+      LaneMask currentMask = active;
+
+      todo[stackptr] = barrier;
+      todoMask[stackptr] = 0;
+
+      while (currentNode != END_FLAG)
+      {
+        if (currentNode > -1)
+        {
+          LaneMask hitLeftChild, hitRightChild;
+          bool rightCloser;
+          IntersectChildren(
+            flatBVH, currentNode, packet, currentMask, hitLeftChild, hitRightChild, rightCloser);
+
+          if (!hitLeftChild && !hitRightChild)
+          {
+            currentNode = todo[stackptr];
+            currentMask = todoMask[stackptr];
+            stackptr--;
+          }
+          else
+          {
+            viskores::Vec4f_32 children = flatBVH.Get(currentNode + 3);
+            viskores::Int32 leftChild;
+            memcpy(&leftChild, &children[0], 4);
+            viskores::Int32 rightChild;
+            memcpy(&rightChild, &children[1], 4);
+            currentNode = (hitLeftChild) ? leftChild : rightChild;
+            currentMask = (hitLeftChild) ? hitLeftChild : hitRightChild;
+            if (hitLeftChild && hitRightChild)
+            {
+              stackptr++;
+              if (rightCloser)
+              {
+                currentNode = rightChild;
+                currentMask = hitRightChild;
+                todo[stackptr] = leftChild;
+                todoMask[stackptr] = hitLeftChild;
+              }
+              else
+              {
+                todo[stackptr] = rightChild;
+                todoMask[stackptr] = hitRightChild;
+              }
+            }
+          }
+        } // if inner node
+
+        if (currentNode < 0 && currentNode != barrier)
+        {
+          currentNode = -currentNode - 1; //swap the neg address
+          for (viskores::IdComponent lane = 0; lane < PacketSize; ++lane)
+          {
+            if ((currentMask >> lane) & 1)
+            {
+              leafIntersector.IntersectLeaf(currentNode,
+                                            packet.Origin[lane],
+                                            packet.Dir[lane],
+                                            points,
+                                            packet.HitIndex[lane],
+                                            packet.ClosestDistance[lane],
+                                            packet.MinU[lane],
+                                            packet.MinV[lane],
+                                            leafs,
+                                            packet.MinDistance[lane]);
+            }
+          }
+          currentNode = todo[stackptr];
+          currentMask = todoMask[stackptr];
+          stackptr--;
+        } // if leaf node
+
+      } //while
+
+      for (viskores::IdComponent lane = 0; lane < numLanes; ++lane)
+      {
+        const viskores::Id ray = firstRay + lane;
+        distances.Set(ray, packet.ClosestDistance[lane]);
+        us.Set(ray, packet.MinU[lane]);
+        vs.Set(ray, packet.MinV[lane]);
+        hitIndices.Set(ray, packet.HitIndex[lane]);
+      }
+    } // ()
+  };
+
+  // usePackets selects PacketIntersector, which is faster for the coherent primary rays of
+  // a camera on CPU devices.
   template <typename Precision, typename LeafIntersectorType>
   VISKORES_CONT void IntersectRays(Ray<Precision>& rays,
                                    LinearBVH& bvh,
                                    LeafIntersectorType& leafIntersector,
-                                   viskores::cont::CoordinateSystem& coordsHandle)
+                                   viskores::cont::CoordinateSystem& coordsHandle,
+                                   bool usePackets = false)
   {
+    if (usePackets)
+    {
+      const viskores::Id numPackets =
+        (rays.NumRays + PacketIntersector::PacketSize - 1) / PacketIntersector::PacketSize;
+      rays.U.Allocate(rays.NumRays);
+      rays.V.Allocate(rays.NumRays);
+      viskores::worklet::DispatcherMapField<PacketIntersector> packetDispatch;
+      packetDispatch.Invoke(viskores::cont::ArrayHandleIndex(numPackets),
+                            rays.Dir,
+                            rays.Origin,
+                            rays.Distance,
+                            rays.MinDistance,
+                            rays.MaxDistance,
+                            rays.U,
+                            rays.V,
+                            rays.HitIdx,
+                            coordsHandle,
+                            leafIntersector,
+                            bvh.FlatBVH,
+                            bvh.Leafs);
+      return;
+    }
+
     viskores::worklet::DispatcherMapField<Intersector> intersectDispatch;
     intersectDispatch.Invoke(rays.Dir,
                              rays.Origin,
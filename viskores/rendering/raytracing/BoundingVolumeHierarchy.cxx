@@ -22,6 +22,7 @@
 #include <viskores/VectorAnalysis.h>
 
 #include <viskores/cont/Algorithm.h>
+#include <viskores/cont/ArrayHandleIndex.h>
 #include <viskores/cont/DeviceAdapter.h>
 #include <viskores/cont/DeviceAdapterAlgorithm.h>
 #include <viskores/cont/Invoker.h>
@@ -63,6 +64,8 @@ public:
 
   class TreeBuilder;
 
+  class NodeArea;
+
   VISKORES_CONT
   LinearBVHBuilder() {}
 
@@ -71,6 +74,15 @@ public:
   VISKORES_CONT void BuildHierarchy(BVHData& bvh);
 
   VISKORES_CONT void Build(LinearBVH& linearBVH);
+
+  VISKORES_CONT void Refit(LinearBVH& linearBVH, AABBs& aabbs);
+
+private:
+  VISKORES_CONT void ComputeTotalBounds(LinearBVH& linearBVH);
+
+  VISKORES_CONT void PropagateBounds(LinearBVH& linearBVH);
+
+  VISKORES_CONT viskores::Float32 ComputeCost(const LinearBVH& linearBVH);
 }; // class LinearBVHBuilder
 
 class LinearBVHBuilder::CountingIterator : public viskores::worklet::WorkletMapField
@@ -131,6 +143,7 @@ public:
   viskores::cont::ArrayHandle<viskores::Id> leftChild;
   viskores::cont::ArrayHandle<viskores::Id> rightChild;
   viskores::cont::ArrayHandle<viskores::Id> leafs;
+  viskores::cont::ArrayHandle<viskores::Id> primitives;
   viskores::cont::ArrayHandle<viskores::Bounds> innerBounds;
   viskores::cont::ArrayHandleCounting<viskores::Id> leafOffsets;
   AABBs& AABB;
@@ -483,6 +496,34 @@ public:
   }
 }; // class TreeBuilder
 
+class LinearBVHBuilder::NodeArea : public viskores::worklet::WorkletMapField
+{
+public:
+  VISKORES_CONT
+  NodeArea() {}
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename BVHType>
+  VISKORES_EXEC void operator()(const viskores::Id& node,
+                                const BVHType& flatBVH,
+                                viskores::Float32& area) const
+  {
+    // The node is the union of the boxes of its children.
+    const viskores::Vec4f_32 first4Vec = flatBVH.Get(node * 4);
+    const viskores::Vec4f_32 second4Vec = flatBVH.Get(node * 4 + 1);
+    const viskores::Vec4f_32 third4Vec = flatBVH.Get(node * 4 + 2);
+    const viskores::Vec3f_32 minPoint(viskores::Min(first4Vec[0], second4Vec[2]),
+                                      viskores::Min(first4Vec[1], second4Vec[3]),
+                                      viskores::Min(first4Vec[2], third4Vec[0]));
+    const viskores::Vec3f_32 maxPoint(viskores::Max(first4Vec[3], third4Vec[1]),
+                                      viskores::Max(second4Vec[0], third4Vec[2]),
+                                      viskores::Max(second4Vec[1], third4Vec[3]));
+    const viskores::Vec3f_32 extent = maxPoint - minPoint;
+    area = extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0];
+  }
+}; // class NodeArea
+
 VISKORES_CONT void LinearBVHBuilder::SortAABBS(BVHData& bvh, bool singleAABB)
 {
   //create array of indexes to be sorted with morton codes
@@ -556,6 +597,7 @@ VISKORES_CONT void LinearBVHBuilder::SortAABBS(BVHData& bvh, bool singleAABB)
 
   viskores::worklet::DispatcherMapField<CreateLeafs> leafDispatcher;
   leafDispatcher.Invoke(iterator, bvh.leafs);
+  bvh.primitives = iterator;
 
 } // method SortAABB
 
@@ -602,23 +644,13 @@ VISKORES_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
 
 
   // Find the extent of all bounding boxes to generate normalization for morton codes
-  viskores::Vec3f_32 minExtent(
-    viskores::Infinity32(), viskores::Infinity32(), viskores::Infinity32());
-  viskores::Vec3f_32 maxExtent(
-    viskores::NegativeInfinity32(), viskores::NegativeInfinity32(), viskores::NegativeInfinity32());
-  maxExtent[0] = viskores::cont::Algorithm::Reduce(bvh.AABB.xmaxs, maxExtent[0], MaxValue());
-  maxExtent[1] = viskores::cont::Algorithm::Reduce(bvh.AABB.ymaxs, maxExtent[1], MaxValue());
-  maxExtent[2] = viskores::cont::Algorithm::Reduce(bvh.AABB.zmaxs, maxExtent[2], MaxValue());
-  minExtent[0] = viskores::cont::Algorithm::Reduce(bvh.AABB.xmins, minExtent[0], MinValue());
-  minExtent[1] = viskores::cont::Algorithm::Reduce(bvh.AABB.ymins, minExtent[1], MinValue());
-  minExtent[2] = viskores::cont::Algorithm::Reduce(bvh.AABB.zmins, minExtent[2], MinValue());
-
-  linearBVH.TotalBounds.X.Min = minExtent[0];
-  linearBVH.TotalBounds.X.Max = maxExtent[0];
-  linearBVH.TotalBounds.Y.Min = minExtent[1];
-  linearBVH.TotalBounds.Y.Max = maxExtent[1];
-  linearBVH.TotalBounds.Z.Min = minExtent[2];
-  linearBVH.TotalBounds.Z.Max = maxExtent[2];
+  this->ComputeTotalBounds(linearBVH);
+  const viskores::Vec3f_32 minExtent(static_cast<viskores::Float32>(linearBVH.TotalBounds.X.Min),
+                                     static_cast<viskores::Float32>(linearBVH.TotalBounds.Y.Min),
+                                     static_cast<viskores::Float32>(linearBVH.TotalBounds.Z.Min));
+  const viskores::Vec3f_32 maxExtent(static_cast<viskores::Float32>(linearBVH.TotalBounds.X.Max),
+                                     static_cast<viskores::Float32>(linearBVH.TotalBounds.Y.Max),
+                                     static_cast<viskores::Float32>(linearBVH.TotalBounds.Z.Max));
 
   viskores::Vec3f_32 deltaExtent = maxExtent - minExtent;
   viskores::Vec3f_32 inverseExtent;
@@ -645,31 +677,113 @@ VISKORES_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
     TreeBuilder(bvh.GetNumberOfPrimitives()));
   treeDispatch.Invoke(bvh.leftChild, bvh.rightChild, bvh.mortonCodes, bvh.parent);
 
-  const viskores::Int32 primitiveCount = viskores::Int32(bvh.GetNumberOfPrimitives());
+  linearBVH.Leafs = bvh.leafs;
+  linearBVH.Parents = bvh.parent;
+  linearBVH.LeftChildren = bvh.leftChild;
+  linearBVH.RightChildren = bvh.rightChild;
+  linearBVH.Primitives = bvh.primitives;
+  this->PropagateBounds(linearBVH);
+
+  linearBVH.BuildCost = this->ComputeCost(linearBVH);
+  linearBVH.IsConstructed = true;
+  ++linearBVH.NumberOfBuilds;
+}
 
-  viskores::cont::ArrayHandle<viskores::Int32> counters;
-  counters.Allocate(bvh.GetNumberOfPrimitives() - 1);
+VISKORES_CONT void LinearBVHBuilder::Refit(LinearBVH& linearBVH, AABBs& aabbs)
+{
+  // Gather the new boxes into the order of the leaves.
+  viskores::worklet::DispatcherMapField<GatherFloat32> gatherDispatcher;
+  AABBs sorted;
+  const viskores::Id arraySize = linearBVH.Primitives.GetNumberOfValues();
+  sorted.xmins.Allocate(arraySize);
+  sorted.ymins.Allocate(arraySize);
+  sorted.zmins.Allocate(arraySize);
+  sorted.xmaxs.Allocate(arraySize);
+  sorted.ymaxs.Allocate(arraySize);
+  sorted.zmaxs.Allocate(arraySize);
+  gatherDispatcher.Invoke(linearBVH.Primitives, aabbs.xmins, sorted.xmins);
+  gatherDispatcher.Invoke(linearBVH.Primitives, aabbs.ymins, sorted.ymins);
+  gatherDispatcher.Invoke(linearBVH.Primitives, aabbs.zmins, sorted.zmins);
+  gatherDispatcher.Invoke(linearBVH.Primitives, aabbs.xmaxs, sorted.xmaxs);
+  gatherDispatcher.Invoke(linearBVH.Primitives, aabbs.ymaxs, sorted.ymaxs);
+  gatherDispatcher.Invoke(linearBVH.Primitives, aabbs.zmaxs, sorted.zmaxs);
+  linearBVH.AABB = sorted;
+
+  this->ComputeTotalBounds(linearBVH);
+  this->PropagateBounds(linearBVH);
+
+  if (this->ComputeCost(linearBVH) > linearBVH.BuildCost * linearBVH.RefitQualityThreshold)
+  {
+    // The primitives moved too far from where the tree was built for.
+    linearBVH.AABB = aabbs;
+    this->Build(linearBVH);
+  }
+}
 
-  viskores::cont::ArrayHandleConstant<viskores::Int32> zero(0, bvh.GetNumberOfPrimitives() - 1);
+VISKORES_CONT void LinearBVHBuilder::ComputeTotalBounds(LinearBVH& linearBVH)
+{
+  const AABBs& aabbs = linearBVH.AABB;
+  linearBVH.TotalBounds.X.Min =
+    viskores::cont::Algorithm::Reduce(aabbs.xmins, viskores::Infinity32(), MinValue());
+  linearBVH.TotalBounds.X.Max =
+    viskores::cont::Algorithm::Reduce(aabbs.xmaxs, viskores::NegativeInfinity32(), MaxValue());
+  linearBVH.TotalBounds.Y.Min =
+    viskores::cont::Algorithm::Reduce(aabbs.ymins, viskores::Infinity32(), MinValue());
+  linearBVH.TotalBounds.Y.Max =
+    viskores::cont::Algorithm::Reduce(aabbs.ymaxs, viskores::NegativeInfinity32(), MaxValue());
+  linearBVH.TotalBounds.Z.Min =
+    viskores::cont::Algorithm::Reduce(aabbs.zmins, viskores::Infinity32(), MinValue());
+  linearBVH.TotalBounds.Z.Max =
+    viskores::cont::Algorithm::Reduce(aabbs.zmaxs, viskores::NegativeInfinity32(), MaxValue());
+}
+
+// Sets the bounds of the inner nodes from the boxes of the leaves, from the bottom up.
+VISKORES_CONT void LinearBVHBuilder::PropagateBounds(LinearBVH& linearBVH)
+{
+  const viskores::Id primitiveCount = linearBVH.GetNumberOfAABBs();
+
+  viskores::cont::ArrayHandle<viskores::Int32> counters;
+  viskores::cont::ArrayHandleConstant<viskores::Int32> zero(0, primitiveCount - 1);
   viskores::cont::Algorithm::Copy(zero, counters);
 
   viskores::worklet::DispatcherMapField<PropagateAABBs> propDispatch(
-    PropagateAABBs{ primitiveCount });
-
-  propDispatch.Invoke(bvh.AABB.xmins,
-                      bvh.AABB.ymins,
-                      bvh.AABB.zmins,
-                      bvh.AABB.xmaxs,
-                      bvh.AABB.ymaxs,
-                      bvh.AABB.zmaxs,
-                      bvh.leafOffsets,
-                      bvh.parent,
-                      bvh.leftChild,
-                      bvh.rightChild,
+    PropagateAABBs{ viskores::Int32(primitiveCount) });
+
+  propDispatch.Invoke(linearBVH.AABB.xmins,
+                      linearBVH.AABB.ymins,
+                      linearBVH.AABB.zmins,
+                      linearBVH.AABB.xmaxs,
+                      linearBVH.AABB.ymaxs,
+                      linearBVH.AABB.zmaxs,
+                      viskores::cont::ArrayHandleCounting<viskores::Id>(0, 2, primitiveCount),
+                      linearBVH.Parents,
+                      linearBVH.LeftChildren,
+                      linearBVH.RightChildren,
                       counters,
                       linearBVH.FlatBVH);
+}
 
-  linearBVH.Leafs = bvh.leafs;
+// Estimates the cost of traversing the tree with the surface area heuristic: the chance
+// that a ray hitting the root also hits a node is the ratio of their surface areas.
+VISKORES_CONT viskores::Float32 LinearBVHBuilder::ComputeCost(const LinearBVH& linearBVH)
+{
+  const viskores::Vec3f_32 extent(static_cast<viskores::Float32>(linearBVH.TotalBounds.X.Length()),
+                                  static_cast<viskores::Float32>(linearBVH.TotalBounds.Y.Length()),
+                                  static_cast<viskores::Float32>(linearBVH.TotalBounds.Z.Length()));
+  const viskores::Float32 rootArea =
+    extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0];
+  if (rootArea <= 0.f)
+  {
+    return 0.f;
+  }
+
+  viskores::cont::ArrayHandle<viskores::Float32> areas;
+  viskores::cont::Invoker invoke;
+  invoke(NodeArea{},
+         viskores::cont::ArrayHandleIndex(linearBVH.GetNumberOfAABBs() - 1),
+         linearBVH.FlatBVH,
+         areas);
+  return viskores::cont::Algorithm::Reduce(areas, 0.f) / rootArea;
 }
 } //namespace detail
 
@@ -690,9 +804,17 @@ LinearBVH::LinearBVH(const LinearBVH& other)
   : AABB(other.AABB)
   , FlatBVH(other.FlatBVH)
   , Leafs(other.Leafs)
+  , TotalBounds(other.TotalBounds)
   , LeafCount(other.LeafCount)
   , IsConstructed(other.IsConstructed)
   , CanConstruct(other.CanConstruct)
+  , Parents(other.Parents)
+  , LeftChildren(other.LeftChildren)
+  , RightChildren(other.RightChildren)
+  , Primitives(other.Primitives)
+  , BuildCost(other.BuildCost)
+  , RefitQualityThreshold(other.RefitQualityThreshold)
+  , NumberOfBuilds(other.NumberOfBuilds)
 {
 }
 
@@ -722,6 +844,38 @@ void LinearBVH::SetData(AABBs& aabbs)
   CanConstruct = true;
 }
 
+VISKORES_CONT
+void LinearBVH::Refit(AABBs& aabbs)
+{
+  if (!this->IsConstructed || (aabbs.xmins.GetNumberOfValues() != this->GetNumberOfAABBs()))
+  {
+    this->SetData(aabbs);
+    this->Construct();
+    return;
+  }
+
+  detail::LinearBVHBuilder builder;
+  builder.Refit(*this, aabbs);
+}
+
+VISKORES_CONT
+void LinearBVH::SetRefitQualityThreshold(viskores::Float32 threshold)
+{
+  this->RefitQualityThreshold = threshold;
+}
+
+VISKORES_CONT
+viskores::Float32 LinearBVH::GetRefitQualityThreshold() const
+{
+  return this->RefitQualityThreshold;
+}
+
+VISKORES_CONT
+viskores::Id LinearBVH::GetNumberOfBuilds() const
+{
+  return this->NumberOfBuilds;
+}
+
 // explicitly export
 //template VISKORES_RENDERING_EXPORT void LinearBVH::ConstructOnDevice<
 //  viskores::cont::DeviceAdapterTagSerial>(viskores::cont::DeviceAdapterTagSerial);
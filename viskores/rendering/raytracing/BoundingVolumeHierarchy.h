@@ -28,6 +28,10 @@ namespace rendering
 {
 namespace raytracing
 {
+namespace detail
+{
+class LinearBVHBuilder;
+}
 
 struct AABBs
 {
@@ -54,9 +58,21 @@ public:
   viskores::Id LeafCount;
 
 protected:
+  friend class detail::LinearBVHBuilder;
+
   bool IsConstructed;
   bool CanConstruct;
 
+  // The tree of the last build, kept so that it can be refit to new boxes. Primitives
+  // holds the index of the primitive of each leaf in the order of the leaves.
+  viskores::cont::ArrayHandle<viskores::Id> Parents;
+  viskores::cont::ArrayHandle<viskores::Id> LeftChildren;
+  viskores::cont::ArrayHandle<viskores::Id> RightChildren;
+  viskores::cont::ArrayHandle<viskores::Id> Primitives;
+  viskores::Float32 BuildCost = 0.f;
+  viskores::Float32 RefitQualityThreshold = 2.f;
+  viskores::Id NumberOfBuilds = 0;
+
 public:
   LinearBVH();
 
@@ -74,6 +90,27 @@ public:
   VISKORES_CONT
   void SetData(AABBs& aabbs);
 
+  /// Updates the hierarchy for new boxes of the same primitives, given in the same order
+  /// as the boxes it was constructed with. The tree is kept and only the bounds of its
+  /// nodes are recomputed, from the leaves up. The hierarchy is rebuilt instead when the
+  /// new boxes have a different count, or when the refit tree would be much slower to
+  /// traverse than the tree first built for the primitives.
+  VISKORES_CONT
+  void Refit(AABBs& aabbs);
+
+  /// Specifies how much worse a refit tree may become before the hierarchy is rebuilt.
+  /// The quality of a tree is estimated by the total surface area of its nodes relative
+  /// to the area of its root. The default of 2 rebuilds once the refit tree is estimated
+  /// to take twice as long to traverse.
+  VISKORES_CONT
+  void SetRefitQualityThreshold(viskores::Float32 threshold);
+  VISKORES_CONT
+  viskores::Float32 GetRefitQualityThreshold() const;
+
+  /// The number of times the hierarchy was built from scratch, as opposed to refit.
+  VISKORES_CONT
+  viskores::Id GetNumberOfBuilds() const;
+
   VISKORES_CONT
   AABBs& GetAABBs();
 
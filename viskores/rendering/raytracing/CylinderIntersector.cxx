@@ -474,7 +474,8 @@ void CylinderIntersector::IntersectRaysImp(Ray<Precision>& rays,
   detail::CylinderLeafWrapper leafIntersector(this->CylIds, Radii);
 
   BVHTraverser traverser;
-  traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+  traverser.IntersectRays(
+    rays, this->BVH, leafIntersector, this->CoordsHandle, this->UsePacketTraversal);
 
   RayOperations::UpdateRayStatus(rays);
 }
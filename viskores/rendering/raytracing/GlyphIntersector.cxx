@@ -589,7 +589,8 @@ void GlyphIntersector::IntersectRaysImp(Ray<Precision>& rays, bool viskoresNotUs
   detail::GlyphLeafWrapper leafIntersector(this->PointIds, Sizes, this->GlyphType);
 
   BVHTraverser traverser;
-  traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+  traverser.IntersectRays(
+    rays, this->BVH, leafIntersector, this->CoordsHandle, this->UsePacketTraversal);
 
   RayOperations::UpdateRayStatus(rays);
 }
@@ -664,7 +664,8 @@ void GlyphIntersectorVector::IntersectRaysImp(Ray<Precision>& rays,
     this->GlyphType, this->PointIds, this->Sizes, this->ArrowBodyRadius, this->ArrowHeadRadius);
 
   BVHTraverser traverser;
-  traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+  traverser.IntersectRays(
+    rays, this->BVH, leafIntersector, this->CoordsHandle, this->UsePacketTraversal);
 
   RayOperations::UpdateRayStatus(rays);
 }
@@ -499,7 +499,8 @@ void QuadIntersector::IntersectRaysImp(Ray<Precision>& rays, bool viskoresNotUse
   detail::QuadExecWrapper leafIntersector(this->QuadIds);
 
   BVHTraverser traverser;
-  traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+  traverser.IntersectRays(
+    rays, this->BVH, leafIntersector, this->CoordsHandle, this->UsePacketTraversal);
 
   RayOperations::UpdateRayStatus(rays);
 }
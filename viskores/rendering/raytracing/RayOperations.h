@@ -26,6 +26,8 @@
 #include <viskores/rendering/raytracing/Worklets.h>
 #include <viskores/rendering/viskores_rendering_export.h>
 
+#include <vector>
+
 namespace viskores
 {
 namespace rendering
@@ -347,6 +349,116 @@ public:
       CopyAndOffsetMask<T>{ offset, RAY_EXITED_MESH }) };
     dispatcher.Invoke(rays.Distance, rays.MinDistance, rays.Status);
   }
+
+  // Copies numRays rays of source, starting at sourceStart, into destination starting at
+  // destinationStart. The destination must already hold enough rays and the same buffers.
+  // The intersection data is only copied if both have it enabled.
+  template <typename T>
+  static void CopyRays(const Ray<T>& source,
+                       viskores::Id sourceStart,
+                       viskores::Id numRays,
+                       Ray<T>& destination,
+                       viskores::Id destinationStart)
+  {
+    if (numRays == 0)
+    {
+      return;
+    }
+
+    auto copy = [&](const auto& input, auto& output, viskores::Id size)
+    {
+      viskores::cont::Algorithm::CopySubRange(
+        input, sourceStart * size, numRays * size, output, destinationStart * size);
+    };
+
+    if (source.IntersectionDataEnabled && destination.IntersectionDataEnabled)
+    {
+      copy(source.IntersectionX, destination.IntersectionX, 1);
+      copy(source.IntersectionY, destination.IntersectionY, 1);
+      copy(source.IntersectionZ, destination.IntersectionZ, 1);
+
+      copy(source.U, destination.U, 1);
+      copy(source.V, destination.V, 1);
+      copy(source.Scalar, destination.Scalar, 1);
+
+      copy(source.NormalX, destination.NormalX, 1);
+      copy(source.NormalY, destination.NormalY, 1);
+      copy(source.NormalZ, destination.NormalZ, 1);
+    }
+
+    copy(source.OriginX, destination.OriginX, 1);
+    copy(source.OriginY, destination.OriginY, 1);
+    copy(source.OriginZ, destination.OriginZ, 1);
+
+    copy(source.DirX, destination.DirX, 1);
+    copy(source.DirY, destination.DirY, 1);
+    copy(source.DirZ, destination.DirZ, 1);
+
+    copy(source.Distance, destination.Distance, 1);
+    copy(source.MinDistance, destination.MinDistance, 1);
+    copy(source.MaxDistance, destination.MaxDistance, 1);
+    copy(source.Status, destination.Status, 1);
+    copy(source.HitIdx, destination.HitIdx, 1);
+    copy(source.PixelIdx, destination.PixelIdx, 1);
+
+    for (std::size_t i = 0; i < source.Buffers.size(); ++i)
+    {
+      copy(source.Buffers[i].Buffer,
+           destination.Buffers.at(i).Buffer,
+           source.Buffers[i].GetNumChannels());
+    }
+  }
+
+  // Puts the rays of several sets one after the other in a single set, so that they are
+  // traced together. The sets must have the same buffers.
+  template <typename T>
+  static void Concatenate(const std::vector<Ray<T>>& rays, Ray<T>& combined)
+  {
+    combined = Ray<T>();
+    if (rays.empty())
+    {
+      return;
+    }
+
+    const Ray<T>& first = rays.front();
+    combined.Buffers.at(0) =
+      ChannelBuffer<T>(first.Buffers.at(0).GetNumChannels(), combined.NumRays);
+    combined.Buffers.at(0).SetName(first.Buffers.at(0).GetName());
+    for (std::size_t i = 1; i < first.Buffers.size(); ++i)
+    {
+      combined.AddBuffer(first.Buffers[i].GetNumChannels(), first.Buffers[i].GetName());
+    }
+    if (first.IntersectionDataEnabled)
+    {
+      combined.EnableIntersectionData();
+    }
+
+    viskores::Id numRays = 0;
+    for (const auto& set : rays)
+    {
+      numRays += set.NumRays;
+    }
+    Resize(combined, static_cast<viskores::Int32>(numRays));
+
+    viskores::Id start = 0;
+    for (const auto& set : rays)
+    {
+      CopyRays(set, 0, set.NumRays, combined, start);
+      start += set.NumRays;
+    }
+  }
+
+  // The inverse of Concatenate: copies the rays of combined back to the sets they came from.
+  template <typename T>
+  static void Split(const Ray<T>& combined, std::vector<Ray<T>>& rays)
+  {
+    viskores::Id start = 0;
+    for (auto& set : rays)
+    {
+      CopyRays(combined, start, set.NumRays, set, 0);
+      start += set.NumRays;
+    }
+  }
 };
 }
 }
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <math.h>
 #include <stdio.h>
+#include <viskores/UpperBound.h>
 #include <viskores/cont/ArrayHandleUniformPointCoordinates.h>
 #include <viskores/cont/ColorTable.h>
 #include <viskores/cont/Timer.h>
@@ -46,22 +47,14 @@ public:
   class Shade : public viskores::worklet::WorkletMapField
   {
   private:
-    viskores::Vec3f_32 LightPosition;
     viskores::Vec3f_32 LightAbmient;
     viskores::Vec3f_32 LightDiffuse;
     viskores::Vec3f_32 LightSpecular;
     viskores::Float32 SpecularExponent;
-    viskores::Vec3f_32 CameraPosition;
-    viskores::Vec3f_32 LookAt;
 
   public:
     VISKORES_CONT
-    Shade(const viskores::Vec3f_32& lightPosition,
-          const viskores::Vec3f_32& cameraPosition,
-          const viskores::Vec3f_32& lookAt)
-      : LightPosition(lightPosition)
-      , CameraPosition(cameraPosition)
-      , LookAt(lookAt)
+    Shade()
     {
       //Set up some default lighting parameters for now
       LightAbmient[0] = .5f;
@@ -76,17 +69,33 @@ public:
       SpecularExponent = 20.f;
     }
 
-    using ControlSignature =
-      void(FieldIn, FieldIn, FieldIn, FieldIn, WholeArrayInOut, WholeArrayIn);
-    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, WorkIndex);
-
-    template <typename ColorPortalType, typename Precision, typename ColorMapPortalType>
+    // The rays of camera i end at rayEnds[i]. The light position and view direction of
+    // each camera are looked up for the ray.
+    using ControlSignature = void(FieldIn,
+                                  FieldIn,
+                                  FieldIn,
+                                  FieldIn,
+                                  WholeArrayInOut,
+                                  WholeArrayIn,
+                                  WholeArrayIn,
+                                  WholeArrayIn,
+                                  WholeArrayIn);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8, _9, WorkIndex);
+
+    template <typename ColorPortalType,
+              typename Precision,
+              typename ColorMapPortalType,
+              typename IdPortalType,
+              typename VecPortalType>
     VISKORES_EXEC void operator()(const viskores::Id& hitIdx,
                                   const Precision& scalar,
                                   const viskores::Vec<Precision, 3>& normal,
                                   const viskores::Vec<Precision, 3>& intersection,
                                   ColorPortalType& colors,
                                   ColorMapPortalType colorMap,
+                                  const IdPortalType& rayEnds,
+                                  const VecPortalType& lightPositions,
+                                  const VecPortalType& viewDirections,
                                   const viskores::Id& idx) const
     {
       viskores::Vec<Precision, 4> color;
@@ -102,8 +111,9 @@ public:
       color[2] = colors.Get(offset + 2);
       color[3] = colors.Get(offset + 3);
 
-      viskores::Vec<Precision, 3> lightDir = LightPosition - intersection;
-      viskores::Vec<Precision, 3> viewDir = CameraPosition - LookAt;
+      const viskores::Id camera = viskores::UpperBound(rayEnds, idx);
+      viskores::Vec<Precision, 3> lightDir = lightPositions.Get(camera) - intersection;
+      viskores::Vec<Precision, 3> viewDir = viewDirections.Get(camera);
       viskores::Normalize(lightDir);
       viskores::Normalize(viewDir);
       //Diffuse lighting
@@ -186,22 +196,35 @@ public:
   template <typename Precision>
   VISKORES_CONT void run(Ray<Precision>& rays,
                          viskores::cont::ArrayHandle<viskores::Vec4f_32>& colorMap,
-                         const viskores::rendering::raytracing::Camera& camera,
+                         const std::vector<Camera>& cameras,
+                         const std::vector<viskores::Id>& numRays,
                          bool shade)
   {
     if (shade)
     {
-      // TODO: support light positions
-      viskores::Vec3f_32 scale(2, 2, 2);
-      viskores::Vec3f_32 lightPosition = camera.GetPosition() + scale * camera.GetUp();
-      viskores::worklet::DispatcherMapField<Shade>(
-        Shade(lightPosition, camera.GetPosition(), camera.GetLookAt()))
+      std::vector<viskores::Id> rayEnds;
+      std::vector<viskores::Vec3f_32> lightPositions;
+      std::vector<viskores::Vec3f_32> viewDirections;
+      viskores::Id rayEnd = 0;
+      for (std::size_t i = 0; i < cameras.size(); ++i)
+      {
+        // TODO: support light positions
+        viskores::Vec3f_32 scale(2, 2, 2);
+        rayEnd += numRays[i];
+        rayEnds.push_back(rayEnd);
+        lightPositions.push_back(cameras[i].GetPosition() + scale * cameras[i].GetUp());
+        viewDirections.push_back(cameras[i].GetPosition() - cameras[i].GetLookAt());
+      }
+      viskores::worklet::DispatcherMapField<Shade>(Shade())
         .Invoke(rays.HitIdx,
                 rays.Scalar,
                 rays.Normal,
                 rays.Intersection,
                 rays.Buffers.at(0).Buffer,
-                colorMap);
+                colorMap,
+                viskores::cont::make_ArrayHandle(rayEnds, viskores::CopyFlag::Off),
+                viskores::cont::make_ArrayHandle(lightPositions, viskores::CopyFlag::Off),
+                viskores::cont::make_ArrayHandle(viewDirections, viskores::CopyFlag::Off));
     }
     else
     {
@@ -250,12 +273,26 @@ void RayTracer::SetColorMap(const viskores::cont::ArrayHandle<viskores::Vec4f_32
 
 void RayTracer::Render(Ray<viskores::Float32>& rays)
 {
-  RenderOnDevice(rays);
+  RenderOnDevice(rays, { this->camera }, { rays.NumRays });
 }
 
 void RayTracer::Render(Ray<viskores::Float64>& rays)
 {
-  RenderOnDevice(rays);
+  RenderOnDevice(rays, { this->camera }, { rays.NumRays });
+}
+
+void RayTracer::Render(Ray<viskores::Float32>& rays,
+                       const std::vector<Camera>& cameras,
+                       const std::vector<viskores::Id>& numRays)
+{
+  RenderOnDevice(rays, cameras, numRays);
+}
+
+void RayTracer::Render(Ray<viskores::Float64>& rays,
+                       const std::vector<Camera>& cameras,
+                       const std::vector<viskores::Id>& numRays)
+{
+  RenderOnDevice(rays, cameras, numRays);
 }
 
 void RayTracer::SetShadingOn(bool on)
@@ -274,7 +311,9 @@ void RayTracer::Clear()
 }
 
 template <typename Precision>
-void RayTracer::RenderOnDevice(Ray<Precision>& rays)
+void RayTracer::RenderOnDevice(Ray<Precision>& rays,
+                               const std::vector<Camera>& cameras,
+                               const std::vector<viskores::Id>& numRays)
 {
   using Timer = viskores::cont::Timer;
 
@@ -308,7 +347,7 @@ void RayTracer::RenderOnDevice(Ray<Precision>& rays)
 
       // Calculate the color at the intersection  point
       detail::SurfaceColor surfaceColor;
-      surfaceColor.run(rays, ColorMap, camera, this->Shade);
+      surfaceColor.run(rays, ColorMap, cameras, numRays, this->Shade);
 
       time = timer.GetElapsedTime();
       logger->AddLogData("shade", time);
@@ -44,7 +44,9 @@ protected:
   bool Shade;
 
   template <typename Precision>
-  void RenderOnDevice(Ray<Precision>& rays);
+  void RenderOnDevice(Ray<Precision>& rays,
+                      const std::vector<Camera>& cameras,
+                      const std::vector<viskores::Id>& numRays);
 
 public:
   VISKORES_CONT
@@ -73,6 +75,19 @@ public:
   VISKORES_CONT
   void Render(viskores::rendering::raytracing::Ray<viskores::Float64>& rays);
 
+  // Renders the rays of several cameras at once. The rays of each camera follow the rays
+  // of the previous one, and numRays holds how many rays each camera has. The cameras
+  // are used to shade the rays, in place of the camera of the tracer.
+  VISKORES_CONT
+  void Render(viskores::rendering::raytracing::Ray<viskores::Float32>& rays,
+              const std::vector<Camera>& cameras,
+              const std::vector<viskores::Id>& numRays);
+
+  VISKORES_CONT
+  void Render(viskores::rendering::raytracing::Ray<viskores::Float64>& rays,
+              const std::vector<Camera>& cameras,
+              const std::vector<viskores::Id>& numRays);
+
   VISKORES_CONT
   viskores::Id GetNumberOfShapes() const;
 
@@ -29,6 +29,10 @@
 #include <viskores/cont/Field.h>
 #include <viskores/cont/TryExecute.h>
 #include <viskores/cont/UncertainArrayHandle.h>
+#include <viskores/cont/internal/Buffer.h>
+
+#include <utility>
+#include <vector>
 
 namespace viskores
 {
@@ -155,6 +159,20 @@ GetScalarFieldArray(const viskores::cont::Field& field)
   return field.GetData().ResetTypes(ScalarRenderingTypes{}, VISKORES_DEFAULT_STORAGE_LIST{});
 }
 
+// The buffers of an array along with how often each had been written to. Comparing the
+// versions taken at two times tells whether the array was replaced or modified.
+using ArrayVersions = std::vector<std::pair<viskores::cont::internal::Buffer, viskores::UInt64>>;
+
+VISKORES_CONT inline ArrayVersions GetArrayVersions(const viskores::cont::UnknownArrayHandle& array)
+{
+  ArrayVersions versions;
+  for (const auto& buffer : array.GetBuffers())
+  {
+    versions.emplace_back(buffer, buffer.GetModifiedCount());
+  }
+  return versions;
+}
+
 VISKORES_CONT inline viskores::cont::UncertainArrayHandle<Vec3RenderingTypes,
                                                           VISKORES_DEFAULT_STORAGE_LIST>
 GetVec3FieldArray(const viskores::cont::Field& field)
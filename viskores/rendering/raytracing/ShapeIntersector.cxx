@@ -95,12 +95,33 @@ viskores::Bounds ShapeIntersector::GetShapeBounds() const
   return ShapeBounds;
 }
 
+viskores::Id ShapeIntersector::GetNumberOfBVHBuilds() const
+{
+  return this->BVH.GetNumberOfBuilds();
+}
+
+void ShapeIntersector::SetUsePacketTraversal(bool usePackets)
+{
+  this->UsePacketTraversal = usePackets;
+}
+
+bool ShapeIntersector::GetUsePacketTraversal() const
+{
+  return this->UsePacketTraversal;
+}
+
 void ShapeIntersector::SetAABBs(AABBs& aabbs)
 {
   this->BVH.SetData(aabbs);
   this->BVH.Construct();
   this->ShapeBounds = this->BVH.TotalBounds;
 }
+
+void ShapeIntersector::RefitAABBs(AABBs& aabbs)
+{
+  this->BVH.Refit(aabbs);
+  this->ShapeBounds = this->BVH.TotalBounds;
+}
 }
 }
 } //namespace viskores::rendering::raytracing
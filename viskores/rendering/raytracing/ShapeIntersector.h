@@ -35,7 +35,10 @@ protected:
   LinearBVH BVH;
   viskores::cont::CoordinateSystem CoordsHandle;
   viskores::Bounds ShapeBounds;
+  bool UsePacketTraversal = false;
   void SetAABBs(AABBs& aabbs);
+  // Refits the BVH to new boxes of the same shapes, which is cheaper than a rebuild.
+  void RefitAABBs(AABBs& aabbs);
 
 public:
   ShapeIntersector();
@@ -74,6 +77,16 @@ public:
   void IntersectionPoint(Ray<viskores::Float64>& rays);
 
   viskores::Bounds GetShapeBounds() const;
+  // The number of times the BVH was built. Refits of the BVH are not counted.
+  viskores::Id GetNumberOfBVHBuilds() const;
+
+  //
+  // Packet traversal traces groups of neighboring rays through the BVH together. It is
+  // faster for the primary rays of a camera on CPU devices, but slower for incoherent rays
+  // and on GPUs, so it is off by default.
+  //
+  void SetUsePacketTraversal(bool usePackets);
+  bool GetUsePacketTraversal() const;
   virtual viskores::Id GetNumberOfShapes() const = 0;
 }; // class ShapeIntersector
 }
@@ -349,7 +349,8 @@ void SphereIntersector::IntersectRaysImp(Ray<Precision>& rays,
   detail::SphereLeafWrapper leafIntersector(this->PointIds, Radii);
 
   BVHTraverser traverser;
-  traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+  traverser.IntersectRays(
+    rays, this->BVH, leafIntersector, this->CoordsHandle, this->UsePacketTraversal);
 
   RayOperations::UpdateRayStatus(rays);
 }
@@ -486,9 +486,19 @@ void TriangleIntersector::SetUseWaterTight(bool useIt)
 void TriangleIntersector::SetData(const viskores::cont::CoordinateSystem& coords,
                                   viskores::cont::ArrayHandle<viskores::Id4> triangles)
 {
-
+  ArrayVersions triangleVersions = GetArrayVersions(triangles);
+  ArrayVersions coordsVersions = GetArrayVersions(coords.GetData());
+  const bool sameTriangles =
+    this->BVH.GetIsConstructed() && (triangleVersions == this->TriangleVersions);
   CoordsHandle = coords;
+  if (sameTriangles && (coordsVersions == this->CoordsVersions))
+  {
+    return;
+  }
+
   Triangles = triangles;
+  this->TriangleVersions = std::move(triangleVersions);
+  this->CoordsVersions = std::move(coordsVersions);
 
   viskores::rendering::raytracing::AABBs AABB;
   viskores::worklet::DispatcherMapField<detail::FindTriangleAABBs>(detail::FindTriangleAABBs())
@@ -501,7 +511,14 @@ void TriangleIntersector::SetData(const viskores::cont::CoordinateSystem& coords
             AABB.zmaxs,
             CoordsHandle);
 
-  this->SetAABBs(AABB);
+  if (sameTriangles)
+  {
+    this->RefitAABBs(AABB);
+  }
+  else
+  {
+    this->SetAABBs(AABB);
+  }
 }
 
 viskores::cont::ArrayHandle<viskores::Id4> TriangleIntersector::GetTriangles()
@@ -531,14 +548,16 @@ VISKORES_CONT void TriangleIntersector::IntersectRaysImp(Ray<Precision>& rays, b
   {
     detail::WaterTightExecWrapper leafIntersector(this->Triangles);
     BVHTraverser traverser;
-    traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    traverser.IntersectRays(
+      rays, this->BVH, leafIntersector, this->CoordsHandle, this->UsePacketTraversal);
   }
   else
   {
     detail::MollerExecWrapper leafIntersector(this->Triangles);
 
     BVHTraverser traverser;
-    traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    traverser.IntersectRays(
+      rays, this->BVH, leafIntersector, this->CoordsHandle, this->UsePacketTraversal);
   }
   // Normally we return the index of the triangle hit,
   // but in some cases we are only interested in the cell
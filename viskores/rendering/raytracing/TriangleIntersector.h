@@ -20,6 +20,7 @@
 
 #include <viskores/cont/DataSet.h>
 #include <viskores/rendering/raytracing/Ray.h>
+#include <viskores/rendering/raytracing/RayTracingTypeDefs.h>
 #include <viskores/rendering/raytracing/ShapeIntersector.h>
 #include <viskores/rendering/viskores_rendering_export.h>
 
@@ -35,12 +36,17 @@ class VISKORES_RENDERING_EXPORT TriangleIntersector : public ShapeIntersector
 protected:
   viskores::cont::ArrayHandle<viskores::Id4> Triangles;
   bool UseWaterTight;
+  ArrayVersions TriangleVersions;
+  ArrayVersions CoordsVersions;
 
 public:
   TriangleIntersector();
 
   void SetUseWaterTight(bool useIt);
 
+  /// Sets the triangles to intersect and builds their BVH. When called again with the
+  /// same, unmodified triangle array, the BVH is refit to the new point coordinates
+  /// instead of rebuilt, or reused as it is if the coordinates did not change either.
   void SetData(const viskores::cont::CoordinateSystem& coords,
                viskores::cont::ArrayHandle<viskores::Id4> triangles);
 
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <viskores/cont/ArrayHandleCartesianProduct.h>
 #include <viskores/cont/ArrayHandleCounting.h>
+#include <viskores/cont/ArrayHandleIndex.h>
 #include <viskores/cont/ArrayHandleUniformPointCoordinates.h>
 #include <viskores/cont/CellLocatorRectilinearGrid.h>
 #include <viskores/cont/CellLocatorUniformGrid.h>
@@ -196,6 +197,190 @@ public:
   }
 }; // class UniformLocatorAdapter
 
+// The number of cells along each side of a brick of cells used to skip empty space.
+constexpr viskores::Id MacroCellSize = 8;
+
+template <typename Device>
+class MacroCellGrid
+{
+private:
+  using VisiblePortal = typename viskores::cont::ArrayHandle<viskores::UInt8>::ReadPortalType;
+  VisiblePortal Visible;
+  viskores::Id3 Dims;
+  viskores::Id3 CellDims;
+
+public:
+  MacroCellGrid(const viskores::cont::ArrayHandle<viskores::UInt8>& visible,
+                const viskores::Id3& dims,
+                const viskores::Id3& cellDims,
+                viskores::cont::Token& token)
+    : Visible(visible.PrepareForInput(Device(), token))
+    , Dims(dims)
+    , CellDims(cellDims)
+  {
+  }
+
+  // Nothing is skipped when no bricks were computed.
+  VISKORES_EXEC
+  inline bool IsTransparent(const viskores::Id3& cell) const
+  {
+    if (this->Visible.GetNumberOfValues() == 0)
+    {
+      return false;
+    }
+    const viskores::Id3 macroCell = cell / MacroCellSize;
+    return this->Visible.Get(macroCell[0] +
+                             this->Dims[0] * (macroCell[1] + this->Dims[1] * macroCell[2])) == 0;
+  }
+
+  // Returns the distance of the first sample past the brick containing the cell. The
+  // samples stay at the same distances as if every sample of the brick had been taken.
+  template <typename LocatorType>
+  VISKORES_EXEC inline viskores::Float32 Skip(const LocatorType& locator,
+                                              const viskores::Id3& cell,
+                                              const viskores::Vec3f_32& rayOrigin,
+                                              const viskores::Vec3f_32& rayDir,
+                                              viskores::Float32 distance,
+                                              viskores::Float32 sampleDistance) const
+  {
+    const viskores::Id3 brickStart = (cell / MacroCellSize) * MacroCellSize;
+    const viskores::Id3 brickEnd = viskores::Min(brickStart + MacroCellSize, this->CellDims);
+    viskores::Vec3f_32 minPoint;
+    viskores::Vec3f_32 maxPoint;
+    locator.GetMinPoint(brickStart, minPoint);
+    locator.GetMinPoint(brickEnd, maxPoint);
+
+    viskores::Float32 exitDistance = viskores::Infinity32();
+    for (viskores::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      if (rayDir[axis] > 0.f)
+      {
+        exitDistance =
+          viskores::Min(exitDistance, (maxPoint[axis] - rayOrigin[axis]) / rayDir[axis]);
+      }
+      else if (rayDir[axis] < 0.f)
+      {
+        exitDistance =
+          viskores::Min(exitDistance, (minPoint[axis] - rayOrigin[axis]) / rayDir[axis]);
+      }
+    }
+    const viskores::Float32 steps =
+      viskores::Max(viskores::Ceil((exitDistance - distance) / sampleDistance), 1.f);
+    return distance + steps * sampleDistance;
+  }
+}; // class MacroCellGrid
+
+class MacroCellRange : public viskores::worklet::WorkletMapField
+{
+  viskores::Id3 Dims;
+  viskores::Id3 CellDims;
+  bool IsAssocPoints;
+
+public:
+  VISKORES_CONT
+  MacroCellRange(const viskores::Id3& dims, const viskores::Id3& cellDims, bool isAssocPoints)
+    : Dims(dims)
+    , CellDims(cellDims)
+    , IsAssocPoints(isAssocPoints)
+  {
+  }
+
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename ScalarPortalType>
+  VISKORES_EXEC void operator()(const viskores::Id& index,
+                                const ScalarPortalType& scalars,
+                                viskores::Vec2f_32& range) const
+  {
+    const viskores::Id3 macroCell(index % this->Dims[0],
+                                  (index / this->Dims[0]) % this->Dims[1],
+                                  index / (this->Dims[0] * this->Dims[1]));
+    const viskores::Id3 start = macroCell * MacroCellSize;
+    viskores::Id3 end = viskores::Min(start + MacroCellSize, this->CellDims);
+    viskores::Id3 valueDims = this->CellDims;
+    // The samples of a cell interpolate all the points of the cell.
+    if (this->IsAssocPoints)
+    {
+      end = end + viskores::Id3(1);
+      valueDims = valueDims + viskores::Id3(1);
+    }
+
+    range[0] = viskores::Infinity32();
+    range[1] = viskores::NegativeInfinity32();
+    for (viskores::Id k = start[2]; k < end[2]; ++k)
+    {
+      for (viskores::Id j = start[1]; j < end[1]; ++j)
+      {
+        for (viskores::Id i = start[0]; i < end[0]; ++i)
+        {
+          const auto value =
+            static_cast<viskores::Float32>(scalars.Get(i + valueDims[0] * (j + valueDims[1] * k)));
+          range[0] = viskores::Min(range[0], value);
+          range[1] = viskores::Max(range[1], value);
+        }
+      }
+    }
+  }
+}; // class MacroCellRange
+
+class MacroCellVisibility : public viskores::worklet::WorkletMapField
+{
+  viskores::Float32 MinScalar;
+  viskores::Float32 InverseDeltaScalar;
+  viskores::Id ColorMapSize;
+
+  VISKORES_EXEC
+  inline viskores::Id ColorIndex(viskores::Float32 scalar) const
+  {
+    // Same lookup as the samplers.
+    const viskores::Float32 normalizedScalar =
+      (scalar - this->MinScalar) * this->InverseDeltaScalar;
+    auto colorIndex =
+      static_cast<viskores::Id>(normalizedScalar * static_cast<viskores::Float32>(ColorMapSize));
+    return viskores::Max(viskores::Id(0), viskores::Min(colorIndex, this->ColorMapSize));
+  }
+
+public:
+  VISKORES_CONT
+  MacroCellVisibility(viskores::Float32 minScalar,
+                      viskores::Float32 maxScalar,
+                      viskores::Id colorMapSize)
+    : MinScalar(minScalar)
+    , InverseDeltaScalar(minScalar)
+    , ColorMapSize(colorMapSize - 1)
+  {
+    if ((maxScalar - minScalar) != 0.f)
+    {
+      InverseDeltaScalar = 1.f / (maxScalar - minScalar);
+    }
+  }
+
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  // visibleCounts holds the number of color map entries with nonzero opacity before
+  // each entry.
+  template <typename CountPortalType>
+  VISKORES_EXEC void operator()(const viskores::Vec2f_32& range,
+                                const CountPortalType& visibleCounts,
+                                viskores::UInt8& visible) const
+  {
+    if (!(range[0] <= range[1]))
+    {
+      // Keep bricks with invalid values.
+      visible = 1;
+      return;
+    }
+    const viskores::Id index0 = this->ColorIndex(range[0]);
+    const viskores::Id index1 = this->ColorIndex(range[1]);
+    // Widen the lookup by one entry to allow for the rounding of the interpolation.
+    const viskores::Id first = viskores::Max(viskores::Min(index0, index1) - 1, viskores::Id(0));
+    const viskores::Id last = viskores::Min(viskores::Max(index0, index1) + 1, this->ColorMapSize);
+    visible = (visibleCounts.Get(last + 1) > visibleCounts.Get(first)) ? 1 : 0;
+  }
+}; // class MacroCellVisibility
+
 } //namespace
 
 
@@ -211,6 +396,7 @@ private:
   viskores::Float32 SampleDistance;
   viskores::Float32 InverseDeltaScalar;
   LocatorType Locator;
+  MacroCellGrid<DeviceAdapterTag> MacroCells;
   viskores::Float32 MeshEpsilon;
 
 public:
@@ -220,6 +406,7 @@ public:
           const viskores::Float32& maxScalar,
           const viskores::Float32& sampleDistance,
           const LocatorType& locator,
+          const MacroCellGrid<DeviceAdapterTag>& macroCells,
           const viskores::Float32& meshEpsilon,
           viskores::cont::Token& token)
     : ColorMap(colorMap.PrepareForInput(DeviceAdapterTag(), token))
@@ -227,6 +414,7 @@ public:
     , SampleDistance(sampleDistance)
     , InverseDeltaScalar(minScalar)
     , Locator(locator)
+    , MacroCells(macroCells)
     , MeshEpsilon(meshEpsilon)
   {
     ColorMapSize = colorMap.GetNumberOfValues() - 1;
@@ -314,6 +502,14 @@ public:
       {
         viskores::Vec<viskores::Id, 8> cellIndices;
         Locator.LocateCell(cell, sampleLocation, invSpacing, parametric);
+        if (MacroCells.IsTransparent(cell))
+        {
+          // Step over the samples of a brick the color map hides.
+          distance =
+            MacroCells.Skip(Locator, cell, rayOrigin, rayDir, distance, SampleDistance);
+          sampleLocation = rayOrigin + distance * rayDir;
+          continue;
+        }
         Locator.GetCellIndices(cell, cellIndices);
         Locator.GetPoint(cellIndices[0], bottomLeft);
 
@@ -402,6 +598,7 @@ private:
   viskores::Float32 SampleDistance;
   viskores::Float32 InverseDeltaScalar;
   LocatorType Locator;
+  MacroCellGrid<DeviceAdapterTag> MacroCells;
   viskores::Float32 MeshEpsilon;
 
 public:
@@ -411,6 +608,7 @@ public:
                    const viskores::Float32& maxScalar,
                    const viskores::Float32& sampleDistance,
                    const LocatorType& locator,
+                   const MacroCellGrid<DeviceAdapterTag>& macroCells,
                    const viskores::Float32& meshEpsilon,
                    viskores::cont::Token& token)
     : ColorMap(colorMap.PrepareForInput(DeviceAdapterTag(), token))
@@ -418,6 +616,7 @@ public:
     , SampleDistance(sampleDistance)
     , InverseDeltaScalar(minScalar)
     , Locator(locator)
+    , MacroCells(macroCells)
     , MeshEpsilon(meshEpsilon)
   {
     ColorMapSize = colorMap.GetNumberOfValues() - 1;
@@ -496,6 +695,14 @@ public:
       if (newCell)
       {
         Locator.LocateCell(cell, sampleLocation, invSpacing, parametric);
+        if (MacroCells.IsTransparent(cell))
+        {
+          // Step over the samples of a brick the color map hides.
+          distance =
+            MacroCells.Skip(Locator, cell, rayOrigin, rayDir, distance, SampleDistance);
+          sampleLocation = rayOrigin + distance * rayDir;
+          continue;
+        }
         viskores::Id cellId = Locator.GetCellIndex(cell);
         Locator.GetMinPoint(cell, bottomLeft);
 
@@ -685,10 +892,11 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
   extent[2] = static_cast<viskores::Float32>(this->SpatialExtent.Z.Length());
   viskores::Float32 mag_extent = viskores::Magnitude(extent);
   viskores::Float32 meshEpsilon = mag_extent * 0.0001f;
-  if (SampleDistance <= 0.f)
+  viskores::Float32 sampleDistance = this->SampleDistance;
+  if (sampleDistance <= 0.f)
   {
     const viskores::Float32 defaultNumberOfSamples = 200.f;
-    SampleDistance = mag_extent / defaultNumberOfSamples;
+    sampleDistance = mag_extent / defaultNumberOfSamples;
   }
 
   viskores::cont::Invoker invoke;
@@ -713,6 +921,11 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
   }
   const bool isAssocPoints = ScalarField->IsPointField();
 
+  this->UpdateMacroCells();
+  time = timer.GetElapsedTime();
+  logger->AddLogData("macro_cells", time);
+  timer.Start();
+
   if (IsUniformDataSet)
   {
     viskores::cont::Token token;
@@ -723,6 +936,8 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
     uniLocator.SetCellSet(this->Cellset);
     uniLocator.SetCoordinates(this->Coordinates);
     UniformLocatorAdapter<Device> locator(vertices, this->Cellset, uniLocator, token);
+    MacroCellGrid<Device> macroCells(
+      this->MacroCellVisible, this->MacroCellDims, this->Cellset.GetCellDimensions(), token);
 
     if (isAssocPoints)
     {
@@ -730,8 +945,9 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
         Sampler<Device, UniformLocatorAdapter<Device>>(ColorMap,
                                                        viskores::Float32(ScalarRange.Min),
                                                        viskores::Float32(ScalarRange.Max),
-                                                       SampleDistance,
+                                                       sampleDistance,
                                                        locator,
+                                                       macroCells,
                                                        meshEpsilon,
                                                        token);
       invoke(sampler,
@@ -748,8 +964,9 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
         SamplerCellAssoc<Device, UniformLocatorAdapter<Device>>(ColorMap,
                                                                 viskores::Float32(ScalarRange.Min),
                                                                 viskores::Float32(ScalarRange.Max),
-                                                                SampleDistance,
+                                                                sampleDistance,
                                                                 locator,
+                                                                macroCells,
                                                                 meshEpsilon,
                                                                 token);
       invoke(sampler,
@@ -770,6 +987,8 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
     rectLocator.SetCellSet(this->Cellset);
     rectLocator.SetCoordinates(this->Coordinates);
     RectilinearLocatorAdapter<Device> locator(vertices, Cellset, rectLocator, token);
+    MacroCellGrid<Device> macroCells(
+      this->MacroCellVisible, this->MacroCellDims, this->Cellset.GetCellDimensions(), token);
 
     if (isAssocPoints)
     {
@@ -777,8 +996,9 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
         Sampler<Device, RectilinearLocatorAdapter<Device>>(ColorMap,
                                                            viskores::Float32(ScalarRange.Min),
                                                            viskores::Float32(ScalarRange.Max),
-                                                           SampleDistance,
+                                                           sampleDistance,
                                                            locator,
+                                                           macroCells,
                                                            meshEpsilon,
                                                            token);
       invoke(sampler,
@@ -795,8 +1015,9 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
         ColorMap,
         viskores::Float32(ScalarRange.Min),
         viskores::Float32(ScalarRange.Max),
-        SampleDistance,
+        sampleDistance,
         locator,
+        macroCells,
         meshEpsilon,
         token);
       invoke(sampler,
@@ -816,6 +1037,66 @@ void VolumeRendererStructured::RenderOnDevice(viskores::rendering::raytracing::R
   logger->CloseLogEntry(time);
 } //Render
 
+void VolumeRendererStructured::UpdateMacroCells()
+{
+  if (!this->UseEmptySpaceSkipping)
+  {
+    this->MacroCellDims = viskores::Id3(0);
+    this->MacroCellRanges.ReleaseResources();
+    this->MacroCellVisible.ReleaseResources();
+    this->MacroCellFieldVersion.clear();
+    this->MacroCellColorMapVersion.clear();
+    return;
+  }
+
+  viskores::cont::Invoker invoke;
+  const viskores::Id3 cellDims = this->Cellset.GetCellDimensions();
+  const viskores::Id3 dims = (cellDims + viskores::Id3(MacroCellSize - 1)) / MacroCellSize;
+  auto fieldVersion = GetArrayVersions(this->ScalarField->GetData());
+  const bool fieldChanged = (dims != this->MacroCellDims) ||
+    (fieldVersion != this->MacroCellFieldVersion) ||
+    (this->MacroCellRanges.GetNumberOfValues() == 0);
+  if (fieldChanged)
+  {
+    this->MacroCellDims = dims;
+    this->MacroCellFieldVersion = std::move(fieldVersion);
+    invoke(MacroCellRange{ dims, cellDims, this->ScalarField->IsPointField() },
+           viskores::cont::ArrayHandleIndex(dims[0] * dims[1] * dims[2]),
+           viskores::rendering::raytracing::GetScalarFieldArray(*this->ScalarField),
+           this->MacroCellRanges);
+  }
+
+  auto colorMapVersion = GetArrayVersions(this->ColorMap);
+  if (!fieldChanged && (colorMapVersion == this->MacroCellColorMapVersion) &&
+      (this->ScalarRange == this->MacroCellScalarRange))
+  {
+    return;
+  }
+  this->MacroCellColorMapVersion = std::move(colorMapVersion);
+  this->MacroCellScalarRange = this->ScalarRange;
+
+  // The color map is small, so count its visible entries on the host.
+  const viskores::Id colorMapSize = this->ColorMap.GetNumberOfValues();
+  viskores::cont::ArrayHandle<viskores::Id> visibleCounts;
+  visibleCounts.Allocate(colorMapSize + 1);
+  {
+    auto colorPortal = this->ColorMap.ReadPortal();
+    auto countPortal = visibleCounts.WritePortal();
+    countPortal.Set(0, 0);
+    for (viskores::Id index = 0; index < colorMapSize; ++index)
+    {
+      countPortal.Set(index + 1,
+                      countPortal.Get(index) + ((colorPortal.Get(index)[3] > 0.f) ? 1 : 0));
+    }
+  }
+  invoke(MacroCellVisibility{ viskores::Float32(this->ScalarRange.Min),
+                              viskores::Float32(this->ScalarRange.Max),
+                              colorMapSize },
+         this->MacroCellRanges,
+         visibleCounts,
+         this->MacroCellVisible);
+}
+
 void VolumeRendererStructured::SetSampleDistance(const viskores::Float32& distance)
 {
   if (distance <= 0.f)
@@ -21,6 +21,7 @@
 #include <viskores/cont/DataSet.h>
 
 #include <viskores/rendering/raytracing/Ray.h>
+#include <viskores/rendering/raytracing/RayTracingTypeDefs.h>
 #include <viskores/rendering/viskores_rendering_export.h>
 
 namespace viskores
@@ -52,10 +53,24 @@ public:
   VISKORES_CONT
   void SetSampleDistance(const viskores::Float32& distance);
 
+  /// @brief Specifies whether rays skip the parts of the volume that are fully transparent.
+  ///
+  /// The volume is divided into bricks of cells, and the range of the scalar field in each
+  /// brick is looked up in the color map. Rays step over the bricks that the color map
+  /// makes fully transparent without sampling them. The bricks are only recomputed when
+  /// the scalar field, the scalar range, or the color map change, so reuse the same
+  /// renderer to render the same data several times. Skipping is on by default.
+  VISKORES_CONT
+  void SetUseEmptySpaceSkipping(bool use) { this->UseEmptySpaceSkipping = use; }
+  VISKORES_CONT
+  bool GetUseEmptySpaceSkipping() const { return this->UseEmptySpaceSkipping; }
+
 protected:
   template <typename Precision, typename Device>
   VISKORES_CONT void RenderOnDevice(viskores::rendering::raytracing::Ray<Precision>& rays, Device);
 
+  VISKORES_CONT void UpdateMacroCells();
+
   bool IsSceneDirty = false;
   bool IsUniformDataSet = true;
   viskores::Bounds SpatialExtent;
@@ -65,6 +80,16 @@ protected:
   viskores::cont::ArrayHandle<viskores::Vec4f_32> ColorMap;
   viskores::Float32 SampleDistance = -1.f;
   viskores::Range ScalarRange;
+
+  bool UseEmptySpaceSkipping = true;
+  // The scalar range of each brick of cells, and whether the color map shows any of it.
+  viskores::Id3 MacroCellDims{ 0, 0, 0 };
+  viskores::cont::ArrayHandle<viskores::Vec2f_32> MacroCellRanges;
+  viskores::cont::ArrayHandle<viskores::UInt8> MacroCellVisible;
+  // The arrays the bricks were computed from and how often they had been written to.
+  ArrayVersions MacroCellFieldVersion;
+  ArrayVersions MacroCellColorMapVersion;
+  viskores::Range MacroCellScalarRange;
 };
 }
 }
@@ -0,0 +1,173 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/cont/testing/Testing.h>
+#include <viskores/rendering/Camera.h>
+#include <viskores/rendering/raytracing/BoundingVolumeHierarchy.h>
+#include <viskores/rendering/raytracing/Camera.h>
+#include <viskores/rendering/raytracing/SphereExtractor.h>
+#include <viskores/rendering/raytracing/SphereIntersector.h>
+#include <viskores/rendering/raytracing/TriangleExtractor.h>
+#include <viskores/rendering/raytracing/TriangleIntersector.h>
+#include <viskores/source/Tangle.h>
+
+namespace
+{
+
+constexpr viskores::Id BoxesPerSide = 10;
+constexpr viskores::Id NumberOfBoxes = BoxesPerSide * BoxesPerSide * BoxesPerSide;
+
+// Makes a grid of small boxes. The box of a primitive is placed at the grid position
+// given by the permutation, and moved by the offset.
+viskores::rendering::raytracing::AABBs MakeBoxes(viskores::Id numBoxes,
+                                                 viskores::Id permutation,
+                                                 viskores::Float32 offset)
+{
+  viskores::rendering::raytracing::AABBs aabbs;
+  for (auto* array : { &aabbs.xmins, &aabbs.ymins, &aabbs.zmins })
+  {
+    array->Allocate(numBoxes);
+  }
+  for (auto* array : { &aabbs.xmaxs, &aabbs.ymaxs, &aabbs.zmaxs })
+  {
+    array->Allocate(numBoxes);
+  }
+  auto xmins = aabbs.xmins.WritePortal();
+  auto ymins = aabbs.ymins.WritePortal();
+  auto zmins = aabbs.zmins.WritePortal();
+  auto xmaxs = aabbs.xmaxs.WritePortal();
+  auto ymaxs = aabbs.ymaxs.WritePortal();
+  auto zmaxs = aabbs.zmaxs.WritePortal();
+  for (viskores::Id index = 0; index < numBoxes; ++index)
+  {
+    const viskores::Id position = (index * permutation) % numBoxes;
+    const viskores::Float32 x = static_cast<viskores::Float32>(position % BoxesPerSide) + offset;
+    const viskores::Float32 y =
+      static_cast<viskores::Float32>((position / BoxesPerSide) % BoxesPerSide);
+    const viskores::Float32 z =
+      static_cast<viskores::Float32>(position / (BoxesPerSide * BoxesPerSide));
+    xmins.Set(index, x);
+    ymins.Set(index, y);
+    zmins.Set(index, z);
+    xmaxs.Set(index, x + 0.5f);
+    ymaxs.Set(index, y + 0.5f);
+    zmaxs.Set(index, z + 0.5f);
+  }
+  return aabbs;
+}
+
+void TestRefit()
+{
+  std::cout << "Test refitting the BVH." << std::endl;
+  viskores::rendering::raytracing::AABBs boxes = MakeBoxes(NumberOfBoxes, 1, 0.f);
+  viskores::rendering::raytracing::LinearBVH bvh;
+  bvh.SetData(boxes);
+  bvh.Construct();
+  VISKORES_TEST_ASSERT(bvh.GetIsConstructed());
+  VISKORES_TEST_ASSERT(bvh.GetNumberOfBuilds() == 1);
+  VISKORES_TEST_ASSERT(test_equal(bvh.TotalBounds.X.Max, BoxesPerSide - 0.5));
+
+  std::cout << "  Moved boxes." << std::endl;
+  boxes = MakeBoxes(NumberOfBoxes, 1, 2.f);
+  bvh.Refit(boxes);
+  VISKORES_TEST_ASSERT(bvh.GetNumberOfBuilds() == 1, "Moved boxes caused a rebuild.");
+  VISKORES_TEST_ASSERT(test_equal(bvh.TotalBounds.X.Min, 2.0));
+  VISKORES_TEST_ASSERT(test_equal(bvh.TotalBounds.X.Max, BoxesPerSide + 1.5));
+
+  // A copy keeps the tree, so it can be refit as well.
+  viskores::rendering::raytracing::LinearBVH copy(bvh);
+  boxes = MakeBoxes(NumberOfBoxes, 1, 0.f);
+  copy.Refit(boxes);
+  VISKORES_TEST_ASSERT(copy.GetNumberOfBuilds() == 1, "Copied BVH was rebuilt.");
+
+  std::cout << "  Scrambled boxes." << std::endl;
+  // Boxes that were close to each other are now far apart, so the refit tree is poor.
+  boxes = MakeBoxes(NumberOfBoxes, 7919, 0.f);
+  bvh.Refit(boxes);
+  VISKORES_TEST_ASSERT(bvh.GetNumberOfBuilds() == 2, "Poor refit did not cause a rebuild.");
+
+  std::cout << "  Threshold." << std::endl;
+  bvh.SetRefitQualityThreshold(1000.f);
+  VISKORES_TEST_ASSERT(bvh.GetRefitQualityThreshold() == 1000.f);
+  boxes = MakeBoxes(NumberOfBoxes, 1, 0.f);
+  bvh.Refit(boxes);
+  VISKORES_TEST_ASSERT(bvh.GetNumberOfBuilds() == 2);
+
+  std::cout << "  Different number of boxes." << std::endl;
+  boxes = MakeBoxes(NumberOfBoxes / 2, 1, 0.f);
+  bvh.Refit(boxes);
+  VISKORES_TEST_ASSERT(bvh.GetNumberOfBuilds() == 3);
+  VISKORES_TEST_ASSERT(bvh.GetNumberOfAABBs() == NumberOfBoxes / 2);
+}
+
+void CheckPacketTraversal(viskores::rendering::raytracing::ShapeIntersector& intersector,
+                          const viskores::Bounds& bounds)
+{
+  viskores::rendering::Camera camera;
+  camera.ResetToBounds(bounds);
+  camera.Azimuth(30.0f);
+  camera.Elevation(20.0f);
+  // The number of rays is not a multiple of the packet size.
+  viskores::rendering::raytracing::Camera rayCamera = camera.CreateRaytracingCamera(67, 45);
+
+  viskores::rendering::raytracing::Ray<viskores::Float32> expected;
+  rayCamera.CreateRays(expected, bounds);
+  intersector.SetUsePacketTraversal(false);
+  intersector.IntersectRays(expected);
+
+  viskores::rendering::raytracing::Ray<viskores::Float32> rays;
+  rayCamera.CreateRays(rays, bounds);
+  intersector.SetUsePacketTraversal(true);
+  intersector.IntersectRays(rays);
+
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(rays.HitIdx, expected.HitIdx));
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(rays.Distance, expected.Distance));
+  viskores::Id numHits = 0;
+  auto hits = rays.HitIdx.ReadPortal();
+  for (viskores::Id index = 0; index < hits.GetNumberOfValues(); ++index)
+  {
+    numHits += (hits.Get(index) != -1) ? 1 : 0;
+  }
+  VISKORES_TEST_ASSERT(numHits > 0, "No ray hit the shapes.");
+}
+
+void TestPacketTraversal()
+{
+  std::cout << "Test packet traversal." << std::endl;
+  viskores::source::Tangle tangle;
+  tangle.SetPointDimensions({ 20, 20, 20 });
+  viskores::cont::DataSet dataSet = tangle.Execute();
+  viskores::cont::CoordinateSystem coords = dataSet.GetCoordinateSystem();
+
+  std::cout << "  Triangles." << std::endl;
+  viskores::rendering::raytracing::TriangleExtractor triangles;
+  triangles.ExtractCells(dataSet.GetCellSet());
+  viskores::rendering::raytracing::TriangleIntersector triIntersector;
+  triIntersector.SetData(coords, triangles.GetTriangles());
+  CheckPacketTraversal(triIntersector, coords.GetBounds());
+
+  std::cout << "  Spheres." << std::endl;
+  viskores::rendering::raytracing::SphereExtractor spheres;
+  spheres.ExtractCoordinates(coords, 0.02f);
+  viskores::rendering::raytracing::SphereIntersector sphereIntersector;
+  sphereIntersector.SetData(coords, spheres.GetPointIds(), spheres.GetRadii());
+  CheckPacketTraversal(sphereIntersector, coords.GetBounds());
+}
+
+void TestBoundingVolumeHierarchy()
+{
+  TestRefit();
+  TestPacketTraversal();
+}
+
+} //namespace
+
+int UnitTestBoundingVolumeHierarchy(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestBoundingVolumeHierarchy, argc, argv);
+}
@@ -0,0 +1,188 @@
+//============================================================================
+//  The contents of this file are covered by the Viskores license. See
+//  LICENSE.txt for details.
+//
+//  By contributing to this file, all contributors agree to the Developer
+//  Certificate of Origin Version 1.1 (DCO 1.1) as stated in DCO.txt.
+//============================================================================
+
+#include <viskores/rendering/Compositor.h>
+
+#include <viskores/cont/EnvironmentTracker.h>
+#include <viskores/cont/testing/Testing.h>
+
+#include <viskores/thirdparty/diy/diy.h>
+
+namespace
+{
+
+constexpr viskores::Id Width = 37;
+constexpr viskores::Id Height = 23;
+
+// The pixels each rank renders to. Every rank leaves some pixels empty, and some pixels
+// are only rendered by one rank.
+bool IsRendered(int rank, viskores::Id pixel)
+{
+  return ((pixel + rank) % 3 != 0) && !((pixel % 7 == 0) && (rank != 0));
+}
+
+viskores::Vec4f_32 RankColor(int rank, viskores::Id pixel)
+{
+  const viskores::Float32 alpha = 0.25f + 0.5f * static_cast<viskores::Float32>(rank % 2);
+  const viskores::Float32 value = static_cast<viskores::Float32>((pixel + rank) % 5) / 5.f;
+  return viskores::Vec4f_32(value * alpha, (1.f - value) * alpha, 0.5f * alpha, alpha);
+}
+
+viskores::Float32 RankDepth(int rank, viskores::Id pixel)
+{
+  return 0.1f + 0.8f * static_cast<viskores::Float32>((pixel * 13 + rank * 7) % 11) / 11.f;
+}
+
+void RenderRank(viskores::rendering::Canvas& canvas, int rank)
+{
+  canvas.Clear();
+  auto colorPortal = canvas.GetColorBuffer().WritePortal();
+  auto depthPortal = canvas.GetDepthBuffer().WritePortal();
+  for (viskores::Id pixel = 0; pixel < Width * Height; ++pixel)
+  {
+    if (IsRendered(rank, pixel))
+    {
+      colorPortal.Set(pixel, RankColor(rank, pixel));
+      depthPortal.Set(pixel, RankDepth(rank, pixel));
+    }
+  }
+}
+
+void CheckZBuffer(const viskores::rendering::Canvas& canvas, int numRanks)
+{
+  auto colorPortal = canvas.GetColorBuffer().ReadPortal();
+  auto depthPortal = canvas.GetDepthBuffer().ReadPortal();
+  for (viskores::Id pixel = 0; pixel < Width * Height; ++pixel)
+  {
+    viskores::Vec4f_32 expectedColor(0.f);
+    viskores::Float32 expectedDepth = VISKORES_DEFAULT_CANVAS_DEPTH;
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+      if (IsRendered(rank, pixel) && (RankDepth(rank, pixel) < expectedDepth))
+      {
+        expectedColor = RankColor(rank, pixel);
+        expectedDepth = RankDepth(rank, pixel);
+      }
+    }
+    VISKORES_TEST_ASSERT(test_equal(colorPortal.Get(pixel), expectedColor),
+                         "Wrong color at pixel ",
+                         pixel);
+    VISKORES_TEST_ASSERT(test_equal(depthPortal.Get(pixel), expectedDepth),
+                         "Wrong depth at pixel ",
+                         pixel);
+  }
+}
+
+// The ranks are given a visibility order that differs from the rank order.
+viskores::Float64 VisibilityDepth(int rank, int numRanks)
+{
+  return static_cast<viskores::Float64>((rank * 2 + 1) % numRanks);
+}
+
+void CheckVisibilityOrder(const viskores::rendering::Canvas& canvas, int numRanks)
+{
+  std::vector<int> order;
+  for (int position = 0; position < numRanks; ++position)
+  {
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+      if (VisibilityDepth(rank, numRanks) == position)
+      {
+        order.push_back(rank);
+      }
+    }
+  }
+
+  auto colorPortal = canvas.GetColorBuffer().ReadPortal();
+  for (viskores::Id pixel = 0; pixel < Width * Height; ++pixel)
+  {
+    viskores::Vec4f_32 expected(0.f);
+    for (int rank : order)
+    {
+      if (IsRendered(rank, pixel))
+      {
+        expected = expected + (1.f - expected[3]) * RankColor(rank, pixel);
+      }
+    }
+    VISKORES_TEST_ASSERT(test_equal(colorPortal.Get(pixel), expected),
+                         "Wrong color at pixel ",
+                         pixel);
+  }
+}
+
+void TestComposite(viskores::rendering::Compositor::CompositeMode mode,
+                   viskores::rendering::Compositor::CompositeAlgorithm algorithm,
+                   viskores::IdComponent k)
+{
+  viskoresdiy::mpi::communicator comm = viskores::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.rank() == 0)
+  {
+    std::cout << "  Radix " << k << std::endl;
+  }
+
+  viskores::rendering::Compositor compositor;
+  compositor.SetCompositeMode(mode);
+  compositor.SetCompositeAlgorithm(algorithm);
+  compositor.SetRadixK(k);
+
+  viskores::rendering::Canvas canvas(Width, Height);
+  RenderRank(canvas, comm.rank());
+  compositor.Composite(canvas, VisibilityDepth(comm.rank(), comm.size()));
+
+  if (comm.rank() != 0)
+  {
+    // The canvases of the other ranks are left unchanged.
+    viskores::rendering::Canvas original(Width, Height);
+    RenderRank(original, comm.rank());
+    VISKORES_TEST_ASSERT(test_equal_ArrayHandles(canvas.GetColorBuffer(),
+                                                 original.GetColorBuffer()));
+  }
+  else if (mode == viskores::rendering::Compositor::CompositeMode::ZBuffer)
+  {
+    CheckZBuffer(canvas, comm.size());
+  }
+  else
+  {
+    CheckVisibilityOrder(canvas, comm.size());
+  }
+}
+
+void TestCompositor()
+{
+  using Compositor = viskores::rendering::Compositor;
+  viskoresdiy::mpi::communicator comm = viskores::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.rank() == 0)
+  {
+    std::cout << "Compositing the images of " << comm.size() << " ranks." << std::endl;
+  }
+
+  for (Compositor::CompositeMode mode :
+       { Compositor::CompositeMode::ZBuffer, Compositor::CompositeMode::VisibilityOrder })
+  {
+    if (comm.rank() == 0)
+    {
+      std::cout << "Binary swap" << std::endl;
+    }
+    TestComposite(mode, Compositor::CompositeAlgorithm::BinarySwap, 2);
+    if (comm.rank() == 0)
+    {
+      std::cout << "Radix-k" << std::endl;
+    }
+    for (viskores::IdComponent k : { 2, 3, 8 })
+    {
+      TestComposite(mode, Compositor::CompositeAlgorithm::RadixK, k);
+    }
+  }
+}
+
+} // anonymous namespace
+
+int UnitTestCompositorMPI(int argc, char* argv[])
+{
+  return viskores::cont::testing::Testing::Run(TestCompositor, argc, argv);
+}
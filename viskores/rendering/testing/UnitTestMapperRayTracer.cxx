@@ -28,6 +28,161 @@
 namespace
 {
 
+void RenderOnce(viskores::rendering::MapperRayTracer& mapper,
+                viskores::rendering::CanvasRayTracer& canvas,
+                const viskores::cont::DataSet& dataSet)
+{
+  viskores::cont::ColorTable colorTable = viskores::cont::ColorTable::Preset::Inferno;
+  const viskores::cont::Field& field = dataSet.GetField("pointvar");
+  viskores::Range range;
+  field.GetRange(&range);
+  viskores::rendering::Camera camera;
+  camera.ResetToBounds(dataSet.GetCoordinateSystem().GetBounds());
+  camera.Azimuth(30.0f);
+  camera.Elevation(20.0f);
+
+  canvas.Clear();
+  mapper.SetCanvas(&canvas);
+  mapper.SetActiveColorTable(colorTable);
+  mapper.RenderCells(
+    dataSet.GetCellSet(), dataSet.GetCoordinateSystem(), field, colorTable, camera, range);
+}
+
+void TestRepeatedRenders()
+{
+  std::cout << "Test rendering the same cells several times." << std::endl;
+  viskores::cont::testing::MakeTestDataSet maker;
+  viskores::cont::DataSet dataSet = maker.Make3DExplicitDataSet4();
+
+  viskores::rendering::MapperRayTracer mapper;
+  viskores::rendering::CanvasRayTracer canvas(64, 64);
+  viskores::rendering::CanvasRayTracer expected(64, 64);
+  RenderOnce(mapper, canvas, dataSet);
+  RenderOnce(mapper, canvas, dataSet);
+  {
+    viskores::rendering::MapperRayTracer freshMapper;
+    RenderOnce(freshMapper, expected, dataSet);
+  }
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(canvas.GetColorBuffer(), expected.GetColorBuffer()));
+  VISKORES_TEST_ASSERT(mapper.GetNumberOfBVHBuilds() == 1, "BVH of the same cells was rebuilt.");
+
+  // Move the points. The triangles are the same, so the BVH of the mapper is refit.
+  viskores::cont::ArrayHandle<viskores::Vec3f_32> coords;
+  dataSet.GetCoordinateSystem().GetData().AsArrayHandle(coords);
+  {
+    auto portal = coords.WritePortal();
+    for (viskores::Id index = 0; index < portal.GetNumberOfValues(); ++index)
+    {
+      viskores::Vec3f_32 point = portal.Get(index);
+      point[2] *= 1.f + 0.1f * point[0];
+      portal.Set(index, point);
+    }
+  }
+  RenderOnce(mapper, canvas, dataSet);
+  {
+    viskores::rendering::MapperRayTracer freshMapper;
+    RenderOnce(freshMapper, expected, dataSet);
+  }
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(canvas.GetColorBuffer(), expected.GetColorBuffer()),
+                       "Render of moved points differs from a new mapper.");
+  VISKORES_TEST_ASSERT(mapper.GetNumberOfBVHBuilds() == 1, "BVH of moved points was rebuilt.");
+
+  // A different cell set is extracted again.
+  viskores::cont::DataSet other = maker.Make3DExplicitDataSet5();
+  RenderOnce(mapper, canvas, other);
+  {
+    viskores::rendering::MapperRayTracer freshMapper;
+    RenderOnce(freshMapper, expected, other);
+  }
+  VISKORES_TEST_ASSERT(test_equal_ArrayHandles(canvas.GetColorBuffer(), expected.GetColorBuffer()),
+                       "Render of other cells differs from a new mapper.");
+  VISKORES_TEST_ASSERT(mapper.GetNumberOfBVHBuilds() == 2);
+}
+
+void TestSceneRenders()
+{
+  std::cout << "Test rendering a scene of several actors several times." << std::endl;
+  viskores::cont::testing::MakeTestDataSet maker;
+  viskores::cont::DataSet dataSet = maker.Make3DExplicitDataSet4();
+  viskores::rendering::Scene scene;
+  scene.AddActor(viskores::rendering::Actor(
+    dataSet, "pointvar", viskores::cont::ColorTable::Preset::Inferno));
+  scene.AddActor(viskores::rendering::Actor(
+    maker.Make3DExplicitDataSet5(), "pointvar", viskores::cont::ColorTable::Preset::Inferno));
+  viskores::rendering::Camera camera;
+  camera.ResetToBounds(scene.GetSpatialBounds());
+
+  // The scene renders all actors with the same mapper, which keeps the BVH of each.
+  viskores::rendering::MapperRayTracer mapper;
+  viskores::rendering::CanvasRayTracer canvas(64, 64);
+  for (int frame = 0; frame < 3; ++frame)
+  {
+    canvas.Clear();
+    camera.Azimuth(10.0f);
+    scene.Render(mapper, canvas, camera);
+    VISKORES_TEST_ASSERT(mapper.GetNumberOfBVHBuilds() == 2, "Actors rebuilt their BVH.");
+  }
+
+  // A cache too small for the actors builds their BVHs every frame.
+  viskores::rendering::MapperRayTracer smallMapper;
+  smallMapper.SetCacheCapacity(1);
+  for (int frame = 0; frame < 3; ++frame)
+  {
+    canvas.Clear();
+    scene.Render(smallMapper, canvas, camera);
+  }
+  VISKORES_TEST_ASSERT(smallMapper.GetNumberOfBVHBuilds() == 6);
+}
+
+void CheckBatchRender(const viskores::rendering::Scene& scene, const viskores::Bounds& bounds)
+{
+  std::vector<viskores::rendering::Camera> cameras;
+  std::vector<viskores::rendering::CanvasRayTracer> canvases;
+  canvases.reserve(4);
+  std::vector<viskores::rendering::Canvas*> canvasPointers;
+  for (viskores::Id index = 0; index < 4; ++index)
+  {
+    viskores::rendering::Camera camera;
+    camera.ResetToBounds(bounds);
+    camera.Azimuth(70.0f * static_cast<viskores::Float32>(index));
+    camera.Elevation(15.0f * static_cast<viskores::Float32>(index));
+    cameras.push_back(camera);
+    // The canvases do not all have the same size.
+    canvases.emplace_back(index == 2 ? 48 : 64, index == 2 ? 32 : 64);
+    canvases.back().Clear();
+    canvasPointers.push_back(&canvases.back());
+  }
+
+  viskores::rendering::MapperRayTracer mapper;
+  scene.Render(mapper, canvasPointers, cameras);
+  for (std::size_t index = 0; index < cameras.size(); ++index)
+  {
+    viskores::rendering::CanvasRayTracer expected(canvases[index].GetWidth(),
+                                                  canvases[index].GetHeight());
+    expected.Clear();
+    scene.Render(mapper, expected, cameras[index]);
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(canvases[index].GetColorBuffer(), expected.GetColorBuffer()),
+      "Batch render differs for camera ",
+      index);
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(canvases[index].GetDepthBuffer(), expected.GetDepthBuffer()),
+      "Batch depth differs for camera ",
+      index);
+  }
+}
+
+void TestBatchRender()
+{
+  std::cout << "Test rendering several cameras at once." << std::endl;
+  viskores::cont::testing::MakeTestDataSet maker;
+  viskores::cont::DataSet dataSet = maker.Make3DExplicitDataSet4();
+  viskores::rendering::Scene scene;
+  scene.AddActor(viskores::rendering::Actor(
+    dataSet, "pointvar", viskores::cont::ColorTable::Preset::Inferno));
+  CheckBatchRender(scene, dataSet.GetCoordinateSystem().GetBounds());
+}
+
 void RenderTests()
 {
   viskores::cont::testing::MakeTestDataSet maker;
@@ -54,6 +209,10 @@ void RenderTests()
   options.ViewDimension = 2;
   viskores::rendering::testing::RenderTest(
     maker.Make2DUniformDataSet1(), "pointvar", "rendering/raytracer/uniform2D.png", options);
+
+  TestRepeatedRenders();
+  TestSceneRenders();
+  TestBatchRender();
 }
 
 } //namespace
@@ -16,6 +16,8 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <viskores/cont/ArrayHandleConstant.h>
+#include <viskores/cont/DataSetBuilderRectilinear.h>
 #include <viskores/cont/testing/MakeTestDataSet.h>
 #include <viskores/cont/testing/Testing.h>
 #include <viskores/filter/field_conversion/CellAverage.h>
@@ -28,6 +30,8 @@
 #include <viskores/rendering/MapperVolume.h>
 #include <viskores/rendering/Scene.h>
 #include <viskores/rendering/View3D.h>
+#include <viskores/rendering/raytracing/Camera.h>
+#include <viskores/rendering/raytracing/VolumeRendererStructured.h>
 #include <viskores/rendering/testing/RenderTest.h>
 #include <viskores/source/Tangle.h>
 
@@ -231,11 +235,184 @@ void TestUniformGrid()
     tangleAvg, "tangle_avg", "rendering/volume/uniform_cell.png", options);
 }
 
+viskores::cont::ArrayHandle<viskores::Float32> RenderStructuredVolume(
+  viskores::rendering::raytracing::VolumeRendererStructured& tracer,
+  const viskores::cont::DataSet& dataSet,
+  const std::string& fieldName,
+  const viskores::cont::ArrayHandle<viskores::Vec4f_32>& colorMap)
+{
+  const viskores::Bounds bounds = dataSet.GetCoordinateSystem().GetBounds();
+  viskores::rendering::Camera camera;
+  camera.ResetToBounds(bounds);
+  camera.Azimuth(30.0f);
+  camera.Elevation(20.0f);
+  viskores::rendering::raytracing::Camera rayCamera = camera.CreateRaytracingCamera(96, 96);
+  viskores::rendering::raytracing::Ray<viskores::Float32> rays;
+  rayCamera.CreateRays(rays, bounds);
+  rays.Buffers.at(0).InitConst(0.f);
+
+  const viskores::cont::Field& field = dataSet.GetField(fieldName);
+  viskores::Range range;
+  field.GetRange(&range);
+  tracer.SetData(dataSet.GetCoordinateSystem(),
+                 field,
+                 dataSet.GetCellSet().AsCellSet<viskores::cont::CellSetStructured<3>>(),
+                 range);
+  tracer.SetColorMap(colorMap);
+  tracer.Render(rays);
+  return rays.Buffers.at(0).Buffer;
+}
+
+void CheckEmptySpaceSkipping(const viskores::cont::DataSet& dataSet, const std::string& fieldName)
+{
+  std::cout << "  Field " << fieldName << std::endl;
+  // Most of the scalar range is fully transparent.
+  viskores::cont::ArrayHandle<viskores::Vec4f_32> colorMap;
+  colorMap.Allocate(256);
+  {
+    auto portal = colorMap.WritePortal();
+    for (viskores::Id index = 0; index < 256; ++index)
+    {
+      const viskores::Float32 value = static_cast<viskores::Float32>(index) / 255.f;
+      const viskores::Float32 alpha = (index < 180) ? 0.f : 0.2f;
+      portal.Set(index, viskores::Vec4f_32(value, 0.5f, 1.f - value, alpha));
+    }
+  }
+
+  viskores::rendering::raytracing::VolumeRendererStructured fullTracer;
+  fullTracer.SetUseEmptySpaceSkipping(false);
+  viskores::rendering::raytracing::VolumeRendererStructured skipTracer;
+  VISKORES_TEST_ASSERT(skipTracer.GetUseEmptySpaceSkipping());
+
+  auto expected = RenderStructuredVolume(fullTracer, dataSet, fieldName, colorMap);
+  const viskores::cont::ArrayHandleConstant<viskores::Float32> blank(
+    0.f, expected.GetNumberOfValues());
+  VISKORES_TEST_ASSERT(!test_equal_ArrayHandles(expected, blank), "Nothing was rendered.");
+  VISKORES_TEST_ASSERT(
+    test_equal_ArrayHandles(RenderStructuredVolume(skipTracer, dataSet, fieldName, colorMap),
+                            expected),
+    "Skipping empty space changed the image.");
+  // The bricks are reused for the same data.
+  VISKORES_TEST_ASSERT(
+    test_equal_ArrayHandles(RenderStructuredVolume(skipTracer, dataSet, fieldName, colorMap),
+                            expected));
+
+  // Changing the color map makes the bricks visible again.
+  {
+    auto portal = colorMap.WritePortal();
+    for (viskores::Id index = 0; index < 180; ++index)
+    {
+      viskores::Vec4f_32 color = portal.Get(index);
+      color[3] = 0.05f;
+      portal.Set(index, color);
+    }
+  }
+  expected = RenderStructuredVolume(fullTracer, dataSet, fieldName, colorMap);
+  VISKORES_TEST_ASSERT(
+    test_equal_ArrayHandles(RenderStructuredVolume(skipTracer, dataSet, fieldName, colorMap),
+                            expected),
+    "Bricks were not updated for the new color map.");
+}
+
+void TestEmptySpaceSkipping()
+{
+  std::cout << "Test empty space skipping." << std::endl;
+  viskores::source::Tangle tangle;
+  tangle.SetPointDimensions({ 40, 40, 40 });
+  viskores::cont::DataSet tangleData = tangle.Execute();
+  CheckEmptySpaceSkipping(tangleData, "tangle");
+
+  viskores::filter::field_conversion::CellAverage cellAverage;
+  cellAverage.SetActiveField("tangle");
+  cellAverage.SetOutputFieldName("tangle_avg");
+  CheckEmptySpaceSkipping(cellAverage.Execute(tangleData), "tangle_avg");
+
+  // A rectilinear grid with uneven spacing and a dimension that is not a multiple of
+  // the brick size.
+  std::vector<viskores::Float32> x, y, z;
+  for (viskores::Id index = 0; index < 30; ++index)
+  {
+    x.push_back(static_cast<viskores::Float32>(index * index) / 30.f);
+    y.push_back(static_cast<viskores::Float32>(index));
+  }
+  for (viskores::Id index = 0; index < 13; ++index)
+  {
+    z.push_back(static_cast<viskores::Float32>(index) * 2.f);
+  }
+  viskores::cont::DataSet rectData = viskores::cont::DataSetBuilderRectilinear::Create(x, y, z);
+  std::vector<viskores::Float32> distance;
+  for (const auto& z0 : z)
+  {
+    for (const auto& y0 : y)
+    {
+      for (const auto& x0 : x)
+      {
+        distance.push_back(viskores::Sqrt((x0 - 15.f) * (x0 - 15.f) + (y0 - 15.f) * (y0 - 15.f) +
+                                          (z0 - 12.f) * (z0 - 12.f)));
+      }
+    }
+  }
+  rectData.AddPointField("distance", distance);
+  CheckEmptySpaceSkipping(rectData, "distance");
+}
+
+void CheckBatchRender(const viskores::rendering::Scene& scene, const viskores::Bounds& bounds)
+{
+  std::vector<viskores::rendering::Camera> cameras;
+  std::vector<viskores::rendering::CanvasRayTracer> canvases;
+  canvases.reserve(4);
+  std::vector<viskores::rendering::Canvas*> canvasPointers;
+  for (viskores::Id index = 0; index < 4; ++index)
+  {
+    viskores::rendering::Camera camera;
+    camera.ResetToBounds(bounds);
+    camera.Azimuth(70.0f * static_cast<viskores::Float32>(index));
+    camera.Elevation(15.0f * static_cast<viskores::Float32>(index));
+    cameras.push_back(camera);
+    // The canvases do not all have the same size.
+    canvases.emplace_back(index == 2 ? 48 : 64, index == 2 ? 32 : 64);
+    canvases.back().Clear();
+    canvasPointers.push_back(&canvases.back());
+  }
+
+  viskores::rendering::MapperVolume mapper;
+  scene.Render(mapper, canvasPointers, cameras);
+  for (std::size_t index = 0; index < cameras.size(); ++index)
+  {
+    viskores::rendering::CanvasRayTracer expected(canvases[index].GetWidth(),
+                                                  canvases[index].GetHeight());
+    expected.Clear();
+    scene.Render(mapper, expected, cameras[index]);
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(canvases[index].GetColorBuffer(), expected.GetColorBuffer()),
+      "Batch render differs for camera ",
+      index);
+    VISKORES_TEST_ASSERT(
+      test_equal_ArrayHandles(canvases[index].GetDepthBuffer(), expected.GetDepthBuffer()),
+      "Batch depth differs for camera ",
+      index);
+  }
+}
+
+void TestBatchRender()
+{
+  std::cout << "Test rendering several cameras at once." << std::endl;
+  viskores::source::Tangle tangle;
+  tangle.SetPointDimensions({ 20, 20, 20 });
+  viskores::cont::DataSet dataSet = tangle.Execute();
+  viskores::rendering::Scene scene;
+  scene.AddActor(viskores::rendering::Actor(
+    dataSet, "tangle", viskores::cont::ColorTable::Preset::Inferno));
+  CheckBatchRender(scene, dataSet.GetCoordinateSystem().GetBounds());
+}
+
 void RenderTests()
 {
   TestVolumeRenderOccludesAnnotations();
   TestRectilinear();
   TestUniformGrid();
+  TestEmptySpaceSkipping();
+  TestBatchRender();
 }
 
 } //namespace
@@ -45,6 +45,8 @@
 
 #include <viskores/BinaryOperators.h>
 
+#include <type_traits>
+
 namespace viskores
 {
 namespace worklet
@@ -116,10 +118,18 @@ protected:
 /// Select the type of sort for BuildArrays calls. Unstable sorting is faster
 /// but will not produce consistent ordering for equal keys. Stable sorting
 /// is slower, but keeps equal keys in their original order.
+///
+/// Hash does not sort at all. It groups equal keys with a concurrent hash table,
+/// which takes roughly linear time, but the unique keys come out in an arbitrary
+/// order and the values within a group are in no particular order. Use it when
+/// only the grouping matters. Key types that cannot be hashed (anything that is not
+/// a basic scalar, a `viskores::Vec` of them, or a `viskores::Pair` of those) fall
+/// back to an unstable sort.
 enum class KeysSortType
 {
   Unstable = 0,
-  Stable = 1
+  Stable = 1,
+  Hash = 2
 };
 
 /// \brief Manage keys for a `viskores::worklet::WorkletReduceByKey`.
@@ -251,6 +261,16 @@ private:
   template <typename KeyArrayType>
   VISKORES_CONT void BuildArraysInternalStable(const KeyArrayType& keys,
                                                viskores::cont::DeviceAdapterId device);
+
+  template <typename KeyArrayType>
+  VISKORES_CONT void BuildArraysInternalHash(const KeyArrayType& keys,
+                                             viskores::cont::DeviceAdapterId device,
+                                             std::true_type hashable);
+
+  template <typename KeyArrayType>
+  VISKORES_CONT void BuildArraysInternalHash(const KeyArrayType& keys,
+                                             viskores::cont::DeviceAdapterId device,
+                                             std::false_type hashable);
   /// @endcond
 };
 
@@ -20,10 +20,210 @@
 
 #include <viskores/worklet/Keys.h>
 
+#include <viskores/Pair.h>
+#include <viskores/TypeTraits.h>
+#include <viskores/VecTraits.h>
+#include <viskores/cont/ArrayHandleConstant.h>
+#include <viskores/cont/Invoker.h>
+#include <viskores/worklet/WorkletMapField.h>
+
+#include <cstring>
+
 namespace viskores
 {
 namespace worklet
 {
+namespace internal
+{
+
+VISKORES_EXEC_CONT inline viskores::UInt64 KeysHashCombine(viskores::UInt64 hash,
+                                                           viskores::UInt64 bits)
+{
+  return hash ^ (bits + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2));
+}
+
+VISKORES_EXEC_CONT inline viskores::UInt64 KeysHashFinalize(viskores::UInt64 hash)
+{
+  // The splitmix64 finalizer. Slots are picked from the low bits, so every input
+  // bit needs to reach them.
+  hash ^= hash >> 30;
+  hash *= 0xBF58476D1CE4E5B9ULL;
+  hash ^= hash >> 27;
+  hash *= 0x94D049BB133111EBULL;
+  return hash ^ (hash >> 31);
+}
+
+template <typename T>
+VISKORES_EXEC_CONT inline viskores::UInt64 KeysHashBits(T value, viskores::TypeTraitsIntegerTag)
+{
+  return static_cast<viskores::UInt64>(value);
+}
+
+template <typename T>
+VISKORES_EXEC_CONT inline viskores::UInt64 KeysHashBits(T value, viskores::TypeTraitsRealTag)
+{
+  // 0 and -0 compare equal, so they have to hash the same.
+  viskores::UInt64 bits = 0;
+  if (value != T(0))
+  {
+    std::memcpy(&bits, &value, sizeof(T));
+  }
+  return bits;
+}
+
+template <typename T>
+struct KeysHashScalar : std::true_type
+{
+  VISKORES_EXEC_CONT static viskores::UInt64 Combine(viskores::UInt64 hash, T value)
+  {
+    return KeysHashCombine(
+      hash, KeysHashBits(value, typename viskores::TypeTraits<T>::NumericTag{}));
+  }
+};
+
+/// Hashes keys for `KeysSortType::Hash`. Hashes are consistent with `operator==`
+/// for basic scalars, `viskores::Vec`-like types, and `viskores::Pair`.
+template <typename T,
+          typename NumericTag = typename viskores::TypeTraits<T>::NumericTag,
+          typename DimensionalityTag = typename viskores::TypeTraits<T>::DimensionalityTag>
+struct KeysHash : std::false_type
+{
+};
+
+template <typename T>
+struct KeysHash<T, viskores::TypeTraitsIntegerTag, viskores::TypeTraitsScalarTag>
+  : KeysHashScalar<T>
+{
+};
+
+template <typename T>
+struct KeysHash<T, viskores::TypeTraitsRealTag, viskores::TypeTraitsScalarTag>
+  : KeysHashScalar<T>
+{
+};
+
+template <typename T, typename NumericTag>
+struct KeysHash<T, NumericTag, viskores::TypeTraitsVectorTag>
+  : KeysHash<typename viskores::VecTraits<T>::ComponentType>
+{
+  VISKORES_EXEC_CONT static viskores::UInt64 Combine(viskores::UInt64 hash, const T& value)
+  {
+    using Traits = viskores::VecTraits<T>;
+    const viskores::IdComponent numComponents = Traits::GetNumberOfComponents(value);
+    for (viskores::IdComponent index = 0; index < numComponents; ++index)
+    {
+      hash = KeysHash<typename Traits::ComponentType>::Combine(hash,
+                                                               Traits::GetComponent(value, index));
+    }
+    return hash;
+  }
+};
+
+template <typename T1, typename T2, typename NumericTag, typename DimensionalityTag>
+struct KeysHash<viskores::Pair<T1, T2>, NumericTag, DimensionalityTag>
+  : std::integral_constant<bool, KeysHash<T1>::value && KeysHash<T2>::value>
+{
+  VISKORES_EXEC_CONT static viskores::UInt64 Combine(viskores::UInt64 hash,
+                                                     const viskores::Pair<T1, T2>& value)
+  {
+    return KeysHash<T2>::Combine(KeysHash<T1>::Combine(hash, value.first), value.second);
+  }
+};
+
+/// Inserts every key into an open addressing table holding the index of the first
+/// key seen with each value. Each key gets the slot of its group.
+class KeysHashInsert : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature =
+    void(FieldIn key, WholeArrayIn keys, AtomicArrayInOut table, FieldOut slot);
+  using ExecutionSignature = void(_1, InputIndex, _2, _3, _4);
+
+  VISKORES_CONT explicit KeysHashInsert(viskores::Id tableSize)
+    : SlotMask(static_cast<viskores::UInt64>(tableSize - 1))
+  {
+  }
+
+  template <typename KeyType, typename KeysPortal, typename TableType>
+  VISKORES_EXEC void operator()(const KeyType& key,
+                                viskores::Id index,
+                                const KeysPortal& keys,
+                                const TableType& table,
+                                viskores::Id& slot) const
+  {
+    viskores::UInt64 hash = KeysHashFinalize(KeysHash<KeyType>::Combine(0, key));
+    slot = static_cast<viskores::Id>(hash & this->SlotMask);
+    // The table is at least twice the number of keys, so the probe always ends.
+    while (true)
+    {
+      viskores::Id current = -1;
+      if (table.CompareExchange(slot, &current, index) || (keys.Get(current) == key))
+      {
+        return;
+      }
+      slot = static_cast<viskores::Id>((static_cast<viskores::UInt64>(slot) + 1) & this->SlotMask);
+    }
+  }
+
+private:
+  viskores::UInt64 SlotMask;
+};
+
+class KeysHashMarkOccupied : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn tableEntry, FieldOut occupied);
+  using ExecutionSignature = _2(_1);
+
+  VISKORES_EXEC viskores::Id operator()(viskores::Id tableEntry) const
+  {
+    return (tableEntry >= 0) ? 1 : 0;
+  }
+};
+
+/// Finds the group of each key and reserves a position for it within the group.
+class KeysHashCountGroups : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn slot,
+                                WholeArrayIn slotGroups,
+                                AtomicArrayInOut counts,
+                                FieldOut group,
+                                FieldOut rank);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  template <typename SlotGroupsPortal, typename CountsType>
+  VISKORES_EXEC void operator()(viskores::Id slot,
+                                const SlotGroupsPortal& slotGroups,
+                                const CountsType& counts,
+                                viskores::Id& group,
+                                viskores::Id& rank) const
+  {
+    group = slotGroups.Get(slot);
+    rank = counts.Add(group, 1);
+  }
+};
+
+class KeysHashScatter : public viskores::worklet::WorkletMapField
+{
+public:
+  using ControlSignature =
+    void(FieldIn group, FieldIn rank, WholeArrayIn offsets, WholeArrayOut sortedValuesMap);
+  using ExecutionSignature = void(_1, _2, InputIndex, _3, _4);
+
+  template <typename OffsetsPortal, typename MapPortal>
+  VISKORES_EXEC void operator()(viskores::Id group,
+                                viskores::Id rank,
+                                viskores::Id index,
+                                const OffsetsPortal& offsets,
+                                const MapPortal& sortedValuesMap) const
+  {
+    sortedValuesMap.Set(offsets.Get(group) + rank, index);
+  }
+};
+
+} // namespace internal
+
 /// Build the internal arrays without modifying the input. This is more
 /// efficient for stable sorted arrays, but requires an extra copy of the
 /// keys for unstable sorting.
@@ -48,6 +248,9 @@ VISKORES_CONT void Keys<T>::BuildArrays(const KeyArrayType& keys,
     case KeysSortType::Stable:
       this->BuildArraysInternalStable(keys, device);
       break;
+    case KeysSortType::Hash:
+      this->BuildArraysInternalHash(keys, device, internal::KeysHash<KeyType>{});
+      break;
   }
 }
 
@@ -68,8 +271,16 @@ VISKORES_CONT void Keys<T>::BuildArraysInPlace(KeyArrayType& keys,
       this->BuildArraysInternal(keys, device);
       break;
     case KeysSortType::Stable:
+    case KeysSortType::Hash:
     {
-      this->BuildArraysInternalStable(keys, device);
+      if (sort == KeysSortType::Stable)
+      {
+        this->BuildArraysInternalStable(keys, device);
+      }
+      else
+      {
+        this->BuildArraysInternalHash(keys, device, internal::KeysHash<KeyType>{});
+      }
       KeyArrayHandleType tmp;
       // Copy into a temporary array so that the permutation array copy
       // won't alias input/output memory:
@@ -144,6 +355,69 @@ VISKORES_CONT void Keys<T>::BuildArraysInternalStable(const KeyArrayType& keys,
   VISKORES_ASSERT(
     numKeys == viskores::cont::ArrayGetValue(this->Offsets.GetNumberOfValues() - 1, this->Offsets));
 }
+
+template <typename T>
+template <typename KeyArrayType>
+VISKORES_CONT void Keys<T>::BuildArraysInternalHash(const KeyArrayType& keys,
+                                                    viskores::cont::DeviceAdapterId device,
+                                                    std::true_type)
+{
+  VISKORES_LOG_SCOPE(viskores::cont::LogLevel::Perf, "Keys::BuildArraysInternalHash");
+
+  const viskores::Id numKeys = keys.GetNumberOfValues();
+  viskores::cont::Invoker invoke(device);
+
+  // Keep the table at most half full so that probe sequences stay short.
+  viskores::Id tableSize = 2;
+  while (tableSize < 2 * numKeys)
+  {
+    tableSize *= 2;
+  }
+  viskores::cont::ArrayHandle<viskores::Id> table;
+  table.AllocateAndFill(tableSize, -1);
+  viskores::cont::ArrayHandle<viskores::Id> keySlots;
+  invoke(internal::KeysHashInsert{ tableSize }, keys, keys, table, keySlots);
+
+  // Number the occupied slots. Each one holds the first key seen for a group.
+  viskores::cont::ArrayHandle<viskores::Id> occupied;
+  invoke(internal::KeysHashMarkOccupied{}, table, occupied);
+  viskores::cont::ArrayHandle<viskores::Id> representatives;
+  viskores::cont::Algorithm::CopyIf(device, table, occupied, representatives);
+  const viskores::Id numGroups = representatives.GetNumberOfValues();
+  viskores::cont::ArrayHandle<viskores::Id> slotGroups;
+  viskores::cont::Algorithm::ScanExclusive(device, occupied, slotGroups);
+
+  viskores::cont::Algorithm::Copy(
+    device, viskores::cont::make_ArrayHandlePermutation(representatives, keys), this->UniqueKeys);
+
+  viskores::cont::ArrayHandle<viskores::Id> counts;
+  counts.AllocateAndFill(numGroups, 0);
+  viskores::cont::ArrayHandle<viskores::Id> keyGroups;
+  viskores::cont::ArrayHandle<viskores::Id> keyRanks;
+  invoke(internal::KeysHashCountGroups{}, keySlots, slotGroups, counts, keyGroups, keyRanks);
+
+  viskores::cont::Algorithm::ScanExtended(device, counts, this->Offsets);
+
+  this->SortedValuesMap.Allocate(numKeys);
+  invoke(internal::KeysHashScatter{}, keyGroups, keyRanks, this->Offsets, this->SortedValuesMap);
+
+  VISKORES_ASSERT(
+    numKeys == viskores::cont::ArrayGetValue(this->Offsets.GetNumberOfValues() - 1, this->Offsets));
+}
+
+template <typename T>
+template <typename KeyArrayType>
+VISKORES_CONT void Keys<T>::BuildArraysInternalHash(const KeyArrayType& keys,
+                                                    viskores::cont::DeviceAdapterId device,
+                                                    std::false_type)
+{
+  VISKORES_LOG_S(viskores::cont::LogLevel::Info,
+                 "Keys of type " << viskores::cont::TypeToString<KeyType>()
+                                 << " cannot be hashed. Using an unstable sort instead.");
+  KeyArrayHandleType mutableKeys;
+  viskores::cont::Algorithm::Copy(device, keys, mutableKeys);
+  this->BuildArraysInternal(mutableKeys, device);
+}
 }
 }
 #endif
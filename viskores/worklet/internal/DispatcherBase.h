@@ -29,6 +29,7 @@
 #include <viskores/cont/ErrorBadType.h>
 #include <viskores/cont/ErrorExecution.h>
 #include <viskores/cont/Logging.h>
+#include <viskores/cont/Tracing.h>
 #include <viskores/cont/TryExecute.h>
 
 #include <viskores/cont/arg/ControlSignatureTagBase.h>
@@ -742,6 +743,16 @@ private:
                                                ThreadRangeType&& threadRange,
                                                DeviceAdapter device) const
   {
+    // The trace covers moving the arguments to the device as well as running the worklet.
+    viskores::cont::TraceScope trace("worklet");
+    if (trace.IsActive())
+    {
+      trace.SetName(viskores::cont::TypeToString<WorkletType>());
+      trace.AddArg("input_size", internal::detail::FlatRange(inputRange));
+      trace.AddArg("threads", internal::detail::FlatRange(threadRange));
+      trace.AddArg("device", device.GetName());
+    }
+
     // This token represents the scope of the execution objects. It should
     // exist as long as things run on the device.
     viskores::cont::Token token;
@@ -18,9 +18,11 @@
 #ifndef viskores_worklet_spatialstructure_BoundingIntervalHierarchy_h
 #define viskores_worklet_spatialstructure_BoundingIntervalHierarchy_h
 
+#include <cstring>
 #include <type_traits>
 
 #include <viskores/Bounds.h>
+#include <viskores/Hash.h>
 #include <viskores/Types.h>
 #include <viskores/VecFromPortalPermute.h>
 #include <viskores/cont/Algorithm.h>
@@ -120,6 +122,38 @@ struct CellRangesExtracter : public viskores::worklet::WorkletVisitCellsWithPoin
   }
 }; // struct CellRangesExtracter
 
+// Hashes the shape, point ids, and point coordinates of each cell. The sum of the hashes
+// identifies the geometry that a hierarchy was built for.
+struct CellFingerprint : public viskores::worklet::WorkletVisitCellsWithPoints
+{
+  typedef void ControlSignature(CellSetIn, FieldInPoint, FieldOutCell);
+  typedef void ExecutionSignature(CellShape, PointIndices, _2, InputIndex, _3);
+
+  template <typename CellShape, typename PointIndicesVec, typename PointsVec>
+  VISKORES_EXEC void operator()(CellShape shape,
+                                const PointIndicesVec& pointIndices,
+                                const PointsVec& points,
+                                viskores::Id cellIndex,
+                                viskores::UInt64& fingerprint) const
+  {
+    viskores::HashType hash = viskores::Hash(viskores::Id2(cellIndex, shape.Id));
+    const viskores::IdComponent numPoints = pointIndices.GetNumberOfComponents();
+    for (viskores::IdComponent i = 0; i < numPoints; ++i)
+    {
+      viskores::Vec<viskores::UInt64, 5> bits;
+      bits[0] = hash;
+      bits[1] = static_cast<viskores::UInt64>(pointIndices[i]);
+      for (viskores::IdComponent d = 0; d < 3; ++d)
+      {
+        const viskores::Float64 coordinate = static_cast<viskores::Float64>(points[i][d]);
+        std::memcpy(&bits[d + 2], &coordinate, sizeof(coordinate));
+      }
+      hash = viskores::Hash(bits);
+    }
+    fingerprint = hash;
+  }
+}; // struct CellFingerprint
+
 struct LEQWorklet : public viskores::worklet::WorkletMapField
 {
 public:
@@ -567,6 +601,288 @@ struct TreeLevelAdder : public viskores::worklet::WorkletMapField
   viskores::IdComponent MaxLeafSize;
 }; // struct TreeLevelAdder
 
+// Number of bins the centroids of a segment are sorted into by the binned SAH build.
+static constexpr viskores::Id SAHNumberOfBins = 16;
+
+// Expands 10-bit unsigned int into 30 bits.
+VISKORES_EXEC inline viskores::UInt32 ExpandBits32(viskores::UInt32 x32)
+{
+  x32 = (x32 | (x32 << 16)) & 0x030000FF;
+  x32 = (x32 | (x32 << 8)) & 0x0300F00F;
+  x32 = (x32 | (x32 << 4)) & 0x030C30C3;
+  x32 = (x32 | (x32 << 2)) & 0x09249249;
+  return x32;
+}
+
+// Returns the 30 bit Morton code of a point in the unit cube.
+VISKORES_EXEC inline viskores::UInt32 Morton3D(viskores::Float64 x,
+                                               viskores::Float64 y,
+                                               viskores::Float64 z)
+{
+  x = viskores::Min(viskores::Max(x * 1024.0, 0.0), 1023.0);
+  y = viskores::Min(viskores::Max(y * 1024.0, 0.0), 1023.0);
+  z = viskores::Min(viskores::Max(z * 1024.0, 0.0), 1023.0);
+  viskores::UInt32 xx = ExpandBits32(static_cast<viskores::UInt32>(x));
+  viskores::UInt32 yy = ExpandBits32(static_cast<viskores::UInt32>(y));
+  viskores::UInt32 zz = ExpandBits32(static_cast<viskores::UInt32>(z));
+  return (zz << 2 | yy << 1 | xx);
+}
+
+VISKORES_EXEC_CONT inline const viskores::Range& AxisRange(const viskores::Bounds& bounds,
+                                                           viskores::IdComponent axis)
+{
+  return (axis == 0) ? bounds.X : ((axis == 1) ? bounds.Y : bounds.Z);
+}
+
+VISKORES_EXEC inline viskores::IdComponent LongestAxis(const viskores::Bounds& bounds)
+{
+  viskores::IdComponent axis = 0;
+  if (bounds.Y.Length() > AxisRange(bounds, axis).Length())
+  {
+    axis = 1;
+  }
+  if (bounds.Z.Length() > AxisRange(bounds, axis).Length())
+  {
+    axis = 2;
+  }
+  return axis;
+}
+
+VISKORES_EXEC inline viskores::Float64 HalfArea(const viskores::Bounds& bounds)
+{
+  if (!bounds.IsNonEmpty())
+  {
+    return 0;
+  }
+  const viskores::Float64 dx = bounds.X.Length();
+  const viskores::Float64 dy = bounds.Y.Length();
+  const viskores::Float64 dz = bounds.Z.Length();
+  return dx * dy + dy * dz + dz * dx;
+}
+
+struct CentroidBounds : public viskores::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+  using InputDomain = _1;
+
+  VISKORES_EXEC
+  void operator()(const viskores::FloatDefault& x,
+                  const viskores::FloatDefault& y,
+                  const viskores::FloatDefault& z,
+                  viskores::Bounds& bounds) const
+  {
+    bounds = viskores::Bounds(x, x, y, y, z, z);
+  }
+}; // struct CentroidBounds
+
+struct MortonCodeCalculator : public viskores::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+  using InputDomain = _1;
+
+  VISKORES_CONT
+  MortonCodeCalculator(const viskores::Bounds& bounds)
+    : Bounds(bounds)
+  {
+  }
+
+  VISKORES_EXEC
+  void operator()(const viskores::FloatDefault& x,
+                  const viskores::FloatDefault& y,
+                  const viskores::FloatDefault& z,
+                  viskores::UInt32& code) const
+  {
+    code = Morton3D(this->Normalize(x, this->Bounds.X),
+                    this->Normalize(y, this->Bounds.Y),
+                    this->Normalize(z, this->Bounds.Z));
+  }
+
+  VISKORES_EXEC
+  viskores::Float64 Normalize(viskores::FloatDefault value, const viskores::Range& range) const
+  {
+    const viskores::Float64 length = range.Length();
+    return (length > 0) ? (value - range.Min) / length : 0;
+  }
+
+  viskores::Bounds Bounds;
+}; // struct MortonCodeCalculator
+
+// Places every cell in a bin along the longest axis of the centroid bounds of its segment.
+// The key identifies the bin over all segments.
+struct SAHBinCalculator : public viskores::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn centerX,
+                                FieldIn centerY,
+                                FieldIn centerZ,
+                                FieldIn rangeX,
+                                FieldIn rangeY,
+                                FieldIn rangeZ,
+                                FieldIn segmentId,
+                                FieldIn segmentCentroidBounds,
+                                FieldOut binKey,
+                                FieldOut cellBounds);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10);
+  using InputDomain = _1;
+
+  VISKORES_EXEC
+  void operator()(const viskores::FloatDefault& x,
+                  const viskores::FloatDefault& y,
+                  const viskores::FloatDefault& z,
+                  const viskores::Range& rangeX,
+                  const viskores::Range& rangeY,
+                  const viskores::Range& rangeZ,
+                  const viskores::Id& segmentId,
+                  const viskores::Bounds& segmentCentroidBounds,
+                  viskores::Id& binKey,
+                  viskores::Bounds& cellBounds) const
+  {
+    const viskores::IdComponent axis = LongestAxis(segmentCentroidBounds);
+    const viskores::Range& range = AxisRange(segmentCentroidBounds, axis);
+    const viskores::Vec3f center(x, y, z);
+    viskores::Id bin = 0;
+    if (range.Length() > 0)
+    {
+      bin = static_cast<viskores::Id>(static_cast<viskores::Float64>(SAHNumberOfBins) *
+                                      (center[axis] - range.Min) / range.Length());
+      bin = viskores::Max(viskores::Id{ 0 }, viskores::Min(bin, SAHNumberOfBins - 1));
+    }
+    binKey = segmentId * SAHNumberOfBins + bin;
+    cellBounds = viskores::Bounds(rangeX, rangeY, rangeZ);
+  }
+}; // struct SAHBinCalculator
+
+// Selects, per segment, the bin boundary with the lowest surface area cost. The split bin is
+// -1 when all the centroids coincide, in which case the segment is split in half, and
+// SAHNumberOfBins when the segment becomes a leaf.
+struct SAHSplitSelector : public viskores::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn segmentIndex,
+                                FieldIn segmentSize,
+                                FieldIn segmentCentroidBounds,
+                                WholeArrayIn binCounts,
+                                WholeArrayIn binBounds,
+                                FieldOut split,
+                                FieldOut splitBin,
+                                FieldOut choice);
+  typedef void ExecutionSignature(_1, _2, _3, _4, _5, _6, _7, _8);
+  using InputDomain = _1;
+
+  VISKORES_CONT
+  SAHSplitSelector(viskores::IdComponent maxLeafSize)
+    : MaxLeafSize(maxLeafSize)
+  {
+  }
+
+  template <typename CountsPortal, typename BoundsPortal>
+  VISKORES_EXEC void operator()(viskores::Id index,
+                                const viskores::Id& segmentSize,
+                                const viskores::Bounds& segmentCentroidBounds,
+                                const CountsPortal& binCounts,
+                                const BoundsPortal& binBounds,
+                                TreeNode& node,
+                                viskores::Id& splitBin,
+                                viskores::Id& choice) const
+  {
+    if (segmentSize <= this->MaxLeafSize)
+    {
+      node.Dimension = -1;
+      splitBin = SAHNumberOfBins;
+      choice = 0;
+      return;
+    }
+    choice = 1;
+    node.Dimension = LongestAxis(segmentCentroidBounds);
+
+    const viskores::Id firstBin = index * SAHNumberOfBins;
+    if (!(AxisRange(segmentCentroidBounds, node.Dimension).Length() > 0))
+    {
+      viskores::Bounds bounds;
+      for (viskores::Id bin = 0; bin < SAHNumberOfBins; ++bin)
+      {
+        bounds.Include(binBounds.Get(firstBin + bin));
+      }
+      splitBin = -1;
+      node.LMax = static_cast<viskores::FloatDefault>(AxisRange(bounds, node.Dimension).Max);
+      node.RMin = static_cast<viskores::FloatDefault>(AxisRange(bounds, node.Dimension).Min);
+      return;
+    }
+
+    // The first and last bins hold the extreme centroids, so there is always a split with
+    // cells on both sides. Ties go to the more balanced split.
+    viskores::Float64 minCost = viskores::Infinity64();
+    viskores::Id minImbalance = segmentSize;
+    for (viskores::Id split = 1; split < SAHNumberOfBins; ++split)
+    {
+      viskores::Bounds leftBounds, rightBounds;
+      viskores::Id leftCount = 0;
+      viskores::Id rightCount = 0;
+      for (viskores::Id bin = 0; bin < SAHNumberOfBins; ++bin)
+      {
+        if (bin < split)
+        {
+          leftBounds.Include(binBounds.Get(firstBin + bin));
+          leftCount += binCounts.Get(firstBin + bin);
+        }
+        else
+        {
+          rightBounds.Include(binBounds.Get(firstBin + bin));
+          rightCount += binCounts.Get(firstBin + bin);
+        }
+      }
+      if (leftCount == 0 || rightCount == 0)
+      {
+        continue;
+      }
+      const viskores::Float64 cost =
+        static_cast<viskores::Float64>(leftCount) * HalfArea(leftBounds) +
+        static_cast<viskores::Float64>(rightCount) * HalfArea(rightBounds);
+      const viskores::Id imbalance = viskores::Max(leftCount, rightCount);
+      if (cost < minCost || (cost == minCost && imbalance < minImbalance))
+      {
+        minCost = cost;
+        minImbalance = imbalance;
+        splitBin = split;
+        node.LMax = static_cast<viskores::FloatDefault>(AxisRange(leftBounds, node.Dimension).Max);
+        node.RMin = static_cast<viskores::FloatDefault>(AxisRange(rightBounds, node.Dimension).Min);
+      }
+    }
+  }
+
+  viskores::IdComponent MaxLeafSize;
+}; // struct SAHSplitSelector
+
+struct SAHSplitDirectionFlag : public viskores::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn binKey,
+                                FieldIn segmentStart,
+                                FieldIn segmentSize,
+                                FieldIn splitBin,
+                                FieldOut flag);
+  typedef void ExecutionSignature(InputIndex, _1, _2, _3, _4, _5);
+  using InputDomain = _1;
+
+  VISKORES_EXEC
+  void operator()(viskores::Id index,
+                  const viskores::Id& binKey,
+                  const viskores::Id& segmentStart,
+                  const viskores::Id& segmentSize,
+                  const viskores::Id& splitBin,
+                  viskores::Id& flag) const
+  {
+    // We use 0 to signify left child, 1 for right child
+    if (splitBin < 0)
+    {
+      flag = static_cast<viskores::Id>(index - segmentStart >= segmentSize / 2);
+    }
+    else
+    {
+      flag = static_cast<viskores::Id>(binKey % SAHNumberOfBins >= splitBin);
+    }
+  }
+}; // struct SAHSplitDirectionFlag
+
 template <typename T, class BinaryFunctor>
 viskores::cont::ArrayHandle<T> ReverseScanInclusiveByKey(
   const viskores::cont::ArrayHandle<T>& keys,
@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <viskores/worklet/Keys.h>
+#include <viskores/worklet/Keys.hxx>
 
 #include <viskores/cont/ArrayCopy.h>
 
@@ -78,6 +79,38 @@ void TryKeyType(KeyType)
                  keys.GetUniqueKeys().ReadPortal(),
                  keys.GetSortedValuesMap().ReadPortal(),
                  keys.GetOffsets().ReadPortal());
+
+  for (viskores::worklet::KeysSortType sort : { viskores::worklet::KeysSortType::Stable,
+                                                viskores::worklet::KeysSortType::Hash })
+  {
+    std::cout << "  sort type " << static_cast<int>(sort) << std::endl;
+    viskores::worklet::Keys<KeyType> builtKeys;
+    builtKeys.BuildArrays(keyArray, sort);
+    VISKORES_TEST_ASSERT(builtKeys.GetInputRange() == NUM_UNIQUE, "Keys has bad input range.");
+    CheckKeyReduce(keyArray.ReadPortal(),
+                   builtKeys.GetUniqueKeys().ReadPortal(),
+                   builtKeys.GetSortedValuesMap().ReadPortal(),
+                   builtKeys.GetOffsets().ReadPortal());
+
+    // Building in place leaves the keys grouped in the same order as the unique keys.
+    viskores::cont::ArrayHandle<KeyType> groupedKeys;
+    viskores::cont::ArrayCopy(keyArray, groupedKeys);
+    builtKeys.BuildArraysInPlace(groupedKeys, sort);
+    VISKORES_TEST_ASSERT(builtKeys.GetInputRange() == NUM_UNIQUE, "Keys has bad input range.");
+    auto uniquePortal = builtKeys.GetUniqueKeys().ReadPortal();
+    auto offsetsPortal = builtKeys.GetOffsets().ReadPortal();
+    auto groupedPortal = groupedKeys.ReadPortal();
+    for (viskores::Id uniqueIndex = 0; uniqueIndex < NUM_UNIQUE; uniqueIndex++)
+    {
+      for (viskores::Id index = offsetsPortal.Get(uniqueIndex);
+           index < offsetsPortal.Get(uniqueIndex + 1);
+           index++)
+      {
+        VISKORES_TEST_ASSERT(groupedPortal.Get(index) == uniquePortal.Get(uniqueIndex),
+                             "Keys not grouped in place.");
+      }
+    }
+  }
 }
 
 void TestKeys()
@@ -93,6 +126,9 @@ void TestKeys()
 
   std::cout << "Testing viskores::Id3 keys." << std::endl;
   TryKeyType(viskores::Id3());
+
+  std::cout << "Testing viskores::Pair<viskores::UInt8, viskores::Id2> keys." << std::endl;
+  TryKeyType(viskores::Pair<viskores::UInt8, viskores::Id2>());
 }
 
 } // anonymous namespace